@@ -1,5 +1,6 @@
 import numpy as np
 import math
+import copy
 import os
 from bisect import bisect_left
 from queue import Queue
@@ -9,7 +10,7 @@ import re
 from hls4ml.backends.backend import Backend
 from hls4ml.model.layers import Layer
 from hls4ml.model.attributes import Attribute
-from hls4ml.model.types import IntegerPrecisionType, FixedPrecisionType, XnorPrecisionType, ExponentPrecisionType
+from hls4ml.model.types import NamedType, IntegerPrecisionType, FixedPrecisionType, XnorPrecisionType, ExponentPrecisionType
 from hls4ml.writer import get_writer
 from hls4ml.model.optimizer import model_optimizer
 
@@ -79,6 +80,17 @@ class FPGABackend(Backend):
             n_out = layer.get_attr('n_out')
             return n_in, n_out
 
+        # Transposed convolutions compute all phases of the stride at once (see nnet_conv_transpose.h)
+        if 'Conv1DTranspose' in layer.class_name:
+            n_in = layer.get_attr('n_chan') * layer.get_attr('phase_width')
+            n_out = layer.get_attr('n_filt') * layer.get_attr('stride_width')
+            return n_in, n_out
+
+        if 'Conv2DTranspose' in layer.class_name:
+            n_in = layer.get_attr('n_chan') * layer.get_attr('phase_height') * layer.get_attr('phase_width')
+            n_out = layer.get_attr('n_filt') * layer.get_attr('stride_height') * layer.get_attr('stride_width')
+            return n_in, n_out
+
         if 'Conv1D' in layer.class_name:
             n_in = layer.get_attr('n_chan') * layer.get_attr('filt_width')
             n_out = layer.get_attr('n_filt')
@@ -102,6 +114,13 @@ class FPGABackend(Backend):
             n_in_recr = layer.get_attr('n_out')
             n_out_recr = n_out
             return n_in, n_out, n_in_recr, n_out_recr
+
+        if 'SimpleRNN' in layer.class_name:
+            n_in = layer.get_attr('n_in')
+            n_out = layer.get_attr('n_out')
+            n_in_recr = layer.get_attr('n_out')
+            n_out_recr = n_out
+            return n_in, n_out, n_in_recr, n_out_recr
         
         raise Exception(f'Cannot get mult size for layer {layer.name} ({layer.class_name})')
 
@@ -157,6 +176,33 @@ class FPGABackend(Backend):
                 .format(chosen_rf, layer.name, closest_rf, ','.join(map(str, valid_rf))))
             layer.set_attr(attribute, closest_rf)
 
+    def set_merge_accum_type(self, layer):
+        ''' The merges of more than two inputs fold them into an accumulator of type accum_t. Unless it is configured,
+            it gets the bits of the sum (add, average) or product (multiply) of all the inputs, so only the output rounds
+            and saturates
+        '''
+        op = layer.get_attr('op', '').lower()
+        if len(layer.inputs) < 3 or op not in ['add', 'average', 'multiply']:
+            return
+        _, type_name = layer.model.config.get_precision(layer, var='accum')
+        if not type_name.endswith('default_t'):
+            return
+        precisions = [layer.get_input_variable(inp).type.precision for inp in layer.inputs]
+        if not all(type(p) in [FixedPrecisionType, IntegerPrecisionType] for p in precisions):
+            return
+
+        signed = any(p.signed for p in precisions)
+        # An unsigned input needs one more integer bit in a signed accumulator
+        integers = [p.integer + int(signed and not p.signed) for p in precisions]
+        if op == 'multiply':
+            integer = sum(integers)
+            fractional = sum(p.fractional for p in precisions)
+        else:
+            integer = max(integers) + int(math.ceil(math.log2(len(precisions))))
+            fractional = max(p.fractional for p in precisions)
+        precision = FixedPrecisionType(width=integer + fractional, integer=integer, signed=signed)
+        layer.set_attr('accum_t', NamedType(layer.name + '_accum_t', precision))
+
     def set_target_reuse_factor(self, layer):
         # TODO update target reuse factor for the RNN layers
         targ_cycles = layer.get_attr('target_cycles')
@@ -277,6 +323,622 @@ class FPGABackend(Backend):
                 product = 'mult'
         return product
 
+    def estimate(self, model):
+        """Analytic estimate of the latency, initiation interval and resource usage of the model.
+
+        The estimate is derived from the layer attributes that end up in the config structs
+        (reuse factor, strategy, multiplication sizes, stream packing and convolution implementation),
+        without invoking the HLS compiler. The model has not been calibrated against synthesis reports, so it is
+        meant to rank configurations, not to predict the numbers of a synthesis run.
+
+        Args:
+            model (ModelGraph): Model to estimate.
+
+        Returns:
+            dict: Per-layer estimates ('Layers') and the totals for the whole model. The latency of the
+                model is taken along the critical path of the graph, which is also reported. 'WeightMemory' totals
+                the weight arrays placed in each type of memory, see `get_weight_memory()`.
+        """
+        io_type = model.config.get_config_value('IOType')
+
+        layer_estimates = {}
+        for layer in model.get_layers():
+            layer_estimates[layer.name] = self.estimate_layer(layer, io_type)
+
+        return self._summarize_estimate(model, layer_estimates)
+
+    def _summarize_estimate(self, model, layer_estimates):
+        io_type = model.config.get_config_value('IOType')
+
+        # Longest path through the graph. With io_parallel the layers execute one after another, with
+        # io_stream they overlap and the throughput of a path is bound by its slowest layer
+        paths = {}
+        for layer in model.get_layers():
+            est = layer_estimates[layer.name]
+            prev_paths = [paths[node.name] for node in (layer.get_input_node(inp) for inp in layer.inputs) if node is not None and node.name in paths]
+            if len(prev_paths) > 0:
+                prev_path = max(prev_paths, key=lambda p: p['Latency'])
+            else:
+                prev_path = {'Latency': 0, 'Fill': 0, 'Interval': 0, 'Layers': []}
+            if io_type == 'io_stream':
+                fill = prev_path['Fill'] + est['Latency'] - est['Interval']
+                interval = max(prev_path['Interval'], est['Interval'])
+                latency = fill + interval
+            else:
+                fill = prev_path['Fill'] + est['Latency']
+                interval = max(prev_path['Interval'], est['Interval'])
+                latency = fill
+            paths[layer.name] = {'Latency': latency, 'Fill': fill, 'Interval': interval, 'Layers': prev_path['Layers'] + [layer.name]}
+
+        critical_path = max((paths[out_node.name] for out_node in model.get_layers() if out_node.name in paths), key=lambda p: p['Latency'])
+        bottleneck = max(layer_estimates.keys(), key=lambda name: layer_estimates[name]['Interval'])
+
+        report = {}
+        report['Layers'] = layer_estimates
+        report['Latency'] = critical_path['Latency']
+        report['Interval'] = max(est['Interval'] for est in layer_estimates.values())
+        report['LatencyNs'] = report['Latency'] * model.config.get_config_value('ClockPeriod')
+        report['DSP'] = sum(est['DSP'] for est in layer_estimates.values())
+        report['BRAM_18K'] = sum(est['BRAM_18K'] for est in layer_estimates.values())
+        report['URAM'] = sum(est.get('URAM', 0) for est in layer_estimates.values())
+        report['WeightMemory'] = self._summarize_weight_memory(layer_estimates)
+        report['CriticalPath'] = critical_path['Layers']
+        report['Bottleneck'] = bottleneck
+
+        return report
+
+    def _summarize_weight_memory(self, layer_estimates):
+        # Totals of the weight arrays placed in each type of memory, see get_weight_memory()
+        totals = {}
+        for est in layer_estimates.values():
+            memory = est.get('WeightMemory')
+            if memory is None:
+                continue
+            total = totals.setdefault(memory['Impl'], {'Arrays': 0, 'Bits': 0, 'LUT': 0, 'BRAM_18K': 0, 'URAM': 0})
+            total['Arrays'] += 1
+            for key in ['Bits', 'LUT', 'BRAM_18K', 'URAM']:
+                total[key] += memory[key]
+        return totals
+
+    def estimate_layer(self, layer, io_type):
+        """Estimate the latency, initiation interval, DSP and BRAM usage of a single layer.
+
+        Args:
+            layer (Layer): The layer to estimate.
+            io_type (str): 'io_parallel' or 'io_stream'.
+
+        Returns:
+            dict: Estimated 'Latency' and 'Interval' (in clock cycles), 'DSP', 'BRAM_18K' and 'URAM', and the
+                placement of the weights in 'WeightMemory' (see `get_weight_memory()`).
+        """
+        rf = layer.get_attr('reuse_factor', 1)
+        strategy = layer.get_attr('strategy', 'latency')
+        class_name = layer.class_name
+
+        # Number of elements (words) a layer reads from and writes to its streams
+        in_var = layer.get_input_variable() if len(layer.inputs) > 0 else None
+        n_words_in = self._get_stream_words(in_var) if in_var is not None else 0
+        out_shape = layer.get_output_variable().shape
+        n_words_out = self._get_stream_words(layer.get_output_variable())
+
+        latency, interval, dsp, bram = 1, 1, 0, 0
+
+        if class_name in ['Input', 'InputLayer']:
+            latency, interval = 0, 0
+
+        elif 'Dense' in class_name:
+            n_in, n_out = self.get_layer_mult_size(layer)
+            n_mult = n_in * n_out
+            if strategy.lower() == 'latency':
+                n_mult -= layer.get_weights('weight').nzeros
+            dsp = math.ceil(n_mult / rf) * self._estimate_mult_dsp(layer, 'weight')
+            latency = rf + self._estimate_adder_tree_depth(n_in) + 2
+            interval = rf
+            bram = self._estimate_weight_bram(layer, rf, strategy)
+            if getattr(layer.get_weights('weight'), 'storage', '') == 'offchip':
+                latency, interval, dsp, bram = self._estimate_offchip_dense(layer, n_in, n_out)
+            if io_type == 'io_stream':
+                latency += n_words_in
+                interval = max(interval, n_words_in)
+
+        elif class_name in ['SeparableConv1D', 'SeparableConv2D', 'DepthwiseConv2D']:
+            kernel_size = layer.get_attr('filt_height', 1) * layer.get_attr('filt_width')
+            n_chan = layer.get_attr('n_chan')
+            depthwise_name = 'weight' if class_name == 'DepthwiseConv2D' else 'depthwise'
+            n_mult = n_chan * kernel_size
+            dsp = math.ceil(n_mult / rf) * self._estimate_mult_dsp(layer, depthwise_name)
+            latency = rf + self._estimate_adder_tree_depth(kernel_size) + 2
+            if 'Separable' in class_name:
+                n_mult = n_chan * layer.get_attr('n_filt')
+                dsp += math.ceil(n_mult / rf) * self._estimate_mult_dsp(layer, 'pointwise')
+                latency += rf + self._estimate_adder_tree_depth(n_chan) + 2
+            latency, interval, dsp = self._estimate_conv_schedule(layer, io_type, latency, rf, dsp, n_words_in)
+            bram = self._estimate_line_buffer_bram(layer, io_type)
+
+        elif 'Conv1D' in class_name or 'Conv2D' in class_name:
+            n_in, n_out = self.get_layer_mult_size(layer)
+            n_mult = n_in * n_out
+            dsp = math.ceil(n_mult / rf) * self._estimate_mult_dsp(layer, 'weight')
+            latency = rf + self._estimate_adder_tree_depth(n_in) + 2
+            latency, interval, dsp = self._estimate_conv_schedule(layer, io_type, latency, rf, dsp, n_words_in)
+            bram = self._estimate_weight_bram(layer, rf, strategy) + self._estimate_line_buffer_bram(layer, io_type)
+
+        elif class_name in ['LSTM', 'GRU', 'SimpleRNN']:
+            n_in, n_out, n_in_recr, n_out_recr = self.get_layer_mult_size(layer)
+            recr_rf = layer.get_attr('recurrent_reuse_factor', rf)
+            dsp = math.ceil(n_in * n_out / rf) * self._estimate_mult_dsp(layer, 'weight')
+            dsp += math.ceil(n_in_recr * n_out_recr / recr_rf) * self._estimate_mult_dsp(layer, 'recurrent_weight')
+            n_timesteps = layer.get_attr('n_timesteps', 1)
+            input_latency = rf + self._estimate_adder_tree_depth(n_in) + 2
+            recr_latency = recr_rf + self._estimate_adder_tree_depth(n_in_recr) + 4
+            if layer.get_attr('implementation', 'sequential') == 'pipelined':
+                # The input projections of all time steps run ahead of the recurrent updates, in a separate stage
+                latency = input_latency + n_timesteps * recr_latency
+                interval = n_timesteps * max(rf, recr_latency)
+            else:
+                latency = n_timesteps * (input_latency + recr_latency)
+                interval = latency
+            bram = self._estimate_weight_bram(layer, rf, strategy)
+
+        elif 'Pooling' in class_name:
+            if 'Global' in class_name:
+                pool_size = int(np.prod(in_var.shape[:-1]))
+            else:
+                pool_size = layer.get_attr('pool_height', 1) * layer.get_attr('pool_width')
+            latency = self._estimate_adder_tree_depth(pool_size) + 1
+            if io_type == 'io_stream':
+                latency += n_words_in
+                interval = n_words_in
+            bram = self._estimate_line_buffer_bram(layer, io_type)
+
+        elif class_name in ['Activation', 'ParametrizedActivation', 'PReLU', 'Softmax', 'HardActivation']:
+            activation = layer.get_attr('activation', '').lower()
+            n_tables = 0
+            if class_name == 'Softmax' or activation == 'softmax':
+                n_tables = 2
+                n_in = layer.get_attr('n_in', out_shape[-1])
+                latency = 4 + self._estimate_adder_tree_depth(n_in)
+            elif activation in ['sigmoid', 'tanh', 'elu', 'selu', 'softplus', 'softsign']:
+                n_tables = 1
+                latency = 2
+            table_bits = layer.get_attr('table_size', 1024) * self._get_precision_width(layer.get_attr('table_t'), 18)
+            if table_bits > 1024:
+                bram = n_tables * math.ceil(table_bits / 18432)
+            if io_type == 'io_stream':
+                latency += n_words_out
+                interval = n_words_out
+
+        elif class_name == 'BatchNormalization':
+            n_mult = out_shape[-1] if io_type == 'io_stream' else int(np.prod(out_shape))
+            dsp = math.ceil(n_mult / rf) * self._estimate_mult_dsp(layer, 'scale')
+            latency = rf + 2
+            interval = rf
+            if io_type == 'io_stream':
+                latency += n_words_out
+                interval = max(interval, n_words_out)
+
+        else:
+            # Data movement layers (merge, reshape, padding, repacking, cloning...) are bound by the stream length
+            if io_type == 'io_stream':
+                latency = max(n_words_in, n_words_out) + 1
+                interval = max(n_words_in, n_words_out)
+
+        memory = self.get_weight_memory(layer, rf, strategy)
+
+        return {
+            'Class': class_name,
+            'Latency': int(latency),
+            'Interval': int(interval),
+            'DSP': int(dsp),
+            'BRAM_18K': int(bram),
+            'URAM': memory['URAM'] if memory is not None else 0,
+            'WeightMemory': memory,
+        }
+
+    def estimate_stream_fill(self, layer):
+        """Estimate how many words an io_stream layer reads from its input before writing its first output word.
+
+        This is the number of words a layer holds back, in its line buffer or internal storage, and the extra depth
+        needed by the streams that bypass it, see the 'vivado:set_bypass_fifo_depth' pass.
+
+        Args:
+            layer (Layer): The layer to estimate.
+
+        Returns:
+            int: Number of words of the (first) input stream of the layer.
+        """
+        if len(layer.inputs) == 0:
+            return 0
+
+        class_name = layer.class_name
+        n_words_in = self._get_stream_words(layer.get_input_variable())
+        in_width = layer.get_attr('in_width', 1)
+        n_pack = max(layer.get_attr('n_pack', 1), 1)
+
+        if 'Transpose' in class_name and 'Conv' in class_name:
+            # The first output comes from the window of the stride-decomposed kernel holding the first uncropped pixel.
+            # The 2D kernel writes its outputs a row at a time, after reading the whole input row of that window
+            if 'Conv2D' in class_name:
+                first_row = layer.get_attr('crop_top') // layer.get_attr('stride_height')
+                return min((first_row + 1) * in_width, n_words_in)
+            first_col = layer.get_attr('crop_left') // layer.get_attr('stride_width')
+            return min(first_col + 1, n_words_in)
+
+        elif ('Conv' in class_name or 'Pooling' in class_name) and 'Global' not in class_name:
+            # The first window is complete once its last pixel has been read
+            filt_height = layer.get_attr('filt_height', layer.get_attr('pool_height', 1))
+            filt_width = layer.get_attr('filt_width', layer.get_attr('pool_width', 1))
+            dilation_height = layer.get_attr('dilation_height', 1)
+            dilation_width = layer.get_attr('dilation_width', layer.get_attr('dilation', 1))
+            n_pixels = (filt_height - 1) * dilation_height * in_width + (filt_width - 1) * dilation_width + 1
+            return int(math.ceil(n_pixels / n_pack))
+
+        elif class_name == 'Resize':
+            # One input row (two for bilinear interpolation) per output row
+            n_rows = 2 if layer.get_attr('algorithm') == 'bilinear' else 1
+            return n_rows * in_width
+
+        elif class_name == 'Repack':
+            in_word = layer.get_input_variable().shape[-1]
+            out_word = layer.get_output_variable().shape[-1]
+            return int(math.ceil(out_word / in_word))
+
+        elif class_name in ['Dense', 'Softmax', 'LayerNormalization', 'Embedding'] and len(layer.get_input_variable().shape) > 1:
+            # Applied to each word (e.g. pixel) independently
+            return 1
+
+        elif class_name in ['Activation', 'ParametrizedActivation', 'PReLU', 'HardActivation', 'TernaryTanh', 'BatchNormalization',
+                            'Merge', 'Concatenate', 'Clone', 'Broadcast', 'ZeroPadding1D', 'ZeroPadding2D']:
+            return 1
+
+        # Global pooling, transposes, recurrent layers, one-dimensional dense layers... need their whole input
+        return n_words_in
+
+    def _estimate_conv_schedule(self, layer, io_type, dense_latency, rf, dsp, n_words_in):
+        n_out_pixels = layer.get_attr('out_height', 1) * layer.get_attr('out_width')
+        if 'Transpose' in layer.class_name:
+            # One window of the stride-decomposed kernel per 'reuse_factor' cycles, in both io types
+            n_windows = math.ceil(layer.get_attr('out_height', 1) / layer.get_attr('stride_height', 1)) * math.ceil(layer.get_attr('out_width') / layer.get_attr('stride_width'))
+            interval = max(n_windows, n_words_in) * rf
+            latency = interval + dense_latency
+        elif io_type == 'io_stream':
+            # Both implementations consume one input word per 'reuse_factor' cycles. The line buffer
+            # can process 'parallelization_factor' pixels per word using as many multiplier arrays
+            pf = layer.get_attr('n_pack', 1)
+            dsp *= pf
+            interval = n_words_in * rf
+            latency = interval + dense_latency
+        elif layer.get_attr('strategy', 'latency').lower() == 'latency':
+            # The whole convolution is pipelined, with the multiplications of all output pixels in parallel
+            dsp *= n_out_pixels
+            interval = rf
+            latency = dense_latency
+        else:
+            # One output pixel at a time through a single set of multipliers
+            interval = n_out_pixels * rf
+            latency = interval + dense_latency - rf
+
+        return latency, interval, dsp
+
+    def _get_stream_words(self, var):
+        n_elem = getattr(var.type, 'n_elem', var.shape[-1])
+        n_pack = getattr(var.type, 'n_pack', 1)
+        if getattr(var.type, 'unpack', False):
+            word_size = n_elem // n_pack
+        else:
+            word_size = n_elem * n_pack
+        return int(np.prod(var.shape)) // word_size
+
+    def _estimate_adder_tree_depth(self, n_in):
+        # Roughly one pipeline stage per two levels of the adder tree
+        return int(math.ceil(math.log2(max(n_in, 2)) / 2))
+
+    def _get_precision_width(self, atype, default=0):
+        if atype is None:
+            return default
+        precision = getattr(atype, 'precision', atype)
+        return getattr(precision, 'width', default)
+
+    def _estimate_mult_dsp(self, layer, weight_name):
+        weight = layer.weights.get(weight_name)
+        if weight is None or len(layer.inputs) == 0:
+            return 0
+        data_precision = layer.get_input_variable().type.precision
+        weight_precision = weight.type.precision
+        if isinstance(weight_precision, (ExponentPrecisionType, XnorPrecisionType)) or isinstance(data_precision, XnorPrecisionType):
+            return 0 # Shifts and XNORs don't use DSPs
+        if isinstance(weight_precision, IntegerPrecisionType) and weight_precision.width <= 2:
+            return 0 # Ternary and binary weights
+        a, b = sorted((self._get_precision_width(data_precision), self._get_precision_width(weight_precision)))
+        if a < 10:
+            return 0 # Narrow multiplications are implemented in LUTs
+        # DSP48E2 has a 27x18 multiplier
+        return int(math.ceil(b / 27) * math.ceil(a / 18))
+
+    def get_weight_memory(self, layer, rf=None, strategy=None):
+        """Chooses the memory holding the weights of a layer computed with the dense matrix multiply.
+
+        With the Resource strategy the weights are reshaped into a ROM of 'ReuseFactor' words, a word holding the
+        weights multiplied in one cycle, and every pixel computed in parallel reads a word per cycle. The ROM is placed
+        in the memory taking the fewest resources for its shape: registers when it is a single word or needs more
+        read ports than the two of a RAM, LUTRAM when it is at most 64 words or 1024 bits, otherwise BRAM, or URAM
+        when the part has it and the ROM fills at least half of the URAMs it takes. The Latency strategy reads all the
+        weights at once, they stay in registers. 'WeightStorage' in the configuration of the layer forces the memory
+        ('register', 'lutram', 'bram' or 'uram').
+
+        Args:
+            layer (Layer): A Dense, Conv1D or Conv2D layer.
+            rf (int, optional): Reuse factor, the one of the layer by default.
+            strategy (str, optional): Strategy, the one of the layer by default.
+
+        Returns:
+            dict: The memory 'Impl' ('register', 'lutram', 'bram' or 'uram'), the 'Depth', 'Width' and read 'Ports'
+                of the ROM, its size in 'Bits' and the resources it takes in 'LUT', 'BRAM_18K' and 'URAM'. None
+                if the layer doesn't use the dense matrix multiply or its weights are ports of the top function.
+        """
+        from hls4ml.model.layers import Dense, Conv1D, Conv2D, DepthwiseConv2D
+        if not isinstance(layer, (Dense, Conv1D, Conv2D)) or isinstance(layer, DepthwiseConv2D):
+            return None
+        weight = layer.get_weights('weight')
+        if getattr(weight, 'storage', '') in ['bram', 'offchip'] or getattr(weight, 'weight_class', '') == 'CompressedWeightVariable':
+            return None
+
+        rf = rf if rf is not None else layer.get_attr('reuse_factor', 1)
+        strategy = (strategy if strategy is not None else layer.get_attr('strategy', 'latency')).lower()
+        n_in, n_out = self.get_layer_mult_size(layer)
+        n_elem = n_in * n_out
+        width = self._get_precision_width(weight.type.precision, 16)
+        block_factor = int(math.ceil(n_elem / rf))
+        depth = int(math.ceil(n_elem / block_factor))
+        ports = layer.get_attr('n_pack', 1)
+        if strategy != 'resource':
+            depth, ports = 1, n_elem
+        word_width = n_elem * width // depth
+
+        resources = {
+            # The weights are constants, in registers they are folded into the logic of the products
+            'register': {},
+            'lutram': {'LUT': min(ports, 2) * int(math.ceil(depth / 64)) * word_width},
+            # Aspect ratios of a BRAM_18K, 36 bits wide only with a single read port
+            'bram': {'BRAM_18K': min(int(math.ceil(depth / d)) * int(math.ceil(word_width / w)) for d, w in
+                                     [(512, 36), (1024, 18), (2048, 9), (4096, 4), (8192, 2), (16384, 1)] if w <= 18 or ports == 1)},
+            'uram': {'URAM': int(math.ceil(depth / 4096)) * int(math.ceil(word_width / 72))},
+        }
+
+        impl = layer.model.config.get_layer_config_value(layer, 'WeightStorage', 'auto').lower()
+        if impl not in resources:
+            if depth == 1 or ports > 2:
+                impl = 'register'
+            elif depth <= 64 or depth * word_width <= 1024:
+                impl = 'lutram'
+            elif self._part_has_uram(layer.model.config.get_config_value('Part')) and \
+                    depth * word_width >= 0.5 * resources['uram']['URAM'] * 4096 * 72:
+                impl = 'uram'
+            else:
+                impl = 'bram'
+
+        memory = {'Impl': impl, 'Depth': depth, 'Width': word_width, 'Ports': ports, 'Bits': n_elem * width,
+                  'LUT': 0, 'BRAM_18K': 0, 'URAM': 0}
+        memory.update(resources[impl])
+        return memory
+
+    def _part_has_uram(self, part):
+        # UltraRAM is found in the Virtex and Kintex UltraScale+ parts, the Alveo cards, the Versal parts and the larger
+        # Zynq UltraScale+ parts
+        part = str(part).lower()
+        if re.match(r'^xc[kv]u\d+p', part) or re.match(r'^xcu\d+', part) or re.match(r'^xcv[cmpeh]\d+', part):
+            return True
+        zynq = re.match(r'^xczu(\d+)', part)
+        return zynq is not None and int(zynq.group(1)) not in [1, 2, 3, 6, 9, 15]
+
+    def _estimate_weight_bram(self, layer, rf, strategy):
+        bram = 0
+        memory = self.get_weight_memory(layer, rf, strategy)
+        for w_name, weight in layer.weights.items():
+            n_elem = int(np.prod(weight.shape))
+            width = self._get_precision_width(weight.type.precision, 16)
+            if getattr(weight, 'storage', '') == 'bram':
+                bram += math.ceil(n_elem * width / 18432)
+            elif memory is not None and w_name == 'weight':
+                bram += memory['BRAM_18K']
+            elif strategy.lower() == 'resource' and 'bias' not in w_name and rf * width > 1024:
+                # Weights are reshaped into 'n_elem / rf' wide words, 'rf' deep. Shallower memories end up in LUTRAM
+                block_factor = int(math.ceil(n_elem / rf))
+                bram += math.ceil(block_factor * width / 36) * math.ceil(rf / 512)
+        return bram
+
+    def _estimate_offchip_dense(self, layer, n_in, n_out):
+        ''' Dense layer with the weights read from off-chip memory, see nnet_dense_offchip.h. Assumes a 512-bit memory
+            port with a latency of 64 cycles, as the C simulation memory model.
+        '''
+        tile = layer.get_attr('offchip_tile')
+        lanes = layer.get_attr('offchip_lanes')
+        word_bytes = layer.get_attr('offchip_word_bytes')
+        n_tiles = int(math.ceil(n_out / tile))
+        width = self._get_precision_width(layer.get_weights('weight').type.precision, 16)
+
+        fetch = 64 + int(math.ceil(tile * n_in * word_bytes / 64))
+        compute = tile * (int(math.ceil(n_in / lanes)) + 3)
+        # Each tile is fetched, then computed
+        interval = n_tiles * (fetch + compute) + n_out
+        latency = interval + self._estimate_adder_tree_depth(lanes) + 2
+        dsp = lanes * self._estimate_mult_dsp(layer, 'weight')
+        bram = lanes * math.ceil(int(math.ceil(tile * n_in / lanes)) * width / 18432)
+        return latency, interval, dsp, bram
+
+    def _estimate_line_buffer_bram(self, layer, io_type):
+        if io_type != 'io_stream' or layer.get_attr('implementation', 'linebuffer') != 'linebuffer':
+            return 0
+        filt_height = layer.get_attr('filt_height', layer.get_attr('pool_height', 1))
+        if filt_height <= 1:
+            return 0
+        n_chan = layer.get_attr('n_chan', layer.get_attr('n_filt', 1))
+        depth = layer.get_attr('dilation_height', 1) * layer.get_attr('in_width') // layer.get_attr('n_pack', 1)
+        width = self._get_precision_width(layer.get_input_variable().type.precision, 16)
+        if depth * width <= 1024:
+            return 0 # Shift registers
+        n_buffers = (filt_height - 1) * n_chan * layer.get_attr('n_pack', 1)
+        return n_buffers * math.ceil(depth * width / 18432)
+
+    def optimize_config(self, model, latency_budget=None, interval_budget=None, dsp_budget=None, bram_budget=None):
+        """Jointly chooses the reuse factor, strategy and convolution implementation of the layers to meet the budgets.
+
+        The search starts from the fastest setting of every layer and relaxes the layers one step at a time. Each step
+        takes the layer whose next setting saves the most resources for the smallest increase of the latency and
+        initiation interval of the model, never exceeding the latency and interval budgets. It stops once the resource
+        budget is met or, if no resource budget is given, when no layer can be relaxed further within the latency and
+        interval budgets. The cost of each setting is obtained with `estimate_layer()`, so the budgets are only met
+        in the units of the estimate; check the chosen configuration with a synthesis run.
+
+        Dense and convolutional layers (except the depthwise and separable ones) are tuned, other layers keep their
+        configuration.
+
+        Args:
+            model (ModelGraph): Model to optimize, converted with any initial configuration.
+            latency_budget (int, optional): Maximum latency of the model, in clock cycles.
+            interval_budget (int, optional): Maximum initiation interval of the model, in clock cycles.
+            dsp_budget (int, optional): Number of available DSPs.
+            bram_budget (int, optional): Number of available BRAM_18K blocks.
+
+        Returns:
+            dict: A copy of the 'HLSConfig' of the model with the chosen 'ReuseFactor', 'Strategy' and
+                'ConvImplementation' of the tuned layers set under 'LayerName'. The model needs to be converted again
+                with the returned configuration.
+        """
+        if all(budget is None for budget in (latency_budget, interval_budget, dsp_budget, bram_budget)):
+            raise Exception('At least one of the latency, interval, DSP or BRAM budgets must be given.')
+
+        io_type = model.config.get_config_value('IOType')
+
+        layer_estimates = {}
+        candidates = {}
+        for layer in model.get_layers():
+            layer_estimates[layer.name] = self.estimate_layer(layer, io_type)
+            layer_candidates = self._get_layer_candidates(layer, io_type)
+            if len(layer_candidates) > 0:
+                candidates[layer.name] = layer_candidates
+
+        if io_type == 'io_stream':
+            time_key = lambda c: (c['Estimate']['Interval'], c['Estimate']['Latency'])
+        else:
+            time_key = lambda c: (c['Estimate']['Latency'], c['Estimate']['Interval'])
+
+        # Start from the fastest setting of every layer. Resources are weighted by their budget. Without a budget, they
+        # are weighted by their usage in this configuration, and only break ties if the other resource has a budget
+        for name, layer_candidates in candidates.items():
+            layer_candidates.sort(key=lambda c: (time_key(c), c['Estimate']['DSP'] + c['Estimate']['BRAM_18K']))
+            layer_estimates[name] = layer_candidates[0]['Estimate']
+        fastest = self._summarize_estimate(model, layer_estimates)
+        has_resource_budget = dsp_budget is not None or bram_budget is not None
+        unconstrained_weight = 1e-3 if has_resource_budget else 1.0
+        dsp_weight = 1.0 / max(dsp_budget, 1) if dsp_budget is not None else unconstrained_weight / max(fastest['DSP'], 1)
+        bram_weight = 1.0 / max(bram_budget, 1) if bram_budget is not None else unconstrained_weight / max(fastest['BRAM_18K'], 1)
+        cost = lambda est: dsp_weight * est['DSP'] + bram_weight * est['BRAM_18K']
+
+        # Keep only the settings that are cheaper than all the faster ones
+        for name, layer_candidates in candidates.items():
+            pareto = []
+            for candidate in layer_candidates:
+                if len(pareto) == 0 or cost(candidate['Estimate']) < cost(pareto[-1]['Estimate']):
+                    pareto.append(candidate)
+            candidates[name] = pareto
+
+        if latency_budget is not None and fastest['Latency'] > latency_budget:
+            print('WARNING: Latency budget of {} cycles cannot be met, the lowest estimated latency is {} cycles.'.format(latency_budget, fastest['Latency']))
+            latency_budget = fastest['Latency']
+        if interval_budget is not None and fastest['Interval'] > interval_budget:
+            print('WARNING: Interval budget of {} cycles cannot be met, the lowest estimated interval is {} cycles.'.format(interval_budget, fastest['Interval']))
+            interval_budget = fastest['Interval']
+
+        fits_resources = lambda est: (dsp_budget is None or est['DSP'] <= dsp_budget) and (bram_budget is None or est['BRAM_18K'] <= bram_budget)
+        meets_time = lambda est: (latency_budget is None or est['Latency'] <= latency_budget) and (interval_budget is None or est['Interval'] <= interval_budget)
+
+        choice = {name: 0 for name in candidates.keys()}
+        current = fastest
+        while not (has_resource_budget and fits_resources(current)):
+            best_move = None
+            for name, layer_candidates in candidates.items():
+                if choice[name] + 1 >= len(layer_candidates):
+                    continue
+                prev_estimate = layer_estimates[name]
+                layer_estimates[name] = layer_candidates[choice[name] + 1]['Estimate']
+                proposed = self._summarize_estimate(model, layer_estimates)
+                layer_estimates[name] = prev_estimate
+                if not meets_time(proposed):
+                    continue
+                saving = cost(current) - cost(proposed)
+                slowdown = max(proposed['Latency'] - current['Latency'], 0) + max(proposed['Interval'] - current['Interval'], 0)
+                score = saving / (1 + slowdown)
+                if best_move is None or score > best_move[0]:
+                    best_move = (score, name, proposed)
+            if best_move is None:
+                break
+            _, name, current = best_move
+            choice[name] += 1
+            layer_estimates[name] = candidates[name][choice[name]]['Estimate']
+
+        if has_resource_budget and not fits_resources(current):
+            print('WARNING: Resource budget cannot be met within the latency and interval budgets. Estimated usage: {} DSP, {} BRAM_18K.'.format(current['DSP'], current['BRAM_18K']))
+
+        hls_config = copy.deepcopy(model.config.config['HLSConfig'])
+        layer_name_config = hls_config.setdefault('LayerName', {})
+        uses_resource = False
+        for name, layer_candidates in candidates.items():
+            settings = layer_candidates[choice[name]]['Settings']
+            layer_config = layer_name_config.setdefault(name, {})
+            layer_config['ReuseFactor'] = settings['reuse_factor']
+            layer_config['Strategy'] = settings['strategy'].capitalize()
+            if 'implementation' in settings:
+                layer_config['ConvImplementation'] = 'LineBuffer' if settings['implementation'] == 'linebuffer' else 'Encoded'
+            uses_resource = uses_resource or settings['strategy'] == 'resource'
+
+        # A layer with "Resource" strategy switches the whole model to it, so pin the strategy of the remaining layers
+        model_config = hls_config.setdefault('Model', {})
+        if uses_resource and model_config.get('Strategy', 'Latency').lower() != 'resource':
+            model_config['Strategy'] = 'Resource'
+            for layer in model.get_layers():
+                if layer.name not in candidates:
+                    layer_name_config.setdefault(layer.name, {}).setdefault('Strategy', model.config.get_strategy(layer))
+
+        return hls_config
+
+    def _get_layer_candidates(self, layer, io_type):
+        if 'Dense' not in layer.class_name and layer.class_name not in ['Conv1D', 'Conv2D', 'Conv2DBatchnorm', 'PointwiseConv1D', 'PointwiseConv2D']:
+            return []
+        if layer.get_attr('strategy') == 'compressed':
+            return []
+
+        n_in, n_out = self.get_layer_mult_size(layer)
+        valid_rf = self.get_valid_reuse_factors(n_in, n_out)
+
+        implementations = [None]
+        if io_type == 'io_stream' and layer.class_name in ['Conv1D', 'Conv2D', 'Conv2DBatchnorm']:
+            implementations = [layer.get_attr('implementation')]
+            no_dilation = layer.get_attr('dilation', 1) == 1 and layer.get_attr('dilation_height', 1) == 1 and layer.get_attr('dilation_width', 1) == 1
+            if layer.get_attr('n_pack', 1) == 1 and no_dilation:
+                implementations = ['linebuffer', 'encoded']
+
+        saved_attrs = {attr: layer.get_attr(attr) for attr in ('reuse_factor', 'strategy', 'implementation')}
+        candidates = []
+        for strategy in self.get_supported_strategies(layer):
+            for implementation in implementations:
+                for rf in valid_rf:
+                    settings = {'reuse_factor': rf, 'strategy': strategy}
+                    if implementation is not None:
+                        settings['implementation'] = implementation
+                    for attr, value in settings.items():
+                        layer.set_attr(attr, value)
+                    candidates.append({'Settings': settings, 'Estimate': self.estimate_layer(layer, io_type)})
+        for attr, value in saved_attrs.items():
+            if value is not None:
+                layer.set_attr(attr, value)
+
+        return candidates
+
+    def get_supported_strategies(self, layer):
+        """Returns the strategies (in lowercase) with which the layer can be implemented by this backend."""
+        return ['latency', 'resource']
+
     def compute_conv1d_instructions(self, in_W, in_C, kernel_size=3, stride=1, pad=0):
 
         # Current limitations
@@ -258,6 +258,13 @@ class VivadoStreamVariableDefinition(VariableDefinition):
         else: # Declaration
             return 'hls::stream<{type}> {name}{suffix}("{name}")'.format(type=self.type.name, name=self.cppname, suffix=name_suffix)
 
+class QuartusStreamVariableDefinition(VariableDefinition):
+    def definition_cpp(self, name_suffix='', as_reference=False):
+        if as_reference: # Function parameter
+            return 'nnet::stream<{type}, {depth}> &{name}{suffix}'.format(type=self.type.name, depth=self.pragma[1], name=self.cppname, suffix=name_suffix)
+        else: # Declaration
+            return 'nnet::stream<{type}, {depth}> {name}{suffix}'.format(type=self.type.name, depth=self.pragma[1], name=self.cppname, suffix=name_suffix)
+
 class StreamVariableConverter(object):
     def __init__(self, type_converter, prefix, definition_cls):
         self.type_converter = type_converter
@@ -270,6 +277,10 @@ class StreamVariableConverter(object):
 
         if depth == 0:
             depth = np.prod(tensor_var.shape) // tensor_var.shape[-1]
+            if n_pack > 0:
+                depth //= n_pack
+            else:
+                depth *= -n_pack
         tensor_var.pragma = ('stream', depth)
         tensor_var.type = self.type_converter.convert(PackedType(tensor_var.type.name, tensor_var.type.precision, tensor_var.shape[-1], n_pack))
 
@@ -280,6 +291,10 @@ class VivadoStreamVariableConverter(StreamVariableConverter):
     def __init__(self, type_converter):
         super().__init__(type_converter=type_converter, prefix='Vivado', definition_cls=VivadoStreamVariableDefinition)
 
+class QuartusStreamVariableConverter(StreamVariableConverter):
+    def __init__(self, type_converter):
+        super().__init__(type_converter=type_converter, prefix='Quartus', definition_cls=QuartusStreamVariableDefinition)
+
 #endregion
 
 #region InplaceVariable
@@ -338,6 +353,12 @@ class BramWeightVariableConverter(object):
         weight_var.storage = 'bram'
         return weight_var
 
+class OffchipWeightVariableConverter(object):
+    @classmethod
+    def convert(cls, weight_var):
+        weight_var.storage = 'offchip'
+        return weight_var
+
 #endregion
 
 #endregion
\ No newline at end of file
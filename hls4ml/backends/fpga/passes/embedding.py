@@ -6,6 +6,8 @@ embed_config_template = """struct config{index} : nnet::embed_config {{
     static const unsigned n_in = {n_in};
     static const unsigned n_out = {n_out};
     static const unsigned vocab_size = {vocab_size};
+    static const unsigned n_banks = {n_banks};
+    static const unsigned table_impl = nnet::{table_impl};
     static const unsigned io_type = nnet::{iotype};
     static const unsigned reuse_factor = {reuse};
     typedef {embeddings_t.name} embeddings_t;
@@ -0,0 +1,14 @@
+from hls4ml.model.layers import register_layer
+from hls4ml.backends.vivado.passes.clone import Clone, CloneOutput, CloneFunctionTemplate
+
+# The Clone layer and its pass are shared with Vivado, nnet::clone_stream has the same signature in both backends
+
+def register_clone(backend):
+    # Register the layer types to the layer map
+    register_layer('Clone', Clone)
+
+    # Register the optimization passes
+    backend.register_pass('clone_output', CloneOutput)
+
+    # Register template passes
+    backend.register_template(CloneFunctionTemplate)
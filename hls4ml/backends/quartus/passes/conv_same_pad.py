@@ -0,0 +1,7 @@
+from hls4ml.backends.vivado.passes.conv_same_pad import InsertZeroPaddingBeforeConv1D, InsertZeroPaddingBeforeConv2D
+
+# The stream convolutions don't pad their input, a ZeroPadding layer is inserted before them as in Vivado
+
+def register_conv_same_pad(backend):
+    backend.register_pass(InsertZeroPaddingBeforeConv1D.name, InsertZeroPaddingBeforeConv1D)
+    backend.register_pass(InsertZeroPaddingBeforeConv2D.name, InsertZeroPaddingBeforeConv2D)
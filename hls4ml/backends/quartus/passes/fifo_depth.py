@@ -0,0 +1,6 @@
+from hls4ml.backends.vivado.passes.fifo_depth import SetBypassFifoDepth
+
+# The depth of the streams is a parameter of their type (nnet::stream<T, D>), it is set from the same estimate as in Vivado
+
+def register_fifo_depth(backend):
+    backend.register_pass('set_bypass_fifo_depth', SetBypassFifoDepth)
@@ -0,0 +1,15 @@
+from hls4ml.model.layers import register_layer
+from hls4ml.backends.vivado.passes.repack_stream import Repack, ReshapeStream, RemoveFinalReshape, RepackFunctionTemplate
+
+# Broadcasting of the merge inputs is not implemented for Quartus, only the repacking passes are shared with Vivado
+
+def register_repack_stream(backend):
+    # Register the layer types to the layer map
+    register_layer('Repack', Repack)
+
+    # Register the optimization passes
+    backend.register_pass('remove_final_reshape', RemoveFinalReshape)
+    backend.register_pass('reshape_stream', ReshapeStream)
+
+    # Register template passes
+    backend.register_template(RepackFunctionTemplate)
@@ -10,7 +10,7 @@ from ast import literal_eval
 from contextlib import contextmanager
 
 from hls4ml.model.types import NamedType, IntegerPrecisionType, FixedPrecisionType
-from hls4ml.model.layers import Embedding, Layer, Dense, BatchNormalization, Activation, ParametrizedActivation, PReLU, Softmax
+from hls4ml.model.layers import Embedding, Layer, Dense, Conv1D, Conv2D, BatchNormalization, Activation, ParametrizedActivation, PReLU, Softmax, Merge
 from hls4ml.model.optimizer import get_backend_passes, layer_optimizer, model_optimizer
 from hls4ml.model.flow import register_flow
 from hls4ml.backends import FPGABackend
@@ -34,8 +34,18 @@ class QuartusBackend(FPGABackend):
         initializers = self._get_layer_initializers()
         init_flow = register_flow('init_layers', initializers, requires=['optimize'], backend=self.name)
 
+        streaming_passes = [
+            'quartus:remove_final_reshape',
+            'quartus:reshape_stream',
+            'quartus:clone_output',
+            'quartus:insert_zero_padding_before_conv1d',
+            'quartus:insert_zero_padding_before_conv2d',
+        ]
+        streaming_flow = register_flow('streaming', streaming_passes, requires=[init_flow], backend=self.name)
+
         quartus_types = [
             'quartus:transform_types',
+            'quartus:set_bypass_fifo_depth',
         ]
         quartus_types_flow = register_flow('specific_types', quartus_types, requires=[init_flow], backend=self.name)
 
@@ -60,7 +70,7 @@ class QuartusBackend(FPGABackend):
 
         extras = [
             # Ideally this should be empty
-            opt_pass for opt_pass in all_passes if opt_pass not in initializers + quartus_types + templates + writer_passes
+            opt_pass for opt_pass in all_passes if opt_pass not in initializers + streaming_passes + quartus_types + templates + writer_passes
         ]
 
         if len(extras) > 0:
@@ -68,7 +78,7 @@ class QuartusBackend(FPGABackend):
         else:
             extras_flow = None
 
-        ip_flow_requirements = ['optimize', init_flow, quantization_flow, quartus_types_flow, extras_flow, template_flow]
+        ip_flow_requirements = ['optimize', init_flow, streaming_flow, quantization_flow, quartus_types_flow, extras_flow, template_flow]
         ip_flow_requirements = list(filter(None, ip_flow_requirements))
 
         self._default_flow = register_flow('ip', None, requires=ip_flow_requirements, backend=self.name)
@@ -89,18 +99,31 @@ class QuartusBackend(FPGABackend):
 
         return config
 
+    def get_supported_strategies(self, layer):
+        # Dense layers are always implemented with the "Resource" strategy, convolutions can be fully unrolled
+        if 'Conv' in layer.class_name:
+            return ['latency', 'resource']
+        return ['resource']
+
     def gen_quartus_weight_array(self, layer):
         rf = layer.get_attr('reuse_factor')
-        block_factor = int((layer.attributes['n_in']*layer.attributes['n_out'])/rf)
+        n_in, n_out = self.get_layer_mult_size(layer)
+        block_factor = int((n_in*n_out)/rf)
         bf_rounded = int(pow(2, np.ceil(np.log2(block_factor))))
         rf_rounded = int(pow(2, np.ceil(np.log2(rf))))
 
-        layer.weights['weight'].data = np.transpose(layer.weights['weight'].data).flatten()
-
-        if(layer.attributes['n_in']*layer.attributes['n_out'] > 2048 and rf_rounded != rf):
+        if(n_in*n_out > 2048 and rf_rounded != rf):
             layer.set_attr('rfpad', rf_rounded-rf)
             layer.set_attr('bfpad', bf_rounded-block_factor)
 
+        # The initializers run again when the model is written, the weights must only be rearranged once
+        if layer.get_attr('_weights_transposed', False):
+            return
+
+        # The kernel of a convolution is the weight matrix of the dense layer over the receptive field of an output pixel
+        layer.weights['weight'].data = np.transpose(layer.weights['weight'].data.reshape(n_in, n_out)).flatten()
+
+        if(n_in*n_out > 2048 and rf_rounded != rf):
             temp = np.empty([bf_rounded, rf_rounded])
             for i in range(rf_rounded):
                 for j in range (bf_rounded):
@@ -112,7 +135,7 @@ class QuartusBackend(FPGABackend):
             layer.weights['weight'].data = temp.flatten()
 
         layer.weights['weight'].data_length = layer.weights['weight'].data.size
-        return
+        layer.set_attr('_weights_transposed', True)
 
     def build(self, model, synth=True, fpgasynth=False):
         """
@@ -175,6 +198,29 @@ class QuartusBackend(FPGABackend):
 
         layer.set_attr('index_t', NamedType('layer{}_index'.format(layer.index), index_t))
 
+    @layer_optimizer(Conv1D)
+    def init_conv1d(self, layer):
+        self._init_conv(layer)
+
+    @layer_optimizer(Conv2D)
+    def init_conv2d(self, layer):
+        self._init_conv(layer)
+
+    def _init_conv(self, layer):
+        if layer.get_attr('data_format') != 'channels_last':
+            raise Exception('Only channels_last data format is supported by the Quartus backend, in layer {} ({})'.format(layer.name, layer.class_name))
+
+        layer.set_attr('rfpad', 0)
+        layer.set_attr('bfpad', 0)
+
+        if layer.model.config.is_resource_strategy(layer):
+            n_in, n_out = self.get_layer_mult_size(layer)
+            self.set_closest_reuse_factor(layer, n_in, n_out)
+            self.gen_quartus_weight_array(layer)
+            layer.set_attr('strategy', 'resource')
+        else:
+            layer.set_attr('strategy', 'latency')
+
     @layer_optimizer(Activation)
     def init_activation(self, layer):
         if 'table_t' not in layer.attributes:
@@ -194,7 +240,22 @@ class QuartusBackend(FPGABackend):
         else:
             layer.set_attr('implementation', layer.model.config.get_strategy(layer).lower())
 
+    @layer_optimizer(Merge)
+    def init_merge(self, layer):
+        self.set_merge_accum_type(layer)
+
     @layer_optimizer(Embedding)
     def init_embed(self, layer):
         if layer.attributes['n_in'] is None:
-           raise Exception('Input length of Embedding layer must be specified.')
\ No newline at end of file
+           raise Exception('Input length of Embedding layer must be specified.')
+
+        # All lookups are done within ReuseFactor cycles, the compiler replicates the table to provide the read ports
+        default_ports = int(np.ceil(layer.get_attr('n_in') / layer.get_attr('reuse_factor')))
+        read_ports = layer.model.config.get_layer_config_value(layer, 'ReadPorts', default_ports)
+        layer.set_attr('read_ports', read_ports)
+        layer.set_attr('n_banks', 1)
+
+        table_storage = layer.model.config.get_layer_config_value(layer, 'TableStorage', 'auto').lower()
+        if table_storage not in ['auto', 'bram', 'lutram']:
+            raise Exception('Unsupported table storage "{}" in layer {}'.format(table_storage, layer.name))
+        layer.set_attr('table_impl', 'mem_' + table_storage)
\ No newline at end of file
@@ -0,0 +1,133 @@
+from hls4ml.backends.backend import get_backend
+from hls4ml.model.layers import MultiHeadAttention
+from hls4ml.backends.template import LayerConfigTemplate, FunctionCallTemplate
+
+# MultiHeadAttention templates
+
+mha_dense_config_template = """struct config{index}_{proj} : nnet::dense_config {{
+    static const unsigned n_in = {n_in};
+    static const unsigned n_out = {n_out};
+    static const unsigned io_type = nnet::io_parallel;
+    static const unsigned strategy = nnet::{strategy};
+    static const unsigned reuse_factor = {reuse};
+    static const unsigned n_zeros = {nzeros};
+    static const unsigned n_nonzeros = {nonzeros};
+    static const bool store_weights_in_bram = false;
+    typedef {accum_t.name} accum_t;
+    typedef {bias_t.name} bias_t;
+    typedef {weight_t.name} weight_t;
+    typedef ap_uint<1> index_t;
+    template<class x_T, class y_T>
+    using product = nnet::product::{product_type}<x_T, y_T>;
+}};\n"""
+
+mha_softmax_config_template = """struct softmax_config{index} : nnet::activ_config {{
+    static const unsigned n_in = {n_in};
+    static const unsigned table_size = {table_size};
+    static const unsigned io_type = nnet::io_parallel;
+    static const unsigned reuse_factor = {reuse};
+    static const unsigned axis = -1;
+    static const nnet::softmax_implementation implementation = nnet::softmax_implementation::{implementation};
+    typedef {exp_table_t.name} exp_table_t;
+    typedef {inv_table_t.name} inv_table_t;
+}};\n"""
+
+mha_config_template = """struct config{index} : nnet::multiheadattention_config {{
+    typedef {accum_t.name} accum_t;
+    typedef {qkv_t.name} qkv_t;
+    typedef {score_t.name} score_t;
+    typedef {attention_t.name} attention_t;
+    typedef {context_t.name} context_t;
+    static const unsigned num_heads = {num_heads};
+    static const unsigned head_dim_key = {head_dim_key};
+    static const unsigned head_dim_value = {head_dim_value};
+    static const unsigned feature_dim = {feature_dim};
+    static const unsigned feature_dim_kv = {feature_dim_kv};
+    static const unsigned seq_len = {seq_len};
+    static const unsigned seq_len_kv = {seq_len_kv};
+    static const unsigned out_dim = {out_dim};
+    static const unsigned io_type = nnet::{iotype};
+    static const unsigned reuse_factor = {reuse};
+    static const bool store_weights_in_bram = false;
+    typedef config{index}_query config_query;
+    typedef config{index}_key config_key;
+    typedef config{index}_value config_value;
+    typedef config{index}_output config_output;
+    typedef softmax_config{index} config_softmax;
+    template<class x_T, class y_T>
+    using product = nnet::product::{product_type}<x_T, y_T>;
+}};\n"""
+
+mha_function_template = 'nnet::multiheadattention<{input_t}, {output_t}, {config}>({input}, {output}, {weights});'
+mha_cross_function_template = 'nnet::multiheadattention<{input_t}, {input2_t}, {output_t}, {config}>({input}, {input2}, {output}, {weights});'
+
+mha_include_list = ['nnet_utils/nnet_multiheadattention.h', 'nnet_utils/nnet_multiheadattention_stream.h']
+
+_mha_projections = ['query', 'key', 'value', 'output']
+
+class MultiHeadAttentionConfigTemplate(LayerConfigTemplate):
+    def __init__(self):
+        super().__init__(MultiHeadAttention)
+        self.template = mha_config_template
+        self.dense_template = mha_dense_config_template
+        self.softmax_template = mha_softmax_config_template
+
+    def format(self, node):
+        backend = get_backend('vivado')
+
+        query_var = node.get_input_variable(node.inputs[0])
+        value_var = node.get_input_variable(node.inputs[-1])
+        dense_inputs = {
+            'query': (node.get_attr('feature_dim'), node.get_attr('head_dim_key'), query_var.type.precision),
+            'key': (node.get_attr('feature_dim_kv'), node.get_attr('head_dim_key'), value_var.type.precision),
+            'value': (node.get_attr('feature_dim_kv'), node.get_attr('head_dim_value'), value_var.type.precision),
+            'output': (node.get_attr('num_heads') * node.get_attr('head_dim_value'), node.get_attr('out_dim'), node.get_attr('context_t').precision),
+        }
+
+        configs = []
+        for proj in _mha_projections:
+            n_in, n_out, input_precision = dense_inputs[proj]
+            weights = node.get_weights('{}_weight'.format(proj))
+            params = self._default_config_params(node)
+            params['proj'] = proj
+            params['n_in'] = n_in
+            params['n_out'] = n_out
+            params['weight_t'] = weights.type
+            params['bias_t'] = node.get_weights('{}_bias'.format(proj)).type
+            # Zeros are counted over the kernels of all heads, only used for the estimate of the resources
+            params['nzeros'] = weights.nzeros // (node.get_attr('num_heads') if proj != 'output' else 1)
+            params['nonzeros'] = n_in * n_out - params['nzeros']
+            params['product_type'] = backend.product_type(input_precision, weights.type.precision)
+            configs.append(self.dense_template.format(**params))
+
+        softmax_params = self._default_config_params(node)
+        softmax_params['n_in'] = node.get_attr('seq_len_kv')
+        softmax_params['implementation'] = node.get_attr('softmax_implementation', 'stable')
+        configs.append(self.softmax_template.format(**softmax_params))
+
+        params = self._default_config_params(node)
+        params['product_type'] = backend.product_type(node.get_attr('qkv_t').precision, node.get_attr('qkv_t').precision)
+        configs.append(self.template.format(**params))
+
+        return '\n'.join(configs)
+
+class MultiHeadAttentionFunctionTemplate(FunctionCallTemplate):
+    def __init__(self):
+        super().__init__(MultiHeadAttention, include_header=mha_include_list)
+        self.template = mha_function_template
+        self.cross_template = mha_cross_function_template
+
+    def format(self, node):
+        params = self._default_function_params(node)
+        weights = []
+        for proj in _mha_projections:
+            weights.append(node.get_weights('{}_weight'.format(proj)).name)
+            weights.append(node.get_weights('{}_bias'.format(proj)).name)
+        params['weights'] = ', '.join(weights)
+
+        if len(node.inputs) > 1:
+            params['input2_t'] = node.get_input_variable(node.inputs[1]).type.name
+            params['input2'] = node.get_input_variable(node.inputs[1]).name
+            return self.cross_template.format(**params)
+
+        return self.template.format(**params)
@@ -11,7 +11,7 @@ class RegisterBramWeights(OptimizerPass):
     def transform(self, model, node):
         bramport_size = model.config.get_bram_size(node)
         for w_name, w_var in node.weights.items():
-            if ('storage' in w_var.__dict__ and w_var.storage != 'bram') and np.prod(w_var.shape) > bramport_size:
+            if ('storage' in w_var.__dict__ and w_var.storage not in ['bram', 'offchip']) and np.prod(w_var.shape) > bramport_size:
                 new_weight = BramWeightVariableConverter.convert(w_var)
                 node.set_attr(w_name, new_weight)
                 
\ No newline at end of file
@@ -19,17 +19,12 @@ clone_include_list = ['nnet_utils/nnet_stream.h']
 class CloneFunctionTemplate(FunctionCallTemplate):
     def __init__(self):
         super().__init__(Clone, include_header=clone_include_list)
-        self.template = None # to be filled once number of clones known
-    
+        self.template = 'nnet::clone_stream<{input_t}, {output_t}, {size}>({input}, {outputs});'
+
     def format(self, node):
         params = self._default_function_params(node)
-        for i, output in enumerate(node.outputs):
-            params['output' + str(i + 1)] = node.variables[node.outputs[i]].name
-        
-        if self.template is None:
-            self.template = 'nnet::clone_stream<{input_t}, {output_t}, {size}>({input}, ' + \
-                            ', '.join(['{output' + str(i + 1) + '}' for i in range(len(node.outputs))]) + \
-                            ');'
+        # A single clone stage feeds all the consumers, regardless of their number
+        params['outputs'] = ', '.join([node.variables[output].name for output in node.outputs])
 
         return self.template.format(**params)
 
@@ -67,14 +62,11 @@ class CloneOutput(OptimizerPass):
         transformed = False
         for output in node.outputs:
             if len(output_map[output]) > 1:
-                if len(output_map[output]) > 3:
-                    print('WARNING: Cloning output {} of {} ({}) more than 3 times not currently supported'.format(output, node.__class__.__name__, node.name))
-                    return False
                 out_var = node.get_output_variable(output)
+                attrs = {
+                    'size' : np.prod(out_var.shape)
+                }
                 for i, layer in enumerate(output_map[output], 1):
-                    attrs = {
-                        'size' : np.prod(out_var.shape)
-                    }
                     idx = layer.inputs.index(output)
                     layer.inputs[idx] = output + '_cpy' + str(i)
                 clone_layer = model.make_node(Clone, 'clone_' + node.name, attrs, [output], [output + '_cpy' + str(i + 1) for i in range(len(output_map[output]))])
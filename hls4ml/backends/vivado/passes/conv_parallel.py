@@ -0,0 +1,68 @@
+from hls4ml.model.optimizer import OptimizerPass
+from hls4ml.model.layers import Conv1D, Conv2D
+from hls4ml.backends.vivado.passes.repack_stream import Repack
+
+class ParallelizeConvStream(OptimizerPass):
+    ''' Packs the input and output streams of convolutions that process multiple pixels per cycle '''
+    name = 'parallelize_conv_stream'
+
+    def match(self, node):
+        return isinstance(node, (Conv1D, Conv2D)) and \
+            node.class_name in ('Conv1D', 'Conv2D', 'Conv2DBatchnorm') and \
+            node.get_attr('parallelization_factor', 1) > 1 and \
+            node.get_attr('n_pack', 1) == 1
+
+    def transform(self, model, node):
+        pf = node.get_attr('parallelization_factor')
+
+        if model.config.get_config_value('IOType') != 'io_stream':
+            node.set_attr('parallelization_factor', 1)
+            return False
+
+        reason = self._unsupported_reason(node, pf)
+        if reason is not None:
+            print('WARNING: Cannot use ParallelizationFactor={} in layer "{}" ({}): {}. Using 1 instead.'.format(pf, node.name, node.class_name, reason))
+            node.set_attr('parallelization_factor', 1)
+            return False
+
+        # Pack 'pf' pixels into every element of the input stream
+        in_var = node.get_input_variable()
+        attrs = {
+            'target_shape': in_var.shape,
+            'n_pack': pf
+        }
+        repack_in = model.make_node(Repack, 'repack_in_' + node.name, attrs, node.inputs.copy())
+        repack_in.get_output_variable().type.precision = in_var.type.precision
+        model.insert_node(repack_in, before=node)
+
+        # Unpack the output stream back to one pixel per element
+        out_var = node.get_output_variable()
+        is_output = node.outputs[0] in model.outputs
+        attrs = {
+            'target_shape': out_var.shape
+        }
+        repack_out = model.make_node(Repack, 'repack_out_' + node.name, attrs, [node.outputs[0]])
+        repack_out.get_output_variable().type.precision = out_var.type.precision
+        model.insert_node(repack_out)
+        if is_output:
+            repack_out.get_output_variable().type.name = out_var.type.name
+            out_var.type.name = 'layer{}_t'.format(node.index)
+
+        node.set_attr('n_pack', pf)
+
+        return True
+
+    def _unsupported_reason(self, node, pf):
+        if node.get_attr('implementation') != 'linebuffer':
+            return 'only "LineBuffer" implementation is supported'
+        if node.get_attr('data_format', 'channels_last') != 'channels_last':
+            return 'only "channels_last" data format is supported'
+        if any(node.get_attr(pad, 0) != 0 for pad in ('pad_top', 'pad_bottom', 'pad_left', 'pad_right')):
+            return 'padding must be applied before the layer'
+        if node.get_attr('in_width') % pf != 0:
+            return 'input width ({}) is not divisible by the factor'.format(node.get_attr('in_width'))
+        n_out = node.get_attr('out_height', 1) * node.get_attr('out_width')
+        if n_out % pf != 0:
+            return 'number of output pixels ({}) is not divisible by the factor'.format(n_out)
+
+        return None
@@ -1,7 +1,8 @@
 
 from hls4ml.backends.backend import get_backend
-from hls4ml.model.layers import Conv1D, Conv2D, Conv2DBatchnorm, DepthwiseConv2D, SeparableConv1D, SeparableConv2D
+from hls4ml.model.layers import Conv1D, Conv2D, Conv2DBatchnorm, DepthwiseConv2D, SeparableConv1D, SeparableConv2D, Conv1DTranspose, Conv2DTranspose
 from hls4ml.backends.template import LayerConfigTemplate, FunctionCallTemplate
+from hls4ml.backends.vivado.passes.core_templates import weight_impl_config_template
 
 # Shared multiplication template
 
@@ -31,6 +32,7 @@ conv1d_config_template = """struct config{index} : nnet::conv1d_config {{
     static const unsigned dilation = {dilation};
     static const unsigned out_width = {out_width};
     static const unsigned reuse_factor = {reuse};
+    static const unsigned parallelization_factor = {parallelization_factor};
     static const unsigned n_zeros = {nzeros};
     static const bool store_weights_in_bram = false;
     static const unsigned strategy = nnet::{strategy};
@@ -57,6 +59,7 @@ class Conv1DConfigTemplate(LayerConfigTemplate):
     def format(self, node):
         params = self._default_config_params(node)
         params['dilation'] = node.get_attr('dilation', 1)
+        params['parallelization_factor'] = node.get_attr('n_pack', 1)
         params['nzeros'] = node.get_weights('weight').nzeros
 
         params['config_t'] = 'config{}_mult'.format(node.index)
@@ -67,6 +70,8 @@ class Conv1DConfigTemplate(LayerConfigTemplate):
         mult_params['n_out'] = node.get_attr('n_filt')
         mult_params['product_type'] = get_backend('vivado').product_type(node.get_input_variable().type.precision, node.get_weights('weight').type.precision)
         mult_config = self.mult_template.format(**mult_params)
+        if node.get_attr('weight_impl') is not None:
+            mult_config = mult_config.replace('    typedef', weight_impl_config_template.format(**mult_params) + '    typedef', 1)
 
         return mult_config + '\n' + conv_config
 
@@ -101,7 +106,10 @@ conv2d_config_template = """struct config{index} : nnet::conv2d_config {{
     static const unsigned stride_width = {stride_width};
     static const unsigned out_height = {out_height};
     static const unsigned out_width = {out_width};
+    static const unsigned dilation_height = {dilation_height};
+    static const unsigned dilation_width = {dilation_width};
     static const unsigned reuse_factor = {reuse};
+    static const unsigned parallelization_factor = {parallelization_factor};
     static const unsigned n_zeros = {nzeros};
     static const bool store_weights_in_bram = false;
     static const unsigned strategy = nnet::{strategy};
@@ -129,7 +137,9 @@ class Conv2DConfigTemplate(LayerConfigTemplate):
 
     def format(self, node):
         params = self._default_config_params(node)
-        params['dilation'] = node.get_attr('dilation', 1)
+        params['dilation_height'] = node.get_attr('dilation_height', 1)
+        params['dilation_width'] = node.get_attr('dilation_width', 1)
+        params['parallelization_factor'] = node.get_attr('n_pack', 1)
         params['nzeros'] = node.get_weights('weight').nzeros
 
         params['config_t'] = 'config{}_mult'.format(node.index)
@@ -140,6 +150,8 @@ class Conv2DConfigTemplate(LayerConfigTemplate):
         mult_params['n_out'] = node.get_attr('n_filt')
         mult_params['product_type'] = get_backend('vivado').product_type(node.get_input_variable().type.precision, node.get_weights('weight').type.precision)
         mult_config = self.mult_template.format(**mult_params)
+        if node.get_attr('weight_impl') is not None:
+            mult_config = mult_config.replace('    typedef', weight_impl_config_template.format(**mult_params) + '    typedef', 1)
 
         return mult_config + '\n' + conv_config
 
@@ -195,6 +207,7 @@ class SeparableConv1DConfigTemplate(LayerConfigTemplate):
         params = self._default_config_params(node)
         params['n_filt'] = params['n_chan'] # In depthwise step n_chan == n_filt
         params['dilation'] = node.get_attr('dilation', 1)
+        params['parallelization_factor'] = 1
         params['nzeros'] = node.get_weights('depthwise').nzeros
         params['index'] = str(node.index) + '_depthwise'
         params['weight_t'] = node.get_weights('depthwise').type
@@ -223,7 +236,8 @@ class SeparableConv1DConfigTemplate(LayerConfigTemplate):
         
         params['filt_width'] = 1
         params['stride_width'] = 1
-        params['dilation'] = node.get_attr('dilation', 1)
+        params['dilation'] = 1
+        params['parallelization_factor'] = 1
         params['nzeros'] = node.get_weights('pointwise').nzeros
         params['index'] = str(node.index) + '_pointwise'
         params['weight_t'] = node.get_weights('pointwise').type
@@ -279,7 +293,9 @@ class SeparableConv2DConfigTemplate(LayerConfigTemplate):
         # Depthwise config
         params = self._default_config_params(node)
         params['n_filt'] = params['n_chan'] # In depthwise step n_chan == n_filt
-        params['dilation'] = node.get_attr('dilation', 1)
+        params['dilation_height'] = node.get_attr('dilation_height', 1)
+        params['dilation_width'] = node.get_attr('dilation_width', 1)
+        params['parallelization_factor'] = 1
         params['nzeros'] = node.get_weights('depthwise').nzeros
         params['index'] = str(node.index) + '_depthwise'
         params['weight_t'] = node.get_weights('depthwise').type
@@ -307,7 +323,8 @@ class SeparableConv2DConfigTemplate(LayerConfigTemplate):
 
         params['filt_height'] = params['filt_width'] = 1
         params['stride_height'] = params['stride_width'] = 1
-        params['dilation'] = node.get_attr('dilation', 1)
+        params['dilation_height'] = params['dilation_width'] = 1
+        params['parallelization_factor'] = 1
         params['nzeros'] = node.get_weights('pointwise').nzeros
         params['index'] = str(node.index) + '_pointwise'
         params['weight_t'] = node.get_weights('pointwise').type
@@ -343,3 +360,92 @@ class SeparableConv2DFunctionTemplate(FunctionCallTemplate):
         params['z'] = node.get_weights('zero_bias').name
 
         return self.template.format(**params)
+
+# Conv1DTranspose/Conv2DTranspose templates
+
+conv1d_transpose_config_template = """struct config{index} : nnet::conv1d_transpose_config {{
+    static const unsigned in_width = {in_width};
+    static const unsigned n_chan = {n_chan};
+    static const unsigned filt_width = {filt_width};
+    static const unsigned n_filt = {n_filt};
+    static const unsigned stride_width = {stride_width};
+    static const unsigned phase_width = {phase_width};
+    static const unsigned crop_left = {crop_left};
+    static const unsigned out_width = {out_width};
+    static const unsigned reuse_factor = {reuse};
+    static const unsigned n_zeros = {nzeros};
+    static const bool store_weights_in_bram = false;
+    static const unsigned strategy = nnet::{strategy};
+    typedef {accum_t.name} accum_t;
+    typedef {bias_t.name} bias_t;
+    typedef {weight_t.name} weight_t;
+    typedef {config_t} mult_config;
+}};\n"""
+
+conv2d_transpose_config_template = """struct config{index} : nnet::conv2d_transpose_config {{
+    static const unsigned in_height = {in_height};
+    static const unsigned in_width = {in_width};
+    static const unsigned n_chan = {n_chan};
+    static const unsigned filt_height = {filt_height};
+    static const unsigned filt_width = {filt_width};
+    static const unsigned n_filt = {n_filt};
+    static const unsigned stride_height = {stride_height};
+    static const unsigned stride_width = {stride_width};
+    static const unsigned phase_height = {phase_height};
+    static const unsigned phase_width = {phase_width};
+    static const unsigned crop_top = {crop_top};
+    static const unsigned crop_left = {crop_left};
+    static const unsigned out_height = {out_height};
+    static const unsigned out_width = {out_width};
+    static const unsigned reuse_factor = {reuse};
+    static const unsigned n_zeros = {nzeros};
+    static const bool store_weights_in_bram = false;
+    static const unsigned strategy = nnet::{strategy};
+    typedef {accum_t.name} accum_t;
+    typedef {bias_t.name} bias_t;
+    typedef {weight_t.name} weight_t;
+    typedef {config_t} mult_config;
+}};\n"""
+
+conv1d_transpose_function_template = 'nnet::conv_1d_transpose_cl<{input_t}, {output_t}, {config}>({input}, {output}, {w}, {b});'
+conv2d_transpose_function_template = 'nnet::conv_2d_transpose_cl<{input_t}, {output_t}, {config}>({input}, {output}, {w}, {b});'
+
+conv_transpose_include_list = ['nnet_utils/nnet_conv_transpose.h', 'nnet_utils/nnet_conv_transpose_stream.h']
+
+class ConvTransposeConfigTemplate(LayerConfigTemplate):
+    def __init__(self):
+        super().__init__((Conv1DTranspose, Conv2DTranspose))
+        self.templates = {
+            'Conv1DTranspose': conv1d_transpose_config_template,
+            'Conv2DTranspose': conv2d_transpose_config_template,
+        }
+        self.mult_template = conv_mult_config_template
+
+    def format(self, node):
+        params = self._default_config_params(node)
+        params['nzeros'] = node.get_weights('weight').nzeros
+        params['config_t'] = 'config{}_mult'.format(node.index)
+        conv_config = self.templates[node.class_name].format(**params)
+
+        # A single dense layer computes all phases of a window
+        mult_params = self._default_config_params(node)
+        mult_params['n_in'], mult_params['n_out'] = get_backend('vivado').get_layer_mult_size(node)
+        mult_params['product_type'] = get_backend('vivado').product_type(node.get_input_variable().type.precision, node.get_weights('weight').type.precision)
+        mult_config = self.mult_template.format(**mult_params)
+
+        return mult_config + '\n' + conv_config
+
+class ConvTransposeFunctionTemplate(FunctionCallTemplate):
+    def __init__(self):
+        super().__init__((Conv1DTranspose, Conv2DTranspose), include_header=conv_transpose_include_list)
+        self.templates = {
+            'Conv1DTranspose': conv1d_transpose_function_template,
+            'Conv2DTranspose': conv2d_transpose_function_template,
+        }
+
+    def format(self, node):
+        params = self._default_function_params(node)
+        params['w'] = node.get_weights('weight').name
+        params['b'] = node.get_weights('bias').name
+
+        return self.templates[node.class_name].format(**params)
@@ -1,6 +1,6 @@
 
 from hls4ml.backends.backend import get_backend
-from hls4ml.model.layers import Activation, BatchNormalization, Dense, Embedding, PReLU, ParametrizedActivation, Softmax
+from hls4ml.model.layers import Activation, BatchNormalization, LayerNormalization, Dense, Embedding, PReLU, ParametrizedActivation, Softmax
 from hls4ml.backends.template import LayerConfigTemplate, FunctionCallTemplate
 
 # Dense templates
@@ -22,9 +22,18 @@ dense_config_template = """struct config{index} : nnet::dense_config {{
     using product = nnet::product::{product_type}<x_T, y_T>;
 }};\n"""
 
+dense_offchip_config_template = """    static const unsigned offchip_tile = {offchip_tile};
+    static const unsigned offchip_lanes = {offchip_lanes};
+    static const unsigned offchip_word_bytes = {offchip_word_bytes};
+"""
+
+weight_impl_config_template = """    static const unsigned weight_impl = nnet::{weight_impl};
+"""
+
 dense_function_template = 'nnet::dense<{input_t}, {output_t}, {config}>({input}, {output}, {w}, {b});'
+dense_offchip_function_template = 'nnet::dense_offchip<{input_t}, {output_t}, {config}>({input}, {output}, {w}, {b});'
 
-dense_include_list = ['nnet_utils/nnet_dense.h', 'nnet_utils/nnet_dense_compressed.h', 'nnet_utils/nnet_dense_stream.h']
+dense_include_list = ['nnet_utils/nnet_dense.h', 'nnet_utils/nnet_dense_compressed.h', 'nnet_utils/nnet_dense_stream.h', 'nnet_utils/nnet_dense_offchip.h']
 
 class DenseConfigTemplate(LayerConfigTemplate):
     def __init__(self):
@@ -37,7 +46,14 @@ class DenseConfigTemplate(LayerConfigTemplate):
         params['nonzeros'] = node.get_weights('weight').nonzeros
         params['product_type'] = get_backend('vivado').product_type(node.get_input_variable().type.precision, node.get_weights('weight').type.precision)
 
-        return self.template.format(**params)
+        config = self.template.format(**params)
+        if node.get_weights('weight').storage == 'offchip':
+            # The tile cache of the weights read from off-chip memory
+            config = config.replace('    typedef', dense_offchip_config_template.format(**params) + '    typedef', 1)
+        if node.get_attr('weight_impl') is not None:
+            config = config.replace('    typedef', weight_impl_config_template.format(**params) + '    typedef', 1)
+
+        return config
 
 class DenseFunctionTemplate(FunctionCallTemplate):
     def __init__(self):
@@ -49,6 +65,8 @@ class DenseFunctionTemplate(FunctionCallTemplate):
         params['w'] = node.get_weights('weight').name
         params['b'] = node.get_weights('bias').name
 
+        if node.get_weights('weight').storage == 'offchip':
+            return dense_offchip_function_template.format(**params)
         return self.template.format(**params)
 
 
@@ -96,6 +114,55 @@ class BatchNormalizationFunctionTemplate(FunctionCallTemplate):
         return self.template.format(**params)
 
 
+# LayerNormalization templates
+
+layernorm_config_template = """struct config{index} : nnet::layernorm_config {{
+    static const unsigned n_in = {n_in};
+    static const unsigned seq_len = {seq_len};
+    static const unsigned table_size = {table_size};
+    static constexpr float table_range = {table_range};
+    static const unsigned table_shifts = {table_shifts};
+    static constexpr float epsilon = {epsilon};
+    static const unsigned io_type = nnet::{iotype};
+    static const unsigned reuse_factor = {reuse};
+    static const bool store_weights_in_bram = false;
+    typedef {bias_t.name} bias_t;
+    typedef {scale_t.name} scale_t;
+    typedef {mean_t.name} mean_t;
+    typedef {variance_t.name} variance_t;
+    typedef {table_t.name} table_t;
+    template<class x_T, class y_T>
+    using product = nnet::product::{product_type}<x_T, y_T>;
+}};\n"""
+
+layernorm_function_template = 'nnet::layernormalize<{input_t}, {output_t}, {config}>({input}, {output}, {scale}, {bias});'
+
+layernorm_include_list = ['nnet_utils/nnet_layernorm.h', 'nnet_utils/nnet_layernorm_stream.h']
+
+class LayerNormalizationConfigTemplate(LayerConfigTemplate):
+    def __init__(self):
+        super().__init__(LayerNormalization)
+        self.template = layernorm_config_template
+
+    def format(self, node):
+        params = self._default_config_params(node)
+        params['product_type'] = get_backend('vivado').product_type(node.get_attr('mean_t').precision, node.get_weights('scale').type.precision)
+
+        return self.template.format(**params)
+
+class LayerNormalizationFunctionTemplate(FunctionCallTemplate):
+    def __init__(self):
+        super().__init__(LayerNormalization, include_header=layernorm_include_list)
+        self.template = layernorm_function_template
+
+    def format(self, node):
+        params = self._default_function_params(node)
+        params['scale'] = node.get_weights('scale').name
+        params['bias'] = node.get_weights('bias').name
+
+        return self.template.format(**params)
+
+
 # Activation templates
 
 activ_config_template = """struct {type}_config{index} : nnet::activ_config {{
@@ -0,0 +1,94 @@
+import math
+import numpy as np
+
+from hls4ml.model.optimizer import OptimizerPass
+from hls4ml.backends.vivado.passes.clone import Clone
+
+class SetBypassFifoDepth(OptimizerPass):
+    ''' Sizes the streams of the branches that reconverge after a clone (e.g. residual blocks) in io_stream.
+
+    The clone writes to all its outputs at once, so while the longest branch fills its line buffers and pipelines,
+    the other branches have to buffer the words the clone keeps writing, or the whole dataflow region deadlocks
+    (or stalls). For every output of a clone this estimates how many words are written to it before the layer where
+    the branches meet reads them, from the fill (see `estimate_stream_fill()`) and pipeline latency of the layers of
+    each branch, and sets the depth of the stream accordingly (its `pragma`, the STREAM pragma of the generated code).
+    The depths can be checked with the threaded C simulation, `ModelGraph.predict_threaded()`.
+    '''
+    def match(self, node):
+        return isinstance(node, Clone) and not node.get_attr('bypass_depth_set', False)
+
+    def transform(self, model, node):
+        backend = model.config.backend
+        n_words = backend._get_stream_words(node.get_output_variable(node.outputs[0]))
+
+        # Time (in words written by the clone) when the first word of each stream is available, along each branch
+        arrival = [self._propagate(model, backend, node, output, n_words) for output in node.outputs]
+
+        required = [None] * len(node.outputs)
+        for layer in model.get_layers():
+            branches = [i for i, times in enumerate(arrival) if any(inp in times for inp in layer.inputs)]
+            if len(branches) < 2:
+                continue
+            # The layer starts once all its inputs have data, and reads some inputs only after the preceding ones
+            lags = self._get_input_lags(backend, layer, n_words)
+            start = max(times[inp] for times in arrival for inp in layer.inputs if inp in times)
+            for i in branches:
+                for inp, lag in zip(layer.inputs, lags):
+                    if inp in arrival[i]:
+                        words = start + lag - arrival[i][inp]
+                        required[i] = words if required[i] is None else max(required[i], words)
+
+        for output, words in zip(node.outputs, required):
+            if words is None:
+                continue # Doesn't reconverge with the other branches
+            var = node.get_output_variable(output)
+            var.pragma = ('stream', int(min(max(words, 1) + 1, var.pragma[1])))
+
+        node.set_attr('bypass_depth_set', True)
+
+        return False
+
+    def _propagate(self, model, backend, clone, output, n_words):
+        times = {output: 0}
+        layers = model.get_layers()
+        for layer in layers:
+            if layer is clone or not any(inp in times for inp in layer.inputs):
+                continue
+            inp = next(inp for inp in layer.inputs if inp in times)
+            scale = n_words / max(backend._get_stream_words(layer.get_input_variable(inp)), 1)
+            fill = int(math.ceil((backend.estimate_stream_fill(layer) - self._get_padding_lead(layer)) * scale))
+            est = backend.estimate_layer(layer, 'io_stream')
+            pipeline = max(est['Latency'] - est['Interval'], 0)
+            start = max(times[inp] for inp in layer.inputs if inp in times)
+            for out in layer.outputs:
+                times[out] = start + fill + pipeline
+
+        return times
+
+    def _get_padding_lead(self, layer):
+        ''' Padding words written before the first word is read, the next layer doesn't wait for those '''
+        if layer.class_name == 'ZeroPadding1D':
+            return layer.get_attr('pad_left')
+        if layer.class_name == 'ZeroPadding2D':
+            return layer.get_attr('pad_top') * layer.get_attr('out_width') + layer.get_attr('pad_left')
+        return 0
+
+    def _get_input_lags(self, backend, layer, n_words):
+        ''' Words (of the clone) read from the other inputs before the first word of each input is read '''
+        lags = [0] * len(layer.inputs)
+        if layer.class_name != 'Concatenate':
+            return lags
+
+        inputs = [layer.get_input_variable(inp) for inp in layer.inputs]
+        axis = layer.get_attr('axis')
+        axis = axis - 1 if axis > 0 else axis + len(inputs[0].shape)
+        if axis == len(inputs[0].shape) - 1:
+            return lags # Packed together, one word of each input at a time
+
+        # The inputs take turns, for every index before the concatenation axis
+        n_outer = int(np.prod(inputs[0].shape[:axis]))
+        words = [backend._get_stream_words(var) // n_outer for var in inputs]
+        for i in range(len(inputs)):
+            lags[i] = int(math.ceil(sum(words[:i]) * n_words / max(backend._get_stream_words(inputs[i]), 1)))
+
+        return lags
@@ -0,0 +1,55 @@
+from hls4ml.model.optimizer import OptimizerPass
+from hls4ml.model.layers import GarNet
+from hls4ml.backends.vivado.passes.repack_stream import Repack
+
+class ParallelizeGarNetStream(OptimizerPass):
+    ''' Packs the input (and output) streams of GarNet layers that process multiple vertices per cycle '''
+    name = 'parallelize_garnet_stream'
+
+    def match(self, node):
+        return isinstance(node, GarNet) and \
+            node.get_attr('vertex_parallelism', 1) > 1 and \
+            node.get_attr('packed_vertices', 1) == 1
+
+    def transform(self, model, node):
+        vp = node.get_attr('vertex_parallelism')
+
+        if model.config.get_config_value('IOType') != 'io_stream':
+            node.set_attr('vertex_parallelism', 1)
+            return False
+
+        n_vertices = node.get_attr('n_vertices')
+        if vp & (vp - 1) != 0 or n_vertices % vp != 0:
+            print('WARNING: Cannot use VertexParallelism={} in layer "{}" ({}): must be a power of two dividing the number of vertices ({}). Using 1 instead.'.format(vp, node.name, node.class_name, n_vertices))
+            node.set_attr('vertex_parallelism', 1)
+            return False
+
+        # Pack 'vp' vertices into every element of the input stream, the number of vertices stays the second input
+        in_var = node.get_input_variable(node.inputs[0])
+        attrs = {
+            'target_shape': in_var.shape,
+            'n_pack': vp
+        }
+        repack_in = model.make_node(Repack, 'repack_in_' + node.name, attrs, [node.inputs[0]])
+        repack_in.get_output_variable().type.precision = in_var.type.precision
+        model.insert_node(repack_in, before=node, input_idx=0)
+
+        # The collapsed output is a single element, otherwise unpack the vertices of the output stream
+        if not node.get_attr('collapse'):
+            out_var = node.get_output_variable()
+            is_output = node.outputs[0] in model.outputs
+            attrs = {
+                'target_shape': out_var.shape
+            }
+            repack_out = model.make_node(Repack, 'repack_out_' + node.name, attrs, [node.outputs[0]])
+            repack_out.get_output_variable().type.precision = out_var.type.precision
+            model.insert_node(repack_out)
+            if is_output:
+                repack_out.get_output_variable().type.name = out_var.type.name
+                out_var.type.name = 'layer{}_t'.format(node.index)
+
+            node.set_attr('n_pack', vp)
+
+        node.set_attr('packed_vertices', vp)
+
+        return True
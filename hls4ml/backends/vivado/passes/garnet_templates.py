@@ -60,7 +60,7 @@ const config{index}::output_transform_biases_t (&config{index}::output_transform
 
 garnet_function_template = 'nnet::garnet{impl}<{input_t}, {integer_input_t}, {output_t}, {config}>({input}, {nvtx}, {output});'
 
-garnet_include_list = ['nnet_utils/nnet_garnet.h']
+garnet_include_list = ['nnet_utils/nnet_garnet.h', 'nnet_utils/nnet_garnet_stream.h']
 
 class GarNetConfigTemplate(LayerConfigTemplate):
     def __init__(self):
@@ -83,6 +83,9 @@ class GarNetConfigTemplate(LayerConfigTemplate):
 
         params['n_vertices'] = node.attributes['n_vertices']
         params['n_vertices_width'] = int(np.log2(params['n_vertices']))
+        if node.model.config.get_config_value('IOType') == 'io_stream':
+            # One stream element per iteration, holding 'packed_vertices' vertices
+            params['reuse'] = params['n_vertices'] // node.get_attr('packed_vertices', 1)
         params['distance_width'] = 12
         params['distance_nint'] = min(4, params['distance_width'] - 6) # this is tuned
         params['log2_reuse'] = int(np.log2(params['reuse']))
@@ -113,6 +116,9 @@ class GarNetConfigTemplate(LayerConfigTemplate):
                 params['{}_t'.format(vname)] = precision_converter.convert(default_precision).definition_cpp()
 
         params['output_t'] = node.get_output_variable().type.name
+        if node.model.config.get_config_value('IOType') == 'io_stream':
+            # Type of a single output feature, not of the packed stream element
+            params['output_t'] = node.get_output_variable().type.precision.definition_cpp()
 
         if node.attributes['collapse'] in ['mean', 'max']:
             params['collapse_type'] = 'collapse_{}'.format(node.attributes['collapse'])
@@ -1,4 +1,6 @@
 
+import numpy as np
+
 from hls4ml.backends.backend import get_backend
 from hls4ml.model.layers import Concatenate, Dot, Merge
 from hls4ml.backends.template import LayerConfigTemplate, FunctionCallTemplate
@@ -7,10 +9,15 @@ from hls4ml.backends.template import LayerConfigTemplate, FunctionCallTemplate
 
 merge_config_template = """struct config{index} : nnet::merge_config {{
     static const unsigned n_elem = {n_elem};
+    static const unsigned n_inputs = {n_inputs};
+    typedef {accum_t.name} accum_t;
 }};\n"""
 
 merge_function_template = 'nnet::{merge}<{input1_t}, {input2_t}, {output_t}, {config}>({input1}, {input2}, {output});'
 
+# More than two inputs are merged in a single stage by the variadic kernels
+merge_n_function_template = 'nnet::{merge}_n<{output_t}, {config}>({output}, {inputs});'
+
 merge_include_list = ['nnet_utils/nnet_merge.h', 'nnet_utils/nnet_merge_stream.h']
 
 class MergeConfigTemplate(LayerConfigTemplate):
@@ -21,6 +28,7 @@ class MergeConfigTemplate(LayerConfigTemplate):
     def format(self, node):
         params = self._default_config_params(node)
         params['n_elem'] = node.get_input_variable(node.inputs[0]).size_cpp()
+        params['n_inputs'] = len(node.inputs)
 
         return self.template.format(**params)
 
@@ -30,6 +38,9 @@ class MergeFunctionTemplate(FunctionCallTemplate):
         self.template = merge_function_template
 
     def format(self, node):
+        if len(node.inputs) > 2:
+            return self._format_n(node)
+
         params = {}
         params['merge'] = node.get_attr('op').lower()
         params['config'] = 'config{}'.format(node.index)
@@ -42,6 +53,17 @@ class MergeFunctionTemplate(FunctionCallTemplate):
 
         return self.template.format(**params)
 
+    def _format_n(self, node):
+        params = {}
+        op = node.get_attr('op').lower()
+        params['merge'] = 'concatenate' if isinstance(node, Concatenate) else op
+        params['config'] = 'config{}'.format(node.index)
+        params['output_t'] = node.get_output_variable().type.name
+        params['output'] = node.get_output_variable().name
+        params['inputs'] = ', '.join([node.get_input_variable(inp).name for inp in node.inputs])
+
+        return merge_n_function_template.format(**params)
+
 
 # Dot templates
 
@@ -62,7 +84,7 @@ class DotConfigTemplate(LayerConfigTemplate):
     def format(self, node):
         inp1 = node.get_input_variable(node.inputs[0])
         inp2 = node.get_input_variable(node.inputs[1])
-        params = node._default_config_params()
+        params = self._default_config_params(node)
         params['n_out'] = 1
         params['n_in'] = inp1.shape[0]
         params['product_type'] = get_backend('vivado').product_type(inp1.type.precision, inp2.type.precision)
@@ -83,12 +105,24 @@ concat_config_template = """struct config{index} : nnet::concat_config {{
     static const int axis = {axis};
 }};\n"""
 
+concat_n_config_template = """struct config{index} : nnet::concat_n_config {{
+    static const unsigned n_inputs = {n_inputs};
+    static const unsigned n_outer = {n_outer};
+    static const unsigned n_inner = {n_inner};
+    static const unsigned n_axis_out = {n_axis_out};
+    static constexpr unsigned n_axis[n_inputs] = {{{n_axis}}};
+    static constexpr unsigned axis_offset[n_inputs] = {{{axis_offset}}};
+}};\n"""
+
 class ConcatenateConfigTemplate(LayerConfigTemplate):
     def __init__(self):
         super().__init__(Concatenate)
         self.template = concat_config_template
 
     def format(self, node):
+        if len(node.inputs) > 2:
+            return self._format_n(node)
+
         params = self._default_config_params(node)
         for i in range(3):
             params.setdefault('n_elem1_{}'.format(i), 0)
@@ -100,3 +134,18 @@ class ConcatenateConfigTemplate(LayerConfigTemplate):
             params['n_elem2_{}'.format(i)] = s2
 
         return self.template.format(**params)
+
+    def _format_n(self, node):
+        params = self._default_config_params(node)
+        shapes = [node.get_input_variable(inp).shape for inp in node.inputs]
+        axis = node.get_attr('axis')
+        axis = axis - 1 if axis > 0 else axis + len(shapes[0])
+        n_axis = [shape[axis] for shape in shapes]
+        params['n_inputs'] = len(shapes)
+        params['n_outer'] = int(np.prod(shapes[0][:axis]))
+        params['n_inner'] = int(np.prod(shapes[0][axis + 1:]))
+        params['n_axis_out'] = sum(n_axis)
+        params['n_axis'] = ','.join([str(n) for n in n_axis])
+        params['axis_offset'] = ','.join([str(sum(n_axis[:i])) for i in range(len(n_axis))])
+
+        return concat_n_config_template.format(**params)
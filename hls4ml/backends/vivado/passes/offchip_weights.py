@@ -0,0 +1,41 @@
+import math
+import numpy as np
+
+from hls4ml.model.optimizer import OptimizerPass
+from hls4ml.model.layers import Dense
+from hls4ml.backends.fpga.fpga_types import OffchipWeightVariableConverter
+
+class RegisterOffchipWeights(OptimizerPass):
+    ''' Moves the weights of large Dense layers to off-chip memory, read through an m_axi port by nnet::dense_offchip '''
+    def match(self, node):
+        if not isinstance(node, Dense) or node.get_attr('offchip_tile') is not None:
+            return False
+        if getattr(node.weights['weight'], 'weight_class', '') in ['CompressedWeightVariable', 'ExponentWeightVariable']:
+            return False
+        storage = node.model.config.get_layer_config_value(node, 'WeightStorage', 'auto').lower()
+        if storage == 'offchip':
+            return True
+        return storage == 'auto' and np.prod(node.weights['weight'].shape) > node.model.config.get_offchip_size(node)
+
+    def transform(self, model, node):
+        n_in = node.get_attr('n_in')
+        n_out = node.get_attr('n_out')
+        weight = node.weights['weight']
+
+        # The neurons are read one after the other, the weights of a neuron are contiguous
+        if not node.get_attr('_weights_transposed', False):
+            weight.data = np.transpose(weight.data)
+            node.set_attr('_weights_transposed', True)
+        node.set_attr('weight', OffchipWeightVariableConverter.convert(weight))
+
+        # The weights take a power of 2 of bytes in memory. By default a cycle consumes a 512-bit beat of the memory
+        # port and a tile of the cache holds 4096 weights
+        width = weight.type.precision.width
+        word_bytes = 2 ** int(math.ceil(math.log2(max(1, math.ceil(width / 8)))))
+        lanes = model.config.get_layer_config_value(node, 'OffchipLanes', max(1, 64 // word_bytes))
+        tile = model.config.get_layer_config_value(node, 'OffchipTile', max(1, 4096 // n_in))
+        node.set_attr('offchip_word_bytes', word_bytes)
+        node.set_attr('offchip_lanes', max(1, min(lanes, n_in)))
+        node.set_attr('offchip_tile', max(1, min(tile, n_out)))
+
+        return False
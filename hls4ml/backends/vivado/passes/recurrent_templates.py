@@ -1,7 +1,7 @@
 
 from hls4ml.backends.backend import get_backend
-from hls4ml.model.layers import LSTM, GRU
-from hls4ml.backends.template import LayerConfigTemplate, FunctionCallTemplate
+from hls4ml.model.layers import SimpleRNN, LSTM, GRU
+from hls4ml.backends.template import Template, LayerConfigTemplate, FunctionCallTemplate
 
 # recurrent multiplication template
 
@@ -17,8 +17,8 @@ recr_mult_config_template = """struct config{index} : nnet::dense_config {{
     typedef {bias_t.name} bias_t;
     typedef {weight_t.name} weight_t;
     typedef ap_{index_t} index_t;
-    template<class x_T, class y_T, class res_T>
-    using product = nnet::product::{product_type}<x_T, y_T, res_T>;
+    template<class x_T, class y_T>
+    using product = nnet::product::{product_type}<x_T, y_T>;
 }};\n"""
 
 #activation templates
@@ -62,16 +62,43 @@ recr_config_template = """struct config{index} : nnet::{recr_type}_config {{
     static const unsigned reuse_factor = {reuse};
     static const bool store_weights_in_bram = false;
     static const bool use_static = {static};
+    static const nnet::recurrent_implementation implementation = nnet::recurrent_implementation::{implementation};
+}};\n"""
+
+# SimpleRNN templates
+
+simple_rnn_config_template = """struct config{index} : nnet::simple_rnn_config {{
+    typedef {accum_t.name} accum_t;
+    typedef {weight_t.name} weight_t;  // Matrix
+    typedef {bias_t.name} bias_t;  // Vector
+    typedef {config_mult_t1} mult_config1;
+    typedef {config_mult_t2} mult_config2;
+    typedef {act_t} ACT_CONFIG_T;
+    template<class x_T, class y_T, class config_T>
+    using activation = nnet::activation::{activation}<x_T, y_T, config_T>;
+    static const unsigned n_in  = {n_in};
+    static const unsigned n_out = {n_out};
+    static const unsigned n_state = {n_state};
+    static const unsigned n_sequence = {n_sequence};
+    static const unsigned n_sequence_out = {n_sequence_out};
+    static const unsigned io_type = nnet::{strategy};
+    static const unsigned reuse_factor = {reuse};
+    static const bool store_weights_in_bram = false;
+    static const bool use_static = {static};
 }};\n"""
 
 recr_function_template = 'nnet::{recr_type}_stack<{input_t}, {output_t}, {config}>({input}, {output}, {w}, {wr}, {b}, {br});'
+recr_batch_function_template = 'nnet::{recr_type}_stack_batch<{input_t}, {output_t}, {config}>(n_samples, {input}, {output}, {w}, {wr}, {b}, {br});'
+recr_state_type_template = 'nnet::{recr_type}_state<{state_t}, {config}>'
+recr_state_function_template = 'nnet::{recr_type}_stack_state<{input_t}, {output_t}, {config}>({input}, {output}, state->layer{index}_state, {w}, {wr}, {b}, {br});'
 
 recr_include_list = ['nnet_utils/nnet_recurrent.h']
 
 class RecurrentConfigTemplate(LayerConfigTemplate):
     def __init__(self):
-        super().__init__((LSTM, GRU))
+        super().__init__((SimpleRNN, LSTM, GRU))
         self.template = recr_config_template
+        self.simple_rnn_template = simple_rnn_config_template
         self.act_template = activ_config_template
         self.recr_act_template = recr_activ_config_template
         self.mult1_template = recr_mult_config_template
@@ -97,15 +124,21 @@ class RecurrentConfigTemplate(LayerConfigTemplate):
         params['act_t'] = '{}_config{}'.format(node.get_attr('activation'), node.index)
         params['strategy'] = node.get_attr('strategy')
         params['static'] = 'true' if node.attributes['static'] else 'false'
+        params['implementation'] = node.get_attr('implementation')
         params['recr_type'] = node.class_name.lower()
         params['RECR_TYPE'] = node.class_name
 
         if node.class_name=='LSTM':
             n_recr_mult = 4
-        else: #GRU
+        elif node.class_name=='GRU':
             n_recr_mult = 3
+        else: #SimpleRNN
+            n_recr_mult = 1
 
-        recr_config = self.template.format(**params)
+        if node.class_name=='SimpleRNN':
+            recr_config = self.simple_rnn_template.format(**params)
+        else:
+            recr_config = self.template.format(**params)
 
         act_params = self._default_config_params(node)
         recr_act_params = self._default_config_params(node)
@@ -141,7 +174,7 @@ class RecurrentConfigTemplate(LayerConfigTemplate):
         else:
             mult_params2['n_in'] = node.get_output_variable().dim_names[0]
             mult_params2['n_out'] = node.get_output_variable().dim_names[0] + ' * %i'%n_recr_mult
-        mult_params2['product_type'] = get_backend('vivado').product_type(node.get_input_variable().type.precision, node.get_weights('recurrent_weight').type.precision)
+        mult_params2['product_type'] = get_backend('vivado').product_type(node.get_output_variable().type.precision, node.get_weights('recurrent_weight').type.precision)
         mult_params2['reuse'] = node.attributes['recurrent_reuse_factor']
         mult_params2['index'] = str(node.index) + '_2'
         mult_params2['nzeros'] = node.get_weights('recurrent_weight').nzeros
@@ -150,11 +183,19 @@ class RecurrentConfigTemplate(LayerConfigTemplate):
         mult_config1 = self.mult1_template.format(**mult_params1)
         mult_config2 = self.mult2_template.format(**mult_params2)
 
+        if node.class_name=='SimpleRNN':
+            return mult_config1 + '\n' + mult_config2 + '\n' + act_config + '\n' + recr_config
+
         return mult_config1 + '\n' + mult_config2 + '\n' + recr_act_config + '\n' + act_config + '\n' + recr_config
 
+def _recr_type(node):
+    if node.class_name == 'SimpleRNN':
+        return 'simple_rnn'
+    return node.class_name.lower()
+
 class RecurrentFunctionTemplate(FunctionCallTemplate):
     def __init__(self):
-        super().__init__((LSTM, GRU), include_header=recr_include_list)
+        super().__init__((SimpleRNN, LSTM, GRU), include_header=recr_include_list)
         self.template = recr_function_template
 
     def format(self, node):
@@ -165,7 +206,71 @@ class RecurrentFunctionTemplate(FunctionCallTemplate):
         params['br'] = node.get_weights('recurrent_bias').name
         params['activation'] = node.get_attr('activation')
         params['recurrent_activation'] = node.get_attr('recurrent_activation')
-        params['recr_type'] = node.class_name.lower()
+        params['recr_type'] = _recr_type(node)
+
+        return self.template.format(**params)
+
+class RecurrentBatchFunctionTemplate(Template):
+    """Call of the batched C simulation of the layer, see `VivadoWriter.write_project_cpp`."""
+    def __init__(self):
+        super().__init__('simplernn_lstm_gru_batch_function_template', (SimpleRNN, LSTM, GRU), 'function_cpp_batch')
+        self.template = recr_batch_function_template
+
+    def format(self, node):
+        if node.model.config.get_config_value('IOType') != 'io_parallel':
+            return None
+
+        params = {}
+        params['config'] = 'config{}'.format(node.index)
+        params['input_t'] = node.get_input_variable().type.name
+        params['output_t'] = node.get_output_variable().type.name
+        params['input'] = node.get_input_variable().name
+        params['output'] = node.get_output_variable().name
+        params['w'] = node.get_weights('weight').name
+        params['b'] = node.get_weights('bias').name
+        params['wr'] = node.get_weights('recurrent_weight').name
+        params['br'] = node.get_weights('recurrent_bias').name
+        params['recr_type'] = _recr_type(node)
+
+        return self.template.format(**params)
+
+
+class RecurrentStateTypeTemplate(Template):
+    """Type of the state object of the layer (member 'layer{index}_state' of the model state), see
+    `VivadoWriter.write_project_cpp`."""
+    def __init__(self):
+        super().__init__('simplernn_lstm_gru_state_type_template', (SimpleRNN, LSTM, GRU), 'state_cpp')
+        self.template = recr_state_type_template
+
+    def format(self, node):
+        params = {}
+        params['config'] = 'config{}'.format(node.index)
+        params['recr_type'] = _recr_type(node)
+        if node.model.config.get_config_value('IOType') == 'io_stream':
+            params['state_t'] = node.get_output_variable().type.name + '::value_type'
+        else:
+            params['state_t'] = node.get_output_variable().type.name
 
         return self.template.format(**params)
 
+class RecurrentStateFunctionTemplate(Template):
+    """Call of the stateful C simulation of the layer, see `VivadoWriter.write_project_cpp`."""
+    def __init__(self):
+        super().__init__('simplernn_lstm_gru_state_function_template', (SimpleRNN, LSTM, GRU), 'function_cpp_state')
+        self.template = recr_state_function_template
+
+    def format(self, node):
+        params = {}
+        params['index'] = node.index
+        params['config'] = 'config{}'.format(node.index)
+        params['input_t'] = node.get_input_variable().type.name
+        params['output_t'] = node.get_output_variable().type.name
+        params['input'] = node.get_input_variable().name
+        params['output'] = node.get_output_variable().name
+        params['w'] = node.get_weights('weight').name
+        params['b'] = node.get_weights('bias').name
+        params['wr'] = node.get_weights('recurrent_weight').name
+        params['br'] = node.get_weights('recurrent_bias').name
+        params['recr_type'] = _recr_type(node)
+
+        return self.template.format(**params)
@@ -1,3 +1,5 @@
+import math
+import numpy as np
 
 from hls4ml.model.layers import ZeroPadding1D, ZeroPadding2D, Resize, Transpose
 from hls4ml.backends.template import LayerConfigTemplate, FunctionCallTemplate
@@ -64,12 +66,50 @@ resize_config_template = """struct config{index} : nnet::resize_config {{
     static const unsigned n_chan = {n_chan};
     static const unsigned new_height = {out_height};
     static const unsigned new_width = {out_width};
-}};\n"""
+    static const unsigned interp_bits = {interp_bits};
+    static const unsigned y_lower[new_height];
+    static const unsigned y_upper[new_height];
+    static const unsigned y_lerp[new_height];
+    static const unsigned x_lower[new_width];
+    static const unsigned x_upper[new_width];
+    static const unsigned x_lerp[new_width];
+    typedef {interp_t.name} interp_t;
+}};
+const unsigned config{index}::y_lower[] = {{{y_lower}}};
+const unsigned config{index}::y_upper[] = {{{y_upper}}};
+const unsigned config{index}::y_lerp[] = {{{y_lerp}}};
+const unsigned config{index}::x_lower[] = {{{x_lower}}};
+const unsigned config{index}::x_upper[] = {{{x_upper}}};
+const unsigned config{index}::x_lerp[] = {{{x_lerp}}};\n"""
 
 resize_function_template = 'nnet::resize_{algorithm}<{input_t}, {config}>({input}, {output});'
 
 resize_include_list = ['nnet_utils/nnet_image.h', 'nnet_utils/nnet_image_stream.h']
 
+def compute_resize_coefficients(in_size, out_size, algorithm, half_pixel_centers, interp_bits):
+    """Source indices and interpolation weights (with interp_bits fractional bits) of every output coordinate.
+
+    The mapping follows the TensorFlow resize kernels. With half-pixel centers, output i samples the input at
+    (i + 0.5) * in_size / out_size (minus 0.5 for bilinear), otherwise at i * in_size / out_size.
+    """
+    scale = in_size / out_size
+    lower, upper, lerp = [], [], []
+    for i in range(out_size):
+        if algorithm == 'nearest':
+            src = (i + 0.5) * scale if half_pixel_centers else i * scale
+            idx = min(int(math.floor(src)), in_size - 1)
+            lower.append(idx)
+            upper.append(idx)
+            lerp.append(0)
+        else:
+            src = (i + 0.5) * scale - 0.5 if half_pixel_centers else i * scale
+            src_floor = math.floor(src)
+            lower.append(min(max(int(src_floor), 0), in_size - 1))
+            upper.append(min(int(math.ceil(src)), in_size - 1))
+            lerp.append(min(int(round((src - src_floor) * 2**interp_bits)), 2**interp_bits - 1))
+
+    return lower, upper, lerp
+
 class ResizeConfigTemplate(LayerConfigTemplate):
     def __init__(self):
         super().__init__(Resize)
@@ -78,6 +118,13 @@ class ResizeConfigTemplate(LayerConfigTemplate):
     def format(self, node):
         params = self._default_config_params(node)
 
+        algorithm = node.get_attr('algorithm')
+        half_pixel_centers = node.get_attr('half_pixel_centers', True)
+        for dim, in_size, out_size in [('y', node.get_attr('in_height'), node.get_attr('out_height')), ('x', node.get_attr('in_width'), node.get_attr('out_width'))]:
+            coefficients = compute_resize_coefficients(in_size, out_size, algorithm, half_pixel_centers, node.get_attr('interp_bits'))
+            for name, values in zip(['lower', 'upper', 'lerp'], coefficients):
+                params['{}_{}'.format(dim, name)] = ','.join(str(v) for v in values)
+
         return self.template.format(**params)
 
 class ResizeFunctionTemplate(FunctionCallTemplate):
@@ -99,11 +146,15 @@ transpose_config_template = """struct config{index} : nnet::transpose_config {{
     static const unsigned height = {height};
     static const unsigned width = {width};
     static constexpr unsigned perm[3] = {{{perm_str}}};
+    static const unsigned n_batch = {n_batch};
+    static const unsigned n_rows = {n_rows};
+    static const unsigned n_cols = {n_cols};
+    static const unsigned n_inner = {n_inner};
 }};\n"""
 
 transpose_function_template = 'nnet::transpose_{dim}<{input_t}, {output_t}, {config}>({input}, {output});'
 
-transpose_include_list = ['nnet_utils/nnet_array.h', 'nnet_utils/nnet_stream.h']
+transpose_include_list = ['nnet_utils/nnet_array.h', 'nnet_utils/nnet_array_stream.h']
 
 class TransposeConfigTemplate(LayerConfigTemplate):
     def __init__(self):
@@ -112,9 +163,29 @@ class TransposeConfigTemplate(LayerConfigTemplate):
 
     def format(self, node):
         params = self._default_config_params(node)
+        shape = node.get_input_variable().shape
+        perm = node.get_attr('perm')
+        matrix = transpose_as_matrix(shape, perm)
+        if matrix is None:
+            matrix = (1, 0, int(np.prod(shape)), 1)
+        params['n_batch'], params['n_rows'], params['n_cols'], params['n_inner'] = matrix
 
         return self.template.format(**params)
 
+def transpose_as_matrix(shape, perm):
+    """Write the permutation as a batch of matrix transposes whose elements are contiguous blocks.
+
+    Returns (n_batch, n_rows, n_cols, n_inner) if the permutation has the form
+    [0..a) + [b..c) + [a..b) + [c..n), i.e. it swaps two adjacent groups of dimensions, None otherwise.
+    """
+    n = len(perm)
+    for a in range(n):
+        for b in range(a + 1, n):
+            for c in range(b + 1, n + 1):
+                if list(perm) == list(range(a)) + list(range(b, c)) + list(range(a, b)) + list(range(c, n)):
+                    return (int(np.prod(shape[:a])), int(np.prod(shape[a:b])), int(np.prod(shape[b:c])), int(np.prod(shape[c:])))
+    return None
+
 class TransposeFunctionTemplate(FunctionCallTemplate):
     def __init__(self):
         super().__init__(Transpose, include_header=transpose_include_list)
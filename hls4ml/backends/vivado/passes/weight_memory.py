@@ -0,0 +1,17 @@
+from hls4ml.model.optimizer import OptimizerPass
+
+class PlaceWeightMemory(OptimizerPass):
+    ''' Binds the weights of the dense matrix multiply to registers, LUTRAM, BRAM or URAM, see get_weight_memory() '''
+    def match(self, node):
+        # Only the resource strategy reads the weights from a memory, the latency strategy keeps them in registers
+        if node.get_attr('weight_impl') is not None or node.get_attr('strategy', '').lower() != 'resource':
+            return False
+        return node.model.config.backend.get_weight_memory(node) is not None
+
+    def transform(self, model, node):
+        memory = model.config.backend.get_weight_memory(node)
+        if memory['Impl'] == 'uram' and not model.config.backend._part_has_uram(model.config.get_config_value('Part')):
+            print('WARNING: The weights of layer "{}" are placed in URAM, which part {} doesn\'t have.'.format(node.name, model.config.get_config_value('Part')))
+        node.set_attr('weight_impl', 'mem_' + memory['Impl'])
+
+        return False
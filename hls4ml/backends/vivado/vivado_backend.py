@@ -7,8 +7,8 @@ from queue import Queue
 from collections.abc import Iterable
 
 from hls4ml.model.types import FixedPrecisionType, NamedType, IntegerPrecisionType
-from hls4ml.model.layers import Layer, Dense, BatchNormalization, Embedding, Conv1D, Conv2D, Conv2DBatchnorm, SeparableConv1D, SeparableConv2D, DepthwiseConv2D, Activation, ParametrizedActivation, PReLU, Softmax, Pooling1D, Pooling2D, GlobalPooling1D, GlobalPooling2D, ZeroPadding1D, ZeroPadding2D, Merge, Concatenate, Dot, Resize, Transpose, SimpleRNN, LSTM, GRU, GarNet, GarNetStack
-from hls4ml.model.attributes import Attribute
+from hls4ml.model.layers import Layer, Dense, BatchNormalization, LayerNormalization, Embedding, Conv1D, Conv2D, Conv2DBatchnorm, SeparableConv1D, SeparableConv2D, DepthwiseConv2D, Conv1DTranspose, Conv2DTranspose, Activation, ParametrizedActivation, PReLU, Softmax, Pooling1D, Pooling2D, GlobalPooling1D, GlobalPooling2D, ZeroPadding1D, ZeroPadding2D, Merge, Concatenate, Dot, Resize, Transpose, SimpleRNN, LSTM, GRU, MultiHeadAttention, GarNet, GarNetStack
+from hls4ml.model.attributes import Attribute, ChoiceAttribute
 from hls4ml.model.optimizer import get_backend_passes, layer_optimizer, model_optimizer
 from hls4ml.model.flow import register_flow
 from hls4ml.backends import FPGABackend
@@ -24,8 +24,12 @@ class VivadoBackend(FPGABackend):
     def _register_layer_attributes(self):
         extended_attrs = {
             SimpleRNN: [Attribute('recurrent_reuse_factor', default=1), Attribute('static', value_type=bool, default=True)],
-            LSTM: [Attribute('recurrent_reuse_factor', default=1), Attribute('static', value_type=bool, default=True)],
-            GRU: [Attribute('recurrent_reuse_factor', default=1), Attribute('static', value_type=bool, default=True)],
+            LSTM: [Attribute('recurrent_reuse_factor', default=1), Attribute('static', value_type=bool, default=True), ChoiceAttribute('implementation', ['sequential', 'pipelined'], default='sequential')],
+            GRU: [Attribute('recurrent_reuse_factor', default=1), Attribute('static', value_type=bool, default=True), ChoiceAttribute('implementation', ['sequential', 'pipelined'], default='sequential')],
+            Conv1D: [Attribute('parallelization_factor', default=1)],
+            Conv2D: [Attribute('parallelization_factor', default=1)],
+            GarNet: [Attribute('vertex_parallelism', default=1)],
+            GarNetStack: [Attribute('vertex_parallelism', default=1)],
         }
         self.attribute_map.update(extended_attrs)
 
@@ -39,6 +43,8 @@ class VivadoBackend(FPGABackend):
             'vivado:clone_output',
             'vivado:insert_zero_padding_before_conv1d',
             'vivado:insert_zero_padding_before_conv2d',
+            'vivado:parallelize_conv_stream',
+            'vivado:parallelize_garnet_stream',
             'vivado:broadcast_stream',
         ]
         streaming_flow = register_flow('streaming', streaming_passes, requires=[init_flow], backend=self.name)
@@ -58,8 +64,11 @@ class VivadoBackend(FPGABackend):
         vivado_types = [
             'vivado:register_bram_weights',
             'vivado:transform_types',
+            'vivado:register_offchip_weights',
             'vivado:generate_conv_streaming_instructions',
             'vivado:apply_resource_strategy',
+            'vivado:place_weight_memory',
+            'vivado:set_bypass_fifo_depth',
         ]
         vivado_types_flow = register_flow('specific_types', vivado_types, requires=[init_flow], backend=self.name)
 
@@ -105,6 +114,31 @@ class VivadoBackend(FPGABackend):
 
         return config
 
+    def compile_threaded(self, model):
+        """Compile the threaded C simulation of an io_stream project, see `ModelGraph.predict_threaded()`.
+
+        Args:
+            model (ModelGraph): Model to compile, already written.
+
+        Raises:
+            Exception: If the project failed to compile
+
+        Returns:
+            string: Returns the name of the compiled library.
+        """
+        curr_dir = os.getcwd()
+        os.chdir(model.config.get_output_dir())
+
+        try:
+            ret_val = os.system('bash build_lib.sh threaded')
+            if ret_val != 0:
+                raise Exception('Failed to compile the threaded simulation of project "{}"'.format(model.config.get_project_name()))
+            lib_name = '{}/firmware/{}-{}-threaded.so'.format(model.config.get_output_dir(), model.config.get_project_name(), model.config.get_config_value('Stamp'))
+        finally:
+            os.chdir(curr_dir)
+
+        return lib_name
+
     def build(self, model, reset=False, csim=True, synth=True, cosim=False, validation=False, export=False, vsynth=False):
         if 'linux' in sys.platform:
             found = os.system('command -v vivado_hls > /dev/null')
@@ -159,9 +193,14 @@ class VivadoBackend(FPGABackend):
             layer.set_attr('strategy', 'latency')
         
         layer.set_attr('implementation', layer.model.config.get_conv_implementation(layer).lower())
+        self._check_conv_dilation(layer, layer.get_attr('dilation'))
+        layer.set_attr('parallelization_factor', layer.model.config.get_layer_config_value(layer, 'ParallelizationFactor', 1))
 
     @layer_optimizer(SeparableConv1D)
     def init_sepconv1d(self, layer):
+        if layer.get_attr('dilation') > 1:
+            raise Exception('Dilated convolution is not supported in layer {} ({})'.format(layer.name, layer.class_name))
+
         if layer.model.config.is_resource_strategy(layer):
             layer.set_attr('strategy', 'resource')
             n_in, n_out = self.get_layer_mult_size(layer)
@@ -185,9 +224,14 @@ class VivadoBackend(FPGABackend):
             layer.set_attr('strategy', 'latency')
         
         layer.set_attr('implementation', layer.model.config.get_conv_implementation(layer).lower())
+        self._check_conv_dilation(layer, layer.get_attr('dilation_height'), layer.get_attr('dilation_width'))
+        layer.set_attr('parallelization_factor', layer.model.config.get_layer_config_value(layer, 'ParallelizationFactor', 1))
 
     @layer_optimizer(SeparableConv2D)
     def init_sepconv2d(self, layer):
+        if layer.get_attr('dilation_height') > 1 or layer.get_attr('dilation_width') > 1:
+            raise Exception('Dilated convolution is not supported in layer {} ({})'.format(layer.name, layer.class_name))
+
         if layer.model.config.is_resource_strategy(layer):
             layer.set_attr('strategy', 'resource')
             n_in, n_out = self.get_layer_mult_size(layer)
@@ -199,6 +243,9 @@ class VivadoBackend(FPGABackend):
 
     @layer_optimizer(DepthwiseConv2D)
     def init_depconv2d(self, layer):
+        if layer.get_attr('dilation_height') > 1 or layer.get_attr('dilation_width') > 1:
+            raise Exception('Dilated convolution is not supported in layer {} ({})'.format(layer.name, layer.class_name))
+
         if layer.model.config.is_resource_strategy(layer):
             layer.set_attr('strategy', 'resource')
             n_in, n_out = self.get_layer_mult_size(layer)
@@ -208,6 +255,30 @@ class VivadoBackend(FPGABackend):
         
         layer.set_attr('implementation', layer.model.config.get_conv_implementation(layer).lower())
 
+    @layer_optimizer(Conv1DTranspose)
+    def init_conv1d_transpose(self, layer):
+        if layer.model.config.is_resource_strategy(layer):
+            layer.set_attr('strategy', 'resource')
+            n_in, n_out = self.get_layer_mult_size(layer)
+            self.set_closest_reuse_factor(layer, n_in, n_out)
+        else:
+            layer.set_attr('strategy', 'latency')
+
+    @layer_optimizer(Conv2DTranspose)
+    def init_conv2d_transpose(self, layer):
+        if layer.model.config.is_resource_strategy(layer):
+            layer.set_attr('strategy', 'resource')
+            n_in, n_out = self.get_layer_mult_size(layer)
+            self.set_closest_reuse_factor(layer, n_in, n_out)
+        else:
+            layer.set_attr('strategy', 'latency')
+
+    def _check_conv_dilation(self, layer, *dilation):
+        # Only the line buffer implementation handles dilated kernels in io_stream
+        if any(d > 1 for d in dilation) and layer.get_attr('implementation') == 'encoded':
+            print('WARNING: "Encoded" implementation does not support dilation in layer "{}". Using "LineBuffer" instead.'.format(layer.name))
+            layer.set_attr('implementation', 'linebuffer')
+
     @layer_optimizer(Activation)
     def init_activation(self, layer):
         if 'table_t' not in layer.attributes:
@@ -230,16 +301,131 @@ class VivadoBackend(FPGABackend):
         if layer.model.config.get_config_value('IOType') == 'io_parallel':
             assert len(layer.get_input_variable().shape) == 1, 'Softmax with io_parallel strategy cannot be used on multidimensional tensors.'
 
+    def _set_internal_type(self, layer, var, default_precision):
+        # Precision of an internal variable, taken from the 'Precision' config of the layer if specified there
+        precision, type_name = layer.model.config.get_precision(layer, var=var)
+        if type_name.endswith('default_t'):
+            precision = default_precision
+        layer.set_attr(var + '_t', NamedType(layer.name + '_' + var + '_t', precision))
+
+    @layer_optimizer(Merge)
+    def init_merge(self, layer):
+        self.set_merge_accum_type(layer)
+
+    @layer_optimizer(LayerNormalization)
+    def init_layernorm(self, layer):
+        # By default the sum of the inputs and of the squared deviations are exact, i.e. extended by log2(n_in) bits
+        inp_precision = layer.get_input_variable().type.precision
+        width = inp_precision.width
+        integer = getattr(inp_precision, 'integer', width)
+        sum_bits = int(np.ceil(np.log2(layer.get_attr('n_in'))))
+        self._set_internal_type(layer, 'mean', FixedPrecisionType(width=width + sum_bits + 1, integer=integer + sum_bits + 1))
+        self._set_internal_type(layer, 'variance', FixedPrecisionType(width=2 * (width + 1) + sum_bits, integer=2 * (integer + 1) + sum_bits))
+
+        if 'table_t' not in layer.attributes:
+            layer.set_attr('table_t', NamedType(name=layer.name + '_table_t', precision=FixedPrecisionType(width=18, integer=8)))
+        if 'table_size' not in layer.attributes:
+            layer.set_attr('table_size', 4096)
+        if 'table_range' not in layer.attributes:
+            layer.set_attr('table_range', 4.0)
+        # Larger variances are divided by 4 until they fit the table, as many times as the largest variance of the
+        # inputs needs, half of their span squared
+        max_variance = 2.0 ** (2 * (integer - 1))
+        layer.set_attr('table_shifts', max(int(np.ceil(np.log(max_variance / layer.get_attr('table_range')) / np.log(4))), 0))
+
+    @layer_optimizer(MultiHeadAttention)
+    def init_mha(self, layer):
+        # Projections use the latency dense kernel, the reuse factor limits the multipliers of each head
+        layer.set_attr('strategy', 'latency')
+
+        accum_precision = layer.get_attr('accum_t').precision
+        self._set_internal_type(layer, 'qkv', accum_precision)
+        # The softmax tables are addressed by the top bits of the scores, their integer bits set the resolution
+        self._set_internal_type(layer, 'score', FixedPrecisionType(width=16, integer=6, rounding_mode='AP_RND', saturation_mode='AP_SAT'))
+        self._set_internal_type(layer, 'attention', FixedPrecisionType(width=16, integer=1, signed=False, rounding_mode='AP_RND', saturation_mode='AP_SAT'))
+        self._set_internal_type(layer, 'context', accum_precision)
+
+        if 'exp_table_t' not in layer.attributes:
+            # The sum of the exponentials addresses the inverse table, it is bounded by the key/value sequence length
+            exp_integer = int(np.ceil(np.log2(layer.get_attr('seq_len_kv')))) + 2
+            layer.set_attr('exp_table_t', NamedType(name=layer.name + '_exp_table_t', precision=FixedPrecisionType(width=18, integer=exp_integer, rounding_mode='AP_RND', saturation_mode='AP_SAT')))
+        if 'inv_table_t' not in layer.attributes:
+            layer.set_attr('inv_table_t', NamedType(name=layer.name + '_inv_table_t', precision=FixedPrecisionType(width=18, integer=8, rounding_mode='AP_RND', saturation_mode='AP_SAT')))
+        if 'table_size' not in layer.attributes:
+            layer.set_attr('table_size', 1024)
+
+    @layer_optimizer(Resize)
+    def init_resize(self, layer):
+        if layer.get_attr('algorithm') not in ['nearest', 'bilinear']:
+            raise Exception('Unsupported interpolation "{}" in layer {} ({})'.format(layer.get_attr('algorithm'), layer.name, layer.class_name))
+
+        # Fractional bits of the interpolation weights, the interpolation between two pixels keeps all of them
+        layer.set_attr('interp_bits', layer.model.config.get_layer_config_value(layer, 'InterpolationBits', 10))
+        inp_precision = layer.get_input_variable().type.precision
+        width = inp_precision.width
+        integer = getattr(inp_precision, 'integer', width)
+        self._set_internal_type(layer, 'interp', FixedPrecisionType(width=width + layer.get_attr('interp_bits') + 1, integer=integer + 1))
+
     @layer_optimizer(Embedding)
     def init_embed(self, layer):
         if layer.attributes['n_in'] is None:
            raise Exception('Input length of Embedding layer must be specified.')
 
+        # With io_parallel all lookups are done within ReuseFactor cycles, with io_stream one lookup is done per iteration
+        if layer.model.config.get_config_value('IOType') == 'io_parallel':
+            default_ports = int(np.ceil(layer.get_attr('n_in') / layer.get_attr('reuse_factor')))
+        else:
+            default_ports = 1
+        read_ports = layer.model.config.get_layer_config_value(layer, 'ReadPorts', default_ports)
+        layer.set_attr('read_ports', read_ports)
+
+        table_storage = layer.model.config.get_layer_config_value(layer, 'TableStorage', 'auto').lower()
+        if table_storage not in ['auto', 'bram', 'uram', 'lutram']:
+            raise Exception('Unsupported table storage "{}" in layer {}'.format(table_storage, layer.name))
+        layer.set_attr('table_impl', 'mem_' + table_storage)
+
+        # Every copy of the table is a dual-port ROM, the rows are interleaved so that each copy becomes separate memories
+        n_banks = int(np.ceil(read_ports / 2))
+        layer.set_attr('n_banks', n_banks)
+        if n_banks > 1 and not layer.get_attr('_table_replicated', False):
+            embeddings = layer.weights['embeddings']
+            data = embeddings.data.reshape(layer.get_attr('vocab_size'), 1, layer.get_attr('n_out'))
+            embeddings.data = np.repeat(data, n_banks, axis=1)
+            embeddings.shape = list(embeddings.data.shape)
+            embeddings.data_length = embeddings.data.size
+            layer.set_attr('_table_replicated', True)
+
+    @layer_optimizer(SimpleRNN)
+    def init_simple_rnn(self, layer):
+        reuse_factor = layer.model.config.get_reuse_factor(layer)
+        layer.set_attr('recurrent_reuse_factor', layer.model.config.get_layer_config_value(layer, 'RecurrentReuseFactor', reuse_factor))
+
+        recurrent_bias = np.zeros(layer.weights['recurrent_weight'].shape[1])
+        layer.add_weights_variable(name='recurrent_bias', var_name='br{index}', data=recurrent_bias)
+
+        index_t = IntegerPrecisionType(width=1, signed=False)
+
+        if 'table_t' not in layer.attributes:
+            layer.set_attr('table_t', FixedPrecisionType(width=18, integer=8))
+        if 'table_size' not in layer.attributes:
+            layer.set_attr('table_size', 1024)
+        if layer.model.config.is_resource_strategy(layer):
+            n_in, n_out, n_in_recr, n_out_recr = self.get_layer_mult_size(layer)
+            self.set_closest_reuse_factor(layer, n_in, n_out)
+            self.set_closest_reuse_factor(layer, n_in_recr, n_out_recr, attribute='recurrent_reuse_factor')
+            layer.weights['weight'].data = np.transpose(layer.weights['weight'].data)
+            layer.weights['recurrent_weight'].data = np.transpose(layer.weights['recurrent_weight'].data)
+            layer.set_attr('strategy', 'resource')
+        else:
+            layer.set_attr('strategy', 'latency')
+
+        layer.set_attr('index_t', index_t)
+
     @layer_optimizer(LSTM)
     def init_lstm(self, layer):
-        # TODO Allow getting recurrent reuse factor from the config
         reuse_factor = layer.model.config.get_reuse_factor(layer)
-        layer.set_attr('recurrent_reuse_factor', reuse_factor)
+        layer.set_attr('recurrent_reuse_factor', layer.model.config.get_layer_config_value(layer, 'RecurrentReuseFactor', reuse_factor))
+        layer.set_attr('implementation', layer.model.config.get_layer_config_value(layer, 'RecurrentImplementation', 'Sequential').lower())
 
         recurrent_bias = np.zeros(layer.weights['recurrent_weight'].shape[1])
         layer.add_weights_variable(name='recurrent_bias', var_name='br{index}', data=recurrent_bias)
@@ -265,10 +451,18 @@ class VivadoBackend(FPGABackend):
     @layer_optimizer(GRU)
     def init_gru(self, layer):
         reuse_factor = layer.model.config.get_reuse_factor(layer)
-        layer.set_attr('recurrent_reuse_factor', reuse_factor)
-
-        recurrent_bias = np.zeros(layer.weights['recurrent_weight'].shape[1])
-        layer.add_weights_variable(name='recurrent_bias', var_name='br{index}', data=recurrent_bias)
+        layer.set_attr('recurrent_reuse_factor', layer.model.config.get_layer_config_value(layer, 'RecurrentReuseFactor', reuse_factor))
+        layer.set_attr('implementation', layer.model.config.get_layer_config_value(layer, 'RecurrentImplementation', 'Sequential').lower())
+
+        if 'recurrent_bias' not in layer.weights:
+            bias = layer.weights['bias'].data
+            if bias.ndim == 2:
+                # With 'reset_after', Keras keeps separate biases for the input and the recurrent kernel
+                layer.add_weights_variable(name='bias', var_name='b{index}', data=bias[0])
+                recurrent_bias = bias[1]
+            else:
+                recurrent_bias = np.zeros(layer.weights['recurrent_weight'].shape[1])
+            layer.add_weights_variable(name='recurrent_bias', var_name='br{index}', data=recurrent_bias)
 
         index_t = IntegerPrecisionType(width=1, signed=False)
 
@@ -291,7 +485,14 @@ class VivadoBackend(FPGABackend):
     @layer_optimizer(GarNet)
     def init_garnet(self, layer):
         reuse_factor = layer.attributes['reuse_factor']
-        
+        layer.set_attr('vertex_parallelism', layer.model.config.get_layer_config_value(layer, 'VertexParallelism', 1))
+
+        if layer.model.config.get_config_value('IOType') == 'io_stream':
+            if layer.ref_impl:
+                raise Exception('The reference implementation of GarNet (ref_impl) is not available with io_stream, layer "{}"'.format(layer.name))
+            # Vertices are packed into the stream elements instead, see 'parallelize_garnet_stream'
+            return
+
         var_converter = VivadoArrayVariableConverter(type_converter=HLSTypeConverter(precision_converter=APTypeConverter()))
         
         # A bit controversial but we are going to set the partitioning of the input here
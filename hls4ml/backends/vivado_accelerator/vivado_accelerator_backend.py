@@ -60,7 +60,8 @@ class VivadoAcceleratorBackend(VivadoBackend):
         os.chdir(curr_dir)
 
     def create_initial_config(self, board='pynq-z2', part=None, clock_period=5, io_type='io_parallel', interface='axi_stream',
-                              driver='python', input_type='float', output_type='float',platform='xilinx_u250_xdma_201830_2'):
+                              driver='python', input_type='float', output_type='float',platform='xilinx_u250_xdma_201830_2',
+                              batch=False, packing=1, bus_width=None):
         '''
         Create initial accelerator config with default parameters
         Args:
@@ -78,6 +79,15 @@ class VivadoAcceleratorBackend(VivadoBackend):
             output_type: the wrapper output precision. Can be `float` or an `ap_type`. Note:
                               VivadoAcceleratorBackend will round the number of bits used to the next power-of-2 value.
             platform: development target platform 
+            batch: with the `axi_stream` interface, process all the events of a transfer, up to the beat with TLAST,
+                   in one call of the accelerator, keeping the network busy across the events.
+            packing: the number of input and output values per beat of the AXI streams, or a dict with `Input` and
+                     `Output` keys. Values other than 1 require the batch mode and fixed-point types of 8, 16, 32 or
+                     64 bits. The events are padded to a whole number of beats. With `auto` the fixed-point values
+                     fill the bus width, floating point values are not packed. On the Alveo boards the input and
+                     output beats must have the same width.
+            bus_width: the width in bits of the bus of the AXI streams, by default the one of the board in
+                       supported_boards.json. Used by the `auto` packing.
 
         Returns:
             populated config
@@ -93,6 +103,11 @@ class VivadoAcceleratorBackend(VivadoBackend):
         config['AcceleratorConfig']['Precision']['Output'] = {}
         config['AcceleratorConfig']['Precision']['Input'] = input_type  # float, double or ap_fixed<a,b>
         config['AcceleratorConfig']['Precision']['Output'] = output_type  # float, double or ap_fixed<a,b>
+        if batch:
+            config['AcceleratorConfig']['Batch'] = batch
+            config['AcceleratorConfig']['Packing'] = packing
+        if bus_width is not None:
+            config['AcceleratorConfig']['BusWidth'] = bus_width
         if board.startswith('alveo'):
             config['AcceleratorConfig']['Platform'] = platform  
 
@@ -3,6 +3,8 @@ import json
 import numpy as np
 
 from hls4ml.model.layers import FixedPrecisionType, IntegerPrecisionType
+from hls4ml.model.types import RoundingMode, SaturationMode
+from hls4ml.backends.fpga.fpga_types import APTypeConverter
 
 
 class VivadoAcceleratorConfig(object):
@@ -48,6 +50,20 @@ class VivadoAcceleratorConfig(object):
         self.output_type = self.config['AcceleratorConfig']['Precision'].get('Output',
                                                                              'float')  # float, double or ap_fixed<a,b>
         self.platform= self.config['AcceleratorConfig'].get('Platform', 'xilinx_u250_xdma_201830_2') # Get platform folder name
+        self.batch = self.config['AcceleratorConfig'].get('Batch', False)  # process the events of a transfer in one call
+        self.bus_width = self.config['AcceleratorConfig'].get('BusWidth', board_info.get('bus_width', 32))
+        packing = self.config['AcceleratorConfig'].get('Packing', 1)  # values per beat of the AXI stream, or 'auto'
+        if isinstance(packing, dict):
+            self.input_pack = packing.get('Input', 1)
+            self.output_pack = packing.get('Output', 1)
+        else:
+            self.input_pack = self.output_pack = packing
+        if self.batch and self.interface != 'axi_stream':
+            raise Exception('Batch mode is only supported with the axi_stream interface')
+        if self._has_offchip_weights():
+            # The m_axi port of the weights is not connected by the designs of the boards nor by the Alveo kernel
+            raise Exception('Weights in off-chip memory (OffchipFactor, WeightStorage: offchip) are not supported by '
+                            'VivadoAcceleratorBackend')
 
         assert len(
             model_inputs) == 1, "Only models with one input tensor are currently supported by VivadoAcceleratorBackend"
@@ -63,19 +79,59 @@ class VivadoAcceleratorConfig(object):
         if out_axi_t not in ['float', 'double']:
             self.output_type = self._next_factor8_type(config.backend.convert_precision_string(out_axi_t))
 
-        if self.input_type == 'float':
+        if inp_axi_t == 'float':
             self.input_bitwidth = 32
-        elif self.input_type == 'double':
+        elif inp_axi_t == 'double':
             self.input_bitwidth = 64
         else:
-            self.input_bitwidth = config.backend.convert_precision_string(inp_axi_t).width
+            self.input_bitwidth = self.input_type.width
 
         if out_axi_t == 'float':
             self.output_bitwidth = 32
         elif out_axi_t == 'double':
             self.output_bitwidth = 64
         else:
-            self.output_bitwidth = config.backend.convert_precision_string(out_axi_t).width
+            self.output_bitwidth = self.output_type.width
+
+        # Fill the bus with as many fixed-point values as it holds, but no more than an event has. Floating point
+        # values are not packed
+        auto_in, auto_out = self.input_pack == 'auto', self.output_pack == 'auto'
+        if auto_in:
+            self.input_pack = self._auto_pack(self.input_type, self.input_bitwidth, self.inp.size())
+        if auto_out:
+            self.output_pack = self._auto_pack(self.output_type, self.output_bitwidth, self.out.size())
+        if 'krnl_rtl_srcs' in board_info:
+            # The Alveo kernel moves both streams through one memory port, their beats must have the same width
+            beat = max(self.input_pack * self.input_bitwidth, self.output_pack * self.output_bitwidth)
+            if auto_in and not isinstance(self.input_type, str):
+                self.input_pack = beat // self.input_bitwidth
+            if auto_out and not isinstance(self.output_type, str):
+                self.output_pack = beat // self.output_bitwidth
+            if self.input_pack * self.input_bitwidth != self.output_pack * self.output_bitwidth:
+                raise Exception('The input and output beats of the Alveo kernel must have the same width, got {} and {} '
+                                'bits. Choose the Packing and the Precision of the two sides accordingly'.format(
+                                    self.input_pack * self.input_bitwidth, self.output_pack * self.output_bitwidth))
+
+        for pack, axi_t, bitwidth in [(self.input_pack, self.input_type, self.input_bitwidth),
+                                      (self.output_pack, self.output_type, self.output_bitwidth)]:
+            if pack == 1:
+                continue
+            if not self.batch:
+                raise Exception('Packing several values per beat requires the batch mode (Batch: True)')
+            if isinstance(axi_t, str) or bitwidth not in [8, 16, 32, 64]:
+                raise Exception('Only fixed-point values of 8, 16, 32 or 64 bits can be packed, not {}'.format(self._type_cpp(axi_t)))
+            if pack * bitwidth > self.bus_width:
+                print('WARNING: {} values of {} bits per beat do not fit the {} bits of the bus of the {}, a beat will '
+                      'take several cycles of the bus'.format(pack, bitwidth, self.bus_width, self.board))
+
+    def _has_offchip_weights(self):
+        hls_config = self.config.get('HLSConfig', {})
+        model_config = hls_config.get('Model', {})
+        if model_config.get('OffchipFactor', np.inf) < np.inf:
+            return True
+        layer_configs = [model_config] + list(hls_config.get('LayerType', {}).values()) + \
+                        list(hls_config.get('LayerName', {}).values())
+        return any(str(c.get('WeightStorage', '')).lower() == 'offchip' for c in layer_configs if isinstance(c, dict))
 
     def _next_factor8_type(self, p):
         ''' Return a new type with the width rounded to the next factor of 8 up to p's width
@@ -93,11 +149,83 @@ class VivadoAcceleratorConfig(object):
         elif isinstance(p, IntegerPrecisionType):
             return IntegerPrecisionType(newW, p.signed)
 
+    def _auto_pack(self, axi_t, bitwidth, n_values):
+        ''' Return the values per beat that fill the bus, a power of 2 so that the beats keep a valid AXI width '''
+        if isinstance(axi_t, str):
+            return 1
+        pack = max(1, self.bus_width // bitwidth)
+        while pack > 1 and pack // 2 >= n_values:
+            pack //= 2
+        return pack
+
+    def _host_word_type(self, axi_t):
+        ''' Return the C++ type of the words of the AXI stream on the host, and the codec of host_runtime.h that
+            converts them from and to floating point
+        '''
+        if isinstance(axi_t, str):
+            return axi_t, 'nnet::float_codec<{}>'.format(axi_t)
+        if axi_t.width not in [8, 16, 32, 64]:
+            raise Exception('The host runtime only supports AXI words of 8, 16, 32 or 64 bits, not {}'.format(axi_t.width))
+        word_t = '{}int{}_t'.format('' if axi_t.signed else 'u', axi_t.width)
+        fractional = axi_t.width - axi_t.integer
+        rounding = getattr(axi_t, 'rounding_mode', None) == RoundingMode.RND
+        saturation = getattr(axi_t, 'saturation_mode', None) == SaturationMode.SAT
+        codec = 'nnet::fixed_codec<{}, {}, {}, {}>'.format(word_t, fractional, str(rounding).lower(),
+                                                          str(saturation).lower())
+        return word_t, codec
+
+    def get_host_types(self):
+        ''' Return the C++ types of the input and output words on the host, and their codecs '''
+        in_word_t, in_codec_t = self._host_word_type(self.input_type)
+        out_word_t, out_codec_t = self._host_word_type(self.output_type)
+        return in_word_t, in_codec_t, out_word_t, out_codec_t
+
+    def has_native_words(self):
+        ''' Return True if the words of both streams are floating point or fixed point of 8, 16, 32 or 64 bits, the
+            types the host runtime and the stream codec of the Python drivers convert
+        '''
+        return all(isinstance(axi_t, str) or axi_t.width in [8, 16, 32, 64] for axi_t in [self.input_type, self.output_type])
+
+    def _driver_fixed_type(self, axi_t):
+        ''' Return the Python literal describing the words of the AXI stream to the Python drivers: None for floating
+            point, or the (numpy dtype, fractional bits, rounding, saturation) of a fixed-point type. Words without a
+            numpy type, only allowed unpacked, are None too: the caller gives the dtype and the encode/decode functions
+        '''
+        if isinstance(axi_t, str) or axi_t.width not in [8, 16, 32, 64]:
+            return 'None'
+        dtype = 'np.{}int{}'.format('' if axi_t.signed else 'u', axi_t.width)
+        rounding = getattr(axi_t, 'rounding_mode', None) == RoundingMode.RND
+        saturation = getattr(axi_t, 'saturation_mode', None) == SaturationMode.SAT
+        return '({}, {}, {}, {})'.format(dtype, axi_t.width - axi_t.integer, rounding, saturation)
+
+    def get_driver_types(self):
+        ''' Return the Python literals of the input and output words for the Python drivers '''
+        return self._driver_fixed_type(self.input_type), self._driver_fixed_type(self.output_type)
+
+    def get_bus_width(self):
+        return self.bus_width
+
     def get_io_bitwidth(self):
+        ''' Return the width of the beats of the input and output AXI streams '''
+        return self.input_bitwidth * self.input_pack, self.output_bitwidth * self.output_pack
+
+    def get_value_bitwidth(self):
+        ''' Return the width of the input and output values, several of which may be packed in a beat '''
         return self.input_bitwidth, self.output_bitwidth
 
+    def get_batch(self):
+        return self.batch
+
+    def get_packing(self):
+        return self.input_pack, self.output_pack
+
     def get_corrected_types(self):
-        return self.input_type, self.output_type, self.inp, self.out
+        return self._type_cpp(self.input_type), self._type_cpp(self.output_type), self.inp, self.out
+
+    def _type_cpp(self, axi_t):
+        if isinstance(axi_t, str):
+            return axi_t
+        return APTypeConverter().convert(axi_t).definition_cpp()
 
     def get_interface(self):
         return self.interface
@@ -137,6 +265,9 @@ class VivadoAcceleratorConfig(object):
         driver_ext = '.py' if self.driver == 'python' else '.h'
         return self.interface + '_driver' + driver_ext
 
+    def get_host_dir(self):
+        return '../templates/vivado_accelerator/host'
+
     def get_krnl_rtl_src_dir(self):
         return '../templates/vivado_accelerator/' + 'alveo/' + '/krnl_rtl_src'
  
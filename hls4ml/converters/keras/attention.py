@@ -0,0 +1,43 @@
+from hls4ml.converters.keras_to_hls import parse_default_keras_layer
+from hls4ml.converters.keras_to_hls import keras_handler
+
+@keras_handler('MultiHeadAttention')
+def parse_mha_layer(keras_layer, input_names, input_shapes, data_reader, config):
+    assert('MultiHeadAttention' in keras_layer['class_name'])
+
+    layer = parse_default_keras_layer(keras_layer, input_names)
+
+    # Inputs are (query, value[, key]), the key defaults to the value
+    if len(input_names) > 2 and input_names[2] != input_names[1]:
+        raise Exception('MultiHeadAttention with a key different from the value is not supported (layer {})'.format(layer['name']))
+    if len(input_names) > 1 and input_names[1] == input_names[0]:
+        # Self-attention, a single input
+        input_names = input_names[:1]
+    else:
+        input_names = input_names[:2]
+    layer['inputs'] = input_names
+
+    if keras_layer['config'].get('attention_axes') not in [None, [1], (1,)]:
+        raise Exception('MultiHeadAttention only supports attention over the sequence axis (layer {})'.format(layer['name']))
+    if len(input_shapes[0]) != 3:
+        raise Exception('MultiHeadAttention only supports inputs of shape (sequence, features) (layer {})'.format(layer['name']))
+
+    layer['num_heads'] = keras_layer['config']['num_heads']
+    layer['head_dim_key'] = keras_layer['config']['key_dim']
+    value_dim = keras_layer['config'].get('value_dim')
+    layer['head_dim_value'] = value_dim if value_dim is not None else layer['head_dim_key']
+
+    query_shape = input_shapes[0]
+    output_dim = keras_layer['config'].get('output_shape')
+    if output_dim is None:
+        layer['out_dim'] = query_shape[-1]
+    else:
+        if isinstance(output_dim, (list, tuple)):
+            if len(output_dim) != 1:
+                raise Exception('MultiHeadAttention only supports a one-dimensional output_shape (layer {})'.format(layer['name']))
+            output_dim = output_dim[0]
+        layer['out_dim'] = output_dim
+
+    output_shape = [query_shape[0], query_shape[1], layer['out_dim']]
+
+    return layer, output_shape
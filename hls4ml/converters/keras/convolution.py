@@ -1,7 +1,7 @@
 import math
 from hls4ml.converters.keras_to_hls import parse_default_keras_layer
 from hls4ml.converters.keras_to_hls import keras_handler
-from hls4ml.converters.utils import parse_data_format, compute_padding_1d, compute_padding_2d
+from hls4ml.converters.utils import parse_data_format, compute_padding_1d, compute_padding_2d, compute_cropping_transpose_1d
 
 @keras_handler('Conv1D', 'SeparableConv1D')
 def parse_conv1d_layer(keras_layer, input_names, input_shapes, data_reader, config):
@@ -17,6 +17,7 @@ def parse_conv1d_layer(keras_layer, input_names, input_shapes, data_reader, conf
     layer['n_filt'] = keras_layer['config']['filters']
     layer['filt_width'] = keras_layer['config']['kernel_size'][0]
     layer['stride_width'] = keras_layer['config']['strides'][0]
+    layer['dilation'] = keras_layer['config'].get('dilation_rate', [1])[0]
     layer['padding'] = keras_layer['config']['padding']
 
     (
@@ -27,7 +28,8 @@ def parse_conv1d_layer(keras_layer, input_names, input_shapes, data_reader, conf
         layer['padding'],
         layer['in_width'],
         layer['stride_width'],
-        layer['filt_width']
+        layer['filt_width'],
+        layer['dilation']
     )
 
     if layer['data_format'] == 'channels_last':
@@ -58,6 +60,8 @@ def parse_conv2d_layer(keras_layer, input_names, input_shapes, data_reader, conf
     layer['filt_width'] = keras_layer['config']['kernel_size'][1]
     layer['stride_height'] = keras_layer['config']['strides'][0]
     layer['stride_width'] = keras_layer['config']['strides'][1]
+    layer['dilation_height'] = keras_layer['config'].get('dilation_rate', [1, 1])[0]
+    layer['dilation_width'] = keras_layer['config'].get('dilation_rate', [1, 1])[1]
     layer['padding'] = keras_layer['config']['padding']
     
     (
@@ -74,7 +78,9 @@ def parse_conv2d_layer(keras_layer, input_names, input_shapes, data_reader, conf
         layer['stride_height'],
         layer['stride_width'],
         layer['filt_height'],
-        layer['filt_width']
+        layer['filt_width'],
+        layer['dilation_height'],
+        layer['dilation_width']
     )
 
     if layer['data_format'] == 'channels_first':
@@ -83,3 +89,74 @@ def parse_conv2d_layer(keras_layer, input_names, input_shapes, data_reader, conf
         output_shape = [input_shapes[0][0], layer['out_height'], layer['out_width'], layer['n_filt']]
 
     return layer, output_shape
+
+
+def _check_transpose_conv(keras_layer, layer):
+    if layer['data_format'] != 'channels_last':
+        raise Exception('{} only supports channels_last data format (layer {})'.format(keras_layer['class_name'], layer['name']))
+    if keras_layer['config'].get('output_padding') is not None:
+        raise Exception('{} does not support output_padding (layer {})'.format(keras_layer['class_name'], layer['name']))
+    dilation = keras_layer['config'].get('dilation_rate', [1])
+    if any(d != 1 for d in dilation):
+        raise Exception('{} does not support dilation (layer {})'.format(keras_layer['class_name'], layer['name']))
+
+
+@keras_handler('Conv1DTranspose')
+def parse_conv1d_transpose_layer(keras_layer, input_names, input_shapes, data_reader, config):
+    assert('Conv1DTranspose' in keras_layer['class_name'])
+
+    layer = parse_default_keras_layer(keras_layer, input_names)
+    _check_transpose_conv(keras_layer, layer)
+
+    (
+        layer['in_width'],
+        layer['n_chan']
+    ) = parse_data_format(input_shapes[0], layer['data_format'])
+
+    layer['n_filt'] = keras_layer['config']['filters']
+    layer['filt_width'] = keras_layer['config']['kernel_size'][0]
+    layer['stride_width'] = keras_layer['config']['strides'][0]
+    layer['padding'] = keras_layer['config']['padding']
+
+    (
+        layer['out_width'],
+        layer['crop_left']
+    ) = compute_cropping_transpose_1d(layer['padding'], layer['in_width'], layer['stride_width'], layer['filt_width'])
+
+    output_shape = [input_shapes[0][0], layer['out_width'], layer['n_filt']]
+
+    return layer, output_shape
+
+
+@keras_handler('Conv2DTranspose')
+def parse_conv2d_transpose_layer(keras_layer, input_names, input_shapes, data_reader, config):
+    assert('Conv2DTranspose' in keras_layer['class_name'])
+
+    layer = parse_default_keras_layer(keras_layer, input_names)
+    _check_transpose_conv(keras_layer, layer)
+
+    (
+        layer['in_height'],
+        layer['in_width'],
+        layer['n_chan']
+    ) = parse_data_format(input_shapes[0], layer['data_format'])
+
+    layer['n_filt'] = keras_layer['config']['filters']
+    layer['filt_height'] = keras_layer['config']['kernel_size'][0]
+    layer['filt_width'] = keras_layer['config']['kernel_size'][1]
+    layer['stride_height'] = keras_layer['config']['strides'][0]
+    layer['stride_width'] = keras_layer['config']['strides'][1]
+    layer['padding'] = keras_layer['config']['padding']
+
+    (
+        layer['out_height'],
+        layer['crop_top']
+    ) = compute_cropping_transpose_1d(layer['padding'], layer['in_height'], layer['stride_height'], layer['filt_height'])
+    (
+        layer['out_width'],
+        layer['crop_left']
+    ) = compute_cropping_transpose_1d(layer['padding'], layer['in_width'], layer['stride_width'], layer['filt_width'])
+
+    output_shape = [input_shapes[0][0], layer['out_height'], layer['out_width'], layer['n_filt']]
+
+    return layer, output_shape
@@ -129,6 +129,23 @@ def parse_batchnorm_layer(keras_layer, input_names, input_shapes, data_reader, c
     return layer, [shape for shape in input_shapes[0]]
 
 
+@keras_handler('LayerNormalization')
+def parse_layernorm_layer(keras_layer, input_names, input_shapes, data_reader, config):
+    assert('LayerNormalization' in keras_layer['class_name'])
+
+    layer = parse_default_keras_layer(keras_layer, input_names)
+
+    axis = keras_layer['config'].get('axis', -1)
+    if isinstance(axis, (list, tuple)):
+        if len(axis) != 1:
+            raise Exception('LayerNormalization over more than one axis is not supported (layer {})'.format(layer['name']))
+        axis = axis[0]
+    if axis not in [-1, len(input_shapes[0]) - 1]:
+        raise Exception('LayerNormalization is only supported over the last axis (layer {})'.format(layer['name']))
+
+    return layer, [shape for shape in input_shapes[0]]
+
+
 @keras_handler('Embedding')
 def parse_embedding_layer(keras_layer, input_names, input_shapes, data_reader, config):
     assert('Embedding' in keras_layer['class_name'])
@@ -17,7 +17,7 @@ def parse_merge_layer(keras_layer, input_names, input_shapes, data_reader, confi
             raise Exception('ERROR: Concatenation of tensors with rank > 3 is not yet supported.')
         layer['op'] = layer['class_name'].lower() + '{}d'.format(rank)
         layer['axis'] = keras_layer['config']['axis']
-        output_shape[layer['axis']] += input_shapes[1][layer['axis']]
+        output_shape[layer['axis']] = sum([shape[layer['axis']] for shape in input_shapes])
     elif layer['class_name'] == 'Dot':
         rank = len(input_shapes[0][1:])
         if rank > 1:
@@ -25,7 +25,7 @@ def parse_merge_layer(keras_layer, input_names, input_shapes, data_reader, confi
         layer['op'] = layer['class_name'].lower() + '{}d'.format(rank) 
     else:
         layer['class_name'] = 'Merge'
-    if len(layer['inputs']) > 2:
-        raise Exception('ERROR: Merging more than two tensors is not yet supported.')
+    if len(layer['inputs']) > 2 and layer['op'] in ['subtract', 'dot1d']:
+        raise Exception('ERROR: {} of more than two tensors is not supported.'.format(keras_layer['class_name']))
 
     return layer, output_shape
@@ -80,6 +80,32 @@ def parse_upsampling2d_layer(keras_layer, input_names, input_shapes, data_reader
 
     return layer, output_shape
 
+@keras_handler('Resizing')
+def parse_resizing_layer(keras_layer, input_names, input_shapes, data_reader, config):
+    assert(keras_layer['class_name'] == 'Resizing')
+
+    layer = parse_default_keras_layer(keras_layer, input_names)
+
+    layer['class_name'] = 'Resize'
+    if keras_layer['config'].get('crop_to_aspect_ratio', False):
+        raise Exception('Resizing with crop_to_aspect_ratio is not supported (layer {})'.format(layer['name']))
+
+    (
+        layer['in_height'],
+        layer['in_width'],
+        layer['n_chan']
+    ) = parse_data_format(input_shapes[0], layer['data_format'])
+
+    layer['algorithm'] = keras_layer['config']['interpolation']
+    layer['half_pixel_centers'] = True
+
+    layer['out_height'] = keras_layer['config']['height']
+    layer['out_width'] = keras_layer['config']['width']
+
+    output_shape = [input_shapes[0][0], layer['out_height'], layer['out_width'], layer['n_chan']]
+
+    return layer, output_shape
+
 @keras_handler('Permute')
 def parse_permute_layer(keras_layer, input_names, input_shapes, data_reader, config):
     assert(keras_layer['class_name'] == 'Permute')
@@ -202,6 +202,21 @@ def compute_padding_2d(pad_type, in_height, in_width, stride_height, stride_widt
 
     return (out_height, out_width, pad_top, pad_bottom, pad_left, pad_right)
 
+def get_inbound_layers(keras_layer):
+    """Names of the layers feeding the first call of the Keras layer.
+
+    Tensors passed as keyword arguments (e.g., 'value' of MultiHeadAttention) follow the positional ones.
+    """
+    inbound_layers = []
+    for inbound_node in keras_layer['inbound_nodes'][0]:
+        inbound_layers.append(inbound_node[0])
+        if len(inbound_node) > 3 and isinstance(inbound_node[3], dict):
+            for kwarg in inbound_node[3].values():
+                if isinstance(kwarg, list) and len(kwarg) == 3 and isinstance(kwarg[0], str):
+                    inbound_layers.append(kwarg[0])
+
+    return inbound_layers
+
 def keras_to_hls(config):
 
     ######################
@@ -289,12 +304,12 @@ def keras_to_hls(config):
     for keras_layer in layer_config:
         if 'batch_input_shape' in keras_layer['config']:
             if 'inbound_nodes' in keras_layer and len(keras_layer['inbound_nodes']) > 0:
-                input_shapes = [output_shapes[inbound_node[0]] for inbound_node in keras_layer['inbound_nodes'][0]]
+                input_shapes = [output_shapes[inbound_layer] for inbound_layer in get_inbound_layers(keras_layer)]
             else:
                 input_shapes = [keras_layer['config']['batch_input_shape']]
         else:
             if 'inbound_nodes' in keras_layer:
-                input_shapes = [output_shapes[inbound_node[0]] for inbound_node in keras_layer['inbound_nodes'][0]]
+                input_shapes = [output_shapes[inbound_layer] for inbound_layer in get_inbound_layers(keras_layer)]
             else:
                 # Sequential model, so output_shape from the previous layer is still valid 
                 input_shapes = [output_shape]
@@ -318,7 +333,7 @@ def keras_to_hls(config):
 
         #Extract inbound nodes
         if 'inbound_nodes' in keras_layer and len(keras_layer['inbound_nodes']) > 0:
-            input_names = [ inputs_map.get(inp[0], inp[0]) for inp in keras_layer['inbound_nodes'][0] ]
+            input_names = [ inputs_map.get(inp, inp) for inp in get_inbound_layers(keras_layer) ]
         else:
             input_names = None
 
@@ -33,7 +33,7 @@ def parse_merge_layer(reader, node, inputs_map, input_shapes, graph, config):
     else:
         layer['class_name'] = 'Merge'
     
-    if len(layer['inputs']) > 2:
-        raise Exception('ERROR: Merging more than two tensors is not yet supported.')
+    if len(layer['inputs']) > 2 and layer['op'] == 'sub':
+        raise Exception('ERROR: Subtraction of more than two tensors is not supported.')
     
     return layer, output_shape
\ No newline at end of file
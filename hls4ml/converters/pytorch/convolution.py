@@ -34,7 +34,8 @@ def parse_conv1d_layer(pytorch_layer, layer_name, input_shapes, data_reader, con
     (layer['out_width'],_,_) = compute_padding_1d(layer['padding'],
                                                   layer['in_width'],
                                                   layer['stride_width'],
-                                                  layer['filt_width'])
+                                                  layer['filt_width'],
+                                                  layer['dilation'])
     
     output_shape=[input_shapes[0][0], layer['n_filt'], layer['out_width']] #Channel first as default
     
@@ -63,7 +64,8 @@ def parse_conv2d_layer(pytorch_layer, layer_name, input_shapes, data_reader, con
     layer['filt_width'] = pytorch_layer.kernel_size[1]
     layer['stride_height'] = pytorch_layer.stride[0]
     layer['stride_width'] = pytorch_layer.stride[1]
-    layer['dilation'] = pytorch_layer.dilation[0]
+    layer['dilation_height'] = pytorch_layer.dilation[0]
+    layer['dilation_width'] = pytorch_layer.dilation[1]
     layer['pad_top'] = layer['pad_bottom'] = pytorch_layer.padding[0]
     layer['pad_left'] = layer['pad_right'] = pytorch_layer.padding[1]
     
@@ -79,7 +81,9 @@ def parse_conv2d_layer(pytorch_layer, layer_name, input_shapes, data_reader, con
                                                                            layer['stride_height'],
                                                                            layer['stride_width'],
                                                                            layer['filt_height'],
-                                                                           layer['filt_width'])
+                                                                           layer['filt_width'],
+                                                                           layer['dilation_height'],
+                                                                           layer['dilation_width'])
     
     output_shape = [input_shapes[0][0], layer['n_filt'], layer['out_height'], layer['out_width']]
     
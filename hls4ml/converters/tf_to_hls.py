@@ -153,7 +153,7 @@ def tf_to_hls(yamlConfig):
     #Define supported operations
     array_ops = ['ConcatV2', 'StridedSlice', 'Transpose']
     core_ops = ['Const', 'Identity', 'Placeholder']
-    image_ops = ['ResizeNearestNeighbor']
+    image_ops = ['ResizeNearestNeighbor', 'ResizeBilinear']
     math_ops = ['Add', 'MatMul', 'Mul', 'Sigmoid']
     nn_ops = ['AvgPool', 'BiasAdd', 'Conv2D', 'Elu', 'FusedBatchNorm', 'MaxPool', 'Relu', 'Selu', 'Softmax']
     supported_ops = array_ops + core_ops + image_ops + math_ops + nn_ops
@@ -336,9 +336,9 @@ def tf_to_hls(yamlConfig):
 
             handled = True
 
-        elif tf_op.type == 'ResizeNearestNeighbor':
+        elif tf_op.type in ['ResizeNearestNeighbor', 'ResizeBilinear']:
             layer['class_name'] = 'Resize'
-            layer['algorithm'] = 'nearest'
+            layer['algorithm'] = 'nearest' if tf_op.type == 'ResizeNearestNeighbor' else 'bilinear'
             layer['inputs'] = _parse_tensor_names(tf_op.inputs[0])
             layer['outputs'] = _parse_tensor_names(tf_op.outputs[0])
 
@@ -354,9 +354,7 @@ def tf_to_hls(yamlConfig):
             align_corners = tf_op.get_attr('align_corners')
             if align_corners:
                 raise NotImplementedError('Property "align_corners=True" is not supported.')
-            half_pixel_centers = tf_op.get_attr('align_corners')
-            if half_pixel_centers:
-                raise NotImplementedError('Property "half_pixel_centers=True" is not supported.')
+            layer['half_pixel_centers'] = tf_op.get_attr('half_pixel_centers')
 
             handled = True
 
@@ -19,7 +19,9 @@ def parse_data_format(input_shape, data_format='channels_last'):
     else:
         raise Exception('Unknown data format: {}'.format(data_format))
 
-def compute_padding_1d(pad_type, in_size, stride, filt_size):
+def compute_padding_1d(pad_type, in_size, stride, filt_size, dilation=1):
+    # A dilated kernel covers the same span as a dense kernel of this size
+    filt_size = dilation * (filt_size - 1) + 1
     if pad_type.lower() == 'same':
         n_out = int(math.ceil(float(in_size) / float(stride)))
         if (in_size % stride == 0):
@@ -28,6 +30,10 @@ def compute_padding_1d(pad_type, in_size, stride, filt_size):
             pad_along_size = max(filt_size - (in_size % stride), 0)
         pad_left  = pad_along_size // 2
         pad_right  = pad_along_size - pad_left
+    elif pad_type.lower() == 'causal':
+        n_out = int(math.ceil(float(in_size) / float(stride)))
+        pad_left = filt_size - 1
+        pad_right = 0
     elif pad_type.lower() == 'valid':
         n_out = int(math.ceil(float(in_size - filt_size + 1) / float(stride)))
         pad_left = 0
@@ -37,7 +43,9 @@ def compute_padding_1d(pad_type, in_size, stride, filt_size):
 
     return (n_out, pad_left, pad_right)
 
-def compute_padding_2d(pad_type, in_height, in_width, stride_height, stride_width, filt_height, filt_width):
+def compute_padding_2d(pad_type, in_height, in_width, stride_height, stride_width, filt_height, filt_width, dilation_height=1, dilation_width=1):
+    filt_height = dilation_height * (filt_height - 1) + 1
+    filt_width = dilation_width * (filt_width - 1) + 1
     if pad_type.lower() == 'same':
         #Height
         out_height = int(math.ceil(float(in_height) / float(stride_height)))
@@ -66,4 +74,17 @@ def compute_padding_2d(pad_type, in_height, in_width, stride_height, stride_widt
     else:
         raise Exception('Unknown padding type: {}'.format(pad_type))
 
-    return (out_height, out_width, pad_top, pad_bottom, pad_left, pad_right)
\ No newline at end of file
+    return (out_height, out_width, pad_top, pad_bottom, pad_left, pad_right)
+def compute_cropping_transpose_1d(pad_type, in_size, stride, filt_size):
+    # Transposed convolution produces (in_size - 1) * stride + filt_size outputs, 'same' keeps
+    # in_size * stride of them, dropping the same number on both sides as the padding of the forward convolution
+    if pad_type.lower() == 'same':
+        n_out = in_size * stride
+        crop_left = max(filt_size - stride, 0) // 2
+    elif pad_type.lower() == 'valid':
+        n_out = in_size * stride + max(filt_size - stride, 0)
+        crop_left = 0
+    else:
+        raise Exception('Unknown padding type: {}'.format(pad_type))
+
+    return (n_out, crop_left)
@@ -22,6 +22,7 @@ class HLSConfig(object):
         self.layer_name_precision = {}
 
         self.model_rf = None
+        self.model_offchip_factor = np.inf
         self.layer_type_rf = {}
         self.layer_name_rf = {}
 
@@ -118,6 +119,9 @@ class HLSConfig(object):
         bf = self.model_bf
         return bf
 
+    def get_offchip_size(self, layer):
+        return self.model_offchip_factor
+
     def get_reuse_factor(self, layer):
         rf = self.layer_name_rf.get(layer.name.lower())
         if rf is None:
@@ -201,6 +205,7 @@ class HLSConfig(object):
                     self.model_precision['default'] = precision_cfg # Default precision for everything
 
             self.model_bf = model_cfg.get('BramFactor', np.inf) # Weight threshold to be external BRAM
+            self.model_offchip_factor = model_cfg.get('OffchipFactor', np.inf) # Weight threshold to be in off-chip memory
             self.model_rf = model_cfg.get('ReuseFactor')
             self.model_targ_cycles = model_cfg.get('TargetCycles')
             self.model_conv_implementation = model_cfg.get('ConvImplementation', 'LineBuffer')
@@ -615,6 +620,20 @@ class ModelGraph(object):
 
         return top_function, ctype
 
+    def _get_batch_function(self, ctype):
+        ctype_name = 'float' if ctype == ctypes.c_float else 'double'
+        try:
+            batch_function = getattr(self._top_function_lib, self.config.get_project_name() + '_batch_' + ctype_name)
+        except AttributeError:
+            # Only generated for some models, see VivadoWriter
+            return None
+
+        n_arrays = len(self.get_input_variables()) + len(self.get_output_variables())
+        batch_function.restype = None
+        batch_function.argtypes = [npc.ndpointer(ctype, flags="C_CONTIGUOUS") for i in range(n_arrays)] + [ctypes.c_uint]
+
+        return batch_function
+
     def _compute_n_samples(self, x):
         if len(self.get_input_variables()) == 1:
             xlist = [x]
@@ -647,18 +666,29 @@ class ModelGraph(object):
         if n_samples == 1 and n_inputs == 1:
             x = [x]
 
+        batch_function = self._get_batch_function(ctype) if n_samples > 1 else None
+
         try:
-            for i in range(n_samples):
-                predictions = [np.zeros(yj.size(), dtype=ctype) for yj in self.get_output_variables()]
-                if n_inputs == 1:
-                    inp = [np.asarray(x[i])]
-                else:
-                    inp = [np.asarray(xj[i]) for xj in x]
-                argtuple = inp
-                argtuple += predictions
-                argtuple = tuple(argtuple)
-                top_function(*argtuple)
-                output.append(predictions)
+            if batch_function is not None:
+                # All the samples are simulated in one call
+                xlist = [x] if n_inputs == 1 else x
+                inp = [np.ascontiguousarray(xj, dtype=ctype).reshape(-1) for xj in xlist]
+                predictions = [np.zeros(n_samples * yj.size(), dtype=ctype) for yj in self.get_output_variables()]
+                batch_function(*(inp + predictions + [n_samples]))
+                predictions = [yj.reshape(n_samples, -1) for yj in predictions]
+                output = [[yj[i] for yj in predictions] for i in range(n_samples)]
+            else:
+                for i in range(n_samples):
+                    predictions = [np.zeros(yj.size(), dtype=ctype) for yj in self.get_output_variables()]
+                    if n_inputs == 1:
+                        inp = [np.asarray(x[i])]
+                    else:
+                        inp = [np.asarray(xj[i]) for xj in x]
+                    argtuple = inp
+                    argtuple += predictions
+                    argtuple = tuple(argtuple)
+                    top_function(*argtuple)
+                    output.append(predictions)
 
 
             # Convert to list of numpy arrays (one for each output)
@@ -675,6 +705,94 @@ class ModelGraph(object):
         else:
             return output
 
+    def predict_threaded(self, x):
+        """Runs the threaded C simulation of an io_stream model.
+
+        Every layer runs in its own thread and a stream blocks its writer once it holds as many elements as its
+        depth, like the FIFOs of the dataflow region in hardware. Unlike `predict()`, which runs the layers one after
+        the other, this exposes streams that are too shallow for the model to complete, e.g. the bypass of a
+        residual block. The threaded simulation is compiled separately, `compile()` is not needed.
+
+        Args:
+            x (ndarray or list of ndarray): Input data, as for `predict()`.
+
+        Raises:
+            Exception: If the simulation deadlocked. The layers and streams involved are printed.
+
+        Returns:
+            The predictions, as for `predict()`.
+        """
+        if self.config.get_config_value('IOType') != 'io_stream':
+            raise Exception('Threaded simulation is only available for io_stream models')
+        if not hasattr(self.config.backend, 'compile_threaded'):
+            raise Exception('Threaded simulation is not supported by the {} backend'.format(self.config.backend.name))
+
+        self.write()
+        lib = ctypes.cdll.LoadLibrary(self.config.backend.compile_threaded(self))
+
+        n_samples = self._compute_n_samples(x)
+        n_inputs = len(self.get_input_variables())
+        n_outputs = len(self.get_output_variables())
+        xlist = [x] if n_inputs == 1 else x
+        xlist = [np.asarray(xi).reshape(n_samples, -1) for xi in xlist]
+        ctype = ctypes.c_float if xlist[0].dtype in [np.single, np.float32] else ctypes.c_double
+        dtype = 'float' if ctype == ctypes.c_float else 'double'
+
+        threaded_function = getattr(lib, '{}_threaded_{}'.format(self.config.get_project_name(), dtype))
+        threaded_function.restype = ctypes.c_int
+        threaded_function.argtypes = [npc.ndpointer(ctype, flags="C_CONTIGUOUS") for i in range(n_inputs + n_outputs)]
+
+        curr_dir = os.getcwd()
+        os.chdir(self.config.get_output_dir() + '/firmware')
+        output = [[] for i in range(n_outputs)]
+        try:
+            for i in range(n_samples):
+                inp = [np.ascontiguousarray(xi[i], dtype=ctype) for xi in xlist]
+                predictions = [np.zeros(yj.size(), dtype=ctype) for yj in self.get_output_variables()]
+                n_deadlocked = threaded_function(*(inp + predictions))
+                if n_deadlocked != 0:
+                    raise Exception('Threaded simulation of sample {} deadlocked in {} layer(s), see the streams reported above'.format(i, n_deadlocked))
+                for j, yj in enumerate(predictions):
+                    output[j].append(yj)
+        finally:
+            os.chdir(curr_dir)
+
+        output = [np.asarray(yj) for yj in output]
+        if n_samples == 1:
+            output = [yj[0] for yj in output]
+
+        return output[0] if n_outputs == 1 else output
+
+    def create_state(self):
+        """Creates the state of the recurrent layers for the stateful C simulation.
+
+        The returned `ModelState` keeps the hidden (and cell) state of all recurrent layers between calls of its
+        `step()` method, so a long sequence can be simulated in chunks, e.g. one time step per call of a model with
+        `n_timesteps=1`. Several states of the same model are independent. With io_parallel they can be stepped from
+        different threads, with io_stream only from one thread at a time, as the streaming kernels keep static buffers.
+
+        Returns:
+            ModelState: The state, with all recurrent layers starting from a zero state.
+        """
+        if self._top_function_lib is None:
+            raise Exception('Model not compiled')
+        try:
+            create_func = getattr(self._top_function_lib, self.config.get_project_name() + '_create_state')
+        except AttributeError:
+            raise Exception('Stateful simulation is only available for models with recurrent layers')
+        create_func.restype = ctypes.c_void_p
+        create_func.argtypes = []
+
+        curr_dir = os.getcwd()
+        os.chdir(self.config.get_output_dir() + '/firmware')
+        try:
+            # Loads the weights, so the state can be stepped from any directory and thread
+            handle = create_func()
+        finally:
+            os.chdir(curr_dir)
+
+        return ModelState(self, handle)
+
     def trace(self, x):
         print('Recompiling {} with tracing'.format(self.config.get_project_name()))
         self.config.trace_output = True
@@ -768,3 +886,94 @@ class ModelGraph(object):
             self.write()
 
         return self.config.backend.build(self, **kwargs)
+
+    def estimate(self):
+        """ Estimates the latency, initiation interval and resource usage of the model without running the HLS compiler.
+
+        Please see the `estimate()` function of backends for the details of the returned report.
+        """
+        return self.config.backend.estimate(self)
+
+    def optimize_config(self, latency_budget=None, interval_budget=None, dsp_budget=None, bram_budget=None):
+        """ Chooses the reuse factor, strategy and convolution implementation of the layers to fit the given budgets.
+
+        Please see the `optimize_config()` function of backends for the details of the search.
+
+        Returns:
+            dict: The 'HLSConfig' to convert the model with.
+        """
+        return self.config.backend.optimize_config(self, latency_budget=latency_budget, interval_budget=interval_budget, dsp_budget=dsp_budget, bram_budget=bram_budget)
+
+
+class ModelState(object):
+    """State of the recurrent layers of a compiled `ModelGraph`, see `ModelGraph.create_state()`."""
+
+    def __init__(self, model, handle):
+        self.model = model
+        self._lib = model._top_function_lib
+        self._handle = handle
+
+    def _get_function(self, name):
+        if self._handle is None:
+            raise Exception('State already freed')
+        if self._lib is not self.model._top_function_lib:
+            raise Exception('Model was recompiled, create a new state')
+        return getattr(self._lib, self.model.config.get_project_name() + name)
+
+    def reset(self):
+        """Resets the state of all recurrent layers to zero."""
+        reset_func = self._get_function('_reset_state')
+        reset_func.restype = None
+        reset_func.argtypes = [ctypes.c_void_p]
+        reset_func(self._handle)
+
+    def step(self, x):
+        """Runs the model on the samples of `x` in order, continuing from the state left by the previous sample.
+
+        The input and output are the same as for `ModelGraph.predict()`.
+        """
+        n_samples = self.model._compute_n_samples(x)
+        n_inputs = len(self.model.get_input_variables())
+        n_outputs = len(self.model.get_output_variables())
+
+        xlist = [x] if n_inputs == 1 else x
+        x0 = xlist[0]
+        if x0.dtype in [np.single, np.float32]:
+            ctype = ctypes.c_float
+            step_func = self._get_function('_step_float')
+        elif x0.dtype in [np.double, np.float64, np.float_]:
+            ctype = ctypes.c_double
+            step_func = self._get_function('_step_double')
+        else:
+            raise Exception('Invalid type ({}) of numpy array. Supported types are: single, float32, double, float64, float_.'.format(x0.dtype))
+        step_func.restype = None
+        step_func.argtypes = [ctypes.c_void_p] + [npc.ndpointer(ctype, flags="C_CONTIGUOUS") for i in range(n_inputs + n_outputs)]
+
+        inp = [np.ascontiguousarray(xj, dtype=ctype).reshape(n_samples, -1) for xj in xlist]
+        output = [np.zeros((n_samples, yj.size()), dtype=ctype) for yj in self.model.get_output_variables()]
+        for i in range(n_samples):
+            predictions = [np.zeros(yj.size(), dtype=ctype) for yj in self.model.get_output_variables()]
+            step_func(self._handle, *([xj[i] for xj in inp] + predictions))
+            for yj, pj in zip(output, predictions):
+                yj[i] = pj
+
+        if n_samples == 1 and n_outputs == 1:
+            return output[0][0]
+        elif n_outputs == 1:
+            return output[0]
+        elif n_samples == 1:
+            return [output_i[0] for output_i in output]
+        else:
+            return output
+
+    def free(self):
+        """Releases the state. Called automatically when the object is garbage collected."""
+        if self._handle is not None and self._lib is self.model._top_function_lib:
+            free_func = getattr(self._lib, self.model.config.get_project_name() + '_free_state')
+            free_func.restype = None
+            free_func.argtypes = [ctypes.c_void_p]
+            free_func(self._handle)
+        self._handle = None
+
+    def __del__(self):
+        self.free()
@@ -313,6 +313,7 @@ class Conv1D(Layer):
 
         Attribute('filt_width'),
         Attribute('stride_width'),
+        Attribute('dilation', default=1),
 
         Attribute('pad_left'),
         Attribute('pad_right'),
@@ -346,6 +347,7 @@ class SeparableConv1D(Layer):
 
         Attribute('filt_width'),
         Attribute('stride_width'),
+        Attribute('dilation', default=1),
 
         Attribute('pad_left'),
         Attribute('pad_right'),
@@ -395,6 +397,8 @@ class Conv2D(Layer):
         Attribute('filt_width'),
         Attribute('stride_height'),
         Attribute('stride_width'),
+        Attribute('dilation_height', default=1),
+        Attribute('dilation_width', default=1),
 
         Attribute('pad_top'),
         Attribute('pad_bottom'),
@@ -479,6 +483,8 @@ class SeparableConv2D(Layer):
         Attribute('filt_width'),
         Attribute('stride_height'),
         Attribute('stride_width'),
+        Attribute('dilation_height', default=1),
+        Attribute('dilation_width', default=1),
 
         Attribute('pad_top'),
         Attribute('pad_bottom'),
@@ -530,6 +536,97 @@ class DepthwiseConv2D(Conv2D):
 
         self.add_bias(quantizer=self.get_attr('bias_quantizer'))
 
+class Conv1DTranspose(Layer):
+    _expected_attributes = [
+        Attribute('in_width'),
+        Attribute('out_width'),
+
+        Attribute('n_chan'),
+        Attribute('n_filt'),
+
+        Attribute('filt_width'),
+        Attribute('stride_width'),
+
+        Attribute('crop_left'),
+
+        WeightAttribute('weight'),
+        WeightAttribute('bias'),
+
+        TypeAttribute('weight'),
+        TypeAttribute('bias'),
+    ]
+
+    def initialize(self):
+        shape = [self.attributes['out_width'], self.attributes['n_filt']]
+        dims = ['N_OUTPUTS_{}'.format(self.index), 'N_FILT_{}'.format(self.index)]
+        self.add_output_variable(shape, dims)
+
+        # Split the kernel into stride_width phases of phase_width taps:
+        # (W, F, C) => (phase_width * C, stride_width * F)
+        stride = self.get_attr('stride_width')
+        phase_width = int(np.ceil(self.get_attr('filt_width') / stride))
+        self.set_attr('phase_width', phase_width)
+
+        kernel = self.model.get_weights_data(self.name, 'kernel')
+        n_filt, n_chan = kernel.shape[1:]
+        phase_kernel = np.zeros((phase_width * stride, n_filt, n_chan), dtype=kernel.dtype)
+        phase_kernel[:kernel.shape[0]] = kernel
+        phase_kernel = phase_kernel.reshape(phase_width, stride, n_filt, n_chan).transpose(0, 3, 1, 2)
+        phase_kernel = phase_kernel.reshape(phase_width * n_chan, stride * n_filt)
+
+        self.add_weights_variable(name='weight', var_name='w{index}', data=phase_kernel, quantizer=self.get_attr('weight_quantizer'))
+        self.add_bias(quantizer=self.get_attr('bias_quantizer'))
+
+class Conv2DTranspose(Layer):
+    _expected_attributes = [
+        Attribute('in_height'),
+        Attribute('in_width'),
+
+        Attribute('out_height'),
+        Attribute('out_width'),
+
+        Attribute('n_chan'),
+        Attribute('n_filt'),
+
+        Attribute('filt_height'),
+        Attribute('filt_width'),
+        Attribute('stride_height'),
+        Attribute('stride_width'),
+
+        Attribute('crop_top'),
+        Attribute('crop_left'),
+
+        WeightAttribute('weight'),
+        WeightAttribute('bias'),
+
+        TypeAttribute('weight'),
+        TypeAttribute('bias'),
+    ]
+
+    def initialize(self):
+        shape = [self.attributes['out_height'], self.attributes['out_width'], self.attributes['n_filt']]
+        dims = ['OUT_HEIGHT_{}'.format(self.index), 'OUT_WIDTH_{}'.format(self.index), 'N_FILT_{}'.format(self.index)]
+        self.add_output_variable(shape, dims)
+
+        # Split the kernel into stride_height * stride_width phases of phase_height * phase_width taps:
+        # (H, W, F, C) => (phase_height * phase_width * C, stride_height * stride_width * F)
+        stride_height = self.get_attr('stride_height')
+        stride_width = self.get_attr('stride_width')
+        phase_height = int(np.ceil(self.get_attr('filt_height') / stride_height))
+        phase_width = int(np.ceil(self.get_attr('filt_width') / stride_width))
+        self.set_attr('phase_height', phase_height)
+        self.set_attr('phase_width', phase_width)
+
+        kernel = self.model.get_weights_data(self.name, 'kernel')
+        n_filt, n_chan = kernel.shape[2:]
+        phase_kernel = np.zeros((phase_height * stride_height, phase_width * stride_width, n_filt, n_chan), dtype=kernel.dtype)
+        phase_kernel[:kernel.shape[0], :kernel.shape[1]] = kernel
+        phase_kernel = phase_kernel.reshape(phase_height, stride_height, phase_width, stride_width, n_filt, n_chan).transpose(0, 2, 5, 1, 3, 4)
+        phase_kernel = phase_kernel.reshape(phase_height * phase_width * n_chan, stride_height * stride_width * n_filt)
+
+        self.add_weights_variable(name='weight', var_name='w{index}', data=phase_kernel, quantizer=self.get_attr('weight_quantizer'))
+        self.add_bias(quantizer=self.get_attr('bias_quantizer'))
+
 class Pooling1D(Layer):
     _expected_attributes = [
         Attribute('n_in'),
@@ -737,19 +834,46 @@ class BatchNormalization(Layer):
         self.add_weights_variable(name='scale', var_name='s{index}', data=scale)
         self.add_weights_variable(name='bias', var_name='b{index}', data=bias)
 
-class Merge(Layer):
+class LayerNormalization(Layer):
+    _expected_attributes = [
+        Attribute('n_in'),
+        Attribute('seq_len'),
+        Attribute('epsilon', value_type=float, default=1e-3),
+
+        WeightAttribute('scale'),
+        WeightAttribute('bias'),
+
+        TypeAttribute('scale'),
+        TypeAttribute('bias'),
+    ]
+
     def initialize(self):
-        assert(len(self.inputs) == 2)
-        inp1 = self.get_input_variable(self.inputs[0])
-        inp2 = self.get_input_variable(self.inputs[1])
-        if np.prod(inp2.shape) > np.prod(inp1.shape):
-            shape = inp2.shape
-            dims = inp2.dim_names
-        else:
-            shape = inp1.shape
-            dims = inp1.dim_names
+        inp = self.get_input_variable()
+        shape = inp.shape
+        dims = inp.dim_names
         self.add_output_variable(shape, dims)
 
+        # Normalization is over the last axis, the other axes are treated as a sequence of vectors
+        self.set_attr('n_in', shape[-1])
+        self.set_attr('seq_len', int(np.prod(shape[:-1])))
+
+        gamma = self.model.get_weights_data(self.name, 'gamma')
+        if gamma is None:
+            gamma = np.ones(shape[-1])
+        beta = self.model.get_weights_data(self.name, 'beta')
+        if beta is None:
+            beta = np.zeros(shape[-1])
+
+        self.add_weights_variable(name='scale', var_name='s{index}', data=gamma)
+        self.add_weights_variable(name='bias', var_name='b{index}', data=beta)
+
+class Merge(Layer):
+    def initialize(self):
+        assert(len(self.inputs) >= 2)
+        inps = [self.get_input_variable(inp_name) for inp_name in self.inputs]
+        inp = max(inps, key=lambda x: np.prod(x.shape)) # First of the largest inputs
+        self.add_output_variable(inp.shape, inp.dim_names)
+
 class Dot(Merge):
     def initialize(self):
         assert(len(self.inputs) == 2)
@@ -763,13 +887,12 @@ class Dot(Merge):
 
 class Concatenate(Merge):
     def initialize(self):
-        assert(len(self.inputs) == 2)
-        inp1 = self.get_input_variable(self.inputs[0])
-        inp2 = self.get_input_variable(self.inputs[1])
+        assert(len(self.inputs) >= 2)
+        inps = [self.get_input_variable(inp_name) for inp_name in self.inputs]
         axis = self.attributes['axis']
         if axis > 0: axis -= 1
-        shape = inp1.shape[:]
-        shape[axis] += inp2.shape[axis]
+        shape = inps[0].shape[:]
+        shape[axis] = sum([inp.shape[axis] for inp in inps])
         rank = len(shape)
         if rank > 1:
             dims = ['OUT_CONCAT_{}_{}'.format(i, self.index) for i in range(rank)]
@@ -974,6 +1097,73 @@ class GRU(Layer):
         recurrent_weight = self.model.get_weights_data(self.name, 'recurrent_kernel')
         self.add_weights_variable(name='recurrent_weight', var_name='wr{index}', data=recurrent_weight)
 
+class MultiHeadAttention(Layer):
+    _expected_attributes = [
+        Attribute('num_heads'),
+        Attribute('head_dim_key'),
+        Attribute('head_dim_value'),
+        Attribute('feature_dim'),
+        Attribute('feature_dim_kv'),
+        Attribute('seq_len'),
+        Attribute('seq_len_kv'),
+        Attribute('out_dim'),
+
+        WeightAttribute('query_weight'),
+        WeightAttribute('query_bias'),
+        WeightAttribute('key_weight'),
+        WeightAttribute('key_bias'),
+        WeightAttribute('value_weight'),
+        WeightAttribute('value_bias'),
+        WeightAttribute('output_weight'),
+        WeightAttribute('output_bias'),
+
+        TypeAttribute('query_weight'),
+        TypeAttribute('query_bias'),
+        TypeAttribute('key_weight'),
+        TypeAttribute('key_bias'),
+        TypeAttribute('value_weight'),
+        TypeAttribute('value_bias'),
+        TypeAttribute('output_weight'),
+        TypeAttribute('output_bias'),
+    ]
+
+    def initialize(self):
+        # Inputs are the query and, unless it is a self-attention, the value (also used as key)
+        query = self.get_input_variable(self.inputs[0])
+        value = self.get_input_variable(self.inputs[-1])
+        self.set_attr('seq_len', query.shape[0])
+        self.set_attr('feature_dim', query.shape[1])
+        self.set_attr('seq_len_kv', value.shape[0])
+        self.set_attr('feature_dim_kv', value.shape[1])
+
+        shape = [self.attributes['seq_len'], self.attributes['out_dim']]
+        dims = ['N_SEQ_{}'.format(self.index), 'N_OUT_{}'.format(self.index)]
+        self.add_output_variable(shape, dims)
+
+        num_heads = self.attributes['num_heads']
+        head_dim_key = self.attributes['head_dim_key']
+        head_dim_value = self.attributes['head_dim_value']
+
+        # The scaling of the dot products by 1/sqrt(head_dim_key) is folded into the query projection
+        query_scale = 1. / np.sqrt(head_dim_key)
+        for proj, head_dim, scale in [('query', head_dim_key, query_scale), ('key', head_dim_key, 1.), ('value', head_dim_value, 1.)]:
+            kernel = self.model.get_weights_data(self.name, '{}/kernel'.format(proj)) # [feature_dim, num_heads, head_dim]
+            bias = self.model.get_weights_data(self.name, '{}/bias'.format(proj)) # [num_heads, head_dim]
+            if bias is None:
+                bias = np.zeros((num_heads, head_dim))
+            # One [feature_dim, head_dim] kernel per head
+            kernel = np.transpose(kernel, (1, 0, 2)) * scale
+            bias = bias * scale
+            self.add_weights_variable(name='{}_weight'.format(proj), var_name='w{}{{index}}'.format(proj[0]), data=kernel)
+            self.add_weights_variable(name='{}_bias'.format(proj), var_name='b{}{{index}}'.format(proj[0]), data=bias)
+
+        kernel = self.model.get_weights_data(self.name, 'attention_output/kernel') # [num_heads, head_dim_value, out_dim]
+        bias = self.model.get_weights_data(self.name, 'attention_output/bias')
+        if bias is None:
+            bias = np.zeros(self.attributes['out_dim'])
+        self.add_weights_variable(name='output_weight', var_name='wo{index}', data=kernel.reshape((num_heads * head_dim_value, -1)))
+        self.add_weights_variable(name='output_bias', var_name='bo{index}', data=bias)
+
 class GarNet(Layer):
     ref_impl = False
 
@@ -1149,7 +1339,10 @@ layer_map = {
     'SeparableConv1D'        : SeparableConv1D,
     'SeparableConv2D'        : SeparableConv2D,
     'DepthwiseConv2D'        : DepthwiseConv2D,
+    'Conv1DTranspose'        : Conv1DTranspose,
+    'Conv2DTranspose'        : Conv2DTranspose,
     'BatchNormalization'     : BatchNormalization,
+    'LayerNormalization'     : LayerNormalization,
     'QBatchNormalization'    : BatchNormalization,
     'MaxPooling1D'           : Pooling1D,
     'AveragePooling1D'       : Pooling1D,
@@ -1172,6 +1365,7 @@ layer_map = {
     'SimpleRNN'              : SimpleRNN,
     'LSTM'                   : LSTM,
     'GRU'                    : GRU,
+    'MultiHeadAttention'     : MultiHeadAttention,
     'GarNet'                 : GarNet,
     'GarNetStack'            : GarNetStack,
     # TensorFlow-specific layers:
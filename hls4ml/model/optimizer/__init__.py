@@ -13,11 +13,11 @@ for opt_name, opt in optimizers.items():
 
 try:
     import qkeras
-    register_flow('convert', ['fuse_bias_add', 'remove_useless_transpose', 'output_rounding_saturation_mode', 'qkeras_factorize_alpha', 'extract_ternary_threshold', 'fuse_consecutive_batch_normalization']) # TODO Maybe not all QKeras optmizers belong here?
-    register_flow('optimize', ['eliminate_linear_activation', 'fuse_consecutive_batch_normalization', 'fuse_batch_normalization', 'replace_multidimensional_dense_with_conv', 'set_precision_concat'], requires=['convert'])
+    register_flow('convert', ['fuse_bias_add', 'remove_useless_transpose', 'merge_consecutive_transposes', 'output_rounding_saturation_mode', 'qkeras_factorize_alpha', 'extract_ternary_threshold', 'fuse_consecutive_batch_normalization']) # TODO Maybe not all QKeras optmizers belong here?
+    register_flow('optimize', ['eliminate_linear_activation', 'fold_transpose_into_dense', 'fold_transpose_into_dense_output', 'fuse_consecutive_batch_normalization', 'fuse_batch_normalization', 'replace_multidimensional_dense_with_conv', 'set_precision_concat'], requires=['convert'])
 except:
-    register_flow('convert', ['fuse_bias_add', 'remove_useless_transpose'])
-    register_flow('optimize', ['eliminate_linear_activation', 'fuse_batch_normalization', 'replace_multidimensional_dense_with_conv', 'set_precision_concat'], requires=['convert'])
+    register_flow('convert', ['fuse_bias_add', 'remove_useless_transpose', 'merge_consecutive_transposes'])
+    register_flow('optimize', ['eliminate_linear_activation', 'fold_transpose_into_dense', 'fold_transpose_into_dense_output', 'fuse_batch_normalization', 'replace_multidimensional_dense_with_conv', 'set_precision_concat'], requires=['convert'])
 
 del opt_path
 del module_path
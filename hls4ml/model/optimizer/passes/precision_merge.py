@@ -1,3 +1,5 @@
+from functools import reduce
+
 from hls4ml.model.optimizer import OptimizerPass
 from hls4ml.model.types import FixedPrecisionType
 
@@ -19,9 +21,8 @@ class SetPrecisionConcat(OptimizerPass):
     def match(self, node):
         if node.__class__.__name__ == 'Concatenate':
             otype = node.get_output_variable().type.precision
-            itype1 = node.get_input_variable(node.inputs[0]).type.precision
-            itype2 = node.get_input_variable(node.inputs[1]).type.precision
-            if isinstance(otype, FixedPrecisionType) and otype != get_concat_type(itype1, itype2):
+            itypes = [node.get_input_variable(inp).type.precision for inp in node.inputs]
+            if isinstance(otype, FixedPrecisionType) and otype != reduce(get_concat_type, itypes):
                 return True
         return False
     
@@ -30,9 +31,8 @@ class SetPrecisionConcat(OptimizerPass):
         Set concat output precision
         """
         otype = node.get_output_variable().type.precision
-        itype1 = node.get_input_variable(node.inputs[0]).type.precision
-        itype2 = node.get_input_variable(node.inputs[1]).type.precision
-        newtype = get_concat_type(itype1, itype2)
+        itypes = [node.get_input_variable(inp).type.precision for inp in node.inputs]
+        newtype = reduce(get_concat_type, itypes)
         print("Found {} in the model, optimizing {} to {}...".format(node.name, otype, newtype))
         node.get_output_variable().type.precision = newtype
        
@@ -1,15 +1,45 @@
+import numpy as np
+
 from hls4ml.model.optimizer import OptimizerPass
-from hls4ml.model.layers import Transpose
+from hls4ml.model.layers import Transpose, Reshape, Dense
+
+def _consumers(model, node):
+    return [x for x in model.graph.values() if node.outputs[0] in x.inputs]
+
+def _collapse_reshapes(model, reshapes, target_shape=None):
+    # Once the transpose is removed, the reshapes before and after it are replaced by a single one. Reshape layers
+    # alias the variable of their input, so the remaining one is recreated on its new input.
+    prev_node = reshapes[0].get_input_node()
+    while isinstance(prev_node, Reshape) and len(_consumers(model, prev_node)) == 1:
+        reshapes.insert(0, prev_node)
+        prev_node = prev_node.get_input_node()
+    if target_shape is None:
+        target_shape = reshapes[-1].get_attr('target_shape')
+    consumers = _consumers(model, reshapes[-1])
+    while reshapes[-1].outputs[0] not in model.outputs and len(consumers) == 1 and isinstance(consumers[0], Reshape):
+        reshapes.append(consumers[0])
+        target_shape = consumers[0].get_attr('target_shape')
+        consumers = _consumers(model, consumers[0])
+
+    for reshape in reshapes[:-1]:
+        model.remove_node(reshape, rewire=True)
+    reshape = reshapes[-1]
+    new_reshape = model.make_node(Reshape, reshape.name, {'target_shape': target_shape}, reshape.inputs.copy())
+    model.replace_node(reshape, new_reshape)
+
+def _transpose_source_index(shape, perm):
+    # Element i of the flattened output of the transpose is element src[i] of the flattened input
+    return np.arange(np.prod(shape)).reshape(shape).transpose(perm).flatten()
 
 class RemoveUselessTranspose(OptimizerPass):
     def match(self, node):
         is_match = isinstance(node, Transpose) and\
-                   node.get_attr('perm') == [0] #Useless transpose
+                   node.get_attr('perm') == list(range(len(node.get_attr('perm')))) #Useless transpose
         return is_match
     
     def transform(self, model, node):
         """
-        Remove a transpose layer if it doesn't do anything. i.e 1D input and perm = [0]
+        Remove a transpose layer if it doesn't do anything. i.e 1D input and perm = [0], or any identity permutation
         """
         print("Unnessary {} in the model, optimizing ...".format(node.name))
         if not node.get_output_nodes():
@@ -18,4 +48,105 @@ class RemoveUselessTranspose(OptimizerPass):
         else:
             model.remove_node(node, rewire=True)
        
-        return True
\ No newline at end of file
+        return True
+
+class MergeConsecutiveTransposes(OptimizerPass):
+    ''' Replaces two consecutive transposes with a single one, or removes both if they cancel out '''
+    def match(self, node):
+        if not isinstance(node, Transpose) or len(node.get_attr('perm')) < 2:
+            return False
+        prev_node = node.get_input_node()
+        return isinstance(prev_node, Transpose) and len(prev_node.get_attr('perm')) == len(node.get_attr('perm')) and \
+            len(_consumers(node.model, prev_node)) == 1 and prev_node.outputs[0] not in node.model.outputs
+
+    def transform(self, model, node):
+        prev_node = node.get_input_node()
+        perm = [prev_node.get_attr('perm')[i] for i in node.get_attr('perm')]
+
+        model.remove_node(prev_node, rewire=True)
+        if perm == list(range(len(perm))):
+            model.remove_node(node, rewire=len(_consumers(model, node)) > 0)
+        else:
+            new_node = model.make_node(Transpose, node.name, {'perm': perm}, node.inputs.copy())
+            model.replace_node(node, new_node)
+
+        return True
+
+class FoldTransposeIntoDense(OptimizerPass):
+    '''
+    Removes a transpose that is flattened into a Dense layer, the Dense layer reads its input in the transposed order
+    by permuting the rows of its weights
+    '''
+    def _follow(self, node):
+        reshapes = []
+        consumers = _consumers(node.model, node)
+        while len(consumers) == 1 and isinstance(consumers[0], Reshape) and consumers[0].outputs[0] not in node.model.outputs:
+            reshapes.append(consumers[0])
+            consumers = _consumers(node.model, consumers[0])
+        if len(reshapes) > 0 and len(consumers) == 1 and isinstance(consumers[0], Dense):
+            return reshapes, consumers[0]
+        return reshapes, None
+
+    def match(self, node):
+        if not isinstance(node, Transpose) or len(node.get_attr('perm')) < 2 or node.outputs[0] in node.model.outputs:
+            return False
+        _, dense = self._follow(node)
+        return dense is not None and len(dense.get_input_variable().shape) == 1 and \
+            dense.weights['weight'].data.shape[0] == dense.get_attr('n_in')
+
+    def transform(self, model, node):
+        reshapes, dense = self._follow(node)
+        src = _transpose_source_index(node.get_input_variable().shape, node.get_attr('perm'))
+
+        weight = dense.weights['weight']
+        for attr in ['data', 'data_unquantized']:
+            data = getattr(weight, attr, None)
+            if data is not None:
+                new_data = np.empty_like(data)
+                new_data[src] = data
+                setattr(weight, attr, new_data)
+
+        model.remove_node(node, rewire=True)
+        _collapse_reshapes(model, reshapes)
+
+        return True
+
+class FoldTransposeIntoDenseOutput(OptimizerPass):
+    '''
+    Removes a transpose applied to the reshaped output of a Dense layer, the Dense layer writes its output in the
+    transposed order by permuting the columns of its weights and its biases
+    '''
+    def _follow(self, node):
+        reshapes = []
+        prev_node = node.get_input_node()
+        while isinstance(prev_node, Reshape) and len(_consumers(node.model, prev_node)) == 1:
+            reshapes.insert(0, prev_node)
+            prev_node = prev_node.get_input_node()
+        if len(reshapes) > 0 and isinstance(prev_node, Dense) and len(_consumers(node.model, prev_node)) == 1 and \
+                prev_node.outputs[0] not in node.model.outputs:
+            return reshapes, prev_node
+        return reshapes, None
+
+    def match(self, node):
+        if not isinstance(node, Transpose) or len(node.get_attr('perm')) < 2:
+            return False
+        _, dense = self._follow(node)
+        return dense is not None and len(dense.get_output_variable().shape) == 1 and \
+            dense.weights['weight'].data.shape[-1] == dense.get_attr('n_out')
+
+    def transform(self, model, node):
+        reshapes, dense = self._follow(node)
+        src = _transpose_source_index(node.get_input_variable().shape, node.get_attr('perm'))
+        out_shape = node.get_output_variable().shape
+
+        for wname in ['weight', 'bias']:
+            var = dense.weights[wname]
+            for attr in ['data', 'data_unquantized']:
+                data = getattr(var, attr, None)
+                if data is not None:
+                    setattr(var, attr, data[..., src])
+
+        model.remove_node(node, rewire=len(_consumers(model, node)) > 0)
+        _collapse_reshapes(model, reshapes, target_shape=out_shape)
+
+        return True
@@ -4,4 +4,5 @@ from hls4ml.report.vivado_report import read_vivado_report
 from hls4ml.report.vivado_report import parse_vivado_report
 
 from hls4ml.report.quartus_report import read_quartus_report
-from hls4ml.report.quartus_report import parse_quartus_report
\ No newline at end of file
+from hls4ml.report.quartus_report import parse_quartus_report
+from hls4ml.report.estimate_report import print_estimate_report
@@ -0,0 +1,76 @@
+from __future__ import print_function
+
+def print_estimate_report(estimate, synth_report=None):
+    """Prints the report obtained with `ModelGraph.estimate()`.
+
+    The summary follows the layout of the Vivado HLS synthesis report, so the printouts of two estimates can be
+    compared with `test/compare-reports.sh`. If the parsed report of an actual synthesis run is given (the
+    'CSynthesisReport' section of `parse_vivado_report()`), the estimate is printed next to it.
+
+    Args:
+        estimate (dict): The report returned by `ModelGraph.estimate()`.
+        synth_report (dict, optional): The 'CSynthesisReport' of the same model.
+    """
+    print('Synthesis report (estimate)')
+    print('================================================================')
+    print('+ Latency (clock cycles):')
+    print('    * Summary:')
+    print('    +---------+---------+----------+')
+    print('    | Latency | Interval| Latency  |')
+    print('    | (cycles)| (cycles)| (ns)     |')
+    print('    +---------+---------+----------+')
+    print('    |{:>9}|{:>9}|{:>10}|'.format(estimate['Latency'], estimate['Interval'], '{:g}'.format(estimate['LatencyNs'])))
+    print('    +---------+---------+----------+')
+    print('')
+    print('    Critical path: {}'.format(' -> '.join(estimate['CriticalPath'])))
+    print('    Bottleneck (largest interval): {}'.format(estimate['Bottleneck']))
+    print('')
+    print('+ Utilization estimates:')
+    print('    * Summary:')
+    print('    +-----------------+---------+-------+-----+')
+    print('    |       Name      | BRAM_18K| DSP48E| URAM|')
+    print('    +-----------------+---------+-------+-----+')
+    print('    |DSP              |        -|{:>7}|    -|'.format(estimate['DSP']))
+    print('    |Memory           |{:>9}|      -|{:>5}|'.format(estimate['BRAM_18K'], estimate.get('URAM', 0)))
+    print('    +-----------------+---------+-------+-----+')
+    print('    |Total            |{:>9}|{:>7}|{:>5}|'.format(estimate['BRAM_18K'], estimate['DSP'], estimate.get('URAM', 0)))
+    print('    +-----------------+---------+-------+-----+')
+    print('')
+    print('+ Per-layer estimates:')
+    print('    +-----------------+---------+---------+---------+-------+-----+--------+')
+    print('    |       Name      | Latency | Interval| BRAM_18K| DSP48E| URAM| Weights|')
+    print('    +-----------------+---------+---------+---------+-------+-----+--------+')
+    for name, layer in estimate['Layers'].items():
+        memory = layer.get('WeightMemory')
+        print('    |{:<17}|{:>9}|{:>9}|{:>9}|{:>7}|{:>5}|{:>8}|'.format(name[:17], layer['Latency'], layer['Interval'], layer['BRAM_18K'], layer['DSP'],
+                                                                  layer.get('URAM', 0), memory['Impl'] if memory is not None else '-'))
+    print('    +-----------------+---------+---------+---------+-------+-----+--------+')
+
+    if len(estimate.get('WeightMemory', {})) > 0:
+        print('')
+        print('+ Weight memory:')
+        print('    +---------+-------+----------+-------+---------+-----+')
+        print('    |  Memory | Arrays|   Bits   |  LUT  | BRAM_18K| URAM|')
+        print('    +---------+-------+----------+-------+---------+-----+')
+        for impl in ['register', 'lutram', 'bram', 'uram']:
+            if impl in estimate['WeightMemory']:
+                total = estimate['WeightMemory'][impl]
+                print('    |{:<9}|{:>7}|{:>10}|{:>7}|{:>9}|{:>5}|'.format(impl, total['Arrays'], total['Bits'], total['LUT'], total['BRAM_18K'], total['URAM']))
+        print('    +---------+-------+----------+-------+---------+-----+')
+
+    if synth_report is not None:
+        print('')
+        print('+ Comparison with synthesis:')
+        print('    +-----------+----------+-----------+')
+        print('    |           | Estimate | Synthesis |')
+        print('    +-----------+----------+-----------+')
+        rows = [
+            ('Latency', estimate['Latency'], synth_report.get('WorstLatency')),
+            ('Interval', estimate['Interval'], synth_report.get('IntervalMax')),
+            ('DSP48E', estimate['DSP'], synth_report.get('DSP48E')),
+            ('BRAM_18K', estimate['BRAM_18K'], synth_report.get('BRAM_18K')),
+            ('URAM', estimate.get('URAM', 0), synth_report.get('URAM')),
+        ]
+        for name, est, syn in rows:
+            print('    |{:<11}|{:>10}|{:>11}|'.format(name, est, syn if syn is not None else '-'))
+        print('    +-----------+----------+-----------+')
@@ -11,6 +11,8 @@
 #include "HLS/ac_fixed.h"
 #endif
 
+#include "nnet_utils/nnet_types.h"
+
 //hls-fpga-machine-learning insert numbers
 
 
@@ -22,22 +22,20 @@
 
 //hls-fpga-machine-learning insert weights
 
+//hls-fpga-machine-learning insert tasks
+
 #ifndef __INTELFPGA_COMPILER__
-output_data myproject(
-   input_data inputs
-) {
+//hls-fpga-machine-learning insert top-level
 #else
 //hls-fpga-machine-learning insert cpragmas
-component output_data myproject(
-   input_data inputs
-) {
+//hls-fpga-machine-learning insert component
 #endif
-    hls_register output_data outputs;
+//hls-fpga-machine-learning insert outputs
 
     // ****************************************
     // NETWORK INSTANTIATION
     // ****************************************
 
     //hls-fpga-machine-learning insert layers
-    return outputs;
+//hls-fpga-machine-learning insert return
 }
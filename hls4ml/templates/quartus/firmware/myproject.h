@@ -32,24 +32,13 @@
 
 #include "parameters.h"
 
-struct input_data {
-  //hls-fpga-machine-learning insert inputs
-};
-
-struct output_data {
-  //hls-fpga-machine-learning insert outputs
-};
-
+//hls-fpga-machine-learning insert data structs
 
 #ifndef __INTELFPGA_COMPILER__
-output_data myproject(
-  input_data inputs
-);
+//hls-fpga-machine-learning insert top-level
 #else
 //hls-fpga-machine-learning insert cpragmas
-component output_data myproject(
-  input_data inputs
-);
+//hls-fpga-machine-learning insert component
 #endif
 
 #endif
@@ -0,0 +1,293 @@
+//
+//    rfnoc-hls-neuralnet: Vivado HLS code for neural-net building blocks
+//
+//    Copyright (C) 2017 EJ Kreinar
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef NNET_ACTIVATION_STREAM_H_
+#define NNET_ACTIVATION_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_types.h"
+#include "nnet_activation.h"
+
+namespace nnet {
+
+// The activations are applied to one packet at a time by the io_parallel kernels, with the size of a packet as n_in
+template<typename CONFIG_T, unsigned N>
+struct activ_word_config : CONFIG_T {
+    static const unsigned n_in = N;
+};
+
+// *************************************************
+//       LINEAR Activation
+// *************************************************
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void linear(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    LinearActLoop:
+    for (int i = 0; i < CONFIG_T::n_in / res_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        linear<typename data_T::value_type, typename res_T::value_type, activ_word_config<CONFIG_T, res_T::size>>(in_data.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+// *************************************************
+//       RELU Activation
+// *************************************************
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void relu(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    ReLUActLoop:
+    for (int i = 0; i < CONFIG_T::n_in / res_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        relu<typename data_T::value_type, typename res_T::value_type, activ_word_config<CONFIG_T, res_T::size>>(in_data.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void relu6(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    ReLU6ActLoop:
+    for (int i = 0; i < CONFIG_T::n_in / res_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        relu6<typename data_T::value_type, typename res_T::value_type, activ_word_config<CONFIG_T, res_T::size>>(in_data.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void relu1(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    ReLU1ActLoop:
+    for (int i = 0; i < CONFIG_T::n_in / res_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        relu1<typename data_T::value_type, typename res_T::value_type, activ_word_config<CONFIG_T, res_T::size>>(in_data.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+// *************************************************
+//       Sigmoid Activation
+// *************************************************
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void sigmoid(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    SigmoidActLoop:
+    for (int i = 0; i < CONFIG_T::n_in / res_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        sigmoid<typename data_T::value_type, typename res_T::value_type, activ_word_config<CONFIG_T, res_T::size>>(in_data.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+// *************************************************
+//       Softmax Activation
+// *************************************************
+// The softmax is computed over the last dimension, which is packed in a single word
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void softmax(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    SoftmaxActLoop:
+    for (int i = 0; i < CONFIG_T::n_in / res_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        softmax<typename data_T::value_type, typename res_T::value_type, activ_word_config<CONFIG_T, res_T::size>>(in_data.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+// *************************************************
+//       TanH Activation
+// *************************************************
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void dense_tanh(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    TanHActLoop:
+    for (int i = 0; i < CONFIG_T::n_in / res_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        dense_tanh<typename data_T::value_type, typename res_T::value_type, activ_word_config<CONFIG_T, res_T::size>>(in_data.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+// *************************************************
+//       Hard sigmoid Activation
+// *************************************************
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void hard_sigmoid(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    HardSigmoidActLoop:
+    for (int i = 0; i < CONFIG_T::n_in / res_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        hard_sigmoid<typename data_T::value_type, typename res_T::value_type, activ_word_config<CONFIG_T, res_T::size>>(in_data.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+// *************************************************
+//       Leaky RELU Activation
+// *************************************************
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void leaky_relu(stream<data_T, data_D> &data, const typename data_T::value_type alpha, stream<res_T, res_D> &res)
+{
+    LeakyReLUActLoop:
+    for (int i = 0; i < CONFIG_T::n_in / res_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        leaky_relu<typename data_T::value_type, typename res_T::value_type, activ_word_config<CONFIG_T, res_T::size>>(in_data.data, alpha, out_data.data);
+        res.write(out_data);
+    }
+}
+
+// *************************************************
+//       Thresholded RELU Activation
+// *************************************************
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void thresholded_relu(stream<data_T, data_D> &data, const typename data_T::value_type theta, stream<res_T, res_D> &res)
+{
+    ThresholdedReLUActLoop:
+    for (int i = 0; i < CONFIG_T::n_in / res_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        thresholded_relu<typename data_T::value_type, typename res_T::value_type, activ_word_config<CONFIG_T, res_T::size>>(in_data.data, theta, out_data.data);
+        res.write(out_data);
+    }
+}
+
+// *************************************************
+//       Softplus Activation
+// *************************************************
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void softplus(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    SoftplusActLoop:
+    for (int i = 0; i < CONFIG_T::n_in / res_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        softplus<typename data_T::value_type, typename res_T::value_type, activ_word_config<CONFIG_T, res_T::size>>(in_data.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+// *************************************************
+//       Softsign Activation
+// *************************************************
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void softsign(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    SoftsignActLoop:
+    for (int i = 0; i < CONFIG_T::n_in / res_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        softsign<typename data_T::value_type, typename res_T::value_type, activ_word_config<CONFIG_T, res_T::size>>(in_data.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+// *************************************************
+//       ELU Activation
+// *************************************************
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void elu(stream<data_T, data_D> &data, const typename res_T::value_type alpha, stream<res_T, res_D> &res)
+{
+    EluActLoop:
+    for (int i = 0; i < CONFIG_T::n_in / res_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        elu<typename data_T::value_type, typename res_T::value_type, activ_word_config<CONFIG_T, res_T::size>>(in_data.data, alpha, out_data.data);
+        res.write(out_data);
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void elu(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    elu<data_T, res_T, CONFIG_T>(data, 1.0, res);
+}
+
+// *************************************************
+//       SELU Activation
+// *************************************************
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void selu(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    SeluActLoop:
+    for (int i = 0; i < CONFIG_T::n_in / res_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        selu<typename data_T::value_type, typename res_T::value_type, activ_word_config<CONFIG_T, res_T::size>>(in_data.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+// *************************************************
+//       PReLU Activation
+// *************************************************
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void prelu(stream<data_T, data_D> &data, const typename data_T::value_type alpha[CONFIG_T::n_in], stream<res_T, res_D> &res)
+{
+    PReLUActLoop:
+    for (int i = 0; i < CONFIG_T::n_in / res_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        prelu<typename data_T::value_type, typename res_T::value_type, activ_word_config<CONFIG_T, res_T::size>>(in_data.data, &alpha[i * res_T::size], out_data.data);
+        res.write(out_data);
+    }
+}
+
+// *************************************************
+//       Binary TanH Activation
+// *************************************************
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void binary_tanh(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    BinaryTanHActLoop:
+    for (int i = 0; i < CONFIG_T::n_in / res_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        binary_tanh<typename data_T::value_type, typename res_T::value_type, activ_word_config<CONFIG_T, res_T::size>>(in_data.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+// *************************************************
+//       Ternary TanH Activation
+// *************************************************
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void ternary_tanh(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    TernaryTanHActLoop:
+    for (int i = 0; i < CONFIG_T::n_in / res_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        ternary_tanh<typename data_T::value_type, typename res_T::value_type, activ_word_config<CONFIG_T, res_T::size>>(in_data.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+}
+
+#endif
@@ -17,17 +17,82 @@
 //    along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
-/*
-*   PLACEHOLDER - The common pass bn_quant.py includes both parallel and streaming BN; streaming is currently not supported in Quartus
-*/
-
 #ifndef NNET_BATCHNORM_STREAM_H_
 #define NNET_BATCHNORM_STREAM_H_
 
 #include "nnet_common.h"
 #include "nnet_helpers.h"
 #include "nnet_mult.h"
+#include "nnet_types.h"
+#include "nnet_batchnorm.h"
+
+namespace nnet {
+
+// A packet usually holds all the channels of a pixel, the index of the scale is then the index in the packet
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void normalize(
+    stream<data_T, data_D> &data,
+    stream<res_T, res_D>   &res,
+    const typename CONFIG_T::scale_t  scale[CONFIG_T::n_in],
+    const typename CONFIG_T::bias_t   bias[CONFIG_T::n_in]
+)
+{
+    BatchNormLoop:
+    for (int i = 0; i < CONFIG_T::n_in / data_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        BatchNormPack:
+        #pragma unroll
+        for (int j = 0; j < data_T::size; j++) {
+            int norm_index;
+            if (CONFIG_T::n_filt == -1) norm_index = i * data_T::size + j;
+            else if (data_T::size % CONFIG_T::n_filt == 0) norm_index = j % CONFIG_T::n_filt;
+            else norm_index = (i * data_T::size + j) % CONFIG_T::n_filt;
+            out_data[j] = CONFIG_T::template product<typename data_T::value_type, typename CONFIG_T::scale_t>::product(in_data[j], scale[norm_index]) + bias[norm_index];
+        }
+        res.write(out_data);
+    }
+}
+
+// ****************************************************
+//       Merged Batch Normalization and Quantized Tanh
+// ****************************************************
+template<class data_T, typename CONFIG_T, class res_T, unsigned data_D, unsigned res_D>
+void normalize_binary_tanh(stream<data_T, data_D> &data, stream<res_T, res_D> &res, const typename data_T::value_type threshold[CONFIG_T::n_in])
+{
+    BinaryNormLoop:
+    for (int i = 0; i < CONFIG_T::n_in / data_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        BinaryNormPack:
+        #pragma unroll
+        for (int j = 0; j < data_T::size; j++) {
+            if (in_data[j] > threshold[i * data_T::size + j]) out_data[j] = 1;
+            else out_data[j] = 0;
+        }
+        res.write(out_data);
+    }
+}
+
+template<class data_T, typename CONFIG_T, class res_T, unsigned data_D, unsigned res_D>
+void normalize_ternary_tanh(stream<data_T, data_D> &data, stream<res_T, res_D> &res, const typename data_T::value_type threshold_hi[CONFIG_T::n_in], const typename data_T::value_type threshold_lo[CONFIG_T::n_in])
+{
+    TernaryNormLoop:
+    for (int i = 0; i < CONFIG_T::n_in / data_T::size; i++) {
+        data_T in_data = data.read();
+        res_T out_data;
+        TernaryNormPack:
+        #pragma unroll
+        for (int j = 0; j < data_T::size; j++) {
+            int norm_index = i * data_T::size + j;
+            if (in_data[j] > threshold_hi[norm_index]) out_data[j] = 1;
+            else if (in_data[j] <= threshold_lo[norm_index]) out_data[j] = -1;
+            else out_data[j] = 0;
+        }
+        res.write(out_data);
+    }
+}
 
-namespace nnet {}
+}
 
 #endif
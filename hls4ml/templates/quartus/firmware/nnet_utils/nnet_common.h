@@ -32,12 +32,16 @@
 #include "nnet_helpers.h"
 #endif
 
+#include "nnet_types.h"
+
 typedef ac_fixed<16,6> table_default_t;
 
 namespace nnet {
 
 // Common type definitions
-enum io_type {io_parallel = 0, io_serial};
+enum io_type {io_parallel = 0, io_serial, io_stream};
+enum strategy { latency, resource };
+enum memory_impl { mem_auto = 0, mem_bram, mem_uram, mem_lutram };
 
 // Default data types (??) TODO: Deprecate
 typedef ac_fixed<16,4>  weight_t_def;
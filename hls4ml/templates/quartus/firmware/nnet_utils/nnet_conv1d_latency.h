@@ -0,0 +1,56 @@
+#ifndef NNET_CONV1D_LATENCY_H_
+#define NNET_CONV1D_LATENCY_H_
+
+#include "nnet_common.h"
+#include "nnet_mult.h"
+
+namespace nnet {
+
+// Fully unrolled, every product is cast to accum_t before it is accumulated, as the Vivado kernel does.
+// The weights are in the Keras order, [filt_width][n_chan][n_filt].
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_1d_latency_cl(
+    data_T data[CONFIG_T::in_width * CONFIG_T::n_chan],
+    res_T  res[CONFIG_T::out_width * CONFIG_T::n_filt],
+    const typename CONFIG_T::weight_t weights[CONFIG_T::filt_width * CONFIG_T::n_chan * CONFIG_T::n_filt],
+    const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt])
+{
+    ConvOut:
+    #pragma unroll
+    for (int ii = 0; ii < CONFIG_T::out_width; ii++) {
+        hls_register typename CONFIG_T::accum_t acc[CONFIG_T::n_filt];
+        InitAccum:
+        #pragma unroll
+        for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+            acc[ff] = (typename CONFIG_T::accum_t) biases[ff];
+        }
+
+        ConvKernel:
+        #pragma unroll
+        for (int jj = 0; jj < CONFIG_T::filt_width; jj++) {
+            int index_in = ii * CONFIG_T::stride_width + jj * CONFIG_T::dilation - CONFIG_T::pad_left;
+            if (index_in < 0 || index_in >= CONFIG_T::in_width) continue; // padded
+            ConvChan:
+            #pragma unroll
+            for (int cc = 0; cc < CONFIG_T::n_chan; cc++) {
+                ConvFilt:
+                #pragma unroll
+                for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+                    int index_weight = (jj * CONFIG_T::n_chan + cc) * CONFIG_T::n_filt + ff;
+                    acc[ff] += (typename CONFIG_T::accum_t) CONFIG_T::mult_config::template product<data_T, typename CONFIG_T::weight_t>::product(
+                        data[index_in * CONFIG_T::n_chan + cc], weights[index_weight]);
+                }
+            }
+        }
+
+        Result:
+        #pragma unroll
+        for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+            res[ii * CONFIG_T::n_filt + ff] = cast<data_T, res_T, typename CONFIG_T::mult_config>(acc[ff]);
+        }
+    }
+}
+
+}
+
+#endif
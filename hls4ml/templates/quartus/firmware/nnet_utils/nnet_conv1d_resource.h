@@ -0,0 +1,59 @@
+#ifndef NNET_CONV1D_RESOURCE_H_
+#define NNET_CONV1D_RESOURCE_H_
+
+#include "nnet_common.h"
+#include "nnet_dense.h"
+
+namespace nnet {
+
+template<class data_T, typename CONFIG_T>
+void im2col_1d_cl(
+    data_T data[CONFIG_T::in_width * CONFIG_T::n_chan],
+    data_T data_col[CONFIG_T::filt_width * CONFIG_T::n_chan],
+    const int col)
+{
+    KernelLoop:
+    #pragma unroll
+    for (int kernel_col = 0; kernel_col < CONFIG_T::filt_width; kernel_col++) {
+        int index_in = col * CONFIG_T::stride_width + kernel_col * CONFIG_T::dilation - CONFIG_T::pad_left;
+        ChannelLoop:
+        #pragma unroll
+        for (int channel = 0; channel < CONFIG_T::n_chan; channel++) {
+            if (index_in >= 0 && index_in < CONFIG_T::in_width) {
+                data_col[kernel_col * CONFIG_T::n_chan + channel] = data[index_in * CONFIG_T::n_chan + channel];
+            } else {
+                data_col[kernel_col * CONFIG_T::n_chan + channel] = 0;
+            }
+        }
+    }
+}
+
+// Every output pixel is a dense layer over its receptive field, the weights are transposed and padded
+// like the weights of a Dense layer (see QuartusBackend.gen_quartus_weight_array)
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_1d_resource_cl(
+    data_T data[CONFIG_T::in_width * CONFIG_T::n_chan],
+    res_T  res[CONFIG_T::out_width * CONFIG_T::n_filt],
+    const typename CONFIG_T::weight_t weights[CONFIG_T::mult_config::reuse_factor_rounded * CONFIG_T::mult_config::block_factor_rounded],
+    const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt])
+{
+    ColLoop:
+    #pragma nofusion
+    for (int i = 0; i < CONFIG_T::out_width; i++) {
+        hls_register data_T data_col[CONFIG_T::filt_width * CONFIG_T::n_chan];
+        hls_register res_T res_col[CONFIG_T::n_filt];
+
+        im2col_1d_cl<data_T, CONFIG_T>(data, data_col, i);
+        dense_resource<data_T, res_T, typename CONFIG_T::mult_config>(data_col, res_col, weights, biases);
+
+        FiltLoop:
+        #pragma unroll
+        for (int j = 0; j < CONFIG_T::n_filt; j++) {
+            res[i * CONFIG_T::n_filt + j] = res_col[j];
+        }
+    }
+}
+
+}
+
+#endif
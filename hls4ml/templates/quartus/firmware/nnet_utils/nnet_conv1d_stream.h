@@ -0,0 +1,51 @@
+#ifndef NNET_CONV1D_STREAM_H_
+#define NNET_CONV1D_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_types.h"
+#include "nnet_conv_stream.h"
+
+namespace nnet {
+
+// The last pixels of the input are kept in a line buffer, an output pixel is computed as soon as the last pixel of
+// its window is read. The padding is done by a ZeroPadding1D layer inserted before the convolution.
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void conv_1d_cl(
+    stream<data_T, data_D> &data,
+    stream<res_T, res_D>   &res,
+    const typename CONFIG_T::weight_t *weights,
+    const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt])
+{
+    static const unsigned eff_width = CONFIG_T::dilation * (CONFIG_T::filt_width - 1) + 1;
+
+    typename data_T::value_type line_buffer[eff_width][CONFIG_T::n_chan];
+
+    ReadInputWidth:
+    for (int w = 0; w < CONFIG_T::in_width; w++) {
+        data_T in_data = data.read();
+        #pragma unroll
+        for (int cc = 0; cc < CONFIG_T::n_chan; cc++) {
+            line_buffer[w % eff_width][cc] = in_data[cc];
+        }
+
+        int ow_offset = w - (int) (eff_width - 1);
+        if (ow_offset >= 0 && ow_offset % CONFIG_T::stride_width == 0) {
+            hls_register typename data_T::value_type window[CONFIG_T::kernel_size * CONFIG_T::n_chan];
+            #pragma unroll
+            for (int kw = 0; kw < CONFIG_T::filt_width; kw++) {
+                #pragma unroll
+                for (int cc = 0; cc < CONFIG_T::n_chan; cc++) {
+                    window[kw * CONFIG_T::n_chan + cc] = line_buffer[(ow_offset + kw * CONFIG_T::dilation) % eff_width][cc];
+                }
+            }
+
+            res_T out_data;
+            conv_window<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(window, out_data.data, weights, biases);
+            res.write(out_data);
+        }
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef NNET_CONV2D_LATENCY_H_
+#define NNET_CONV2D_LATENCY_H_
+
+#include "nnet_common.h"
+#include "nnet_mult.h"
+
+namespace nnet {
+
+// Fully unrolled, every product is cast to accum_t before it is accumulated, as the Vivado kernel does.
+// The weights are in the Keras order, [filt_height][filt_width][n_chan][n_filt].
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_2d_latency_cl(
+    data_T data[CONFIG_T::in_height * CONFIG_T::in_width * CONFIG_T::n_chan],
+    res_T  res[CONFIG_T::out_height * CONFIG_T::out_width * CONFIG_T::n_filt],
+    const typename CONFIG_T::weight_t weights[CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan * CONFIG_T::n_filt],
+    const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt])
+{
+    OutHeight:
+    #pragma unroll
+    for (int oh = 0; oh < CONFIG_T::out_height; oh++) {
+        OutWidth:
+        #pragma unroll
+        for (int ow = 0; ow < CONFIG_T::out_width; ow++) {
+            hls_register typename CONFIG_T::accum_t acc[CONFIG_T::n_filt];
+            InitAccum:
+            #pragma unroll
+            for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+                acc[ff] = (typename CONFIG_T::accum_t) biases[ff];
+            }
+
+            KernelHeight:
+            #pragma unroll
+            for (int fh = 0; fh < CONFIG_T::filt_height; fh++) {
+                int index_in_h = oh * CONFIG_T::stride_height + fh * CONFIG_T::dilation_height - CONFIG_T::pad_top;
+                if (index_in_h < 0 || index_in_h >= CONFIG_T::in_height) continue; // padded
+                KernelWidth:
+                #pragma unroll
+                for (int fw = 0; fw < CONFIG_T::filt_width; fw++) {
+                    int index_in_w = ow * CONFIG_T::stride_width + fw * CONFIG_T::dilation_width - CONFIG_T::pad_left;
+                    if (index_in_w < 0 || index_in_w >= CONFIG_T::in_width) continue; // padded
+                    int index_data = (index_in_h * CONFIG_T::in_width + index_in_w) * CONFIG_T::n_chan;
+                    ConvChan:
+                    #pragma unroll
+                    for (int cc = 0; cc < CONFIG_T::n_chan; cc++) {
+                        ConvFilt:
+                        #pragma unroll
+                        for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+                            int index_weight = ((fh * CONFIG_T::filt_width + fw) * CONFIG_T::n_chan + cc) * CONFIG_T::n_filt + ff;
+                            acc[ff] += (typename CONFIG_T::accum_t) CONFIG_T::mult_config::template product<data_T, typename CONFIG_T::weight_t>::product(
+                                data[index_data + cc], weights[index_weight]);
+                        }
+                    }
+                }
+            }
+
+            Result:
+            #pragma unroll
+            for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+                res[(oh * CONFIG_T::out_width + ow) * CONFIG_T::n_filt + ff] = cast<data_T, res_T, typename CONFIG_T::mult_config>(acc[ff]);
+            }
+        }
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef NNET_CONV2D_RESOURCE_H_
+#define NNET_CONV2D_RESOURCE_H_
+
+#include "nnet_common.h"
+#include "nnet_dense.h"
+
+namespace nnet {
+
+template<class data_T, typename CONFIG_T>
+void im2col_2d_cl(
+    data_T data[CONFIG_T::in_height * CONFIG_T::in_width * CONFIG_T::n_chan],
+    data_T data_col[CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan],
+    const int row,
+    const int col)
+{
+    KernelRowLoop:
+    #pragma unroll
+    for (int kernel_row = 0; kernel_row < CONFIG_T::filt_height; kernel_row++) {
+        int input_row = row * CONFIG_T::stride_height + kernel_row * CONFIG_T::dilation_height - CONFIG_T::pad_top;
+        KernelColLoop:
+        #pragma unroll
+        for (int kernel_col = 0; kernel_col < CONFIG_T::filt_width; kernel_col++) {
+            int input_col = col * CONFIG_T::stride_width + kernel_col * CONFIG_T::dilation_width - CONFIG_T::pad_left;
+            bool in_image = input_row >= 0 && input_row < CONFIG_T::in_height && input_col >= 0 && input_col < CONFIG_T::in_width;
+            ChannelLoop:
+            #pragma unroll
+            for (int channel = 0; channel < CONFIG_T::n_chan; channel++) {
+                int index = (kernel_row * CONFIG_T::filt_width + kernel_col) * CONFIG_T::n_chan + channel;
+                if (in_image) {
+                    data_col[index] = data[(input_row * CONFIG_T::in_width + input_col) * CONFIG_T::n_chan + channel];
+                } else {
+                    data_col[index] = 0;
+                }
+            }
+        }
+    }
+}
+
+// Every output pixel is a dense layer over its receptive field, the weights are transposed and padded
+// like the weights of a Dense layer (see QuartusBackend.gen_quartus_weight_array)
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_2d_resource_cl(
+    data_T data[CONFIG_T::in_height * CONFIG_T::in_width * CONFIG_T::n_chan],
+    res_T  res[CONFIG_T::out_height * CONFIG_T::out_width * CONFIG_T::n_filt],
+    const typename CONFIG_T::weight_t weights[CONFIG_T::mult_config::reuse_factor_rounded * CONFIG_T::mult_config::block_factor_rounded],
+    const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt])
+{
+    HeightLoop:
+    #pragma nofusion
+    for (int i = 0; i < CONFIG_T::out_height; i++) {
+        WidthLoop:
+        #pragma nofusion
+        for (int j = 0; j < CONFIG_T::out_width; j++) {
+            hls_register data_T data_col[CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan];
+            hls_register res_T res_col[CONFIG_T::n_filt];
+
+            im2col_2d_cl<data_T, CONFIG_T>(data, data_col, i, j);
+            dense_resource<data_T, res_T, typename CONFIG_T::mult_config>(data_col, res_col, weights, biases);
+
+            FiltLoop:
+            #pragma unroll
+            for (int k = 0; k < CONFIG_T::n_filt; k++) {
+                res[(i * CONFIG_T::out_width + j) * CONFIG_T::n_filt + k] = res_col[k];
+            }
+        }
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef NNET_CONV2D_STREAM_H_
+#define NNET_CONV2D_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_types.h"
+#include "nnet_conv_stream.h"
+
+namespace nnet {
+
+// The last rows of the input are kept in a line buffer, an output pixel is computed as soon as the bottom right pixel
+// of its window is read. The padding is done by a ZeroPadding2D layer inserted before the convolution.
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void conv_2d_cl(
+    stream<data_T, data_D> &data,
+    stream<res_T, res_D>   &res,
+    const typename CONFIG_T::weight_t *weights,
+    const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt])
+{
+    static const unsigned eff_height = CONFIG_T::dilation_height * (CONFIG_T::filt_height - 1) + 1;
+    static const unsigned eff_width = CONFIG_T::dilation_width * (CONFIG_T::filt_width - 1) + 1;
+
+    typename data_T::value_type line_buffer[eff_height][CONFIG_T::in_width][CONFIG_T::n_chan];
+
+    ReadInputHeight:
+    for (int h = 0; h < CONFIG_T::in_height; h++) {
+        ReadInputWidth:
+        for (int w = 0; w < CONFIG_T::in_width; w++) {
+            data_T in_data = data.read();
+            #pragma unroll
+            for (int cc = 0; cc < CONFIG_T::n_chan; cc++) {
+                line_buffer[h % eff_height][w][cc] = in_data[cc];
+            }
+
+            int oh_offset = h - (int) (eff_height - 1);
+            int ow_offset = w - (int) (eff_width - 1);
+            if (oh_offset >= 0 && ow_offset >= 0 && oh_offset % CONFIG_T::stride_height == 0 && ow_offset % CONFIG_T::stride_width == 0) {
+                hls_register typename data_T::value_type window[CONFIG_T::kernel_size * CONFIG_T::n_chan];
+                #pragma unroll
+                for (int kh = 0; kh < CONFIG_T::filt_height; kh++) {
+                    #pragma unroll
+                    for (int kw = 0; kw < CONFIG_T::filt_width; kw++) {
+                        #pragma unroll
+                        for (int cc = 0; cc < CONFIG_T::n_chan; cc++) {
+                            window[(kh * CONFIG_T::filt_width + kw) * CONFIG_T::n_chan + cc] =
+                                line_buffer[(oh_offset + kh * CONFIG_T::dilation_height) % eff_height][ow_offset + kw * CONFIG_T::dilation_width][cc];
+                        }
+                    }
+                }
+
+                res_T out_data;
+                conv_window<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(window, out_data.data, weights, biases);
+                res.write(out_data);
+            }
+        }
+    }
+}
+
+}
+
+#endif
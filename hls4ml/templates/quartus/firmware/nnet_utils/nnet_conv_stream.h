@@ -0,0 +1,50 @@
+#ifndef NNET_CONV_STREAM_H_
+#define NNET_CONV_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_types.h"
+#include "nnet_mult.h"
+#include "nnet_dense.h"
+
+namespace nnet {
+
+// Computes the output pixel of a receptive field (the window) in io_stream, in the same order as the io_parallel
+// kernels, so the results are identical. The window is laid out as [filt_height][filt_width][n_chan].
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_window(
+    data_T window[CONFIG_T::kernel_size * CONFIG_T::n_chan],
+    res_T  res[CONFIG_T::n_filt],
+    const typename CONFIG_T::weight_t *weights,
+    const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt])
+{
+    if (CONFIG_T::strategy == nnet::latency) {
+        hls_register typename CONFIG_T::accum_t acc[CONFIG_T::n_filt];
+        InitAccum:
+        #pragma unroll
+        for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+            acc[ff] = (typename CONFIG_T::accum_t) biases[ff];
+        }
+
+        WindowMult:
+        #pragma unroll
+        for (int ii = 0; ii < CONFIG_T::kernel_size * CONFIG_T::n_chan; ii++) {
+            #pragma unroll
+            for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+                acc[ff] += (typename CONFIG_T::accum_t) CONFIG_T::mult_config::template product<data_T, typename CONFIG_T::weight_t>::product(
+                    window[ii], weights[ii * CONFIG_T::n_filt + ff]);
+            }
+        }
+
+        Result:
+        #pragma unroll
+        for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+            res[ff] = cast<data_T, res_T, typename CONFIG_T::mult_config>(acc[ff]);
+        }
+    } else {
+        dense_resource<data_T, res_T, typename CONFIG_T::mult_config>(window, res, weights, biases);
+    }
+}
+
+}
+
+#endif
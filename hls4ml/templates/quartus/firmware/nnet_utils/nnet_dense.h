@@ -23,6 +23,7 @@
 #include "nnet_common.h"
 #include "nnet_helpers.h"
 #include "nnet_mult.h"
+#include "nnet_native_fixed.h"
 
 namespace nnet {
 
@@ -57,6 +58,125 @@ struct dense_config
     using product = nnet::product::mult<x_T, y_T>;
 };
 
+// Output and input of the product (ir, im) in dense_rf_gt. The kernel only evaluates them at ir = 0, at compile time,
+// and advances them with counters across the iterations of ir
+template<typename CONFIG_T>
+constexpr unsigned dense_rf_gt_out_index(unsigned ir, unsigned im) {
+    return (ir + CONFIG_T::reuse_factor * im) / CONFIG_T::multiplier_factor;
+}
+
+template<typename CONFIG_T>
+constexpr unsigned dense_rf_gt_data_index(unsigned ir, unsigned im) {
+    return (ir + CONFIG_T::reuse_factor * im) % CONFIG_T::n_in;
+}
+
+// The C simulation runs the dense kernels on native integers when the product is the plain multiplication
+// and the data, weights and accumulator fit, the aligned product of data and weight included
+template<class data_T, typename CONFIG_T>
+struct dense_native {
+    typedef native_fixed<data_T> native_data;
+    typedef native_fixed<typename CONFIG_T::weight_t> native_weight;
+    typedef native_fixed<typename CONFIG_T::accum_t> native_accum;
+
+    static const int product_frac = native_data::frac + native_weight::frac;
+
+    static const bool value =
+#ifndef __INTELFPGA_COMPILER__
+        std::is_same<typename CONFIG_T::template product<data_T, typename CONFIG_T::weight_t>,
+                     product::mult<data_T, typename CONFIG_T::weight_t>>::value
+        && native_data::enabled && native_weight::enabled && native_accum::enabled
+        && native_data::width + native_weight::width
+            + (native_accum::frac > product_frac ? native_accum::frac - product_frac : 0) <= 62;
+#else
+        false;
+#endif
+};
+
+// Same loops as dense_rf_gt and dense_rf_lt below, each assignment to accum_t rounds and overflows as accum_t would
+template<class data_T, class res_T, typename CONFIG_T>
+void dense_rf_gt_native(
+   data_T    data[CONFIG_T::n_in],
+   res_T     res[CONFIG_T::n_out],
+   const typename CONFIG_T::weight_t  weights[CONFIG_T::reuse_factor_rounded*CONFIG_T::block_factor_rounded],
+   const typename CONFIG_T::bias_t    biases[CONFIG_T::n_out]
+   )
+{
+   typedef typename CONFIG_T::accum_t accum_t;
+   typedef dense_native<data_T, CONFIG_T> native;
+
+   long long data_raw[CONFIG_T::n_in];
+   for (unsigned i = 0; i < CONFIG_T::n_in; i++) {
+       data_raw[i] = native::native_data::to_raw(data[i]);
+   }
+   long long acc[CONFIG_T::n_out];
+   for (unsigned iacc = 0; iacc < CONFIG_T::n_out; iacc++) {
+       acc[iacc] = native::native_accum::to_raw((accum_t) biases[iacc]);
+   }
+   for (unsigned ir = 0; ir < CONFIG_T::reuse_factor; ir++) {
+      long long tmp_acc[CONFIG_T::block_factor];
+      for (unsigned im = 0; im < CONFIG_T::block_factor; im++) {
+          unsigned w_index = ir + (CONFIG_T::reuse_factor_rounded) * im;
+          if (w_index >= CONFIG_T::reuse_factor_rounded*CONFIG_T::block_factor_rounded) continue;
+          long long product = data_raw[dense_rf_gt_data_index<CONFIG_T>(ir, im)] * native::native_weight::to_raw(weights[w_index]);
+          tmp_acc[im] = native_assign<accum_t>(product, native::product_frac);
+      }
+      long long mult[CONFIG_T::multiplier_limit] = {0};
+      for (unsigned im = 0; im < CONFIG_T::block_factor; im++) {
+          unsigned o_index = dense_rf_gt_out_index<CONFIG_T>(ir, im);
+          if (o_index >= CONFIG_T::n_out) continue;
+          mult[o_index] = native_assign<accum_t>(mult[o_index] + tmp_acc[im], native::native_accum::frac);
+      }
+      for (unsigned im = 0; im < CONFIG_T::multiplier_limit; im++) {
+          acc[im] = native_assign<accum_t>(acc[im] + mult[im], native::native_accum::frac);
+      }
+   }
+   for (unsigned ires = 0; ires < CONFIG_T::n_out; ires++) {
+     res[ires] = cast<data_T, res_T, CONFIG_T>(native::native_accum::from_raw(acc[ires]));
+   }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void dense_rf_lt_native(
+  data_T    data[CONFIG_T::n_in],
+  res_T     res[CONFIG_T::n_out],
+  const typename CONFIG_T::weight_t  weights[CONFIG_T::reuse_factor_rounded*CONFIG_T::block_factor_rounded],
+  const typename CONFIG_T::bias_t    biases[CONFIG_T::n_out]
+  )
+{
+    typedef typename CONFIG_T::accum_t accum_t;
+    typedef dense_native<data_T, CONFIG_T> native;
+
+    long long data_raw[CONFIG_T::n_in];
+    for (unsigned i = 0; i < CONFIG_T::n_in; i++) {
+        data_raw[i] = native::native_data::to_raw(data[i]);
+    }
+    long long acc[CONFIG_T::n_out];
+    for (unsigned iacc = 0; iacc < CONFIG_T::n_out; iacc++) {
+        acc[iacc] = native::native_accum::to_raw((accum_t) biases[iacc]);
+    }
+    for (unsigned ir = 0; ir < CONFIG_T::reuse_factor; ir++) {
+       for (unsigned im = 0, in_index = ir, out_index = 0, acc_step = 0; im < CONFIG_T::block_factor; im++) {
+            if (ir + CONFIG_T::reuse_factor * im < CONFIG_T::n_in*CONFIG_T::n_out) {
+                unsigned w_index = ir + (CONFIG_T::reuse_factor_rounded) * im;
+                long long product = data_raw[in_index] * native::native_weight::to_raw(weights[w_index]);
+                long long mult = native_assign<accum_t>(product, native::product_frac);
+                acc[out_index] = native_assign<accum_t>(acc[out_index] + mult, native::native_accum::frac);
+                in_index += CONFIG_T::reuse_factor;
+                if (in_index >= CONFIG_T::n_in) in_index = ir;
+            }
+            if (acc_step + 1 >= CONFIG_T::multiplier_scale) {
+                acc_step = 0;
+                out_index++;
+            } else {
+                acc_step++;
+            }
+       }
+    }
+    for (unsigned ires = 0; ires < CONFIG_T::n_out; ires++) {
+        res[ires] = cast<data_T, res_T, CONFIG_T>(native::native_accum::from_raw(acc[ires]));
+    }
+}
+
 template<class data_T, class res_T, typename CONFIG_T>
 void dense_rf_gt(
    data_T    data[CONFIG_T::n_in],
@@ -74,17 +194,16 @@ void dense_rf_gt(
    for(int iacc = 0; iacc < CONFIG_T::n_out; iacc++) {
        acc[iacc] = (typename CONFIG_T::accum_t) biases[iacc];
    }
-   hls_register int out_index[CONFIG_T::reuse_factor][CONFIG_T::block_factor];
-   hls_register int d_index[CONFIG_T::reuse_factor][CONFIG_T::block_factor];
-
+   // Input, output and position within the output of the product of each lane, without division in the rolled loop
+   hls_register unsigned in_index[CONFIG_T::block_factor];
+   hls_register unsigned out_index[CONFIG_T::block_factor];
+   hls_register unsigned out_step[CONFIG_T::block_factor];
+   InitIndex:
    #pragma unroll
-   for(int ir = 0; ir < CONFIG_T::reuse_factor; ir++) {
-       #pragma unroll
-       for(int im = 0; im < CONFIG_T::block_factor ; im++) {
-         uint32 w_index = ir + CONFIG_T::reuse_factor * im;
-         out_index[ir][im] = (w_index / CONFIG_T::multiplier_factor).to_int();
-         d_index[ir][im] = w_index % CONFIG_T::n_in;
-       }
+   for(int im = 0; im < CONFIG_T::block_factor; im++) {
+       in_index[im] = dense_rf_gt_data_index<CONFIG_T>(0, im);
+       out_index[im] = dense_rf_gt_out_index<CONFIG_T>(0, im);
+       out_step[im] = (CONFIG_T::reuse_factor * im) % CONFIG_T::multiplier_factor;
    }
    Product1:
    #pragma nofusion
@@ -94,11 +213,9 @@ void dense_rf_gt(
       Product2:
       #pragma unroll
       for(int im = 0; im < CONFIG_T::block_factor ; im++) {
-          uint32 w_index = ir + (CONFIG_T::reuse_factor_rounded) * im;
+          unsigned w_index = ir + (CONFIG_T::reuse_factor_rounded) * im;
           if (w_index >= CONFIG_T::reuse_factor_rounded*CONFIG_T::block_factor_rounded) continue;
-          int data_index = d_index[ir][im];
-          // Modified this
-          tmp_acc[im] = CONFIG_T::template product<data_T, typename CONFIG_T::weight_t>::product(data[data_index], weights[w_index]);
+          tmp_acc[im] = CONFIG_T::template product<data_T, typename CONFIG_T::weight_t>::product(data[in_index[im]], weights[w_index]);
       }
       hls_register typename CONFIG_T::accum_t mult[CONFIG_T::multiplier_limit];
       ResetMult:
@@ -109,7 +226,7 @@ void dense_rf_gt(
       AccumLoop1:
       #pragma unroll
       for(int im = 0; im < CONFIG_T::block_factor ; im++) {
-          int o_index = out_index[ir][im];
+          unsigned o_index = out_index[im];
           if (o_index >= CONFIG_T::n_out) continue; // check out of bounds
           mult[o_index] += tmp_acc[im];
       }
@@ -118,6 +235,15 @@ void dense_rf_gt(
       for (int im = 0; im < CONFIG_T::multiplier_limit; im++) {
           acc[im] += mult[im];
       }
+      NextIndex:
+      #pragma unroll
+      for(int im = 0; im < CONFIG_T::block_factor; im++) {
+          if (++in_index[im] >= CONFIG_T::n_in) in_index[im] = 0;
+          if (++out_step[im] >= CONFIG_T::multiplier_factor) {
+              out_step[im] = 0;
+              out_index[im]++;
+          }
+      }
    }
    Store:
    #pragma unroll
@@ -150,7 +276,7 @@ void dense_rf_lt(
        MultLoop:
        #pragma unroll
        for (int im = 0, in_index = ir; im < CONFIG_T::block_factor; im++) {
-            uint32 w_index = ir + (CONFIG_T::reuse_factor_rounded) * im;
+            unsigned w_index = ir + (CONFIG_T::reuse_factor_rounded) * im;
             if (ir + CONFIG_T::reuse_factor * im >= CONFIG_T::n_in*CONFIG_T::n_out) continue;
             // Modified this
             mult[im] = CONFIG_T::template product<data_T, typename CONFIG_T::weight_t>::product(data[in_index], weights[w_index]);
@@ -176,6 +302,32 @@ void dense_rf_lt(
         res[ires] = cast<data_T, res_T, CONFIG_T>(acc[ires]);
     }
 }
+// Only instantiates the native kernels for the types they support
+template<class data_T, class res_T, typename CONFIG_T>
+void dense_resource_native(
+   data_T    data[CONFIG_T::n_in],
+   res_T     res[CONFIG_T::n_out],
+   const typename CONFIG_T::weight_t  weights[CONFIG_T::reuse_factor_rounded*CONFIG_T::block_factor_rounded],
+   const typename CONFIG_T::bias_t    biases[CONFIG_T::n_out],
+   std::true_type
+   )
+{
+    if (CONFIG_T::reuse_factor <= CONFIG_T::n_in) {
+        dense_rf_lt_native<data_T, res_T, CONFIG_T>(data, res, weights, biases);
+    } else {
+        dense_rf_gt_native<data_T, res_T, CONFIG_T>(data, res, weights, biases);
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void dense_resource_native(
+   data_T    data[CONFIG_T::n_in],
+   res_T     res[CONFIG_T::n_out],
+   const typename CONFIG_T::weight_t  weights[CONFIG_T::reuse_factor_rounded*CONFIG_T::block_factor_rounded],
+   const typename CONFIG_T::bias_t    biases[CONFIG_T::n_out],
+   std::false_type
+   ) {}
+
 template<class data_T, class res_T, typename CONFIG_T>
 void dense_resource(
    data_T    data[CONFIG_T::n_in],
@@ -184,7 +336,9 @@ void dense_resource(
    const typename CONFIG_T::bias_t    biases[CONFIG_T::n_out]
    )
 {
-    if (CONFIG_T::reuse_factor <= CONFIG_T::n_in) {
+    if (dense_native<data_T, CONFIG_T>::value) {
+        dense_resource_native<data_T, res_T, CONFIG_T>(data, res, weights, biases, std::integral_constant<bool, dense_native<data_T, CONFIG_T>::value>());
+    } else if (CONFIG_T::reuse_factor <= CONFIG_T::n_in) {
         dense_rf_lt<data_T, res_T, CONFIG_T>(data, res, weights, biases);
     } else {
         dense_rf_gt<data_T, res_T, CONFIG_T>(data, res, weights, biases);
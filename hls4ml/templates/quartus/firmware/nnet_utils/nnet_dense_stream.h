@@ -0,0 +1,45 @@
+#ifndef NNET_DENSE_STREAM_H_
+#define NNET_DENSE_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_types.h"
+#include "nnet_stream.h"
+#include "nnet_dense.h"
+#include "nnet_dense_compressed.h"
+
+namespace nnet {
+
+// The whole input vector is gathered from its packets, multiplied as in io_parallel and written out packet by packet
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void dense_resource(
+    stream<data_T, data_D> &data_stream,
+    stream<res_T, res_D>   &res_stream,
+    const typename CONFIG_T::weight_t  weights[CONFIG_T::reuse_factor_rounded*CONFIG_T::block_factor_rounded],
+    const typename CONFIG_T::bias_t    biases[CONFIG_T::n_out])
+{
+    hls_register typename data_T::value_type data[CONFIG_T::n_in];
+    hls_register typename res_T::value_type res[CONFIG_T::n_out];
+
+    read_packets<data_T, CONFIG_T::n_in>(data_stream, data);
+    dense_resource<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(data, res, weights, biases);
+    write_packets<res_T, CONFIG_T::n_out>(res, res_stream);
+}
+
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void dense_compressed(
+    stream<data_T, data_D> &data_stream,
+    stream<res_T, res_D>   &res_stream,
+    const typename CONFIG_T::weight_t  weights[CONFIG_T::n_nonzeros],
+    const typename CONFIG_T::bias_t    biases[CONFIG_T::n_out])
+{
+    hls_register typename data_T::value_type data[CONFIG_T::n_in];
+    hls_register typename res_T::value_type res[CONFIG_T::n_out];
+
+    read_packets<data_T, CONFIG_T::n_in>(data_stream, data);
+    dense_compressed<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(data, res, weights, biases);
+    write_packets<res_T, CONFIG_T::n_out>(res, res_stream);
+}
+
+}
+
+#endif
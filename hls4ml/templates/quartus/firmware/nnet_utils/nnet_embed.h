@@ -3,6 +3,8 @@
 
 #include "nnet_common.h"
 #include "nnet_helpers.h"
+#include <cstring>
+#include <type_traits>
 
 namespace nnet {
 
@@ -15,11 +17,39 @@ namespace nnet {
         static const unsigned n_out = 16;
         static const unsigned vocab_size = 50;
 
+        // The table is replicated by the compiler, the number of copies and their
+        // implementation are set by the memory attributes of the weights
+        static const unsigned n_banks = 1;
+        static const unsigned table_impl = mem_auto;
+
         // Resource reuse info
         static const unsigned io_type = io_parallel;
         static const unsigned reuse_factor = 1;
     };
 
+    template<class res_T, typename CONFIG_T>
+    void embedding_lookup(
+        unsigned index,
+        res_T res[CONFIG_T::n_out],
+        const typename CONFIG_T::embeddings_t embeddings[CONFIG_T::vocab_size * CONFIG_T::n_out]) {
+
+        const typename CONFIG_T::embeddings_t *row = &embeddings[index * CONFIG_T::n_out];
+
+        #ifndef __INTELFPGA_COMPILER__
+        // In C simulation the row is copied directly when the table and the result have the same type
+        if (std::is_same<typename CONFIG_T::embeddings_t, res_T>::value) {
+            std::memcpy((void *) res, (const void *) row, CONFIG_T::n_out * sizeof(res_T));
+            return;
+        }
+        #endif
+
+        DenseEmbedding:
+        #pragma unroll
+        for (int i = 0; i < CONFIG_T::n_out; i++) {
+            res[i] = row[i];
+        }
+    }
+
     template<class data_T, class res_T, typename CONFIG_T>
     void embedding(
         data_T data[CONFIG_T::n_in],
@@ -35,11 +65,7 @@ namespace nnet {
         #pragma ii CONFIG_T::reuse_factor 
         #pragma unroll
         for (int j = 0; j < CONFIG_T::n_in; j++) {
-            DenseEmbedding: 
-            #pragma unroll
-            for (int i = 0; i < CONFIG_T::n_out; i++) {
-                res[j * CONFIG_T::n_out + i] = embeddings[data[j].to_uint() * CONFIG_T::n_out + i];
-            }
+            embedding_lookup<res_T, CONFIG_T>(data[j].to_uint(), &res[j * CONFIG_T::n_out], embeddings);
         }
     }
 
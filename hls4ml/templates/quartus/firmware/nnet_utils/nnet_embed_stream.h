@@ -1,10 +1,31 @@
-/*
-*   PLACEHOLDER - The common pass embedding.py includes both parallel and streaming implementations; streaming is currently not supported in Quartus
-*/
-
 #ifndef NNET_EMBED_STREAM_H_
 #define NNET_EMBED_STREAM_H_
 
-namespace nnet {}
+#include "nnet_common.h"
+#include "nnet_helpers.h"
+#include "nnet_types.h"
+#include "nnet_embed.h"
+
+namespace nnet {
+
+    // The indices arrive in a single packet, every looked up row is written as a packet of n_out elements
+    template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+    void embedding(
+        stream<data_T, data_D> &data,
+        stream<res_T, res_D>   &res,
+        const typename CONFIG_T::embeddings_t embeddings[CONFIG_T::vocab_size * CONFIG_T::n_out]) {
+
+        data_T in_data = data.read();
+
+        InputSequence:
+        #pragma ii CONFIG_T::reuse_factor
+        for (int j = 0; j < data_T::size; j++) {
+            res_T out_data;
+            embedding_lookup<typename res_T::value_type, CONFIG_T>(in_data[j].to_uint(), out_data.data, embeddings);
+            res.write(out_data);
+        }
+    }
+
+}
 
 #endif
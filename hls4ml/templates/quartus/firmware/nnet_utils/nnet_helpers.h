@@ -26,6 +26,7 @@
 #include <fstream>
 #include <algorithm>
 #include <map>
+#include "nnet_types.h"
 
 namespace nnet {
 
@@ -41,6 +42,26 @@ void convert_data_back(srcType *src, dstType *dst) {
     dst[i] = static_cast<dstType>(src[i].to_double());
   }
 }
+
+template<class srcType, class dstType, size_t SIZE>
+void convert_data(srcType *src, stream_in<dstType> &dst) {
+  for (size_t i = 0; i < SIZE / dstType::size; i++) {
+    dstType ctype;
+    for (size_t j = 0; j < dstType::size; j++) {
+      ctype[j] = typename dstType::value_type(src[i * dstType::size + j]);
+    }
+    dst.write(ctype);
+  }
+}
+template<class srcType, class dstType, size_t SIZE>
+void convert_data_back(stream_out<srcType> &src, dstType *dst) {
+  for (size_t i = 0; i < SIZE / srcType::size; i++) {
+    srcType ctype = src.read();
+    for (size_t j = 0; j < srcType::size; j++) {
+      dst[i * srcType::size + j] = static_cast<dstType>(ctype[j].to_double());
+    }
+  }
+}
 extern bool trace_enabled;
 extern std::map<std::string, void *> *trace_outputs;
 extern size_t trace_type_size;
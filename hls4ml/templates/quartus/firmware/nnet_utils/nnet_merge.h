@@ -0,0 +1,360 @@
+//
+//    rfnoc-hls-neuralnet: Vivado HLS code for neural-net building blocks
+//
+//    Copyright (C) 2017 EJ Kreinar
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef NNET_MERGE_H_
+#define NNET_MERGE_H_
+
+#include "nnet_common.h"
+#include "nnet_mult.h"
+
+namespace nnet {
+
+struct merge_config
+{
+    static const unsigned n_elem = 10;
+    static const unsigned n_inputs = 2;
+    typedef float accum_t; // Used by the N-input merges
+};
+
+struct dot_config {
+    static const unsigned n_in = 10;
+    static const unsigned n_out = 1;
+    static const unsigned reuse_factor = 1;
+    typedef float accum_t;
+    // Product function to use
+    template<class x_T, class y_T>
+    using product = nnet::product::mult<x_T, y_T>;
+};
+
+struct concat_config {
+    static const unsigned n_elem1_0 = 10;
+    static const unsigned n_elem1_1 = 10;
+    static const unsigned n_elem1_2 = 10;
+    static const unsigned n_elem2_0 = 10;
+    static const unsigned n_elem2_1 = 10;
+    static const unsigned n_elem2_2 = 10;
+
+    static const unsigned axis = -1;
+};
+
+struct concat_n_config {
+    static const unsigned n_inputs = 3;
+    static const unsigned n_outer = 1;     // Product of the dimensions before the concatenation axis
+    static const unsigned n_inner = 1;     // Product of the dimensions after the concatenation axis
+    static const unsigned n_axis_out = 30; // Size of the output along the concatenation axis
+    // Size of every input along the concatenation axis and its offset in the output, constexpr so that the
+    // parameters can be included by several translation units
+    // static constexpr unsigned n_axis[n_inputs], axis_offset[n_inputs];
+};
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T>
+void add(
+    input1_T data1[CONFIG_T::n_elem],
+    input2_T data2[CONFIG_T::n_elem],
+    res_T res[CONFIG_T::n_elem])
+{
+    #pragma unroll
+    for (int ii = 0; ii < CONFIG_T::n_elem; ii++) {
+        res[ii] = data1[ii] + data2[ii];
+    }
+}
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T>
+void subtract(
+    input1_T data1[CONFIG_T::n_elem],
+    input2_T data2[CONFIG_T::n_elem],
+    res_T res[CONFIG_T::n_elem])
+{
+    #pragma unroll
+    for (int ii = 0; ii < CONFIG_T::n_elem; ii++) {
+        res[ii] = data1[ii] - data2[ii];
+    }
+}
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T>
+void multiply(
+    input1_T data1[CONFIG_T::n_elem],
+    input2_T data2[CONFIG_T::n_elem],
+    res_T res[CONFIG_T::n_elem])
+{
+    #pragma unroll
+    for (int ii = 0; ii < CONFIG_T::n_elem; ii++) {
+        res[ii] = data1[ii] * data2[ii];
+    }
+}
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T>
+void average(
+    input1_T data1[CONFIG_T::n_elem],
+    input2_T data2[CONFIG_T::n_elem],
+    res_T res[CONFIG_T::n_elem])
+{
+    #pragma unroll
+    for (int ii = 0; ii < CONFIG_T::n_elem; ii++) {
+        res[ii] = (data1[ii] + data2[ii]) / (res_T) 2;
+    }
+}
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T>
+void maximum(
+    input1_T data1[CONFIG_T::n_elem],
+    input2_T data2[CONFIG_T::n_elem],
+    res_T res[CONFIG_T::n_elem])
+{
+    #pragma unroll
+    for (int ii = 0; ii < CONFIG_T::n_elem; ii++) {
+        res[ii] = (data1[ii] > data2[ii]) ? static_cast<res_T>(data1[ii]) : static_cast<res_T>(data2[ii]);
+    }
+}
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T>
+void minimum(
+    input1_T data1[CONFIG_T::n_elem],
+    input2_T data2[CONFIG_T::n_elem],
+    res_T res[CONFIG_T::n_elem])
+{
+    #pragma unroll
+    for (int ii = 0; ii < CONFIG_T::n_elem; ii++) {
+        res[ii] = (data1[ii] < data2[ii]) ? static_cast<res_T>(data1[ii]) : static_cast<res_T>(data2[ii]);
+    }
+}
+
+// N-input merges fold the inputs one by one into an accumulator of type CONFIG_T::accum_t, so a merge of any
+// number of inputs is a single layer instead of a chain of two-input merges
+namespace merge_op {
+
+struct add {
+    template<class acc_T, class x_T>
+    static acc_T apply(acc_T acc, x_T x) { return acc + x; }
+    template<class CONFIG_T, class acc_T>
+    static acc_T finish(acc_T acc) { return acc; }
+};
+
+struct multiply {
+    template<class acc_T, class x_T>
+    static acc_T apply(acc_T acc, x_T x) { return acc * x; }
+    template<class CONFIG_T, class acc_T>
+    static acc_T finish(acc_T acc) { return acc; }
+};
+
+struct average {
+    template<class acc_T, class x_T>
+    static acc_T apply(acc_T acc, x_T x) { return acc + x; }
+    template<class CONFIG_T, class acc_T>
+    static acc_T finish(acc_T acc) { return acc / (acc_T) CONFIG_T::n_inputs; }
+};
+
+struct maximum {
+    template<class acc_T, class x_T>
+    static acc_T apply(acc_T acc, x_T x) { return (x > acc) ? (acc_T) x : acc; }
+    template<class CONFIG_T, class acc_T>
+    static acc_T finish(acc_T acc) { return acc; }
+};
+
+struct minimum {
+    template<class acc_T, class x_T>
+    static acc_T apply(acc_T acc, x_T x) { return (x < acc) ? (acc_T) x : acc; }
+    template<class CONFIG_T, class acc_T>
+    static acc_T finish(acc_T acc) { return acc; }
+};
+
+}
+
+template<class OP, typename CONFIG_T>
+void merge_n_fold(typename CONFIG_T::accum_t acc[]) {}
+
+template<class OP, typename CONFIG_T, class input_T, class... rest_T>
+void merge_n_fold(
+    typename CONFIG_T::accum_t acc[CONFIG_T::n_elem],
+    input_T data[CONFIG_T::n_elem],
+    rest_T... rest)
+{
+    #pragma unroll
+    for (int ii = 0; ii < CONFIG_T::n_elem; ii++) {
+        acc[ii] = OP::apply(acc[ii], data[ii]);
+    }
+    merge_n_fold<OP, CONFIG_T>(acc, rest...);
+}
+
+template<class OP, class res_T, typename CONFIG_T, class input_T, class... rest_T>
+void merge_n(
+    res_T res[CONFIG_T::n_elem],
+    input_T data[CONFIG_T::n_elem],
+    rest_T... rest)
+{
+    hls_register typename CONFIG_T::accum_t acc[CONFIG_T::n_elem];
+
+    #pragma unroll
+    for (int ii = 0; ii < CONFIG_T::n_elem; ii++) {
+        acc[ii] = data[ii];
+    }
+    merge_n_fold<OP, CONFIG_T>(acc, rest...);
+    #pragma unroll
+    for (int ii = 0; ii < CONFIG_T::n_elem; ii++) {
+        res[ii] = OP::template finish<CONFIG_T>(acc[ii]);
+    }
+}
+
+template<class res_T, typename CONFIG_T, class... input_T>
+void add_n(res_T res[CONFIG_T::n_elem], input_T... data) {
+    merge_n<merge_op::add, res_T, CONFIG_T>(res, data...);
+}
+
+template<class res_T, typename CONFIG_T, class... input_T>
+void multiply_n(res_T res[CONFIG_T::n_elem], input_T... data) {
+    merge_n<merge_op::multiply, res_T, CONFIG_T>(res, data...);
+}
+
+template<class res_T, typename CONFIG_T, class... input_T>
+void average_n(res_T res[CONFIG_T::n_elem], input_T... data) {
+    merge_n<merge_op::average, res_T, CONFIG_T>(res, data...);
+}
+
+template<class res_T, typename CONFIG_T, class... input_T>
+void maximum_n(res_T res[CONFIG_T::n_elem], input_T... data) {
+    merge_n<merge_op::maximum, res_T, CONFIG_T>(res, data...);
+}
+
+template<class res_T, typename CONFIG_T, class... input_T>
+void minimum_n(res_T res[CONFIG_T::n_elem], input_T... data) {
+    merge_n<merge_op::minimum, res_T, CONFIG_T>(res, data...);
+}
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T>
+void dot1d(
+    input1_T data1[CONFIG_T::n_in],
+    input2_T data2[CONFIG_T::n_in],
+    res_T res[CONFIG_T::n_out])
+{
+    hls_register typename CONFIG_T::accum_t mult[CONFIG_T::n_in];
+    Product:
+    #pragma unroll
+    for (int i_mult = 0; i_mult < CONFIG_T::n_in; i_mult++) {
+        mult[i_mult] = CONFIG_T::template product<input1_T, input2_T>::product(data1[i_mult], data2[i_mult]);
+    }
+
+    hls_register typename CONFIG_T::accum_t acc = 0;
+    Accum:
+    #pragma unroll
+    for (int i_acc = 0; i_acc < CONFIG_T::n_in; i_acc++) {
+        acc += mult[i_acc];
+    }
+
+    res[0] = cast<input1_T, res_T, CONFIG_T>(acc);
+}
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T>
+void concatenate1d(
+    input1_T data1[CONFIG_T::n_elem1_0],
+    input2_T data2[CONFIG_T::n_elem2_0],
+    res_T res[CONFIG_T::n_elem1_0 + CONFIG_T::n_elem2_0])
+{
+    #pragma unroll
+    for (int ii = 0; ii < CONFIG_T::n_elem1_0; ii++) {
+        res[ii] = data1[ii];
+    }
+    #pragma unroll
+    for (int ii = 0; ii < CONFIG_T::n_elem2_0; ii++) {
+        res[CONFIG_T::n_elem1_0 + ii] = data2[ii];
+    }
+}
+
+// Concatenation along axis A of the two inputs is the interleaving of their slices of
+// n_elem1_A * ... and n_elem2_A * ... elements, once for each index of the dimensions before A
+template<class input1_T, class input2_T, class res_T, unsigned N_OUTER, unsigned N_SLICE1, unsigned N_SLICE2>
+void concatenate_slices(
+    input1_T data1[N_OUTER * N_SLICE1],
+    input2_T data2[N_OUTER * N_SLICE2],
+    res_T res[N_OUTER * (N_SLICE1 + N_SLICE2)])
+{
+    #pragma unroll
+    for (int ii = 0; ii < N_OUTER; ii++) {
+        #pragma unroll
+        for (int jj = 0; jj < N_SLICE1; jj++) {
+            res[ii * (N_SLICE1 + N_SLICE2) + jj] = data1[ii * N_SLICE1 + jj];
+        }
+        #pragma unroll
+        for (int jj = 0; jj < N_SLICE2; jj++) {
+            res[ii * (N_SLICE1 + N_SLICE2) + N_SLICE1 + jj] = data2[ii * N_SLICE2 + jj];
+        }
+    }
+}
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T>
+void concatenate2d(
+    input1_T data1[CONFIG_T::n_elem1_0 * CONFIG_T::n_elem1_1],
+    input2_T data2[CONFIG_T::n_elem2_0 * CONFIG_T::n_elem2_1],
+    res_T res[CONFIG_T::n_elem1_0 * CONFIG_T::n_elem1_1 + CONFIG_T::n_elem2_0 * CONFIG_T::n_elem2_1])
+{
+    if (CONFIG_T::axis == 2 || CONFIG_T::axis == -1) {
+        concatenate_slices<input1_T, input2_T, res_T, CONFIG_T::n_elem1_0, CONFIG_T::n_elem1_1, CONFIG_T::n_elem2_1>(data1, data2, res);
+    } else {
+        concatenate_slices<input1_T, input2_T, res_T, 1, CONFIG_T::n_elem1_0 * CONFIG_T::n_elem1_1, CONFIG_T::n_elem2_0 * CONFIG_T::n_elem2_1>(data1, data2, res);
+    }
+}
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T>
+void concatenate3d(
+    input1_T data1[CONFIG_T::n_elem1_0 * CONFIG_T::n_elem1_1 * CONFIG_T::n_elem1_2],
+    input2_T data2[CONFIG_T::n_elem2_0 * CONFIG_T::n_elem2_1 * CONFIG_T::n_elem2_2],
+    res_T res[CONFIG_T::n_elem1_0 * CONFIG_T::n_elem1_1 * CONFIG_T::n_elem1_2 + CONFIG_T::n_elem2_0 * CONFIG_T::n_elem2_1 * CONFIG_T::n_elem2_2])
+{
+    if (CONFIG_T::axis == 3 || CONFIG_T::axis == -1) {
+        concatenate_slices<input1_T, input2_T, res_T, CONFIG_T::n_elem1_0 * CONFIG_T::n_elem1_1,
+            CONFIG_T::n_elem1_2, CONFIG_T::n_elem2_2>(data1, data2, res);
+    } else if (CONFIG_T::axis == 2 || CONFIG_T::axis == -2) {
+        concatenate_slices<input1_T, input2_T, res_T, CONFIG_T::n_elem1_0,
+            CONFIG_T::n_elem1_1 * CONFIG_T::n_elem1_2, CONFIG_T::n_elem2_1 * CONFIG_T::n_elem2_2>(data1, data2, res);
+    } else {
+        concatenate_slices<input1_T, input2_T, res_T, 1,
+            CONFIG_T::n_elem1_0 * CONFIG_T::n_elem1_1 * CONFIG_T::n_elem1_2, CONFIG_T::n_elem2_0 * CONFIG_T::n_elem2_1 * CONFIG_T::n_elem2_2>(data1, data2, res);
+    }
+}
+
+// Concatenation of any number of inputs along any axis, input I fills the slice
+// [axis_offset[I], axis_offset[I] + n_axis[I]) of the concatenation axis
+template<typename CONFIG_T, unsigned I, class res_T>
+void concatenate_n_copy(res_T *res) {}
+
+template<typename CONFIG_T, unsigned I, class res_T, class input_T, class... rest_T>
+void concatenate_n_copy(res_T *res, input_T *data, rest_T... rest) {
+    constexpr unsigned n_copy = CONFIG_T::n_axis[I] * CONFIG_T::n_inner;
+    constexpr unsigned offset = CONFIG_T::axis_offset[I] * CONFIG_T::n_inner;
+    #pragma unroll
+    for (int i = 0; i < CONFIG_T::n_outer; i++) {
+        #pragma unroll
+        for (int j = 0; j < n_copy; j++) {
+            res[i * CONFIG_T::n_axis_out * CONFIG_T::n_inner + offset + j] = data[i * n_copy + j];
+        }
+    }
+    concatenate_n_copy<CONFIG_T, I + 1>(res, rest...);
+}
+
+template<class res_T, typename CONFIG_T, class... input_T>
+void concatenate_n(
+    res_T res[CONFIG_T::n_outer * CONFIG_T::n_axis_out * CONFIG_T::n_inner],
+    input_T... data)
+{
+    concatenate_n_copy<CONFIG_T, 0>(res, data...);
+}
+
+}
+
+#endif
@@ -0,0 +1,310 @@
+#ifndef NNET_MERGE_STREAM_H_
+#define NNET_MERGE_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_types.h"
+#include "nnet_merge.h"
+
+namespace nnet {
+
+// The element-wise merges are applied to one packet of every input at a time by the io_parallel kernels
+template<typename CONFIG_T, unsigned N>
+struct merge_word_config : CONFIG_T {
+    static const unsigned n_elem = N;
+};
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T, unsigned input1_D, unsigned input2_D, unsigned res_D>
+void add(
+    stream<input1_T, input1_D> &data1,
+    stream<input2_T, input2_D> &data2,
+    stream<res_T, res_D> &res)
+{
+    AddLoop:
+    for (int i = 0; i < CONFIG_T::n_elem / res_T::size; i++) {
+        input1_T in_data1 = data1.read();
+        input2_T in_data2 = data2.read();
+        res_T out_data;
+        add<typename input1_T::value_type, typename input2_T::value_type, typename res_T::value_type, merge_word_config<CONFIG_T, res_T::size>>(
+            in_data1.data, in_data2.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T, unsigned input1_D, unsigned input2_D, unsigned res_D>
+void subtract(
+    stream<input1_T, input1_D> &data1,
+    stream<input2_T, input2_D> &data2,
+    stream<res_T, res_D> &res)
+{
+    SubtractLoop:
+    for (int i = 0; i < CONFIG_T::n_elem / res_T::size; i++) {
+        input1_T in_data1 = data1.read();
+        input2_T in_data2 = data2.read();
+        res_T out_data;
+        subtract<typename input1_T::value_type, typename input2_T::value_type, typename res_T::value_type, merge_word_config<CONFIG_T, res_T::size>>(
+            in_data1.data, in_data2.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T, unsigned input1_D, unsigned input2_D, unsigned res_D>
+void multiply(
+    stream<input1_T, input1_D> &data1,
+    stream<input2_T, input2_D> &data2,
+    stream<res_T, res_D> &res)
+{
+    MultiplyLoop:
+    for (int i = 0; i < CONFIG_T::n_elem / res_T::size; i++) {
+        input1_T in_data1 = data1.read();
+        input2_T in_data2 = data2.read();
+        res_T out_data;
+        multiply<typename input1_T::value_type, typename input2_T::value_type, typename res_T::value_type, merge_word_config<CONFIG_T, res_T::size>>(
+            in_data1.data, in_data2.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T, unsigned input1_D, unsigned input2_D, unsigned res_D>
+void average(
+    stream<input1_T, input1_D> &data1,
+    stream<input2_T, input2_D> &data2,
+    stream<res_T, res_D> &res)
+{
+    AverageLoop:
+    for (int i = 0; i < CONFIG_T::n_elem / res_T::size; i++) {
+        input1_T in_data1 = data1.read();
+        input2_T in_data2 = data2.read();
+        res_T out_data;
+        average<typename input1_T::value_type, typename input2_T::value_type, typename res_T::value_type, merge_word_config<CONFIG_T, res_T::size>>(
+            in_data1.data, in_data2.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T, unsigned input1_D, unsigned input2_D, unsigned res_D>
+void maximum(
+    stream<input1_T, input1_D> &data1,
+    stream<input2_T, input2_D> &data2,
+    stream<res_T, res_D> &res)
+{
+    MaximumLoop:
+    for (int i = 0; i < CONFIG_T::n_elem / res_T::size; i++) {
+        input1_T in_data1 = data1.read();
+        input2_T in_data2 = data2.read();
+        res_T out_data;
+        maximum<typename input1_T::value_type, typename input2_T::value_type, typename res_T::value_type, merge_word_config<CONFIG_T, res_T::size>>(
+            in_data1.data, in_data2.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T, unsigned input1_D, unsigned input2_D, unsigned res_D>
+void minimum(
+    stream<input1_T, input1_D> &data1,
+    stream<input2_T, input2_D> &data2,
+    stream<res_T, res_D> &res)
+{
+    MinimumLoop:
+    for (int i = 0; i < CONFIG_T::n_elem / res_T::size; i++) {
+        input1_T in_data1 = data1.read();
+        input2_T in_data2 = data2.read();
+        res_T out_data;
+        minimum<typename input1_T::value_type, typename input2_T::value_type, typename res_T::value_type, merge_word_config<CONFIG_T, res_T::size>>(
+            in_data1.data, in_data2.data, out_data.data);
+        res.write(out_data);
+    }
+}
+
+// N-input merges read one packet of every input and fold them as in io_parallel
+template<class OP, class res_T, typename CONFIG_T, unsigned res_D, class... input_S>
+void merge_n(stream<res_T, res_D> &res, input_S &... data) {
+    MergeLoop:
+    for (int i = 0; i < CONFIG_T::n_elem / res_T::size; i++) {
+        res_T out_data;
+        merge_n<OP, typename res_T::value_type, merge_word_config<CONFIG_T, res_T::size>>(out_data.data, data.read().data...);
+        res.write(out_data);
+    }
+}
+
+template<class res_T, typename CONFIG_T, unsigned res_D, class... input_S>
+void add_n(stream<res_T, res_D> &res, input_S &... data) {
+    merge_n<merge_op::add, res_T, CONFIG_T>(res, data...);
+}
+
+template<class res_T, typename CONFIG_T, unsigned res_D, class... input_S>
+void multiply_n(stream<res_T, res_D> &res, input_S &... data) {
+    merge_n<merge_op::multiply, res_T, CONFIG_T>(res, data...);
+}
+
+template<class res_T, typename CONFIG_T, unsigned res_D, class... input_S>
+void average_n(stream<res_T, res_D> &res, input_S &... data) {
+    merge_n<merge_op::average, res_T, CONFIG_T>(res, data...);
+}
+
+template<class res_T, typename CONFIG_T, unsigned res_D, class... input_S>
+void maximum_n(stream<res_T, res_D> &res, input_S &... data) {
+    merge_n<merge_op::maximum, res_T, CONFIG_T>(res, data...);
+}
+
+template<class res_T, typename CONFIG_T, unsigned res_D, class... input_S>
+void minimum_n(stream<res_T, res_D> &res, input_S &... data) {
+    merge_n<merge_op::minimum, res_T, CONFIG_T>(res, data...);
+}
+
+// The two vectors of a dot product are single packets
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T, unsigned input1_D, unsigned input2_D, unsigned res_D>
+void dot1d(
+    stream<input1_T, input1_D> &data1,
+    stream<input2_T, input2_D> &data2,
+    stream<res_T, res_D> &res)
+{
+    input1_T in_data1 = data1.read();
+    input2_T in_data2 = data2.read();
+    res_T out_data;
+    dot1d<typename input1_T::value_type, typename input2_T::value_type, typename res_T::value_type, CONFIG_T>(
+        in_data1.data, in_data2.data, out_data.data);
+    res.write(out_data);
+}
+
+// Concatenation along the last axis packs a packet of each input into every packet of the result, along the other
+// axes the packets of the slices are forwarded in turn
+template<class input1_T, class input2_T, class res_T, unsigned N_OUTER, unsigned N_SLICE1, unsigned N_SLICE2, unsigned input1_D, unsigned input2_D, unsigned res_D>
+void concatenate_slices(
+    stream<input1_T, input1_D> &data1,
+    stream<input2_T, input2_D> &data2,
+    stream<res_T, res_D> &res)
+{
+    ConcatLoop:
+    for (int i = 0; i < N_OUTER; i++) {
+        if (res_T::size == N_SLICE1 + N_SLICE2) {
+            input1_T in_data1 = data1.read();
+            input2_T in_data2 = data2.read();
+            res_T out_data;
+            #pragma unroll
+            for (int j = 0; j < N_SLICE1; j++) {
+                out_data[j] = in_data1[j];
+            }
+            #pragma unroll
+            for (int j = 0; j < N_SLICE2; j++) {
+                out_data[N_SLICE1 + j] = in_data2[j];
+            }
+            res.write(out_data);
+        } else {
+            ConcatSlice1:
+            for (int j = 0; j < N_SLICE1 / input1_T::size; j++) {
+                input1_T in_data1 = data1.read();
+                res_T out_data;
+                #pragma unroll
+                for (int k = 0; k < res_T::size; k++) {
+                    out_data[k] = in_data1[k];
+                }
+                res.write(out_data);
+            }
+            ConcatSlice2:
+            for (int j = 0; j < N_SLICE2 / input2_T::size; j++) {
+                input2_T in_data2 = data2.read();
+                res_T out_data;
+                #pragma unroll
+                for (int k = 0; k < res_T::size; k++) {
+                    out_data[k] = in_data2[k];
+                }
+                res.write(out_data);
+            }
+        }
+    }
+}
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T, unsigned input1_D, unsigned input2_D, unsigned res_D>
+void concatenate1d(
+    stream<input1_T, input1_D> &data1,
+    stream<input2_T, input2_D> &data2,
+    stream<res_T, res_D> &res)
+{
+    concatenate_slices<input1_T, input2_T, res_T, 1, CONFIG_T::n_elem1_0, CONFIG_T::n_elem2_0>(data1, data2, res);
+}
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T, unsigned input1_D, unsigned input2_D, unsigned res_D>
+void concatenate2d(
+    stream<input1_T, input1_D> &data1,
+    stream<input2_T, input2_D> &data2,
+    stream<res_T, res_D> &res)
+{
+    if (CONFIG_T::axis == 2 || CONFIG_T::axis == -1) {
+        concatenate_slices<input1_T, input2_T, res_T, CONFIG_T::n_elem1_0, CONFIG_T::n_elem1_1, CONFIG_T::n_elem2_1>(data1, data2, res);
+    } else {
+        concatenate_slices<input1_T, input2_T, res_T, 1, CONFIG_T::n_elem1_0 * CONFIG_T::n_elem1_1, CONFIG_T::n_elem2_0 * CONFIG_T::n_elem2_1>(data1, data2, res);
+    }
+}
+
+template<class input1_T, class input2_T, class res_T, typename CONFIG_T, unsigned input1_D, unsigned input2_D, unsigned res_D>
+void concatenate3d(
+    stream<input1_T, input1_D> &data1,
+    stream<input2_T, input2_D> &data2,
+    stream<res_T, res_D> &res)
+{
+    if (CONFIG_T::axis == 3 || CONFIG_T::axis == -1) {
+        concatenate_slices<input1_T, input2_T, res_T, CONFIG_T::n_elem1_0 * CONFIG_T::n_elem1_1,
+            CONFIG_T::n_elem1_2, CONFIG_T::n_elem2_2>(data1, data2, res);
+    } else if (CONFIG_T::axis == 2 || CONFIG_T::axis == -2) {
+        concatenate_slices<input1_T, input2_T, res_T, CONFIG_T::n_elem1_0,
+            CONFIG_T::n_elem1_1 * CONFIG_T::n_elem1_2, CONFIG_T::n_elem2_1 * CONFIG_T::n_elem2_2>(data1, data2, res);
+    } else {
+        concatenate_slices<input1_T, input2_T, res_T, 1,
+            CONFIG_T::n_elem1_0 * CONFIG_T::n_elem1_1 * CONFIG_T::n_elem1_2, CONFIG_T::n_elem2_0 * CONFIG_T::n_elem2_1 * CONFIG_T::n_elem2_2>(data1, data2, res);
+    }
+}
+
+// Concatenation of any number of inputs, along the last axis input I fills the elements
+// [axis_offset[I], axis_offset[I] + n_axis[I]) of every packet of the result
+template<typename CONFIG_T, unsigned I, class res_T>
+void concatenate_n_gather(res_T &out_data) {}
+
+template<typename CONFIG_T, unsigned I, class res_T, class input_T, unsigned input_D, class... rest_S>
+void concatenate_n_gather(res_T &out_data, stream<input_T, input_D> &data, rest_S &... rest) {
+    constexpr unsigned n_copy = CONFIG_T::n_axis[I];
+    constexpr unsigned offset = CONFIG_T::axis_offset[I];
+    input_T in_data = data.read();
+    #pragma unroll
+    for (int j = 0; j < n_copy; j++) {
+        out_data[offset + j] = in_data[j];
+    }
+    concatenate_n_gather<CONFIG_T, I + 1>(out_data, rest...);
+}
+
+// Along the other axes, the slice of every input is forwarded in turn
+template<typename CONFIG_T, unsigned I, class res_T, unsigned res_D>
+void concatenate_n_forward(stream<res_T, res_D> &res) {}
+
+template<typename CONFIG_T, unsigned I, class res_T, unsigned res_D, class input_T, unsigned input_D, class... rest_S>
+void concatenate_n_forward(stream<res_T, res_D> &res, stream<input_T, input_D> &data, rest_S &... rest) {
+    constexpr unsigned n_words = CONFIG_T::n_axis[I] * CONFIG_T::n_inner / input_T::size;
+    ConcatForward:
+    for (int j = 0; j < n_words; j++) {
+        input_T in_data = data.read();
+        res_T out_data;
+        #pragma unroll
+        for (int k = 0; k < res_T::size; k++) {
+            out_data[k] = in_data[k];
+        }
+        res.write(out_data);
+    }
+    concatenate_n_forward<CONFIG_T, I + 1>(res, rest...);
+}
+
+template<class res_T, typename CONFIG_T, unsigned res_D, class... input_S>
+void concatenate_n(stream<res_T, res_D> &res, input_S &... data) {
+    ConcatLoop:
+    for (int i = 0; i < CONFIG_T::n_outer; i++) {
+        if (res_T::size == CONFIG_T::n_axis_out * CONFIG_T::n_inner) {
+            res_T out_data;
+            concatenate_n_gather<CONFIG_T, 0>(out_data, data...);
+            res.write(out_data);
+        } else {
+            concatenate_n_forward<CONFIG_T, 0>(res, data...);
+        }
+    }
+}
+
+}
+
+#endif
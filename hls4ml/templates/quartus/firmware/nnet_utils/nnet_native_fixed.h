@@ -0,0 +1,119 @@
+#ifndef NNET_NATIVE_FIXED_H_
+#define NNET_NATIVE_FIXED_H_
+
+#include "nnet_common.h"
+#include <type_traits>
+
+namespace nnet {
+
+/*
+* Native integer model of ac_fixed and ac_int for the C simulation
+* The generic ac_types arithmetic works on arrays of 32-bit words, whatever the width. The types up to 62 bits are
+* kept here as their raw two's complement value in a long long instead, and each assignment to the type quantizes
+* and overflows the value with the same mode as ac_fixed, so the results are bit for bit those of the ac_types.
+* Types not covered (floats, binary and exponential weights, wider types) have enabled = false, and a zero width so
+* that the conditions on the widths of the types still compile for them.
+*/
+template<class T>
+struct native_fixed {
+    static const bool enabled = false;
+    static const int width = 0;
+    static const int frac = 0;
+};
+
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+struct native_fixed<ac_fixed<W, I, S, Q, O>> {
+    typedef ac_fixed<W, I, S, Q, O> type;
+
+    static const bool enabled = W <= 62;
+    static const int width = W;
+    static const int frac = W - I;
+    static const bool is_signed = S;
+    static const ac_q_mode q_mode = Q;
+    static const ac_o_mode o_mode = O;
+
+    inline static long long to_raw(const type &x) {
+        return x.template slc<W>(0).to_int64();
+    }
+
+    inline static type from_raw(long long x) {
+        type y;
+        y.set_slc(0, ac_int<W, S>(x));
+        return y;
+    }
+};
+
+template<int W, bool S>
+struct native_fixed<ac_int<W, S>> {
+    typedef ac_int<W, S> type;
+
+    static const bool enabled = W <= 62;
+    static const int width = W;
+    static const int frac = 0;
+    static const bool is_signed = S;
+    static const ac_q_mode q_mode = AC_TRN;
+    static const ac_o_mode o_mode = AC_WRAP;
+
+    inline static long long to_raw(const type &x) {
+        return x.to_int64();
+    }
+
+    inline static type from_raw(long long x) {
+        return type(x);
+    }
+};
+
+// Drops the lowest 'shift' bits of x, rounding as the quantization mode Q of ac_fixed
+template<ac_q_mode Q>
+inline long long native_quantize(long long x, int shift) {
+    if (shift <= 0) return (long long) ((unsigned long long) x << -shift);
+
+    const long long half = 1LL << (shift - 1);
+    const long long q = x >> shift;
+    const long long r = x - (long long) ((unsigned long long) q << shift);
+    switch (Q) {
+        case AC_TRN:          return q;
+        case AC_TRN_ZERO:     return q + (x < 0 && r != 0);
+        case AC_RND:          return q + (r >= half);
+        case AC_RND_ZERO:     return q + (r > half || (r == half && x < 0));
+        case AC_RND_INF:      return q + (r > half || (r == half && x >= 0));
+        case AC_RND_MIN_INF:  return q + (r > half);
+        case AC_RND_CONV:     return q + (r > half || (r == half && (q & 1)));
+        case AC_RND_CONV_ODD: return q + (r > half || (r == half && !(q & 1)));
+    }
+    return q;
+}
+
+// Brings x back to the range of the W-bit type, as the overflow mode O of ac_fixed
+template<int W, bool S, ac_o_mode O>
+inline long long native_overflow(long long x) {
+    const long long max = S ? (1LL << (W - 1)) - 1 : (1LL << W) - 1;
+    const long long min = S ? -(1LL << (W - 1)) : 0;
+    if (x >= min && x <= max) {
+        if (O == AC_SAT_SYM && S && x == min) return -max;
+        return x;
+    }
+    switch (O) {
+        case AC_WRAP: {
+            const unsigned long long low = (unsigned long long) x & ((1ULL << W) - 1);
+            return (S && (low >> (W - 1))) ? (long long) (low | ~((1ULL << W) - 1)) : (long long) low;
+        }
+        case AC_SAT:      return x < min ? min : max;
+        case AC_SAT_ZERO: return 0;
+        case AC_SAT_SYM:  return x < min ? (S ? -max : 0) : max;
+    }
+    return x;
+}
+
+// Assignment of a raw value with 'frac' fractional bits to the type T
+template<class T>
+inline long long native_assign(long long x, int frac) {
+    typedef native_fixed<T> native_T;
+    return native_overflow<native_T::width, native_T::is_signed, native_T::o_mode>(
+        native_quantize<native_T::q_mode>(x, frac - native_T::frac)
+    );
+}
+
+}
+
+#endif
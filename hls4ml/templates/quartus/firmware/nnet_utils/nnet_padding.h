@@ -0,0 +1,81 @@
+#ifndef NNET_PADDING_H_
+#define NNET_PADDING_H_
+
+#include "nnet_common.h"
+
+namespace nnet {
+
+struct padding1d_config {
+    static const unsigned n_chan = 10;
+    static const unsigned in_width = 10;
+    static const unsigned out_width = 10;
+    static const unsigned pad_left = 0;
+    static const unsigned pad_right = 0;
+};
+
+template<class data_T, class res_T, typename CONFIG_T>
+void zeropad1d_cl(
+    data_T data[CONFIG_T::n_chan * CONFIG_T::in_width],
+    res_T  res[CONFIG_T::n_chan * CONFIG_T::out_width])
+{
+    PadLeft:
+    #pragma unroll
+    for (int i = 0; i < CONFIG_T::pad_left * CONFIG_T::n_chan; i++) {
+        res[i] = 0;
+    }
+
+    CopyMain:
+    #pragma unroll
+    for (int i = 0; i < CONFIG_T::in_width * CONFIG_T::n_chan; i++) {
+        res[CONFIG_T::pad_left * CONFIG_T::n_chan + i] = (res_T) data[i];
+    }
+
+    PadRight:
+    #pragma unroll
+    for (int i = 0; i < CONFIG_T::pad_right * CONFIG_T::n_chan; i++) {
+        res[(CONFIG_T::pad_left + CONFIG_T::in_width) * CONFIG_T::n_chan + i] = 0;
+    }
+}
+
+struct padding2d_config {
+    static const unsigned n_chan = 10;
+    static const unsigned in_height = 10;
+    static const unsigned in_width = 10;
+    static const unsigned out_height = 10;
+    static const unsigned out_width = 10;
+    static const unsigned pad_top = 0;
+    static const unsigned pad_bottom = 0;
+    static const unsigned pad_left = 0;
+    static const unsigned pad_right = 0;
+};
+
+template<class data_T, class res_T, typename CONFIG_T>
+void zeropad2d_cl(
+    data_T data[CONFIG_T::n_chan * CONFIG_T::in_height * CONFIG_T::in_width],
+    res_T  res[CONFIG_T::n_chan * CONFIG_T::out_height * CONFIG_T::out_width])
+{
+    HeightLoop:
+    #pragma unroll
+    for (int i = 0; i < CONFIG_T::out_height; i++) {
+        WidthLoop:
+        #pragma unroll
+        for (int j = 0; j < CONFIG_T::out_width; j++) {
+            int index_in_h = i - CONFIG_T::pad_top;
+            int index_in_w = j - CONFIG_T::pad_left;
+            bool in_image = index_in_h >= 0 && index_in_h < CONFIG_T::in_height && index_in_w >= 0 && index_in_w < CONFIG_T::in_width;
+            ChanLoop:
+            #pragma unroll
+            for (int k = 0; k < CONFIG_T::n_chan; k++) {
+                if (in_image) {
+                    res[(i * CONFIG_T::out_width + j) * CONFIG_T::n_chan + k] = (res_T) data[(index_in_h * CONFIG_T::in_width + index_in_w) * CONFIG_T::n_chan + k];
+                } else {
+                    res[(i * CONFIG_T::out_width + j) * CONFIG_T::n_chan + k] = 0;
+                }
+            }
+        }
+    }
+}
+
+}
+
+#endif
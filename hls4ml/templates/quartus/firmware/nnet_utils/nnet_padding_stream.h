@@ -0,0 +1,82 @@
+#ifndef NNET_PADDING_STREAM_H_
+#define NNET_PADDING_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_types.h"
+#include "nnet_padding.h"
+
+namespace nnet {
+
+template<class res_T, unsigned res_D>
+void fill_zero(stream<res_T, res_D> &res) {
+    res_T out_data;
+    #pragma unroll
+    for (int i = 0; i < res_T::size; i++) {
+        out_data[i] = 0;
+    }
+    res.write(out_data);
+}
+
+template<class data_T, class res_T, unsigned data_D, unsigned res_D>
+void fill_data(stream<data_T, data_D> &data, stream<res_T, res_D> &res) {
+    data_T in_data = data.read();
+    res_T out_data;
+    #pragma unroll
+    for (int i = 0; i < res_T::size; i++) {
+        out_data[i] = (typename res_T::value_type) in_data[i];
+    }
+    res.write(out_data);
+}
+
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void zeropad1d_cl(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    PadLeft:
+    for (int i = 0; i < CONFIG_T::pad_left; i++) {
+        fill_zero<res_T>(res);
+    }
+
+    CopyMain:
+    for (int i = 0; i < CONFIG_T::in_width; i++) {
+        fill_data<data_T, res_T>(data, res);
+    }
+
+    PadRight:
+    for (int i = 0; i < CONFIG_T::pad_right; i++) {
+        fill_zero<res_T>(res);
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void zeropad2d_cl(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    PadTop:
+    for (int i = 0; i < CONFIG_T::pad_top * CONFIG_T::out_width; i++) {
+        fill_zero<res_T>(res);
+    }
+
+    PadMain:
+    for (int i = 0; i < CONFIG_T::in_height; i++) {
+        PadLeft:
+        for (int j = 0; j < CONFIG_T::pad_left; j++) {
+            fill_zero<res_T>(res);
+        }
+        CopyMain:
+        for (int j = 0; j < CONFIG_T::in_width; j++) {
+            fill_data<data_T, res_T>(data, res);
+        }
+        PadRight:
+        for (int j = 0; j < CONFIG_T::pad_right; j++) {
+            fill_zero<res_T>(res);
+        }
+    }
+
+    PadBottom:
+    for (int i = 0; i < CONFIG_T::pad_bottom * CONFIG_T::out_width; i++) {
+        fill_zero<res_T>(res);
+    }
+}
+
+}
+
+#endif
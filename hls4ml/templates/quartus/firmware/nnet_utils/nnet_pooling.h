@@ -0,0 +1,227 @@
+#ifndef NNET_POOLING_H_
+#define NNET_POOLING_H_
+
+#include "nnet_common.h"
+#include "nnet_helpers.h"
+
+namespace nnet {
+
+// Return the maximum value from an array
+template<typename T, int N>
+T max(T x[N]) {
+    hls_register T y = x[0];
+    #pragma unroll
+    for (int i = 1; i < N; i++) {
+        y = x[i] > y ? x[i] : y;
+    }
+    return y;
+}
+
+// Return the mean of the first `length` elements of an array, the padded elements (all zero) are at most N - length
+template<int W, bool S, int N>
+ac_int<W, S> avg(ac_int<W, S> (&x)[N], unsigned length) {
+    // Use a wider accumulator than the input to avoid overflow
+    hls_register ac_int<W + ceillog2(N), S> tmp = 0;
+    #pragma unroll
+    for (int i = 0; i < N; i++) {
+        tmp += x[i];
+    }
+    tmp /= length;
+    // Now cast back to original type
+    ac_int<W, S> y = tmp;
+    return y;
+}
+
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int N>
+ac_fixed<W, I, S, Q, O> avg(ac_fixed<W, I, S, Q, O> (&x)[N], unsigned length) {
+    // Use a wider accumulator than the input to avoid overflow
+    hls_register ac_fixed<W + ceillog2(N), I + ceillog2(N), S> tmp = 0;
+    #pragma unroll
+    for (int i = 0; i < N; i++) {
+        tmp += x[i];
+    }
+    tmp /= length;
+    // Now cast back to original type
+    ac_fixed<W, I, S, Q, O> y = tmp;
+    return y;
+}
+
+// Enumeration for pooling operation (max, avg, l2norm pooling)
+enum Pool_Op { Max, Average }; // L2Norm };
+
+template<typename T, int N, Pool_Op op>
+T pool_op(T (&x)[N], unsigned length) {
+    switch (op) {
+        case Max: return max<T, N>(x);
+        case Average: return avg(x, length);
+        // case L2Norm: return l2norm<T, N>(x);
+    }
+}
+
+template<typename T, Pool_Op op>
+T pad_val() {
+    /*---
+    *- In Tensorflow, pooling ignores the value in the padded cells
+    *- For Avg pooling, return 0 (the divisor is the number of pixels
+    *- of the pool window that overlap the unpadded image).
+    *- For max pooling, return the most negative value for the type.
+    ---*/
+    switch (op) {
+        case Max: {
+            T x = 0;
+            x.template set_val<AC_VAL_MIN>();
+            return x;
+        }
+        case Average: return 0;
+    }
+}
+
+struct pooling1d_config {
+    // IO size
+    static const unsigned n_in = 10;
+    static const unsigned pool_width = 2;
+    static const unsigned stride_width = 2;
+    static const unsigned n_out = (n_in - pool_width) / stride_width + 1;
+    static const unsigned n_filt = 4;
+    static const unsigned pad_left = 0;
+    static const unsigned pad_right = 0;
+    // Pooling function
+    static const Pool_Op pool_op = Max;
+    // Reuse
+    static const unsigned reuse_factor = 1;
+};
+
+template<class data_T, class res_T, typename CONFIG_T>
+void pooling1d_cl(
+    data_T data[CONFIG_T::n_in * CONFIG_T::n_filt],
+    res_T  res[CONFIG_T::n_out * CONFIG_T::n_filt])
+{
+    FiltLoop:
+    #pragma unroll
+    for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+        // Loop over the output, the pool window of output ii starts at ii * stride_width in the padded input
+        OutLoop:
+        #pragma unroll
+        for (int ii = 0; ii < CONFIG_T::n_out; ii++) {
+            hls_register data_T pool[CONFIG_T::pool_width];
+            // Keep track of number of pixels in image vs padding region
+            unsigned img_overlap = 0;
+            PoolLoop:
+            #pragma unroll
+            for (int jj = 0; jj < CONFIG_T::pool_width; jj++) {
+                int index_in = ii * CONFIG_T::stride_width + jj - CONFIG_T::pad_left;
+                if (index_in < 0 || index_in >= CONFIG_T::n_in) {
+                    // Add padding
+                    pool[jj] = pad_val<data_T, CONFIG_T::pool_op>();
+                } else {
+                    pool[jj] = data[index_in * CONFIG_T::n_filt + ff];
+                    img_overlap++;
+                }
+            }
+            res[ii * CONFIG_T::n_filt + ff] = pool_op<data_T, CONFIG_T::pool_width, CONFIG_T::pool_op>(pool, img_overlap);
+        }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void global_pooling1d_cl(
+    data_T data[CONFIG_T::n_in * CONFIG_T::n_filt],
+    res_T  res[CONFIG_T::n_filt])
+{
+    FiltLoop:
+    #pragma unroll
+    for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+        hls_register data_T pool[CONFIG_T::n_in];
+        InputLoop:
+        #pragma unroll
+        for (int jj = 0; jj < CONFIG_T::n_in; jj++) {
+            pool[jj] = data[jj * CONFIG_T::n_filt + ff];
+        }
+        res[ff] = pool_op<data_T, CONFIG_T::n_in, CONFIG_T::pool_op>(pool, CONFIG_T::n_in);
+    }
+}
+
+struct pooling2d_config {
+    // IO size
+    static const unsigned in_height = 10;
+    static const unsigned in_width = 10;
+    static const unsigned n_filt = 4;
+    static const unsigned stride_height = 2;
+    static const unsigned stride_width = 2;
+    static const unsigned pool_height = 2;
+    static const unsigned pool_width = 2;
+    static const unsigned out_height = (in_height - pool_height) / stride_height + 1;
+    static const unsigned out_width = (in_width - pool_width) / stride_width + 1;
+    // Padding
+    static const unsigned pad_top = 0;
+    static const unsigned pad_bottom = 0;
+    static const unsigned pad_left = 0;
+    static const unsigned pad_right = 0;
+    // Pooling function
+    static const Pool_Op pool_op = Max;
+    // Reuse
+    static const unsigned reuse_factor = 1;
+};
+
+template<class data_T, class res_T, typename CONFIG_T>
+void pooling2d_cl(
+    data_T data[CONFIG_T::in_height * CONFIG_T::in_width * CONFIG_T::n_filt],
+    res_T  res[CONFIG_T::out_height * CONFIG_T::out_width * CONFIG_T::n_filt])
+{
+    FiltLoop:
+    #pragma unroll
+    for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+        OutHeightLoop:
+        #pragma unroll
+        for (int ii = 0; ii < CONFIG_T::out_height; ii++) {
+            OutWidthLoop:
+            #pragma unroll
+            for (int jj = 0; jj < CONFIG_T::out_width; jj++) {
+                hls_register data_T pool[CONFIG_T::pool_height * CONFIG_T::pool_width];
+                // Keep track of number of pixels in image vs padding region
+                unsigned img_overlap = 0;
+                PoolHeightLoop:
+                #pragma unroll
+                for (int kk = 0; kk < CONFIG_T::pool_height; kk++) {
+                    PoolWidthLoop:
+                    #pragma unroll
+                    for (int ll = 0; ll < CONFIG_T::pool_width; ll++) {
+                        int index_in_h = ii * CONFIG_T::stride_height + kk - CONFIG_T::pad_top;
+                        int index_in_w = jj * CONFIG_T::stride_width + ll - CONFIG_T::pad_left;
+                        if (index_in_h < 0 || index_in_h >= CONFIG_T::in_height || index_in_w < 0 || index_in_w >= CONFIG_T::in_width) {
+                            // Add padding
+                            pool[kk * CONFIG_T::pool_width + ll] = pad_val<data_T, CONFIG_T::pool_op>();
+                        } else {
+                            pool[kk * CONFIG_T::pool_width + ll] = data[(index_in_h * CONFIG_T::in_width + index_in_w) * CONFIG_T::n_filt + ff];
+                            img_overlap++;
+                        }
+                    }
+                }
+                res[(ii * CONFIG_T::out_width + jj) * CONFIG_T::n_filt + ff] =
+                    pool_op<data_T, CONFIG_T::pool_height * CONFIG_T::pool_width, CONFIG_T::pool_op>(pool, img_overlap);
+            }
+        }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void global_pooling2d_cl(
+    data_T data[CONFIG_T::in_height * CONFIG_T::in_width * CONFIG_T::n_filt],
+    res_T  res[CONFIG_T::n_filt])
+{
+    FiltLoop:
+    #pragma unroll
+    for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+        hls_register data_T pool[CONFIG_T::in_height * CONFIG_T::in_width];
+        InputLoop:
+        #pragma unroll
+        for (int jj = 0; jj < CONFIG_T::in_height * CONFIG_T::in_width; jj++) {
+            pool[jj] = data[jj * CONFIG_T::n_filt + ff];
+        }
+        res[ff] = pool_op<data_T, CONFIG_T::in_height * CONFIG_T::in_width, CONFIG_T::pool_op>(pool, CONFIG_T::in_height * CONFIG_T::in_width);
+    }
+}
+
+}
+
+#endif
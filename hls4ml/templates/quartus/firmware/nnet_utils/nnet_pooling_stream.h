@@ -0,0 +1,152 @@
+#ifndef NNET_POOLING_STREAM_H_
+#define NNET_POOLING_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_types.h"
+#include "nnet_pooling.h"
+
+namespace nnet {
+
+// The pool windows are gathered from a line buffer like the windows of the convolutions, padding is not supported
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void pooling1d_cl(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    typename data_T::value_type line_buffer[CONFIG_T::pool_width][CONFIG_T::n_filt];
+
+    ReadInputWidth:
+    for (int w = 0; w < CONFIG_T::n_in; w++) {
+        data_T in_data = data.read();
+        #pragma unroll
+        for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+            line_buffer[w % CONFIG_T::pool_width][ff] = in_data[ff];
+        }
+
+        int ow_offset = w - (int) (CONFIG_T::pool_width - 1);
+        if (ow_offset >= 0 && ow_offset % CONFIG_T::stride_width == 0 && ow_offset / CONFIG_T::stride_width < CONFIG_T::n_out) {
+            res_T out_data;
+            FiltLoop:
+            #pragma unroll
+            for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+                hls_register typename data_T::value_type pool[CONFIG_T::pool_width];
+                #pragma unroll
+                for (int kw = 0; kw < CONFIG_T::pool_width; kw++) {
+                    pool[kw] = line_buffer[(ow_offset + kw) % CONFIG_T::pool_width][ff];
+                }
+                out_data[ff] = pool_op<typename data_T::value_type, CONFIG_T::pool_width, CONFIG_T::pool_op>(pool, CONFIG_T::pool_width);
+            }
+            res.write(out_data);
+        }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void pooling2d_cl(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    typename data_T::value_type line_buffer[CONFIG_T::pool_height][CONFIG_T::in_width][CONFIG_T::n_filt];
+
+    ReadInputHeight:
+    for (int h = 0; h < CONFIG_T::in_height; h++) {
+        ReadInputWidth:
+        for (int w = 0; w < CONFIG_T::in_width; w++) {
+            data_T in_data = data.read();
+            #pragma unroll
+            for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+                line_buffer[h % CONFIG_T::pool_height][w][ff] = in_data[ff];
+            }
+
+            int oh_offset = h - (int) (CONFIG_T::pool_height - 1);
+            int ow_offset = w - (int) (CONFIG_T::pool_width - 1);
+            if (oh_offset >= 0 && ow_offset >= 0 && oh_offset % CONFIG_T::stride_height == 0 && ow_offset % CONFIG_T::stride_width == 0 &&
+                oh_offset / CONFIG_T::stride_height < CONFIG_T::out_height && ow_offset / CONFIG_T::stride_width < CONFIG_T::out_width) {
+                res_T out_data;
+                FiltLoop:
+                #pragma unroll
+                for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+                    hls_register typename data_T::value_type pool[CONFIG_T::pool_height * CONFIG_T::pool_width];
+                    #pragma unroll
+                    for (int kh = 0; kh < CONFIG_T::pool_height; kh++) {
+                        #pragma unroll
+                        for (int kw = 0; kw < CONFIG_T::pool_width; kw++) {
+                            pool[kh * CONFIG_T::pool_width + kw] = line_buffer[(oh_offset + kh) % CONFIG_T::pool_height][ow_offset + kw][ff];
+                        }
+                    }
+                    out_data[ff] = pool_op<typename data_T::value_type, CONFIG_T::pool_height * CONFIG_T::pool_width, CONFIG_T::pool_op>(
+                        pool, CONFIG_T::pool_height * CONFIG_T::pool_width);
+                }
+                res.write(out_data);
+            }
+        }
+    }
+}
+
+// Type of the running sum of the global average pooling, the same as the accumulator of avg()
+template<class T, int N>
+struct pool_accum;
+
+template<int W, bool S, int N>
+struct pool_accum<ac_int<W, S>, N> {
+    typedef ac_int<W + ceillog2(N), S> type;
+};
+
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int N>
+struct pool_accum<ac_fixed<W, I, S, Q, O>, N> {
+    typedef ac_fixed<W + ceillog2(N), I + ceillog2(N), S> type;
+};
+
+// The global poolings reduce the pixels as they arrive, only one value per channel is stored
+template<class data_T, class res_T, typename CONFIG_T, int N, unsigned data_D, unsigned res_D>
+void global_pooling_cl(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    typedef typename data_T::value_type value_T;
+    typedef typename pool_accum<value_T, N>::type accum_T;
+
+    hls_register value_T max_acc[CONFIG_T::n_filt];
+    hls_register accum_T avg_acc[CONFIG_T::n_filt];
+    #pragma unroll
+    for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+        avg_acc[ff] = 0;
+    }
+
+    ReadInput:
+    for (int i = 0; i < N; i++) {
+        data_T in_data = data.read();
+        #pragma unroll
+        for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+            if (CONFIG_T::pool_op == Max) {
+                max_acc[ff] = (i == 0 || in_data[ff] > max_acc[ff]) ? in_data[ff] : max_acc[ff];
+            } else {
+                avg_acc[ff] += in_data[ff];
+            }
+        }
+    }
+
+    res_T out_data;
+    #pragma unroll
+    for (int ff = 0; ff < CONFIG_T::n_filt; ff++) {
+        if (CONFIG_T::pool_op == Max) {
+            out_data[ff] = max_acc[ff];
+        } else {
+            unsigned length = N;
+            avg_acc[ff] /= length;
+            value_T y = avg_acc[ff];
+            out_data[ff] = y;
+        }
+    }
+    res.write(out_data);
+}
+
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void global_pooling1d_cl(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    global_pooling_cl<data_T, res_T, CONFIG_T, CONFIG_T::n_in>(data, res);
+}
+
+template<class data_T, class res_T, typename CONFIG_T, unsigned data_D, unsigned res_D>
+void global_pooling2d_cl(stream<data_T, data_D> &data, stream<res_T, res_D> &res)
+{
+    global_pooling_cl<data_T, res_T, CONFIG_T, CONFIG_T::in_height * CONFIG_T::in_width>(data, res);
+}
+
+}
+
+#endif
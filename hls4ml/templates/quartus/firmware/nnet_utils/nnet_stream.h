@@ -0,0 +1,158 @@
+#ifndef NNET_STREAM_H_
+#define NNET_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_types.h"
+
+namespace nnet {
+
+// Reads the N elements of a tensor from a stream of packets into an array, and the reverse
+template<class data_T, int N, unsigned data_D>
+void read_packets(stream<data_T, data_D> &data, typename data_T::value_type res[N]) {
+    ReadLoop:
+    for (int i = 0; i < N / data_T::size; i++) {
+        data_T in_data = data.read();
+        ReadPack:
+        #pragma unroll
+        for (int j = 0; j < data_T::size; j++) {
+            res[i * data_T::size + j] = in_data[j];
+        }
+    }
+}
+
+template<class res_T, int N, unsigned res_D>
+void write_packets(typename res_T::value_type data[N], stream<res_T, res_D> &res) {
+    WriteLoop:
+    for (int i = 0; i < N / res_T::size; i++) {
+        res_T out_data;
+        WritePack:
+        #pragma unroll
+        for (int j = 0; j < res_T::size; j++) {
+            out_data[j] = data[i * res_T::size + j];
+        }
+        res.write(out_data);
+    }
+}
+
+// Moves the packets of a tensor between the interfaces of the component and the streams of the layers
+template<class data_T, int N, class data_S, class res_S>
+void copy_stream(data_S &data, res_S &res) {
+    CopyLoop:
+    for (int i = 0; i < N / data_T::size; i++) {
+        res.write(data.read());
+    }
+}
+
+// Writes the same packet to every output stream, the recursion is unrolled at compile time for any number of outputs
+template<class res_T>
+void clone_write(const res_T &out_data) {}
+
+template<class res_T, class res_S, class... rest_S>
+void clone_write(const res_T &out_data, res_S &res, rest_S &... rest) {
+    res.write(out_data);
+    clone_write<res_T>(out_data, rest...);
+}
+
+template<class data_T, class res_T, int N, unsigned data_D, class... res_S>
+void clone_stream(stream<data_T, data_D> &data, res_S &... res) {
+    if (data_T::size == res_T::size) {
+        CloneLoop:
+        for (int i = 0; i < N / data_T::size; i++) {
+            data_T in_data = data.read();
+            res_T out_data;
+            ClonePack:
+            #pragma unroll
+            for (int j = 0; j < data_T::size; j++) {
+                out_data[j] = in_data[j];
+            }
+            clone_write<res_T>(out_data, res...);
+        }
+    } else {
+        // The stream of a flattened tensor keeps the packets of the layer before the Flatten, repack while cloning
+        data_T in_data;
+        res_T out_data;
+        unsigned in_cnt = data_T::size, out_cnt = 0;
+        CloneElemLoop:
+        for (int i = 0; i < N; i++) {
+            if (in_cnt == data_T::size) {
+                in_data = data.read();
+                in_cnt = 0;
+            }
+            out_data[out_cnt++] = in_data[in_cnt++];
+            if (out_cnt == res_T::size) {
+                clone_write<res_T>(out_data, res...);
+                out_cnt = 0;
+            }
+        }
+    }
+}
+
+template<class data_T, class res_T, int N, unsigned data_D, unsigned res_D>
+void repack_stream(stream<data_T, data_D> &data, stream<res_T, res_D> &res) {
+    if (data_T::size == res_T::size) {
+        RepackLoop:
+        for (int i = 0; i < N / data_T::size; i++) {
+            data_T in_data = data.read();
+            res_T out_data;
+            #pragma unroll
+            for (int j = 0; j < data_T::size; j++) {
+                out_data[j] = in_data[j];
+            }
+            res.write(out_data);
+        }
+    } else if (data_T::size % res_T::size == 0) {
+        constexpr unsigned pack_diff = data_T::size / res_T::size;
+        RepackSplitLoop:
+        for (int i = 0; i < N / data_T::size; i++) {
+            data_T in_data = data.read();
+            #pragma nofusion
+            for (int j = 0; j < pack_diff; j++) {
+                res_T out_data;
+                #pragma unroll
+                for (int k = 0; k < res_T::size; k++) {
+                    out_data[k] = in_data[j * res_T::size + k];
+                }
+                res.write(out_data);
+            }
+        }
+    } else if (res_T::size % data_T::size == 0) {
+        constexpr unsigned pack_diff = res_T::size / data_T::size;
+        res_T out_data;
+        unsigned pack_cnt = 0;
+        RepackMergeLoop:
+        for (int i = 0; i < N / data_T::size; i++) {
+            data_T in_data = data.read();
+            #pragma unroll
+            for (int j = 0; j < data_T::size; j++) {
+                out_data[pack_cnt * data_T::size + j] = in_data[j];
+            }
+            if (pack_cnt == pack_diff - 1) {
+                res.write(out_data);
+                pack_cnt = 0;
+            } else {
+                pack_cnt++;
+            }
+        }
+    } else {
+        // The packets don't divide each other, move the elements one by one
+        data_T in_data;
+        res_T out_data;
+        unsigned in_cnt = data_T::size, out_cnt = 0;
+        RepackElemLoop:
+        for (int i = 0; i < N; i++) {
+            if (in_cnt == data_T::size) {
+                in_data = data.read();
+                in_cnt = 0;
+            }
+            out_data[out_cnt++] = in_data[in_cnt++];
+            if (out_cnt == res_T::size) {
+                res.write(out_data);
+                out_cnt = 0;
+            }
+        }
+    }
+}
+
+}
+
+#endif
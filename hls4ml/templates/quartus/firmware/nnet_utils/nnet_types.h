@@ -0,0 +1,106 @@
+#ifndef NNET_TYPES_H_
+#define NNET_TYPES_H_
+
+#include <assert.h>
+#include <cstddef>
+#include <cstdio>
+
+#ifndef __INTELFPGA_COMPILER__
+#include <deque>
+#else
+#include "HLS/hls.h"
+#endif
+
+namespace nnet {
+
+// Fixed-size array, the element of the streams in io_stream
+template<typename T, unsigned N>
+struct array {
+    typedef T value_type;
+    static const unsigned size = N;
+
+    T data[N];
+
+    T& operator[](size_t pos) {
+        return data[pos];
+    }
+
+    const T& operator[](size_t pos) const {
+        return data[pos];
+    }
+
+    array& operator=(const array &other) {
+        if(&other == this)
+            return *this;
+
+        assert(N == other.size && "Array sizes must match.");
+
+        #pragma unroll
+        for (unsigned i = 0; i < N; i++) {
+            data[i] = other[i];
+        }
+        return *this;
+    }
+};
+
+#ifndef __INTELFPGA_COMPILER__
+
+/*
+* C simulation model of ihc::stream, ihc::stream_in and ihc::stream_out, for g++ which doesn't have the HLS headers
+* The layers are simulated one after the other, so a stream holds the whole tensor at some point and never blocks,
+* the depth only sets the type, as in hardware. Reading an empty stream means the layers are not connected properly.
+*/
+template<typename T, unsigned D = 1>
+class stream {
+  private:
+    std::deque<T> _data;
+
+  public:
+    typedef T value_type;
+    static const unsigned depth = D;
+
+    stream() {}
+
+    T read() {
+        assert(!_data.empty() && "Read from an empty stream.");
+        T element = _data.front();
+        _data.pop_front();
+        return element;
+    }
+
+    void write(const T &element) {
+        _data.push_back(element);
+    }
+
+    bool empty() const {
+        return _data.empty();
+    }
+
+    size_t size() const {
+        return _data.size();
+    }
+};
+
+template<typename T>
+using stream_in = stream<T>;
+
+template<typename T>
+using stream_out = stream<T>;
+
+#else
+
+// The streams between the layers are FIFOs with a capacity of D elements
+template<typename T, unsigned D = 1>
+using stream = ihc::stream<T, ihc::buffer<D>>;
+
+template<typename T>
+using stream_in = ihc::stream_in<T>;
+
+template<typename T>
+using stream_out = ihc::stream_out<T>;
+
+#endif
+
+}
+
+#endif
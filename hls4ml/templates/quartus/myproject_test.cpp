@@ -62,8 +62,7 @@ int main(int argc, char **argv)
   std::string iline;
   std::string pline;
 
-  std::vector<input_data> inputs;
-  std::vector<output_data> outputs;
+  //hls-fpga-machine-learning insert inputs/outputs
 
   if (fin.is_open() && fpr.is_open()) {
     std::vector<std::vector<float> > predictions;
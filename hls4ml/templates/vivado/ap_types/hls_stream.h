@@ -85,6 +85,9 @@
 #ifdef HLS_STREAM_THREAD_SAFE
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
 #endif
 
 #ifndef _MSC_VER
@@ -94,6 +97,24 @@
 
 namespace hls {
 
+#ifdef HLS_STREAM_THREAD_SAFE
+// In the threaded simulation, a blocking read or write gives up once no stream has been read or written
+// for this long, all the other threads being blocked as well
+#ifndef HLS_STREAM_DEADLOCK_TIMEOUT_MS
+#define HLS_STREAM_DEADLOCK_TIMEOUT_MS 2000
+#endif
+
+class stream_deadlock : public std::runtime_error {
+  public:
+    explicit stream_deadlock(const std::string &what) : std::runtime_error(what) {}
+};
+
+inline std::atomic<unsigned long> &stream_progress() {
+    static std::atomic<unsigned long> progress(0);
+    return progress;
+}
+#endif
+
 template<typename __STREAM_T__>
 class stream
 {
@@ -103,6 +124,26 @@ class stream
 #ifdef HLS_STREAM_THREAD_SAFE
     std::mutex _mutex;
     std::condition_variable _condition_var;
+    size_t _depth = 0; // Writes block once the stream holds _depth elements, 0 is unbounded
+
+    // Waits until ready() holds, throws stream_deadlock if no stream makes progress in the meantime
+    template<class __PRED_T__>
+    void wait_until(std::unique_lock<std::mutex> &ul, __PRED_T__ ready, const char *state) {
+        unsigned long progress = stream_progress();
+        std::chrono::steady_clock::time_point last_progress = std::chrono::steady_clock::now();
+        while (!ready()) {
+            _condition_var.wait_for(ul, std::chrono::milliseconds(10));
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            if (stream_progress() != progress) {
+                progress = stream_progress();
+                last_progress = now;
+            } else if (now - last_progress > std::chrono::milliseconds(HLS_STREAM_DEADLOCK_TIMEOUT_MS)) {
+                std::stringstream ss;
+                ss << "Hls::stream '" << _name << "' is " << state << " (depth " << _depth << ", " << _data.size() << " elements)";
+                throw stream_deadlock(ss.str());
+            }
+        }
+    }
 #endif    
 
   public:
@@ -179,7 +220,20 @@ class stream
         return _data.empty();
     }    
 
+#ifdef HLS_STREAM_THREAD_SAFE
+    bool full() {
+        std::lock_guard<std::mutex> lg(_mutex);
+        return _depth > 0 && _data.size() >= _depth;
+    }
+
+    /// Depth of the FIFO, only enforced by the threaded simulation
+    void set_depth(size_t depth) {
+        std::lock_guard<std::mutex> lg(_mutex);
+        _depth = depth;
+    }
+#else
     bool full() const { return false; }
+#endif
 
     /// Blocking read
     void read(__STREAM_T__& head) {
@@ -189,13 +243,13 @@ class stream
 #ifdef HLS_STREAM_THREAD_SAFE
     __STREAM_T__ read() {
         std::unique_lock<std::mutex> ul(_mutex);
-        while (_data.empty()) {
-            _condition_var.wait(ul);
-        }
+        wait_until(ul, [this]() { return !_data.empty(); }, "read while empty");
 
         __STREAM_T__ elem;
         elem = _data.front();
         _data.pop_front();
+        stream_progress()++;
+        _condition_var.notify_all();
         return elem;
     }
 #else
@@ -220,10 +274,12 @@ class stream
     void write(const __STREAM_T__& tail) { 
 #ifdef HLS_STREAM_THREAD_SAFE
         std::unique_lock<std::mutex> ul(_mutex);
+        wait_until(ul, [this]() { return _depth == 0 || _data.size() < _depth; }, "written while full");
 #endif
         _data.push_back(tail);
 #ifdef HLS_STREAM_THREAD_SAFE
-        _condition_var.notify_one();
+        stream_progress()++;
+        _condition_var.notify_all();
 #endif
     }
 
@@ -239,6 +295,10 @@ class stream
             __STREAM_T__ elem(_data.front());
             _data.pop_front();
             head = elem;
+#ifdef HLS_STREAM_THREAD_SAFE
+            stream_progress()++;
+            _condition_var.notify_all();
+#endif
         }
         return !is_empty;
     }
@@ -246,6 +306,9 @@ class stream
     /// Nonblocking write
     bool write_nb(const __STREAM_T__& tail) {
         bool is_full = full();
+#ifdef HLS_STREAM_THREAD_SAFE
+        if (is_full) return false;
+#endif
         write(tail);
         return !is_full;
     }
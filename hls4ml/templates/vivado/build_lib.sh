@@ -11,6 +11,12 @@ INCFLAGS="-Ifirmware/ap_types/"
 PROJECT=myproject
 LIB_STAMP=mystamp
 
+if [[ "$1" == "threaded" ]]; then
+    # Threaded C simulation, the streams are limited to their depth
+    CFLAGS="${CFLAGS} -DHLS_STREAM_THREAD_SAFE -pthread"
+    LIB_STAMP="${LIB_STAMP}-threaded"
+fi
+
 ${CC} ${CFLAGS} ${INCFLAGS} -c firmware/${PROJECT}.cpp -o ${PROJECT}.o
 ${CC} ${CFLAGS} ${INCFLAGS} -c ${PROJECT}_bridge.cpp -o ${PROJECT}_bridge.o
 ${CC} ${CFLAGS} ${INCFLAGS} -shared ${PROJECT}.o ${PROJECT}_bridge.o -o firmware/${PROJECT}-${LIB_STAMP}.so
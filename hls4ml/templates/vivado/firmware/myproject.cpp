@@ -41,3 +41,9 @@ void myproject(
 
     //hls-fpga-machine-learning insert layers
 }
+
+//hls-fpga-machine-learning insert batch
+
+//hls-fpga-machine-learning insert stateful
+
+//hls-fpga-machine-learning insert threaded
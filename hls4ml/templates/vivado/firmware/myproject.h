@@ -31,4 +31,10 @@ void myproject(
     //hls-fpga-machine-learning insert header
 );
 
+//hls-fpga-machine-learning insert batch
+
+//hls-fpga-machine-learning insert stateful
+
+//hls-fpga-machine-learning insert threaded
+
 #endif
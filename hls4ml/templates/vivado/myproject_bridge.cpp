@@ -63,6 +63,19 @@ void myproject_double(
     //hls-fpga-machine-learning insert wrapper #double
 }
 
+// Wrapper of the batched C simulation for Python bridge, only generated for some models
+//hls-fpga-machine-learning insert batch #float
+//hls-fpga-machine-learning insert batch #double
+
+// Stateful C simulation for Python bridge, only generated for models with recurrent layers
+//hls-fpga-machine-learning insert stateful #float
+//hls-fpga-machine-learning insert stateful #double
+//hls-fpga-machine-learning insert state handles
+
+// Threaded C simulation for Python bridge, only built with HLS_STREAM_THREAD_SAFE for io_stream models
+//hls-fpga-machine-learning insert threaded #float
+//hls-fpga-machine-learning insert threaded #double
+
 }
 
 #endif
@@ -108,5 +108,7 @@ int main(int argc, char **argv)
   fout.close();
   std::cout << "INFO: Saved inference results to file: " << RESULTS_LOG << std::endl;
 
+  //hls-fpga-machine-learning insert offchip
+
   return 0;
 }
@@ -10,6 +10,13 @@ struct transpose_config {
     static const unsigned width = 10;
     static const unsigned depth = 10;
     static constexpr unsigned perm[3] = {2, 0, 1};
+
+    // The permutation seen as n_batch transposes of a n_rows x n_cols matrix whose elements are blocks of
+    // n_inner contiguous values, n_rows is 0 if the permutation cannot be written this way
+    static const unsigned n_batch = 1;
+    static const unsigned n_rows = 10;
+    static const unsigned n_cols = 100;
+    static const unsigned n_inner = 1;
 };
 
 template<class data_T, class res_T, typename CONFIG_T>
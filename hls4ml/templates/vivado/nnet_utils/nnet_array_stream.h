@@ -0,0 +1,210 @@
+#ifndef NNET_ARRAY_STREAM_H_
+#define NNET_ARRAY_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_array.h"
+#include "hls_stream.h"
+
+namespace nnet {
+
+// The streaming transposes are split in a process writing the input into a buffer and a process reading the output
+// from it. In a dataflow region the buffer becomes a ping-pong buffer, the next tensor is written while the previous
+// one is read out, so a new tensor is accepted every max(input packets, output packets) cycles.
+
+// Transpose of a matrix, an input packet holds consecutive columns of a row and an output packet consecutive rows of
+// a column. Element (r, c) is stored in bank (r + c) % n_banks, so the elements of a packet are always in different
+// banks, both when writing and reading, and one packet is transferred per cycle on each side.
+template<class data_T, class res_T, typename CONFIG_T>
+struct transpose_matrix_buffer {
+    static const unsigned n_banks = MAX(data_T::size, res_T::size);
+    static const unsigned bank_cols = DIV_ROUNDUP(CONFIG_T::n_cols, n_banks);
+    static const unsigned depth = MAX(CONFIG_T::n_batch * CONFIG_T::n_rows * bank_cols, 1);
+};
+
+template<class data_T, class res_T, typename CONFIG_T>
+void transpose_matrix_write(
+    hls::stream<data_T> &data,
+    typename data_T::value_type buffer[transpose_matrix_buffer<data_T, res_T, CONFIG_T>::n_banks][transpose_matrix_buffer<data_T, res_T, CONFIG_T>::depth]
+) {
+    typedef transpose_matrix_buffer<data_T, res_T, CONFIG_T> buf_T;
+
+    WriteBatch: for (unsigned k = 0; k < CONFIG_T::n_batch; k++) {
+        WriteRows: for (unsigned r = 0; r < CONFIG_T::n_rows; r++) {
+            WriteCols: for (unsigned c = 0; c < CONFIG_T::n_cols; c += data_T::size) {
+                #pragma HLS PIPELINE
+                data_T in_data = data.read();
+                unsigned rotation = (r + c) % buf_T::n_banks;
+
+                WriteBanks: for (unsigned b = 0; b < buf_T::n_banks; b++) {
+                    #pragma HLS UNROLL
+                    unsigned j = (b + buf_T::n_banks - rotation) % buf_T::n_banks;
+                    if (j < data_T::size) {
+                        buffer[b][(k * CONFIG_T::n_rows + r) * buf_T::bank_cols + (c + j) / buf_T::n_banks] = in_data[j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void transpose_matrix_read(
+    typename data_T::value_type buffer[transpose_matrix_buffer<data_T, res_T, CONFIG_T>::n_banks][transpose_matrix_buffer<data_T, res_T, CONFIG_T>::depth],
+    hls::stream<res_T> &res
+) {
+    typedef transpose_matrix_buffer<data_T, res_T, CONFIG_T> buf_T;
+
+    ReadBatch: for (unsigned k = 0; k < CONFIG_T::n_batch; k++) {
+        ReadCols: for (unsigned c = 0; c < CONFIG_T::n_cols; c++) {
+            ReadRows: for (unsigned r = 0; r < CONFIG_T::n_rows; r += res_T::size) {
+                #pragma HLS PIPELINE
+                unsigned rotation = (r + c) % buf_T::n_banks;
+
+                typename data_T::value_type banks[buf_T::n_banks];
+                #pragma HLS ARRAY_PARTITION variable=banks complete
+                ReadBanks: for (unsigned b = 0; b < buf_T::n_banks; b++) {
+                    #pragma HLS UNROLL
+                    unsigned j = (b + buf_T::n_banks - rotation) % buf_T::n_banks;
+                    if (j < res_T::size) {
+                        banks[b] = buffer[b][(k * CONFIG_T::n_rows + r + j) * buf_T::bank_cols + c / buf_T::n_banks];
+                    }
+                }
+
+                res_T out_data;
+                #pragma HLS DATA_PACK variable=out_data
+                ReadPack: for (unsigned j = 0; j < res_T::size; j++) {
+                    #pragma HLS UNROLL
+                    out_data[j] = banks[(rotation + j) % buf_T::n_banks];
+                }
+                res.write(out_data);
+            }
+        }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void transpose_matrix(hls::stream<data_T> &data, hls::stream<res_T> &res) {
+    #pragma HLS DATAFLOW
+    typedef transpose_matrix_buffer<data_T, res_T, CONFIG_T> buf_T;
+
+    typename data_T::value_type buffer[buf_T::n_banks][buf_T::depth];
+    #pragma HLS ARRAY_PARTITION variable=buffer complete dim=1
+
+    transpose_matrix_write<data_T, res_T, CONFIG_T>(data, buffer);
+    transpose_matrix_read<data_T, res_T, CONFIG_T>(buffer, res);
+}
+
+// Transpose moving whole packets, used when the last dimension is not permuted (n_inner is a multiple of the packet size)
+template<class data_T, class res_T, typename CONFIG_T>
+void transpose_blocks_write(
+    hls::stream<data_T> &data,
+    typename data_T::value_type buffer[data_T::size][CONFIG_T::depth * CONFIG_T::height * CONFIG_T::width / data_T::size]
+) {
+    WritePackets: for (unsigned i = 0; i < CONFIG_T::depth * CONFIG_T::height * CONFIG_T::width / data_T::size; i++) {
+        #pragma HLS PIPELINE
+        data_T in_data = data.read();
+        WritePack: for (unsigned j = 0; j < data_T::size; j++) {
+            #pragma HLS UNROLL
+            buffer[j][i] = in_data[j];
+        }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void transpose_blocks_read(
+    typename data_T::value_type buffer[data_T::size][CONFIG_T::depth * CONFIG_T::height * CONFIG_T::width / data_T::size],
+    hls::stream<res_T> &res
+) {
+    const unsigned block_packets = CONFIG_T::n_inner / data_T::size;
+
+    ReadBatch: for (unsigned k = 0; k < CONFIG_T::n_batch; k++) {
+        ReadCols: for (unsigned c = 0; c < CONFIG_T::n_cols; c++) {
+            ReadRows: for (unsigned r = 0; r < CONFIG_T::n_rows; r++) {
+                ReadBlock: for (unsigned q = 0; q < block_packets; q++) {
+                    #pragma HLS PIPELINE
+                    unsigned i = ((k * CONFIG_T::n_rows + r) * CONFIG_T::n_cols + c) * block_packets + q;
+                    res_T out_data;
+                    #pragma HLS DATA_PACK variable=out_data
+                    ReadPack: for (unsigned j = 0; j < res_T::size; j++) {
+                        #pragma HLS UNROLL
+                        out_data[j] = buffer[j][i];
+                    }
+                    res.write(out_data);
+                }
+            }
+        }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void transpose_blocks(hls::stream<data_T> &data, hls::stream<res_T> &res) {
+    #pragma HLS DATAFLOW
+    assert(data_T::size == res_T::size);
+
+    typename data_T::value_type buffer[data_T::size][CONFIG_T::depth * CONFIG_T::height * CONFIG_T::width / data_T::size];
+    #pragma HLS ARRAY_PARTITION variable=buffer complete dim=1
+
+    transpose_blocks_write<data_T, res_T, CONFIG_T>(data, buffer);
+    transpose_blocks_read<data_T, res_T, CONFIG_T>(buffer, res);
+}
+
+// Any other permutation, the output is assembled one element per cycle
+template<class data_T, class res_T, typename CONFIG_T>
+void transpose_elements_read(
+    typename data_T::value_type buffer[data_T::size][CONFIG_T::depth * CONFIG_T::height * CONFIG_T::width / data_T::size],
+    hls::stream<res_T> &res
+) {
+    const unsigned dims[3] = { CONFIG_T::depth, CONFIG_T::height, CONFIG_T::width };
+    const unsigned strides[3] = { CONFIG_T::height * CONFIG_T::width, CONFIG_T::width, 1 };
+    const unsigned dims_t[3] = { dims[CONFIG_T::perm[0]], dims[CONFIG_T::perm[1]], dims[CONFIG_T::perm[2]] };
+
+    res_T out_data;
+    #pragma HLS DATA_PACK variable=out_data
+
+    ReadDim0: for (unsigned i0 = 0; i0 < dims_t[0]; i0++) {
+        ReadDim1: for (unsigned i1 = 0; i1 < dims_t[1]; i1++) {
+            ReadDim2: for (unsigned i2 = 0; i2 < dims_t[2]; i2++) {
+                #pragma HLS PIPELINE
+                unsigned src = i0 * strides[CONFIG_T::perm[0]] + i1 * strides[CONFIG_T::perm[1]] + i2 * strides[CONFIG_T::perm[2]];
+                unsigned j = i2 % res_T::size;
+                out_data[j] = buffer[src % data_T::size][src / data_T::size];
+                if (j == res_T::size - 1) {
+                    res.write(out_data);
+                }
+            }
+        }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void transpose_elements(hls::stream<data_T> &data, hls::stream<res_T> &res) {
+    #pragma HLS DATAFLOW
+
+    typename data_T::value_type buffer[data_T::size][CONFIG_T::depth * CONFIG_T::height * CONFIG_T::width / data_T::size];
+    #pragma HLS ARRAY_PARTITION variable=buffer complete dim=1
+
+    transpose_blocks_write<data_T, res_T, CONFIG_T>(data, buffer);
+    transpose_elements_read<data_T, res_T, CONFIG_T>(buffer, res);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void transpose_2d(hls::stream<data_T> &data, hls::stream<res_T> &res) {
+    #pragma HLS INLINE
+    transpose_matrix<data_T, res_T, CONFIG_T>(data, res);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void transpose_3d(hls::stream<data_T> &data, hls::stream<res_T> &res) {
+    #pragma HLS INLINE
+    if (CONFIG_T::n_rows == 0) {
+        transpose_elements<data_T, res_T, CONFIG_T>(data, res);
+    } else if (CONFIG_T::n_inner == 1) {
+        transpose_matrix<data_T, res_T, CONFIG_T>(data, res);
+    } else {
+        transpose_blocks<data_T, res_T, CONFIG_T>(data, res);
+    }
+}
+
+}
+
+#endif
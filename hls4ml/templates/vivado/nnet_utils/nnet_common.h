@@ -32,6 +32,7 @@ namespace nnet {
 // Common type definitions
 enum io_type {io_parallel = 0, io_serial, io_stream};
 enum strategy { latency, resource };
+enum memory_impl { mem_auto = 0, mem_bram, mem_uram, mem_lutram, mem_register };
 
  /* ---
   * Balanced tree reduce implementation.
@@ -21,7 +21,7 @@ int compute_multiplier_limit(
 
                     int index_weight = jj*CONFIG_T::n_chan*CONFIG_T::n_filt + cc*CONFIG_T::n_filt + ff;
 
-                    if((ii*CONFIG_T::stride_width+jj) < CONFIG_T::pad_left || (ii*CONFIG_T::stride_width+jj) >= (CONFIG_T::pad_left + CONFIG_T::in_width)){
+                    if((ii*CONFIG_T::stride_width+jj*CONFIG_T::dilation) < CONFIG_T::pad_left || (ii*CONFIG_T::stride_width+jj*CONFIG_T::dilation) >= (CONFIG_T::pad_left + CONFIG_T::in_width)){
                         //padded -- do nothing
                         continue;
                     } else {
@@ -74,9 +74,9 @@ void conv_1d_latency_cl(
 
                     int index_mult   = ii*CONFIG_T::n_filt*CONFIG_T::n_chan*CONFIG_T::filt_width + ff*CONFIG_T::n_chan*CONFIG_T::filt_width + cc*CONFIG_T::filt_width + jj;
                     int index_weight = jj*CONFIG_T::n_chan*CONFIG_T::n_filt + cc*CONFIG_T::n_filt + ff;
-                    int index_data   = (ii*CONFIG_T::stride_width+jj-CONFIG_T::pad_left) * CONFIG_T::n_chan + cc;
+                    int index_data   = (ii*CONFIG_T::stride_width+jj*CONFIG_T::dilation-CONFIG_T::pad_left) * CONFIG_T::n_chan + cc;
 
-                    if((ii*CONFIG_T::stride_width+jj) < CONFIG_T::pad_left || (ii*CONFIG_T::stride_width+jj) >= (CONFIG_T::pad_left + CONFIG_T::in_width)){
+                    if((ii*CONFIG_T::stride_width+jj*CONFIG_T::dilation) < CONFIG_T::pad_left || (ii*CONFIG_T::stride_width+jj*CONFIG_T::dilation) >= (CONFIG_T::pad_left + CONFIG_T::in_width)){
                         mult[index_mult] = 0;
                     }
                     else {
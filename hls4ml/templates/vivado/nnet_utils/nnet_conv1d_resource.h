@@ -148,7 +148,7 @@ void im2col_1d_cl(data_T data[CONFIG_T::in_width * CONFIG_T::n_chan], data_T dat
 
         ChannelLoop:
         for (int channel = 0; channel < CONFIG_T::n_chan; channel++) {
-            int index_data = (col*CONFIG_T::stride_width+kernel_col-CONFIG_T::pad_left) * CONFIG_T::n_chan + channel;
+            int index_data = (col*CONFIG_T::stride_width+kernel_col*CONFIG_T::dilation-CONFIG_T::pad_left) * CONFIG_T::n_chan + channel;
 
             if (index_data >= 0 && index_data < CONFIG_T::in_width*CONFIG_T::n_chan) {
                 data_col[index] = data[index_data];
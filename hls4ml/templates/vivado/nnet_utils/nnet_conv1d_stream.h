@@ -30,6 +30,7 @@ void conv_1d_encoded_cl(
     typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt])
 {
     assert(CONFIG_T::pad_left == 0 && CONFIG_T::pad_right == 0);
+    assert(CONFIG_T::dilation == 1);
 
     hls::stream<typename data_T::value_type> data_window[CONFIG_T::filt_width * CONFIG_T::n_chan];
     const int win_depth = CONFIG_T::out_width;
@@ -56,6 +57,24 @@ void conv_1d_encoded_cl(
     }
 }
 
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_1d_buffer_parallel_cl(
+    hls::stream<data_T> &data,
+    hls::stream<res_T>  &res,
+    typename CONFIG_T::weight_t weights[CONFIG_T::filt_width * CONFIG_T::n_chan * CONFIG_T::n_filt],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt])
+{
+    assert(CONFIG_T::pad_left == 0 && CONFIG_T::pad_right == 0);
+    assert(CONFIG_T::in_width % CONFIG_T::parallelization_factor == 0);
+    assert(data_T::size == CONFIG_T::parallelization_factor * CONFIG_T::n_chan);
+    assert(res_T::size % CONFIG_T::n_filt == 0);
+
+    ReadInputWidth: for (unsigned i_iw = 0; i_iw < CONFIG_T::in_width / CONFIG_T::parallelization_factor; i_iw++) {
+        #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+        compute_output_buffer_1d_parallel<data_T, res_T, CONFIG_T>(data.read(), res, weights, biases);
+    }
+}
+
 template<class data_T, class res_T, typename CONFIG_T>
 void conv_1d_buffer_cl(
     hls::stream<data_T> &data,
@@ -65,6 +84,11 @@ void conv_1d_buffer_cl(
 {
     assert(CONFIG_T::pad_left == 0 && CONFIG_T::pad_right == 0);
 
+    if (CONFIG_T::parallelization_factor > 1) {
+        conv_1d_buffer_parallel_cl<data_T, res_T, CONFIG_T>(data, res, weights, biases);
+        return;
+    }
+
     ReadInputWidth: for (unsigned i_iw = 0; i_iw < CONFIG_T::in_width; i_iw++) {
         #pragma HLS LOOP_FLATTEN
         if (CONFIG_T::strategy == nnet::latency) {
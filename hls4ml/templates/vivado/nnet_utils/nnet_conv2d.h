@@ -54,6 +54,7 @@ struct conv2d_config
     static const unsigned dilation_width = 1;
 
     static const unsigned reuse_factor = 1;
+    static const unsigned parallelization_factor = 1;
     static const bool store_weights_in_bram = false;
     static const unsigned n_zeros = 0; // not used yet
 };
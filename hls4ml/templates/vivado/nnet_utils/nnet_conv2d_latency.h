@@ -27,10 +27,10 @@ template<typename CONFIG_T>
                                                  + cc*CONFIG_T::n_filt
                                                   + ff;
 
-                                if ((oh*CONFIG_T::stride_height+fh) < CONFIG_T::pad_top
-                                || (oh*CONFIG_T::stride_height+fh) >= (CONFIG_T::pad_top+CONFIG_T::in_height)
-                                || (ow*CONFIG_T::stride_width+fw) < CONFIG_T::pad_left
-                                || (ow*CONFIG_T::stride_width+fw) >= (CONFIG_T::pad_left+CONFIG_T::in_width)) {
+                                if ((oh*CONFIG_T::stride_height+fh*CONFIG_T::dilation_height) < CONFIG_T::pad_top
+                                || (oh*CONFIG_T::stride_height+fh*CONFIG_T::dilation_height) >= (CONFIG_T::pad_top+CONFIG_T::in_height)
+                                || (ow*CONFIG_T::stride_width+fw*CONFIG_T::dilation_width) < CONFIG_T::pad_left
+                                || (ow*CONFIG_T::stride_width+fw*CONFIG_T::dilation_width) >= (CONFIG_T::pad_left+CONFIG_T::in_width)) {
                                     //padded - do nothing
                                     continue;
                                 } else {
@@ -95,15 +95,15 @@ void conv_2d_latency_cf(
                                                  + cc*CONFIG_T::n_filt
                                                  + ff;
 
-                                if ((oh*CONFIG_T::stride_height+fh) < CONFIG_T::pad_top
-                                || (oh*CONFIG_T::stride_height+fh) >= (CONFIG_T::pad_top+CONFIG_T::in_height)
-                                || (ow*CONFIG_T::stride_width+fw) < CONFIG_T::pad_left
-                                || (ow*CONFIG_T::stride_width+fw) >= (CONFIG_T::pad_left+CONFIG_T::in_width)) {
+                                if ((oh*CONFIG_T::stride_height+fh*CONFIG_T::dilation_height) < CONFIG_T::pad_top
+                                || (oh*CONFIG_T::stride_height+fh*CONFIG_T::dilation_height) >= (CONFIG_T::pad_top+CONFIG_T::in_height)
+                                || (ow*CONFIG_T::stride_width+fw*CONFIG_T::dilation_width) < CONFIG_T::pad_left
+                                || (ow*CONFIG_T::stride_width+fw*CONFIG_T::dilation_width) >= (CONFIG_T::pad_left+CONFIG_T::in_width)) {
                                     mult[index_mult] = 0;
                                 } else {
                                     int index_data = cc*CONFIG_T::in_height*CONFIG_T::in_width
-                                                   + (oh*CONFIG_T::stride_height+fh-CONFIG_T::pad_top)*CONFIG_T::in_width
-                                                   + (ow*CONFIG_T::stride_width+fw-CONFIG_T::pad_left);
+                                                   + (oh*CONFIG_T::stride_height+fh*CONFIG_T::dilation_height-CONFIG_T::pad_top)*CONFIG_T::in_width
+                                                   + (ow*CONFIG_T::stride_width+fw*CONFIG_T::dilation_width-CONFIG_T::pad_left);
                                     mult[index_mult] = data[index_data] * weights[index_weight];
                                 }
 
@@ -211,14 +211,14 @@ void conv_2d_latency_cl(
                                                  + cc*CONFIG_T::n_filt
                                                  + ff;
 
-                                if ((oh*CONFIG_T::stride_height+fh) < CONFIG_T::pad_top
-                                || (oh*CONFIG_T::stride_height+fh) >= (CONFIG_T::pad_top+CONFIG_T::in_height)
-                                || (ow*CONFIG_T::stride_width+fw) < CONFIG_T::pad_left
-                                || (ow*CONFIG_T::stride_width+fw) >= (CONFIG_T::pad_left+CONFIG_T::in_width)) {
+                                if ((oh*CONFIG_T::stride_height+fh*CONFIG_T::dilation_height) < CONFIG_T::pad_top
+                                || (oh*CONFIG_T::stride_height+fh*CONFIG_T::dilation_height) >= (CONFIG_T::pad_top+CONFIG_T::in_height)
+                                || (ow*CONFIG_T::stride_width+fw*CONFIG_T::dilation_width) < CONFIG_T::pad_left
+                                || (ow*CONFIG_T::stride_width+fw*CONFIG_T::dilation_width) >= (CONFIG_T::pad_left+CONFIG_T::in_width)) {
                                     mult[index_mult] = 0;
                                 } else {
-                                    int index_data = (oh*CONFIG_T::stride_height+fh-CONFIG_T::pad_top)*CONFIG_T::in_width*CONFIG_T::n_chan
-                                                   + (ow*CONFIG_T::stride_width+fw-CONFIG_T::pad_left)*CONFIG_T::n_chan
+                                    int index_data = (oh*CONFIG_T::stride_height+fh*CONFIG_T::dilation_height-CONFIG_T::pad_top)*CONFIG_T::in_width*CONFIG_T::n_chan
+                                                   + (ow*CONFIG_T::stride_width+fw*CONFIG_T::dilation_width-CONFIG_T::pad_left)*CONFIG_T::n_chan
                                                    + cc;
                                     mult[index_mult] = data[index_data] * weights[index_weight];
                                 }
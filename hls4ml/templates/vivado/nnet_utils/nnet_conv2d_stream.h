@@ -34,6 +34,7 @@ void conv_2d_encoded_cl(
 {
     assert(CONFIG_T::pad_top == 0 && CONFIG_T::pad_bottom == 0 && CONFIG_T::pad_left == 0 && CONFIG_T::pad_right == 0);
     assert(CONFIG_T::filt_height == CONFIG_T::filt_width);
+    assert(CONFIG_T::dilation_height == 1 && CONFIG_T::dilation_width == 1);
 
     hls::stream<typename data_T::value_type> data_window[CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan];
     const int win_depth = CONFIG_T::filt_height * CONFIG_T::out_width;
@@ -63,6 +64,35 @@ void conv_2d_encoded_cl(
 }
 
 // Line Buffer
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_2d_buffer_parallel_cl(
+    hls::stream<data_T> &data,
+    hls::stream<res_T>  &res,
+    typename CONFIG_T::weight_t weights[CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan * CONFIG_T::n_filt],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt])
+{
+    assert(CONFIG_T::pad_top == 0 && CONFIG_T::pad_bottom == 0 && CONFIG_T::pad_left == 0 && CONFIG_T::pad_right == 0);
+    assert(CONFIG_T::in_width % CONFIG_T::parallelization_factor == 0);
+    assert(data_T::size == CONFIG_T::parallelization_factor * CONFIG_T::n_chan);
+    assert(res_T::size % CONFIG_T::n_filt == 0);
+
+    // One line buffer per lane, each holding every 'parallelization_factor'-th pixel of the row
+    static ap_shift_reg<typename data_T::value_type, CONFIG_T::dilation_height * CONFIG_T::in_width / CONFIG_T::parallelization_factor> line_buffer[MAX(CONFIG_T::filt_height - 1,1)][CONFIG_T::parallelization_factor * CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable = line_buffer complete dim = 2
+
+    ReadInputHeight: for (unsigned i_ih = 0; i_ih < CONFIG_T::in_height; i_ih++) {
+        ReadInputWidth: for (unsigned i_iw = 0; i_iw < CONFIG_T::in_width / CONFIG_T::parallelization_factor; i_iw++) {
+            #pragma HLS LOOP_FLATTEN
+            #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+            if (CONFIG_T::filt_height > 1) {
+                compute_output_buffer_2d_parallel<data_T, res_T, CONFIG_T>(data.read(), line_buffer, res, weights, biases);
+            } else {
+                compute_output_buffer_1d_parallel<data_T, res_T, CONFIG_T, CONFIG_T::dilation_width>(data.read(), res, weights, biases);
+            }
+        }
+    }
+}
+
 template <class data_T, class res_T, typename CONFIG_T>
 void conv_2d_buffer_cl(
     hls::stream<data_T> &data,
@@ -72,7 +102,13 @@ void conv_2d_buffer_cl(
 {
     assert(CONFIG_T::pad_top == 0 && CONFIG_T::pad_bottom == 0 && CONFIG_T::pad_left == 0 && CONFIG_T::pad_right == 0);
 
-    static ap_shift_reg<typename data_T::value_type, CONFIG_T::in_width> line_buffer[MAX(CONFIG_T::filt_height - 1,1)][CONFIG_T::n_chan];
+    if (CONFIG_T::parallelization_factor > 1) {
+        conv_2d_buffer_parallel_cl<data_T, res_T, CONFIG_T>(data, res, weights, biases);
+        return;
+    }
+
+    // Line buffers span 'dilation_height' rows so dilated kernels see the right input rows
+    static ap_shift_reg<typename data_T::value_type, CONFIG_T::dilation_height * CONFIG_T::in_width> line_buffer[MAX(CONFIG_T::filt_height - 1,1)][CONFIG_T::n_chan];
     #pragma HLS ARRAY_PARTITION variable = line_buffer complete dim = 2
 
     ReadInputHeight: for (unsigned i_ih = 0; i_ih < CONFIG_T::in_height; i_ih++) {
@@ -84,7 +120,7 @@ void conv_2d_buffer_cl(
             if (CONFIG_T::filt_height > 1) {
                 compute_output_buffer_2d<data_T, res_T, CONFIG_T>(data.read(), line_buffer, res, weights, biases);
             } else {
-                compute_output_buffer_1d<data_T, res_T, CONFIG_T>(data.read(), res, weights, biases);
+                compute_output_buffer_1d<data_T, res_T, CONFIG_T, CONFIG_T::dilation_width>(data.read(), res, weights, biases);
             }
         }
     }
@@ -235,19 +235,92 @@ void shift_line_buffer(const data_T& in_elem,
     kernel_shift_2d<data_T, CONFIG_T>(shift_buffer, kernel_window);
 }
 
+// Dilated variants of the kernel shift. Each kernel column is fed from the column to its right
+// through a shift register of depth 'dilation', so the window spans (filt - 1) * dilation + 1 pixels
+// while only filt taps are kept in registers. With dilation = 1 this is the plain shift above.
+template <class data_T, typename CONFIG_T, unsigned dilation_width>
+void kernel_shift_1d_dilated(
+    const data_T& in_elem,
+    ap_shift_reg<typename data_T::value_type, dilation_width> tap_buffer[MAX(CONFIG_T::filt_width - 1,1)][CONFIG_T::n_chan],
+    typename data_T::value_type kernel_window[CONFIG_T::filt_width * CONFIG_T::n_chan]
+) {
+    #pragma HLS inline
+
+    // Insert new pixel into right-most column of kernel
+    static const int lastheight = (CONFIG_T::filt_width - 1) * CONFIG_T::n_chan;
+    KernelPushChannel: for (unsigned i_ic = 0; i_ic < CONFIG_T::n_chan; i_ic++) {
+        #pragma HLS UNROLL
+        kernel_window[lastheight + i_ic] = in_elem[i_ic];
+    }
+
+    // Walk right to left, each column receives the pixel seen 'dilation_width' steps before its right neighbour
+    KernelTapWidth: for (int i_iw = CONFIG_T::filt_width - 2; i_iw >= 0; i_iw--) {
+        #pragma HLS UNROLL
+        KernelTapChannel: for (unsigned i_ic = 0; i_ic < CONFIG_T::n_chan; i_ic++) {
+            #pragma HLS UNROLL
+            kernel_window[i_iw * CONFIG_T::n_chan + i_ic] = tap_buffer[i_iw][i_ic].shift(kernel_window[(i_iw + 1) * CONFIG_T::n_chan + i_ic]);
+        }
+    }
+}
+
+template <class data_T, typename CONFIG_T>
+void shift_line_buffer_dilated(const data_T& in_elem,
+                    ap_shift_reg<typename data_T::value_type, CONFIG_T::dilation_height * CONFIG_T::in_width> line_buffer[MAX(CONFIG_T::filt_height - 1,1)][CONFIG_T::n_chan],
+                    ap_shift_reg<typename data_T::value_type, CONFIG_T::dilation_width> tap_buffer[CONFIG_T::filt_height][MAX(CONFIG_T::filt_width - 1,1)][CONFIG_T::n_chan],
+                    typename data_T::value_type kernel_window[CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan]
+) {
+
+    #pragma HLS PIPELINE
+
+    // Temporary buffer for popped (shifted) elements
+    typename data_T::value_type shift_buffer[CONFIG_T::filt_height][CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable = shift_buffer complete dim = 0
+
+    UpdateBuffer: for (int i_ic = 0; i_ic < CONFIG_T::n_chan; i_ic++) {
+        #pragma HLS UNROLL
+
+        // Insert pixel(s) at end of shift buffer
+        shift_buffer[CONFIG_T::filt_height - 1][i_ic] = in_elem[i_ic];
+    }
+
+    LineBufferDataIn: for (int i_ic = 0; i_ic < CONFIG_T::n_chan; i_ic++) {
+        // Shift the shift buffer into the line buffer, each line buffer holds 'dilation_height' rows
+        LineBufferShift: for (unsigned i_ih = 1; i_ih < CONFIG_T::filt_height; i_ih++) {
+            #pragma HLS UNROLL
+            typename data_T::value_type pop_elem = line_buffer[i_ih - 1][i_ic].shift(shift_buffer[CONFIG_T::filt_height - i_ih][i_ic]); // Shift the line buffer, return the popped pixel
+            shift_buffer[CONFIG_T::filt_height - i_ih - 1][i_ic] = pop_elem; // Popped element placed back into shift_buffer, one (dilated) row up.
+        }
+    }
+
+    // Insert shift_buffer column into right-most column of kernel and propagate through the tap buffers
+    static const int lastheight = (CONFIG_T::filt_width - 1) * CONFIG_T::n_chan;
+    KernelPushHeight: for (int i_ih = 0; i_ih < CONFIG_T::filt_height; i_ih++) {
+        #pragma HLS UNROLL
+        KernelPushChannel: for (int i_ic = 0; i_ic < CONFIG_T::n_chan; i_ic++) {
+            kernel_window[lastheight + i_ih * CONFIG_T::filt_width * CONFIG_T::n_chan + i_ic] = shift_buffer[i_ih][i_ic];
+        }
+        KernelTapWidth: for (int i_iw = CONFIG_T::filt_width - 2; i_iw >= 0; i_iw--) {
+            KernelTapChannel: for (int i_ic = 0; i_ic < CONFIG_T::n_chan; i_ic++) {
+                kernel_window[i_ih * CONFIG_T::filt_width * CONFIG_T::n_chan + i_iw * CONFIG_T::n_chan + i_ic] =
+                    tap_buffer[i_ih][i_iw][i_ic].shift(kernel_window[i_ih * CONFIG_T::filt_width * CONFIG_T::n_chan + (i_iw + 1) * CONFIG_T::n_chan + i_ic]);
+            }
+        }
+    }
+}
+
 template<class data_T, class res_T, typename CONFIG_T>
 void compute_output_buffer_2d(
     const data_T& in_elem,
-    ap_shift_reg<typename data_T::value_type, CONFIG_T::in_width> line_buffer[MAX(CONFIG_T::filt_height - 1,1)][CONFIG_T::n_chan],
+    ap_shift_reg<typename data_T::value_type, CONFIG_T::dilation_height * CONFIG_T::in_width> line_buffer[MAX(CONFIG_T::filt_height - 1,1)][CONFIG_T::n_chan],
     hls::stream<res_T> &res_stream,
     typename CONFIG_T::weight_t weights[CONFIG_T::kernel_size * CONFIG_T::n_chan * CONFIG_T::n_filt],
     typename CONFIG_T::bias_t biases[CONFIG_T::n_filt]
 ) {
     #pragma HLS INLINE
 
-    // Thresholds
-    const static int lShiftX = CONFIG_T::filt_width - 1;
-    const static int lShiftY = CONFIG_T::filt_height - 1;
+    // Thresholds (dilated receptive field)
+    const static int lShiftX = CONFIG_T::dilation_width * (CONFIG_T::filt_width - 1);
+    const static int lShiftY = CONFIG_T::dilation_height * (CONFIG_T::filt_height - 1);
 
     // Counters
     static int pX = 0; // Pixel X
@@ -259,6 +332,9 @@ void compute_output_buffer_2d(
     static typename data_T::value_type kernel_data[CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan];
     #pragma HLS ARRAY_PARTITION variable=kernel_data complete
 
+    static ap_shift_reg<typename data_T::value_type, CONFIG_T::dilation_width> tap_buffer[CONFIG_T::filt_height][MAX(CONFIG_T::filt_width - 1,1)][CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=tap_buffer complete dim = 0
+
     typename res_T::value_type res_out[CONFIG_T::n_filt];
     #pragma HLS ARRAY_PARTITION variable=res_out complete dim = 0
 
@@ -266,7 +342,7 @@ void compute_output_buffer_2d(
     #pragma HLS DATA_PACK variable=res_pack
 
     // Add pixel to buffer
-    nnet::shift_line_buffer<data_T, CONFIG_T>(in_elem, line_buffer, kernel_data);
+    nnet::shift_line_buffer_dilated<data_T, CONFIG_T>(in_elem, line_buffer, tap_buffer, kernel_data);
 
     // Check to see if we have a full kernel
     if ( (sX - lShiftX) == 0 && (sY - lShiftY) == 0 && pY > lShiftY - 1 && pX > lShiftX - 1) {
@@ -310,7 +386,8 @@ void compute_output_buffer_2d(
 }
 
 // Conv 1D compute output
-template<class data_T, class res_T, typename CONFIG_T>
+// The dilation is a template parameter so Conv2D layers with filt_height == 1 can pass their dilation_width
+template<class data_T, class res_T, typename CONFIG_T, unsigned dilation_width = CONFIG_T::dilation>
 void compute_output_buffer_1d(
     const data_T& in_elem,
     hls::stream<res_T> &res_stream,
@@ -319,8 +396,8 @@ void compute_output_buffer_1d(
 ) {
     #pragma HLS INLINE
 
-    // Thresholds
-    const static int lShiftX = CONFIG_T::filt_width - 1;
+    // Thresholds (dilated receptive field)
+    const static int lShiftX = dilation_width * (CONFIG_T::filt_width - 1);
 
     // Counters
     static int pX = 0; // pixel counter
@@ -329,6 +406,9 @@ void compute_output_buffer_1d(
     static typename data_T::value_type kernel_data[CONFIG_T::filt_width * CONFIG_T::n_chan];
     #pragma HLS ARRAY_PARTITION variable=kernel_data complete
 
+    static ap_shift_reg<typename data_T::value_type, dilation_width> tap_buffer[MAX(CONFIG_T::filt_width - 1,1)][CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=tap_buffer complete dim = 0
+
     typename res_T::value_type res_out[CONFIG_T::n_filt];
     #pragma HLS ARRAY_PARTITION variable=res_out complete dim = 0
 
@@ -336,7 +416,7 @@ void compute_output_buffer_1d(
     #pragma HLS DATA_PACK variable=res_pack
 
     // Add pixel to buffer
-    nnet::kernel_shift_1d<data_T, CONFIG_T>(in_elem, kernel_data);
+    nnet::kernel_shift_1d_dilated<data_T, CONFIG_T, dilation_width>(in_elem, tap_buffer, kernel_data);
 
     // Check to see if we have a full kernel
     if ( (sX - lShiftX) == 0 && pX > lShiftX - 1 ) {
@@ -371,5 +451,218 @@ void compute_output_buffer_1d(
     }
 }
 
+// *************************************************
+//       Parallel Line Buffer Implementation
+// *************************************************
+// Processes 'parallelization_factor' (P) adjacent pixels of a row per call. The input stream packs
+// P pixels per element (data_T::size == P * n_chan) and the output stream packs P output pixels
+// (res_T::size == P * n_filt). Every lane has its own dense engine, so a row of in_width pixels is
+// consumed in in_width / P iterations of II=reuse_factor.
+
+template<class data_T, class res_T, typename CONFIG_T>
+void pack_output_parallel(
+    typename res_T::value_type res_out[CONFIG_T::n_filt],
+    res_T &res_pack,
+    unsigned &outputs_ready,
+    hls::stream<res_T> &res_stream
+) {
+    #pragma HLS INLINE
+
+    CastLoop: for (unsigned i_ic = 0; i_ic < CONFIG_T::n_filt; i_ic++) {
+        #pragma HLS UNROLL
+        res_pack[outputs_ready * CONFIG_T::n_filt + i_ic] = res_out[i_ic];
+    }
+
+    if (outputs_ready == (res_T::size / CONFIG_T::n_filt) - 1) {
+        res_stream.write(res_pack);
+        outputs_ready = 0;
+    } else {
+        outputs_ready++;
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void compute_output_buffer_2d_parallel(
+    const data_T& in_elem,
+    ap_shift_reg<typename data_T::value_type, CONFIG_T::dilation_height * CONFIG_T::in_width / CONFIG_T::parallelization_factor> line_buffer[MAX(CONFIG_T::filt_height - 1,1)][CONFIG_T::parallelization_factor * CONFIG_T::n_chan],
+    hls::stream<res_T> &res_stream,
+    typename CONFIG_T::weight_t weights[CONFIG_T::kernel_size * CONFIG_T::n_chan * CONFIG_T::n_filt],
+    typename CONFIG_T::bias_t biases[CONFIG_T::n_filt]
+) {
+    #pragma HLS INLINE
+
+    static const unsigned P = CONFIG_T::parallelization_factor;
+
+    // Thresholds (dilated receptive field)
+    const static int lShiftX = CONFIG_T::dilation_width * (CONFIG_T::filt_width - 1);
+    const static int lShiftY = CONFIG_T::dilation_height * (CONFIG_T::filt_height - 1);
+
+    // The window holds the receptive field of the left-most lane plus the P - 1 columns to its right
+    static const unsigned win_width = lShiftX + P;
+
+    // Counters
+    static int pX = 0; // Pixel X of the first lane
+    static int pY = 0; // Pixel Y
+
+    static typename data_T::value_type window[CONFIG_T::filt_height][win_width][CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=window complete dim = 0
+
+    static res_T res_pack;
+    #pragma HLS DATA_PACK variable=res_pack
+    static unsigned outputs_ready = 0;
+
+    // Pass the P new pixels through the line buffers, one column of filt_height pixels per lane
+    typename data_T::value_type col_block[CONFIG_T::filt_height][P][CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=col_block complete dim = 0
+
+    LineBufferLane: for (unsigned i_p = 0; i_p < P; i_p++) {
+        #pragma HLS UNROLL
+        LineBufferChan: for (unsigned i_ic = 0; i_ic < CONFIG_T::n_chan; i_ic++) {
+            #pragma HLS UNROLL
+            col_block[CONFIG_T::filt_height - 1][i_p][i_ic] = in_elem[i_p * CONFIG_T::n_chan + i_ic];
+            LineBufferShift: for (unsigned i_ih = 1; i_ih < CONFIG_T::filt_height; i_ih++) {
+                #pragma HLS UNROLL
+                col_block[CONFIG_T::filt_height - i_ih - 1][i_p][i_ic] = line_buffer[i_ih - 1][i_p * CONFIG_T::n_chan + i_ic].shift(col_block[CONFIG_T::filt_height - i_ih][i_p][i_ic]);
+            }
+        }
+    }
+
+    // Shift the window P columns to the left and append the new columns
+    WindowHeight: for (unsigned i_ih = 0; i_ih < CONFIG_T::filt_height; i_ih++) {
+        #pragma HLS UNROLL
+        WindowShift: for (unsigned i_iw = 0; i_iw < win_width - P; i_iw++) {
+            #pragma HLS UNROLL
+            for (unsigned i_ic = 0; i_ic < CONFIG_T::n_chan; i_ic++) {
+                #pragma HLS UNROLL
+                window[i_ih][i_iw][i_ic] = window[i_ih][i_iw + P][i_ic];
+            }
+        }
+        WindowPush: for (unsigned i_p = 0; i_p < P; i_p++) {
+            #pragma HLS UNROLL
+            for (unsigned i_ic = 0; i_ic < CONFIG_T::n_chan; i_ic++) {
+                #pragma HLS UNROLL
+                window[i_ih][win_width - P + i_p][i_ic] = col_block[i_ih][i_p][i_ic];
+            }
+        }
+    }
+
+    // Each lane completes a kernel whose bottom-right pixel is (pX + i_p, pY)
+    bool row_valid = pY >= lShiftY && (pY - lShiftY) % CONFIG_T::stride_height == 0;
+
+    LaneLoop: for (unsigned i_p = 0; i_p < P; i_p++) {
+        #pragma HLS UNROLL
+        int x = pX + i_p;
+        if (row_valid && x >= lShiftX && (x - lShiftX) % CONFIG_T::stride_width == 0) {
+            typename data_T::value_type kernel_data[CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan];
+            #pragma HLS ARRAY_PARTITION variable=kernel_data complete
+            typename res_T::value_type res_out[CONFIG_T::n_filt];
+            #pragma HLS ARRAY_PARTITION variable=res_out complete dim = 0
+
+            KernelHeight: for (unsigned i_ih = 0; i_ih < CONFIG_T::filt_height; i_ih++) {
+                #pragma HLS UNROLL
+                KernelWidth: for (unsigned i_iw = 0; i_iw < CONFIG_T::filt_width; i_iw++) {
+                    #pragma HLS UNROLL
+                    KernelChan: for (unsigned i_ic = 0; i_ic < CONFIG_T::n_chan; i_ic++) {
+                        #pragma HLS UNROLL
+                        kernel_data[i_ih * CONFIG_T::filt_width * CONFIG_T::n_chan + i_iw * CONFIG_T::n_chan + i_ic] = window[i_ih][i_p + i_iw * CONFIG_T::dilation_width][i_ic];
+                    }
+                }
+            }
+
+            // Dense multiply
+            #pragma HLS INLINE region
+            if (CONFIG_T::strategy == nnet::latency) {
+                dense_latency<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(kernel_data, res_out, weights, biases);
+            } else {
+                dense_resource<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(kernel_data, res_out, weights, biases);
+            }
+
+            pack_output_parallel<data_T, res_T, CONFIG_T>(res_out, res_pack, outputs_ready, res_stream);
+        }
+    }
+
+    // Counter Housekeeping
+    if (pX + P == CONFIG_T::in_width) { // End of line
+        pX = 0;
+        pY = (pY + 1 == CONFIG_T::in_height) ? 0 : pY + 1;
+    } else {
+        pX = pX + P;
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T, unsigned dilation_width = CONFIG_T::dilation>
+void compute_output_buffer_1d_parallel(
+    const data_T& in_elem,
+    hls::stream<res_T> &res_stream,
+    typename CONFIG_T::weight_t weights[CONFIG_T::kernel_size * CONFIG_T::n_chan * CONFIG_T::n_filt],
+    typename CONFIG_T::bias_t biases[CONFIG_T::n_filt]
+) {
+    #pragma HLS INLINE
+
+    static const unsigned P = CONFIG_T::parallelization_factor;
+
+    // Thresholds (dilated receptive field)
+    const static int lShiftX = dilation_width * (CONFIG_T::filt_width - 1);
+    static const unsigned win_width = lShiftX + P;
+
+    // Counters
+    static int pX = 0; // Pixel X of the first lane
+
+    static typename data_T::value_type window[win_width][CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=window complete dim = 0
+
+    static res_T res_pack;
+    #pragma HLS DATA_PACK variable=res_pack
+    static unsigned outputs_ready = 0;
+
+    // Shift the window P pixels to the left and append the new pixels
+    WindowShift: for (unsigned i_iw = 0; i_iw < win_width - P; i_iw++) {
+        #pragma HLS UNROLL
+        for (unsigned i_ic = 0; i_ic < CONFIG_T::n_chan; i_ic++) {
+            #pragma HLS UNROLL
+            window[i_iw][i_ic] = window[i_iw + P][i_ic];
+        }
+    }
+    WindowPush: for (unsigned i_p = 0; i_p < P; i_p++) {
+        #pragma HLS UNROLL
+        for (unsigned i_ic = 0; i_ic < CONFIG_T::n_chan; i_ic++) {
+            #pragma HLS UNROLL
+            window[win_width - P + i_p][i_ic] = in_elem[i_p * CONFIG_T::n_chan + i_ic];
+        }
+    }
+
+    LaneLoop: for (unsigned i_p = 0; i_p < P; i_p++) {
+        #pragma HLS UNROLL
+        int x = pX + i_p;
+        if (x >= lShiftX && (x - lShiftX) % CONFIG_T::stride_width == 0) {
+            typename data_T::value_type kernel_data[CONFIG_T::filt_width * CONFIG_T::n_chan];
+            #pragma HLS ARRAY_PARTITION variable=kernel_data complete
+            typename res_T::value_type res_out[CONFIG_T::n_filt];
+            #pragma HLS ARRAY_PARTITION variable=res_out complete dim = 0
+
+            KernelWidth: for (unsigned i_iw = 0; i_iw < CONFIG_T::filt_width; i_iw++) {
+                #pragma HLS UNROLL
+                KernelChan: for (unsigned i_ic = 0; i_ic < CONFIG_T::n_chan; i_ic++) {
+                    #pragma HLS UNROLL
+                    kernel_data[i_iw * CONFIG_T::n_chan + i_ic] = window[i_p + i_iw * dilation_width][i_ic];
+                }
+            }
+
+            // Dense multiply
+            #pragma HLS INLINE region
+            if (CONFIG_T::strategy == nnet::latency) {
+                dense_latency<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(kernel_data, res_out, weights, biases);
+            } else {
+                dense_resource<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(kernel_data, res_out, weights, biases);
+            }
+
+            pack_output_parallel<data_T, res_T, CONFIG_T>(res_out, res_pack, outputs_ready, res_stream);
+        }
+    }
+
+    // Counter Housekeeping
+    pX = (pX + P == CONFIG_T::in_width) ? 0 : pX + P;
+}
+
 }
 #endif
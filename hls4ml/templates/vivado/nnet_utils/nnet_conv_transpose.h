@@ -0,0 +1,206 @@
+#ifndef NNET_CONV_TRANSPOSE_H_
+#define NNET_CONV_TRANSPOSE_H_
+
+#include "nnet_common.h"
+#include "nnet_dense.h"
+
+namespace nnet {
+
+// *************************************************
+//       Transposed convolution
+// *************************************************
+
+// The transposed convolution y[i * stride + k - crop] += x[i] * w[k] is decomposed into 'stride' phases.
+// Output u = q * stride + p only receives the taps w[p + j * stride], applied to the inputs x[q - j]:
+//     y[q * stride + p] = sum_j x[q - j] * w[p + j * stride],  j < phase_width = ceil(filt_width / stride)
+// so every window of phase_width inputs produces 'stride' consecutive outputs with a single dense layer of
+// phase_width * n_chan inputs and stride * n_filt outputs. No multiplication involves the zeros that an
+// upsample + convolution would insert. The converter rearranges the kernel into this matrix, taps beyond
+// filt_width (only present if filt_width is not a multiple of the stride) are constant zeros.
+
+struct conv1d_transpose_config
+{
+    // Internal data type definitions
+    typedef float bias_t;
+    typedef float weight_t;
+    typedef float accum_t;
+
+    // Convolutional parameters
+    static const unsigned in_width = 10;
+    static const unsigned n_chan = 1;
+    static const unsigned filt_width = 3;
+    static const unsigned n_filt = 1;
+    static const unsigned stride_width = 2;
+    static const unsigned phase_width = 2; // ceil(filt_width / stride_width)
+    static const unsigned crop_left = 0;   // Outputs of the full transposed convolution dropped on the left
+    static const unsigned out_width = 21;
+
+    static const unsigned reuse_factor = 1;
+    static const bool store_weights_in_bram = false;
+    static const unsigned strategy = latency;
+    static const unsigned n_zeros = 0;
+};
+
+struct conv2d_transpose_config
+{
+    // Internal data type definitions
+    typedef float bias_t;
+    typedef float weight_t;
+    typedef float accum_t;
+
+    // Convolutional parameters
+    static const unsigned in_height = 10;
+    static const unsigned in_width = 10;
+    static const unsigned n_chan = 1;
+    static const unsigned filt_height = 3;
+    static const unsigned filt_width = 3;
+    static const unsigned n_filt = 1;
+    static const unsigned stride_height = 2;
+    static const unsigned stride_width = 2;
+    static const unsigned phase_height = 2; // ceil(filt_height / stride_height)
+    static const unsigned phase_width = 2;  // ceil(filt_width / stride_width)
+    static const unsigned crop_top = 0;
+    static const unsigned crop_left = 0;
+    static const unsigned out_height = 21;
+    static const unsigned out_width = 21;
+
+    static const unsigned reuse_factor = 1;
+    static const bool store_weights_in_bram = false;
+    static const unsigned strategy = latency;
+    static const unsigned n_zeros = 0;
+};
+
+// Every phase shares the bias of its filter
+template<typename CONFIG_T, unsigned N_PHASES>
+void init_phase_biases(
+    typename CONFIG_T::bias_t biases[CONFIG_T::n_filt],
+    typename CONFIG_T::bias_t phase_biases[N_PHASES * CONFIG_T::n_filt]
+) {
+    #pragma HLS INLINE
+    PhaseBias: for (unsigned p = 0; p < N_PHASES; p++) {
+        #pragma HLS UNROLL
+        for (unsigned f = 0; f < CONFIG_T::n_filt; f++) {
+            #pragma HLS UNROLL
+            phase_biases[p * CONFIG_T::n_filt + f] = biases[f];
+        }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_1d_transpose_cl(
+    data_T data[CONFIG_T::in_width * CONFIG_T::n_chan],
+    res_T  res[CONFIG_T::out_width * CONFIG_T::n_filt],
+    typename CONFIG_T::weight_t weights[CONFIG_T::phase_width * CONFIG_T::n_chan * CONFIG_T::stride_width * CONFIG_T::n_filt],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt])
+{
+    // Only the windows producing outputs that survive the cropping are computed
+    constexpr unsigned first_window = CONFIG_T::crop_left / CONFIG_T::stride_width;
+    constexpr unsigned last_window = (CONFIG_T::crop_left + CONFIG_T::out_width - 1) / CONFIG_T::stride_width;
+
+    typename CONFIG_T::bias_t phase_biases[CONFIG_T::stride_width * CONFIG_T::n_filt];
+    #pragma HLS ARRAY_PARTITION variable=phase_biases complete
+    init_phase_biases<CONFIG_T, CONFIG_T::stride_width>(biases, phase_biases);
+
+    data_T data_col[CONFIG_T::phase_width * CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=data_col complete
+    res_T res_col[CONFIG_T::stride_width * CONFIG_T::n_filt];
+    #pragma HLS ARRAY_PARTITION variable=res_col complete
+
+    WindowLoop: for (unsigned q = first_window; q <= last_window; q++) {
+        #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+
+        TapLoop: for (unsigned j = 0; j < CONFIG_T::phase_width; j++) {
+            #pragma HLS UNROLL
+            int in_col = int(q) - int(j);
+            for (unsigned c = 0; c < CONFIG_T::n_chan; c++) {
+                #pragma HLS UNROLL
+                if (in_col >= 0 && in_col < CONFIG_T::in_width) {
+                    data_col[j * CONFIG_T::n_chan + c] = data[in_col * CONFIG_T::n_chan + c];
+                } else {
+                    data_col[j * CONFIG_T::n_chan + c] = 0;
+                }
+            }
+        }
+
+        dense<data_T, res_T, typename CONFIG_T::mult_config>(data_col, res_col, weights, phase_biases);
+
+        PhaseLoop: for (unsigned p = 0; p < CONFIG_T::stride_width; p++) {
+            #pragma HLS UNROLL
+            int out_col = int(q * CONFIG_T::stride_width + p) - int(CONFIG_T::crop_left);
+            if (out_col < 0 || out_col >= CONFIG_T::out_width) continue;
+            for (unsigned f = 0; f < CONFIG_T::n_filt; f++) {
+                #pragma HLS UNROLL
+                res[out_col * CONFIG_T::n_filt + f] = res_col[p * CONFIG_T::n_filt + f];
+            }
+        }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_2d_transpose_cl(
+    data_T data[CONFIG_T::in_height * CONFIG_T::in_width * CONFIG_T::n_chan],
+    res_T  res[CONFIG_T::out_height * CONFIG_T::out_width * CONFIG_T::n_filt],
+    typename CONFIG_T::weight_t weights[CONFIG_T::phase_height * CONFIG_T::phase_width * CONFIG_T::n_chan * CONFIG_T::stride_height * CONFIG_T::stride_width * CONFIG_T::n_filt],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt])
+{
+    constexpr unsigned n_phases = CONFIG_T::stride_height * CONFIG_T::stride_width;
+    constexpr unsigned first_window_h = CONFIG_T::crop_top / CONFIG_T::stride_height;
+    constexpr unsigned last_window_h = (CONFIG_T::crop_top + CONFIG_T::out_height - 1) / CONFIG_T::stride_height;
+    constexpr unsigned first_window_w = CONFIG_T::crop_left / CONFIG_T::stride_width;
+    constexpr unsigned last_window_w = (CONFIG_T::crop_left + CONFIG_T::out_width - 1) / CONFIG_T::stride_width;
+
+    typename CONFIG_T::bias_t phase_biases[n_phases * CONFIG_T::n_filt];
+    #pragma HLS ARRAY_PARTITION variable=phase_biases complete
+    init_phase_biases<CONFIG_T, n_phases>(biases, phase_biases);
+
+    data_T data_col[CONFIG_T::phase_height * CONFIG_T::phase_width * CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=data_col complete
+    res_T res_col[n_phases * CONFIG_T::n_filt];
+    #pragma HLS ARRAY_PARTITION variable=res_col complete
+
+    WindowRowLoop: for (unsigned qh = first_window_h; qh <= last_window_h; qh++) {
+        WindowColLoop: for (unsigned qw = first_window_w; qw <= last_window_w; qw++) {
+            #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+
+            TapRowLoop: for (unsigned jh = 0; jh < CONFIG_T::phase_height; jh++) {
+                #pragma HLS UNROLL
+                int in_row = int(qh) - int(jh);
+                TapColLoop: for (unsigned jw = 0; jw < CONFIG_T::phase_width; jw++) {
+                    #pragma HLS UNROLL
+                    int in_col = int(qw) - int(jw);
+                    bool inside = in_row >= 0 && in_row < CONFIG_T::in_height && in_col >= 0 && in_col < CONFIG_T::in_width;
+                    for (unsigned c = 0; c < CONFIG_T::n_chan; c++) {
+                        #pragma HLS UNROLL
+                        unsigned index_col = (jh * CONFIG_T::phase_width + jw) * CONFIG_T::n_chan + c;
+                        if (inside) {
+                            data_col[index_col] = data[(in_row * CONFIG_T::in_width + in_col) * CONFIG_T::n_chan + c];
+                        } else {
+                            data_col[index_col] = 0;
+                        }
+                    }
+                }
+            }
+
+            dense<data_T, res_T, typename CONFIG_T::mult_config>(data_col, res_col, weights, phase_biases);
+
+            PhaseRowLoop: for (unsigned ph = 0; ph < CONFIG_T::stride_height; ph++) {
+                #pragma HLS UNROLL
+                int out_row = int(qh * CONFIG_T::stride_height + ph) - int(CONFIG_T::crop_top);
+                if (out_row < 0 || out_row >= CONFIG_T::out_height) continue;
+                PhaseColLoop: for (unsigned pw = 0; pw < CONFIG_T::stride_width; pw++) {
+                    #pragma HLS UNROLL
+                    int out_col = int(qw * CONFIG_T::stride_width + pw) - int(CONFIG_T::crop_left);
+                    if (out_col < 0 || out_col >= CONFIG_T::out_width) continue;
+                    for (unsigned f = 0; f < CONFIG_T::n_filt; f++) {
+                        #pragma HLS UNROLL
+                        res[(out_row * CONFIG_T::out_width + out_col) * CONFIG_T::n_filt + f] = res_col[(ph * CONFIG_T::stride_width + pw) * CONFIG_T::n_filt + f];
+                    }
+                }
+            }
+        }
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,227 @@
+#ifndef NNET_CONV_TRANSPOSE_STREAM_H_
+#define NNET_CONV_TRANSPOSE_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_dense.h"
+#include "nnet_conv_transpose.h"
+#include "hls_stream.h"
+
+namespace nnet {
+
+// ****************************************************
+//       Streaming transposed convolution
+// ****************************************************
+
+// Window q holds the inputs x[q - j], j < phase_width, so input pixel q enters the window at step q and the
+// window is shifted by one pixel per step. Steps past the end of the input shift in zeros.
+
+template<class data_T, class res_T, typename CONFIG_T>
+void compute_transpose_phases(
+    typename data_T::value_type data_col[CONFIG_T::mult_config::n_in],
+    typename res_T::value_type  res_col[CONFIG_T::mult_config::n_out],
+    typename CONFIG_T::weight_t weights[CONFIG_T::mult_config::n_in * CONFIG_T::mult_config::n_out],
+    typename CONFIG_T::bias_t   phase_biases[CONFIG_T::mult_config::n_out]
+) {
+    #pragma HLS INLINE region
+    if (CONFIG_T::strategy == nnet::latency) {
+        dense_latency<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(data_col, res_col, weights, phase_biases);
+    } else {
+        dense_resource<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(data_col, res_col, weights, phase_biases);
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_1d_transpose_cl(
+    hls::stream<data_T> &data,
+    hls::stream<res_T>  &res,
+    typename CONFIG_T::weight_t weights[CONFIG_T::phase_width * CONFIG_T::n_chan * CONFIG_T::stride_width * CONFIG_T::n_filt],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt])
+{
+    assert(data_T::size == CONFIG_T::n_chan && res_T::size == CONFIG_T::n_filt);
+
+    constexpr unsigned first_window = CONFIG_T::crop_left / CONFIG_T::stride_width;
+    constexpr unsigned last_window = (CONFIG_T::crop_left + CONFIG_T::out_width - 1) / CONFIG_T::stride_width;
+
+    typename CONFIG_T::bias_t phase_biases[CONFIG_T::stride_width * CONFIG_T::n_filt];
+    #pragma HLS ARRAY_PARTITION variable=phase_biases complete
+    init_phase_biases<CONFIG_T, CONFIG_T::stride_width>(biases, phase_biases);
+
+    typename data_T::value_type window[CONFIG_T::phase_width * CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=window complete
+    typename res_T::value_type res_col[CONFIG_T::stride_width * CONFIG_T::n_filt];
+    #pragma HLS ARRAY_PARTITION variable=res_col complete
+
+    InitWindow: for (unsigned i = 0; i < CONFIG_T::phase_width * CONFIG_T::n_chan; i++) {
+        #pragma HLS UNROLL
+        window[i] = 0;
+    }
+
+    // Every step writes up to stride_width output pixels
+    WindowLoop: for (unsigned q = 0; q <= last_window; q++) {
+        #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+
+        ShiftWindow: for (int j = CONFIG_T::phase_width - 1; j > 0; j--) {
+            #pragma HLS UNROLL
+            for (unsigned c = 0; c < CONFIG_T::n_chan; c++) {
+                #pragma HLS UNROLL
+                window[j * CONFIG_T::n_chan + c] = window[(j - 1) * CONFIG_T::n_chan + c];
+            }
+        }
+        if (q < CONFIG_T::in_width) {
+            data_T in_elem = data.read();
+            for (unsigned c = 0; c < CONFIG_T::n_chan; c++) {
+                #pragma HLS UNROLL
+                window[c] = in_elem[c];
+            }
+        } else {
+            for (unsigned c = 0; c < CONFIG_T::n_chan; c++) {
+                #pragma HLS UNROLL
+                window[c] = 0;
+            }
+        }
+
+        if (q < first_window) continue;
+
+        compute_transpose_phases<data_T, res_T, CONFIG_T>(window, res_col, weights, phase_biases);
+
+        PhaseLoop: for (unsigned p = 0; p < CONFIG_T::stride_width; p++) {
+            int out_col = int(q * CONFIG_T::stride_width + p) - int(CONFIG_T::crop_left);
+            if (out_col < 0 || out_col >= CONFIG_T::out_width) continue;
+            res_T out_elem;
+            #pragma HLS DATA_PACK variable=out_elem
+            for (unsigned f = 0; f < CONFIG_T::n_filt; f++) {
+                #pragma HLS UNROLL
+                out_elem[f] = res_col[p * CONFIG_T::n_filt + f];
+            }
+            res.write(out_elem);
+        }
+    }
+}
+
+// Rows of windows are computed one at a time. The last phase_height input rows are kept in a circular line
+// buffer, and the stride_height output rows produced by a row of windows are collected in a row buffer and
+// written out in raster order once the row of windows is complete.
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_2d_transpose_cl(
+    hls::stream<data_T> &data,
+    hls::stream<res_T>  &res,
+    typename CONFIG_T::weight_t weights[CONFIG_T::phase_height * CONFIG_T::phase_width * CONFIG_T::n_chan * CONFIG_T::stride_height * CONFIG_T::stride_width * CONFIG_T::n_filt],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt])
+{
+    assert(data_T::size == CONFIG_T::n_chan && res_T::size == CONFIG_T::n_filt);
+
+    constexpr unsigned n_phases = CONFIG_T::stride_height * CONFIG_T::stride_width;
+    constexpr unsigned first_window_h = CONFIG_T::crop_top / CONFIG_T::stride_height;
+    constexpr unsigned last_window_h = (CONFIG_T::crop_top + CONFIG_T::out_height - 1) / CONFIG_T::stride_height;
+    constexpr unsigned first_window_w = CONFIG_T::crop_left / CONFIG_T::stride_width;
+    constexpr unsigned last_window_w = (CONFIG_T::crop_left + CONFIG_T::out_width - 1) / CONFIG_T::stride_width;
+
+    typename CONFIG_T::bias_t phase_biases[n_phases * CONFIG_T::n_filt];
+    #pragma HLS ARRAY_PARTITION variable=phase_biases complete
+    init_phase_biases<CONFIG_T, n_phases>(biases, phase_biases);
+
+    typename data_T::value_type line_buffer[CONFIG_T::phase_height][CONFIG_T::in_width * CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=line_buffer complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=line_buffer cyclic factor=CONFIG_T::n_chan dim=2
+    typename res_T::value_type row_buffer[CONFIG_T::stride_height][CONFIG_T::out_width * CONFIG_T::n_filt];
+    #pragma HLS ARRAY_PARTITION variable=row_buffer complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=row_buffer cyclic factor=CONFIG_T::stride_width*CONFIG_T::n_filt dim=2
+
+    typename data_T::value_type window[CONFIG_T::phase_height * CONFIG_T::phase_width * CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=window complete
+    typename res_T::value_type res_col[n_phases * CONFIG_T::n_filt];
+    #pragma HLS ARRAY_PARTITION variable=res_col complete
+
+    // Slot of the line buffer holding input row qh
+    unsigned slot = 0;
+
+    WindowRowLoop: for (unsigned qh = 0; qh <= last_window_h; qh++) {
+        WindowColLoop: for (unsigned qw = 0; qw <= last_window_w; qw++) {
+            #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+
+            // Store the new input pixel, rows past the end of the input are zero
+            if (qw < CONFIG_T::in_width) {
+                data_T in_elem;
+                if (qh < CONFIG_T::in_height) {
+                    in_elem = data.read();
+                }
+                for (unsigned c = 0; c < CONFIG_T::n_chan; c++) {
+                    #pragma HLS UNROLL
+                    line_buffer[slot][qw * CONFIG_T::n_chan + c] = (qh < CONFIG_T::in_height) ? typename data_T::value_type(in_elem[c]) : typename data_T::value_type(0);
+                }
+            }
+
+            // Shift the window by one column and load the new column x[qh - jh][qw]
+            ShiftWindow: for (unsigned jh = 0; jh < CONFIG_T::phase_height; jh++) {
+                #pragma HLS UNROLL
+                for (int jw = CONFIG_T::phase_width - 1; jw > 0; jw--) {
+                    #pragma HLS UNROLL
+                    for (unsigned c = 0; c < CONFIG_T::n_chan; c++) {
+                        #pragma HLS UNROLL
+                        window[(jh * CONFIG_T::phase_width + jw) * CONFIG_T::n_chan + c] = window[(jh * CONFIG_T::phase_width + jw - 1) * CONFIG_T::n_chan + c];
+                    }
+                }
+                unsigned row_slot = (slot + CONFIG_T::phase_height - jh) % CONFIG_T::phase_height;
+                bool inside = jh <= qh && qw < CONFIG_T::in_width;
+                for (unsigned c = 0; c < CONFIG_T::n_chan; c++) {
+                    #pragma HLS UNROLL
+                    window[jh * CONFIG_T::phase_width * CONFIG_T::n_chan + c] = inside ? line_buffer[row_slot][qw * CONFIG_T::n_chan + c] : typename data_T::value_type(0);
+                }
+            }
+
+            // Columns left of the input are zero at the start of every row
+            if (qw == 0) {
+                for (unsigned jh = 0; jh < CONFIG_T::phase_height; jh++) {
+                    #pragma HLS UNROLL
+                    for (unsigned jw = 1; jw < CONFIG_T::phase_width; jw++) {
+                        #pragma HLS UNROLL
+                        for (unsigned c = 0; c < CONFIG_T::n_chan; c++) {
+                            #pragma HLS UNROLL
+                            window[(jh * CONFIG_T::phase_width + jw) * CONFIG_T::n_chan + c] = 0;
+                        }
+                    }
+                }
+            }
+
+            if (qh < first_window_h || qw < first_window_w) continue;
+
+            compute_transpose_phases<data_T, res_T, CONFIG_T>(window, res_col, weights, phase_biases);
+
+            PhaseRowLoop: for (unsigned ph = 0; ph < CONFIG_T::stride_height; ph++) {
+                #pragma HLS UNROLL
+                PhaseColLoop: for (unsigned pw = 0; pw < CONFIG_T::stride_width; pw++) {
+                    #pragma HLS UNROLL
+                    int out_col = int(qw * CONFIG_T::stride_width + pw) - int(CONFIG_T::crop_left);
+                    if (out_col < 0 || out_col >= CONFIG_T::out_width) continue;
+                    for (unsigned f = 0; f < CONFIG_T::n_filt; f++) {
+                        #pragma HLS UNROLL
+                        row_buffer[ph][out_col * CONFIG_T::n_filt + f] = res_col[(ph * CONFIG_T::stride_width + pw) * CONFIG_T::n_filt + f];
+                    }
+                }
+            }
+        }
+
+        slot = (slot + 1) % CONFIG_T::phase_height;
+
+        if (qh < first_window_h) continue;
+
+        WriteRows: for (unsigned ph = 0; ph < CONFIG_T::stride_height; ph++) {
+            int out_row = int(qh * CONFIG_T::stride_height + ph) - int(CONFIG_T::crop_top);
+            if (out_row < 0 || out_row >= CONFIG_T::out_height) continue;
+            WriteRow: for (unsigned out_col = 0; out_col < CONFIG_T::out_width; out_col++) {
+                #pragma HLS PIPELINE
+                res_T out_elem;
+                #pragma HLS DATA_PACK variable=out_elem
+                for (unsigned f = 0; f < CONFIG_T::n_filt; f++) {
+                    #pragma HLS UNROLL
+                    out_elem[f] = row_buffer[ph][out_col * CONFIG_T::n_filt + f];
+                }
+                res.write(out_elem);
+            }
+        }
+    }
+}
+
+}
+
+#endif
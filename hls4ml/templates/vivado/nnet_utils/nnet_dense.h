@@ -28,6 +28,8 @@ struct dense_config
     static const unsigned reuse_factor = 1;
     static const bool store_weights_in_bram = false;
     static const unsigned n_zeros = 0;
+    // Memory of the weights of the resource strategy, chosen by the placement of the weights. mem_auto leaves it to HLS
+    static const unsigned weight_impl = mem_auto;
     // partitioning arrays cyclically to go with roll factors?
     // Product function to use
     template<class x_T, class y_T>
@@ -0,0 +1,174 @@
+#ifndef NNET_DENSE_OFFCHIP_H_
+#define NNET_DENSE_OFFCHIP_H_
+
+#include "nnet_common.h"
+#include "nnet_mult.h"
+#include "hls_stream.h"
+#include <string.h>
+
+namespace nnet {
+
+#ifndef __SYNTHESIS__
+// Model of the off-chip memory in C simulation. The reads of the weights are split into AXI bursts as the m_axi
+// adapter splits them, at most 256 beats and not crossing a 4 KiB boundary, to count the bursts and the beats and to
+// estimate the cycles spent reading. The buffers of the weights are assumed to be 4 KiB aligned.
+struct offchip_memory_model {
+    unsigned bus_bytes; // Width of the memory port, 64 for 512-bit HBM/DDR ports on Alveo
+    unsigned latency;   // Cycles from the request of a read to its first beat
+    unsigned long long n_reads;
+    unsigned long long n_bursts;
+    unsigned long long n_beats;
+    unsigned long long n_bytes;
+
+    offchip_memory_model() : bus_bytes(64), latency(64) { reset(); }
+
+    void reset() {
+        n_reads = n_bursts = n_beats = n_bytes = 0;
+    }
+
+    void read(unsigned long long offset, unsigned long long bytes) {
+        if (bytes == 0) return;
+        n_reads++;
+        n_bytes += bytes;
+        const unsigned long long max_burst = 256ULL * bus_bytes;
+        unsigned long long end = offset + bytes;
+        while (offset < end) {
+            unsigned long long page_end = (offset / 4096 + 1) * 4096;
+            unsigned long long burst_end = offset - offset % bus_bytes + max_burst;
+            unsigned long long stop = end < page_end ? end : page_end;
+            if (burst_end < stop) stop = burst_end;
+            n_bursts++;
+            n_beats += (stop - 1) / bus_bytes - offset / bus_bytes + 1;
+            offset = stop;
+        }
+    }
+
+    // The bursts of a read are issued back to back, only the first one waits for the memory
+    unsigned long long cycles() const {
+        return n_reads * latency + n_beats;
+    }
+};
+
+inline offchip_memory_model &offchip_memory() {
+    static offchip_memory_model model;
+    return model;
+}
+#endif
+
+// Reads the weights of a tile of output neurons into the cache with one burst
+template<typename CONFIG_T>
+void dense_offchip_fetch(
+    typename CONFIG_T::weight_t *weights,
+    typename CONFIG_T::weight_t cache[CONFIG_T::offchip_tile * CONFIG_T::n_in],
+    unsigned tile)
+{
+    #pragma HLS INLINE off
+    const unsigned first_row = tile * CONFIG_T::offchip_tile;
+    const unsigned n_rows = (first_row + CONFIG_T::offchip_tile <= CONFIG_T::n_out) ? CONFIG_T::offchip_tile : CONFIG_T::n_out - first_row;
+
+    #ifndef __SYNTHESIS__
+    offchip_memory().read((unsigned long long) first_row * CONFIG_T::n_in * CONFIG_T::offchip_word_bytes,
+                          (unsigned long long) n_rows * CONFIG_T::n_in * CONFIG_T::offchip_word_bytes);
+    #endif
+    memcpy(cache, weights + first_row * CONFIG_T::n_in, n_rows * CONFIG_T::n_in * sizeof(typename CONFIG_T::weight_t));
+}
+
+// Computes the output neurons of a tile from the weights in the cache, offchip_lanes products per cycle
+template<class data_T, typename CONFIG_T>
+void dense_offchip_compute(
+    data_T data[CONFIG_T::n_in],
+    typename CONFIG_T::weight_t cache[CONFIG_T::offchip_tile * CONFIG_T::n_in],
+    typename CONFIG_T::bias_t biases[CONFIG_T::n_out],
+    typename CONFIG_T::accum_t acc[CONFIG_T::n_out],
+    unsigned tile)
+{
+    #pragma HLS INLINE off
+    const unsigned n_blocks = (CONFIG_T::n_in + CONFIG_T::offchip_lanes - 1) / CONFIG_T::offchip_lanes;
+
+    TileRows: for (unsigned r = 0; r < CONFIG_T::offchip_tile; r++) {
+        const unsigned jj = tile * CONFIG_T::offchip_tile + r;
+        if (jj >= CONFIG_T::n_out) break;
+        typename CONFIG_T::accum_t sum = biases[jj];
+        RowBlocks: for (unsigned b = 0; b < n_blocks; b++) {
+            #pragma HLS PIPELINE II=1
+            typename CONFIG_T::accum_t partial = 0;
+            Lanes: for (unsigned l = 0; l < CONFIG_T::offchip_lanes; l++) {
+                #pragma HLS UNROLL
+                const unsigned ii = b * CONFIG_T::offchip_lanes + l;
+                if (ii < CONFIG_T::n_in) {
+                    partial += CONFIG_T::template product<data_T, typename CONFIG_T::weight_t>::product(data[ii], cache[r * CONFIG_T::n_in + ii]);
+                }
+            }
+            sum += partial;
+        }
+        acc[jj] = sum;
+    }
+}
+
+// Dense layer with the weights in off-chip memory, behind an m_axi port. The weights are stored transposed, one output
+// neuron after the other, and are read a tile of neurons at a time into a cache with one burst, then the tile is
+// computed. The reads do not overlap the products. On top of dense_config, CONFIG_T defines offchip_tile (output
+// neurons per tile), offchip_lanes (products per cycle) and offchip_word_bytes (bytes of a weight in memory).
+template<class data_T, class res_T, typename CONFIG_T>
+void dense_offchip(
+    data_T    data[CONFIG_T::n_in],
+    res_T     res[CONFIG_T::n_out],
+    typename CONFIG_T::weight_t  weights[CONFIG_T::n_in*CONFIG_T::n_out],
+    typename CONFIG_T::bias_t    biases[CONFIG_T::n_out])
+{
+    const unsigned n_tiles = (CONFIG_T::n_out + CONFIG_T::offchip_tile - 1) / CONFIG_T::offchip_tile;
+
+    #pragma HLS ARRAY_PARTITION variable=data cyclic factor=CONFIG_T::offchip_lanes
+
+    typename CONFIG_T::weight_t cache[CONFIG_T::offchip_tile * CONFIG_T::n_in];
+    #pragma HLS ARRAY_PARTITION variable=cache cyclic factor=CONFIG_T::offchip_lanes
+
+    typename CONFIG_T::accum_t acc[CONFIG_T::n_out];
+
+    Tiles: for (unsigned t = 0; t < n_tiles; t++) {
+        dense_offchip_fetch<CONFIG_T>(weights, cache, t);
+        dense_offchip_compute<data_T, CONFIG_T>(data, cache, biases, acc, t);
+    }
+
+    Result: for (unsigned jj = 0; jj < CONFIG_T::n_out; jj++) {
+        #pragma HLS PIPELINE
+        res[jj] = cast<data_T, res_T, CONFIG_T>(acc[jj]);
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void dense_offchip(
+    hls::stream<data_T> &data_stream,
+    hls::stream<res_T>  &res_stream,
+    typename CONFIG_T::weight_t weights[CONFIG_T::n_in*CONFIG_T::n_out],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::n_out])
+{
+    typename data_T::value_type data[CONFIG_T::n_in];
+    typename res_T::value_type res[CONFIG_T::n_out];
+
+    DataPrepare: for(unsigned i_in = 0; i_in < CONFIG_T::n_in / data_T::size; i_in++) {
+        #pragma HLS PIPELINE
+        data_T data_pack = data_stream.read();
+        DataPack: for (unsigned i_pack = 0; i_pack < data_T::size; i_pack++) {
+            #pragma HLS UNROLL
+            data[i_in * data_T::size + i_pack] = data_pack[i_pack];
+        }
+    }
+
+    dense_offchip<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(data, res, weights, biases);
+
+    ResWrite: for(unsigned i_out = 0; i_out < CONFIG_T::n_out / res_T::size; i_out++) {
+        #pragma HLS PIPELINE
+        res_T res_pack;
+        #pragma HLS DATA_PACK variable=res_pack
+        ResPack: for (unsigned i_pack = 0; i_pack < res_T::size; i_pack++) {
+            #pragma HLS UNROLL
+            res_pack[i_pack] = res[i_out * res_T::size + i_pack];
+        }
+        res_stream.write(res_pack);
+    }
+}
+
+}
+
+#endif
@@ -28,6 +28,22 @@
 
 namespace nnet {
 
+// The weights are reshaped into a ROM of reuse_factor words, one word of block_factor weights is read per cycle.
+// CONFIG_T::weight_impl binds the ROM to a memory, with mem_register the weights are reshaped into a single word.
+template<typename CONFIG_T>
+void dense_resource_weight_impl(
+    typename CONFIG_T::weight_t weights[CONFIG_T::n_in*CONFIG_T::n_out])
+{
+    #pragma HLS INLINE
+    if (CONFIG_T::weight_impl == mem_bram) {
+        #pragma HLS RESOURCE variable=weights core=ROM_2P_BRAM
+    } else if (CONFIG_T::weight_impl == mem_uram) {
+        #pragma HLS RESOURCE variable=weights core=XPM_MEMORY uram
+    } else if (CONFIG_T::weight_impl == mem_lutram) {
+        #pragma HLS RESOURCE variable=weights core=ROM_2P_LUTRAM
+    }
+}
+
 template<class data_T, class res_T, typename CONFIG_T>
 void dense_resource_rf_leq_nin(
     data_T data[CONFIG_T::n_in],
@@ -47,8 +63,9 @@ void dense_resource_rf_leq_nin(
     assert((multiplier_limit == block_factor) && "This function is correct only for RF <= N_IN");
 
     #pragma HLS function_instantiate variable=weights,biases
-    //#pragma HLS RESOURCE variable=weights core=RAM_2P_BRAM Commenting out the deisgnation HLS seems to choose correctly
-    #pragma HLS ARRAY_RESHAPE   variable=weights block factor=block_factor
+    const int reshape_factor = (CONFIG_T::weight_impl == mem_register) ? CONFIG_T::n_in * CONFIG_T::n_out : block_factor;
+    #pragma HLS ARRAY_RESHAPE   variable=weights block factor=reshape_factor
+    dense_resource_weight_impl<CONFIG_T>(weights);
     #pragma HLS ARRAY_PARTITION variable=biases complete
 
     typename CONFIG_T::accum_t acc[CONFIG_T::n_out];
@@ -120,8 +137,9 @@ void dense_resource_rf_gt_nin_rem0(
     assert((rufactor > nin && rufactor % nin == 0) && "This function is correct only for RF > N_IN && RF % N_IN == 0");
 
     #pragma HLS function_instantiate variable=weights,biases
-    //#pragma HLS RESOURCE variable=weights core=RAM_2P_BRAM Commenting out the deisgnation HLS seems to choose correctly
-    #pragma HLS ARRAY_RESHAPE   variable=weights block factor=block_factor
+    const int reshape_factor = (CONFIG_T::weight_impl == mem_register) ? CONFIG_T::n_in * CONFIG_T::n_out : block_factor;
+    #pragma HLS ARRAY_RESHAPE   variable=weights block factor=reshape_factor
+    dense_resource_weight_impl<CONFIG_T>(weights);
     #pragma HLS ARRAY_PARTITION variable=biases complete
 
     typename CONFIG_T::accum_t acc[CONFIG_T::n_out];
@@ -200,8 +218,9 @@ void dense_resource_rf_gt_nin(
     assert((rufactor > nin) && "This function is correct only for RF > N_IN");
 
     #pragma HLS function_instantiate variable=weights,biases
-    //#pragma HLS RESOURCE variable=weights core=RAM_2P_BRAM Commenting out the deisgnation HLS seems to choose correctly
-    #pragma HLS ARRAY_RESHAPE   variable=weights block factor=block_factor
+    const int reshape_factor = (CONFIG_T::weight_impl == mem_register) ? CONFIG_T::n_in * CONFIG_T::n_out : block_factor;
+    #pragma HLS ARRAY_RESHAPE   variable=weights block factor=reshape_factor
+    dense_resource_weight_impl<CONFIG_T>(weights);
     #pragma HLS ARRAY_PARTITION variable=biases complete
 
     typename CONFIG_T::accum_t acc[CONFIG_T::n_out];
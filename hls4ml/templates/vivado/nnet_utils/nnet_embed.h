@@ -3,6 +3,8 @@
 
 #include "nnet_common.h"
 #include "nnet_helpers.h"
+#include <cstring>
+#include <type_traits>
 
 namespace nnet {
 
@@ -16,32 +18,76 @@ struct embed_config
     static const unsigned n_out = 16;
     static const unsigned vocab_size = 50;
 
+    // The table is stored n_banks times, every copy of row v is at (v * n_banks + bank) * n_out.
+    // Each copy is a dual-port ROM serving two lookups per cycle.
+    static const unsigned n_banks = 1;
+    static const unsigned table_impl = mem_auto;
+
     // Resource reuse info
     static const unsigned io_type = io_parallel;
     static const unsigned reuse_factor = 1;
 };
 
+template<typename CONFIG_T>
+void embedding_table_impl(
+    const typename CONFIG_T::embeddings_t embeddings[CONFIG_T::vocab_size * CONFIG_T::n_banks * CONFIG_T::n_out])
+{
+    #pragma HLS INLINE
+    // Every column of every copy is a separate memory, so a lookup reads a whole row in one access
+    const unsigned table_factor = CONFIG_T::n_banks * CONFIG_T::n_out;
+    #pragma HLS ARRAY_PARTITION variable=embeddings cyclic factor=table_factor
+
+    if (CONFIG_T::table_impl == mem_bram) {
+        #pragma HLS RESOURCE variable=embeddings core=ROM_2P_BRAM
+    } else if (CONFIG_T::table_impl == mem_uram) {
+        #pragma HLS RESOURCE variable=embeddings core=XPM_MEMORY uram
+    } else if (CONFIG_T::table_impl == mem_lutram) {
+        #pragma HLS RESOURCE variable=embeddings core=ROM_2P_LUTRAM
+    }
+}
+
+template<class res_T, typename CONFIG_T>
+void embedding_lookup(
+    unsigned index,
+    unsigned bank,
+    res_T res[CONFIG_T::n_out],
+    const typename CONFIG_T::embeddings_t embeddings[CONFIG_T::vocab_size * CONFIG_T::n_banks * CONFIG_T::n_out])
+{
+    #pragma HLS INLINE
+    const typename CONFIG_T::embeddings_t *row = &embeddings[(index * CONFIG_T::n_banks + bank) * CONFIG_T::n_out];
+
+#ifndef __SYNTHESIS__
+    // In C simulation the row is copied directly when the table and the result have the same type
+    if (std::is_same<typename CONFIG_T::embeddings_t, res_T>::value) {
+        std::memcpy((void *) res, (const void *) row, CONFIG_T::n_out * sizeof(res_T));
+        return;
+    }
+#endif
+
+    DenseEmbedding: for (int i = 0; i < CONFIG_T::n_out; i++) {
+        #pragma HLS UNROLL
+        res[i] = row[i];
+    }
+}
+
 template<class data_T, class res_T, typename CONFIG_T>
 void embedding(
     data_T data[CONFIG_T::n_in],
     res_T  res[CONFIG_T::n_in * CONFIG_T::n_out],
-    typename CONFIG_T::embeddings_t embeddings[CONFIG_T::vocab_size * CONFIG_T::n_out])
+    const typename CONFIG_T::embeddings_t embeddings[CONFIG_T::vocab_size * CONFIG_T::n_banks * CONFIG_T::n_out])
 {
 
     #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
-    // This can save a few cycles, but it will create a large multiplexer due to
-    // non-constant access pattern, so let's leave it out
-    //#pragma HLS ARRAY_PARTITION variable=embeddings complete
+    embedding_table_impl<CONFIG_T>(embeddings);
 
+    // Lookup j reads copy j % n_banks of the table, the copies are sized by the backend so that
+    // n_in lookups fit in reuse_factor cycles
     InputSequence: for (int j = 0; j < CONFIG_T::n_in; j++) {
         #pragma HLS UNROLL
-        DenseEmbedding: for (int i = 0; i < CONFIG_T::n_out; i++) {
-            #pragma HLS UNROLL
-            res[j * CONFIG_T::n_out + i] = embeddings[data[j] * CONFIG_T::n_out + i];
-        }
+        embedding_lookup<res_T, CONFIG_T>(data[j].to_uint(), j % CONFIG_T::n_banks, &res[j * CONFIG_T::n_out], embeddings);
     }
 }
 
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -3,6 +3,7 @@
 
 #include "nnet_common.h"
 #include "nnet_helpers.h"
+#include "nnet_embed.h"
 #include "hls_stream.h"
 
 namespace nnet {
@@ -11,8 +12,10 @@ template<class data_T, class res_T, typename CONFIG_T>
 void embedding(
     hls::stream<data_T> &data,
     hls::stream<res_T>  &res,
-    typename CONFIG_T::embeddings_t embeddings[CONFIG_T::vocab_size * CONFIG_T::n_out])
+    const typename CONFIG_T::embeddings_t embeddings[CONFIG_T::vocab_size * CONFIG_T::n_banks * CONFIG_T::n_out])
 {
+    embedding_table_impl<CONFIG_T>(embeddings);
+
     data_T in_data = data.read();
 
     InputSequence: for (int j = 0; j < data_T::size; j++) {
@@ -21,9 +24,13 @@ void embedding(
         res_T res_pack;
         #pragma HLS DATA_PACK variable=res_pack
 
+        typename res_T::value_type row[CONFIG_T::n_out];
+        #pragma HLS ARRAY_PARTITION variable=row complete
+        embedding_lookup<typename res_T::value_type, CONFIG_T>(in_data[j].to_uint(), j % CONFIG_T::n_banks, row, embeddings);
+
         DenseEmbedding: for (int i = 0; i < CONFIG_T::n_out; i++) {
             #pragma HLS UNROLL
-            res_pack[i] = embeddings[in_data[j] * CONFIG_T::n_out + i];
+            res_pack[i] = row[i];
         }
         res.write(res_pack);
     }
@@ -31,4 +38,4 @@ void embedding(
 
 }
 
-#endif
\ No newline at end of file
+#endif
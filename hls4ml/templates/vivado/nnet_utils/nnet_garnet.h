@@ -67,7 +67,7 @@ namespace nnet {
     template<class CONFIG_T>
     inline
     typename std::enable_if<std::is_class<typename CONFIG_T::distance_t>::value, typename CONFIG_T::edge_weight_t>::type
-    get_edge_weight(typename CONFIG_T::distance_t distance, typename CONFIG_T::edge_weight_t edge_weights_table[])
+    get_edge_weight(typename CONFIG_T::distance_t distance, typename CONFIG_T::edge_weight_t const edge_weights_table[])
     {
       typedef ap_uint<CONFIG_T::distance_width> index_t;
 
@@ -79,7 +79,7 @@ namespace nnet {
     template<class CONFIG_T>
     inline
     typename std::enable_if<not std::is_class<typename CONFIG_T::distance_t>::value, typename CONFIG_T::edge_weight_t>::type
-    get_edge_weight(typename CONFIG_T::distance_t distance, typename CONFIG_T::edge_weight_t edge_weights_table[])
+    get_edge_weight(typename CONFIG_T::distance_t distance, typename CONFIG_T::edge_weight_t const edge_weights_table[])
     {
       unsigned const table_size = (1 << CONFIG_T::distance_width);
       double const step = 64. / table_size;
@@ -93,6 +93,7 @@ namespace nnet {
       return edge_weights_table[index];
     }
 
+    // Only used by the reference implementation (garnet_ref), the others share an EdgeWeightTable
     template<class CONFIG_T>
     typename CONFIG_T::edge_weight_t
     compute_edge_weight(typename CONFIG_T::distance_t distance)
@@ -117,6 +118,41 @@ namespace nnet {
       return get_edge_weight<CONFIG_T>(distance, edge_weights_table);
     }
 
+    // Table of exp(-d^2) shared by all aggregators of a layer (and all sublayers of a stack in the C simulation),
+    // instead of one table per call of compute_edge_weight
+    template<class CONFIG_T>
+    struct EdgeWeightTable {
+      typedef typename CONFIG_T::edge_weight_t edge_weight_t;
+
+      static unsigned const table_size = (1 << CONFIG_T::distance_width);
+
+#ifdef __SYNTHESIS__
+      edge_weight_t table[table_size];
+
+      EdgeWeightTable() {
+        #pragma HLS INLINE
+        initialize_edge_weights_table<CONFIG_T>(table);
+      }
+#else
+      edge_weight_t const* table;
+
+      EdgeWeightTable() {
+        static edge_weight_t shared_table[table_size];
+        static bool initialized = false;
+        if (not initialized) {
+          initialize_edge_weights_table<CONFIG_T>(shared_table);
+          initialized = true;
+        }
+        table = shared_table;
+      }
+#endif
+
+      edge_weight_t get(typename CONFIG_T::distance_t distance) const {
+        #pragma HLS INLINE
+        return get_edge_weight<CONFIG_T>(distance, table);
+      }
+    };
+
     template<class dividend_T, class exponent_T>
     inline
     typename std::enable_if<std::is_class<dividend_T>::value, dividend_T>::type
@@ -344,7 +380,8 @@ namespace nnet {
       data_getter_T const& data_getter,
       unsigned iv,
       arrays_local_T& arrays_local,
-      arrays_T& arrays
+      arrays_T& arrays,
+      EdgeWeightTable<typename CONFIG_T::base_t> const& edge_weights_table
     )
     {
       #pragma HLS INLINE
@@ -362,7 +399,7 @@ namespace nnet {
           distance += incr;
         }
 
-        typename CONFIG_T::edge_weight_t edge_weight = garnet_utils::compute_edge_weight<typename CONFIG_T::base_t>(distance);
+        typename CONFIG_T::edge_weight_t edge_weight = edge_weights_table.get(distance);
 
         arrays_local.edge_weight_mean[ia] += edge_weight;
 
@@ -380,6 +417,233 @@ namespace nnet {
       }
     }
 
+#ifndef __SYNTHESIS__
+    // The C simulation of the aggregation emulates the fixed-point arithmetic with 64-bit integers, which gives the
+    // same bits as the ap_fixed operations much faster. Only quantization by truncation or rounding to plus infinity
+    // and overflow by wrapping or saturation are emulated, other types use the ap_fixed operations.
+
+    template<class T>
+    struct RawFixed {
+      static const bool supported = false;
+      static const int width = 64;
+      static const int frac = 0;
+    };
+
+    template<class T, int W, int I, bool S, ap_q_mode Q, ap_o_mode O, int N>
+    struct RawFixedBase {
+      static const bool supported = (W <= 40) && (Q == AP_TRN || Q == AP_RND) && (O == AP_WRAP || O == AP_SAT) && (N == 0);
+      static const int width = W;
+      static const int frac = W - I;
+
+      static long long get(T const& x) {
+        unsigned long long bits = x.bits_to_uint64();
+        if (S && ((bits >> (W - 1)) & 1))
+          return (long long)(bits | ~((1ULL << W) - 1));
+        return (long long)bits;
+      }
+
+      static void set(T& x, long long raw) {
+        x.setBits((unsigned long long)raw & ((1ULL << W) - 1));
+      }
+
+      // Bits of the value 'raw' with 'raw_frac' fractional bits converted to T
+      static long long convert(long long raw, int raw_frac) {
+        if (raw_frac < frac) {
+          raw *= (1LL << (frac - raw_frac));
+        }
+        else if (raw_frac > frac) {
+          int const shift = raw_frac - frac;
+          if (Q == AP_RND)
+            raw += (1LL << (shift - 1));
+          raw >>= shift;
+        }
+
+        if (O == AP_SAT) {
+          long long const max = S ? (1LL << (W - 1)) - 1 : (1LL << W) - 1;
+          long long const min = S ? -(1LL << (W - 1)) : 0;
+          if (raw > max)
+            raw = max;
+          else if (raw < min)
+            raw = min;
+        }
+        else {
+          unsigned long long bits = (unsigned long long)raw & ((1ULL << W) - 1);
+          if (S && ((bits >> (W - 1)) & 1))
+            bits |= ~((1ULL << W) - 1);
+          raw = (long long)bits;
+        }
+        return raw;
+      }
+
+      // Bits of a + b converted to T
+      static long long add(long long a, int a_frac, long long b, int b_frac) {
+        int const sum_frac = a_frac > b_frac ? a_frac : b_frac;
+        return convert(a * (1LL << (sum_frac - a_frac)) + b * (1LL << (sum_frac - b_frac)), sum_frac);
+      }
+    };
+
+    template<int W, int I, ap_q_mode Q, ap_o_mode O, int N>
+    struct RawFixed<ap_fixed<W, I, Q, O, N> > : RawFixedBase<ap_fixed<W, I, Q, O, N>, W, I, true, Q, O, N> {};
+
+    template<int W, int I, ap_q_mode Q, ap_o_mode O, int N>
+    struct RawFixed<ap_ufixed<W, I, Q, O, N> > : RawFixedBase<ap_ufixed<W, I, Q, O, N>, W, I, false, Q, O, N> {};
+
+    template<class CONFIG_T, class data_T, class edge_weight_aggr_T>
+    struct FastAggregation {
+      typedef RawFixed<data_T> data_t;
+      typedef RawFixed<typename CONFIG_T::aggregator_distance_weights_t> weight_t;
+      typedef RawFixed<typename CONFIG_T::aggregator_distance_biases_t> bias_t;
+      typedef RawFixed<typename CONFIG_T::distance_t> distance_t;
+      typedef RawFixed<typename CONFIG_T::edge_weight_t> edge_weight_t;
+      typedef RawFixed<edge_weight_aggr_T> edge_weight_aggr_t;
+      typedef RawFixed<typename CONFIG_T::aggr_t> aggr_t;
+
+      // Largest shift used to align the operands of an addition
+      static const int max_align = 16;
+
+      static const bool value = data_t::supported && weight_t::supported && bias_t::supported && distance_t::supported &&
+        edge_weight_t::supported && edge_weight_aggr_t::supported && aggr_t::supported &&
+        data_t::width + weight_t::width <= 62 && data_t::width + edge_weight_t::width <= 62 &&
+        distance_t::frac - bias_t::frac <= max_align && bias_t::frac - distance_t::frac <= max_align &&
+        edge_weight_aggr_t::frac - edge_weight_t::frac <= max_align && edge_weight_t::frac - edge_weight_aggr_t::frac <= max_align &&
+        aggr_t::frac - data_t::frac <= max_align && data_t::frac - aggr_t::frac <= max_align;
+    };
+
+    template<class CONFIG_T, class data_getter_T, class nvtx_T, class arrays_local_T, class arrays_T>
+    inline
+    typename std::enable_if<not FastAggregation<CONFIG_T, typename data_getter_T::data_t, typename arrays_local_T::edge_weight_t>::value, bool>::type
+    compute_weights_aggregates_fast(
+      data_getter_T const&,
+      unsigned,
+      nvtx_T const,
+      arrays_local_T&,
+      arrays_T&,
+      EdgeWeightTable<typename CONFIG_T::base_t> const&
+    )
+    {
+      return false;
+    }
+
+    template<class CONFIG_T, class data_getter_T, class nvtx_T, class arrays_local_T, class arrays_T>
+    inline
+    typename std::enable_if<FastAggregation<CONFIG_T, typename data_getter_T::data_t, typename arrays_local_T::edge_weight_t>::value, bool>::type
+    compute_weights_aggregates_fast(
+      data_getter_T const& data_getter,
+      unsigned iv_begin,
+      nvtx_T const nvtx,
+      arrays_local_T& arrays_local,
+      arrays_T& arrays,
+      EdgeWeightTable<typename CONFIG_T::base_t> const& edge_weights_table
+    )
+    {
+      typedef FastAggregation<CONFIG_T, typename data_getter_T::data_t, typename arrays_local_T::edge_weight_t> fast_t;
+      typedef typename fast_t::data_t data_t;
+      typedef typename fast_t::distance_t distance_t;
+      typedef typename fast_t::edge_weight_t edge_weight_t;
+      typedef typename fast_t::edge_weight_aggr_t edge_weight_aggr_t;
+      typedef typename fast_t::aggr_t aggr_t;
+
+      unsigned const n_aggregators = CONFIG_T::n_aggregators;
+      unsigned const n_in_features = CONFIG_T::n_in_features;
+      unsigned const unroll_factor = CONFIG_T::n_vertices >> CONFIG_T::log2_reuse_factor;
+
+      // Bits of the weights and of the table, converted once per configuration
+      static long long weights[n_aggregators * n_in_features];
+      static long long biases[n_aggregators];
+      static long long table[EdgeWeightTable<typename CONFIG_T::base_t>::table_size];
+      static bool initialized = false;
+      if (not initialized) {
+        for (unsigned iax = 0; iax < n_aggregators * n_in_features; ++iax)
+          weights[iax] = fast_t::weight_t::get(CONFIG_T::aggregator_distance_weights[iax]);
+        for (unsigned ia = 0; ia < n_aggregators; ++ia)
+          biases[ia] = distance_t::convert(fast_t::bias_t::get(CONFIG_T::aggregator_distance_biases[ia]), fast_t::bias_t::frac);
+        for (unsigned iw = 0; iw < EdgeWeightTable<typename CONFIG_T::base_t>::table_size; ++iw)
+          table[iw] = edge_weight_t::get(edge_weights_table.table[iw]);
+        initialized = true;
+      }
+
+      long long edge_weight_mean[n_aggregators];
+      long long weighted_feature_mean[n_aggregators * n_in_features];
+      for (unsigned ia = 0; ia < n_aggregators; ++ia)
+        edge_weight_mean[ia] = edge_weight_aggr_t::get(arrays_local.edge_weight_mean[ia]);
+      for (unsigned iax = 0; iax < n_aggregators * n_in_features; ++iax)
+        weighted_feature_mean[iax] = aggr_t::get(arrays_local.weighted_feature_mean[iax]);
+
+      unsigned long long const index_mask = (1ULL << CONFIG_T::distance_width) - 1;
+
+      long long data[n_in_features];
+
+      for (unsigned iv = iv_begin; iv < iv_begin + unroll_factor; ++iv) {
+        if (iv >= nvtx)
+          break;
+
+        for (unsigned ix = 0; ix < n_in_features; ++ix)
+          data[ix] = data_t::get(data_getter.get(iv, ix));
+
+        for (unsigned ia = 0; ia < n_aggregators; ++ia) {
+          long long distance = biases[ia];
+          for (unsigned ix = 0; ix < n_in_features; ++ix) {
+            long long const incr = distance_t::convert(data[ix] * weights[ia * n_in_features + ix], data_t::frac + fast_t::weight_t::frac);
+            distance = distance_t::convert(distance + incr, distance_t::frac);
+          }
+
+          unsigned const iw = (unsigned long long)distance & index_mask;
+          long long const edge_weight = table[iw];
+
+          edge_weight_mean[ia] = edge_weight_aggr_t::add(edge_weight_mean[ia], edge_weight_aggr_t::frac, edge_weight, edge_weight_t::frac);
+
+          for (unsigned ix = 0; ix < n_in_features; ++ix) {
+            unsigned const iax = ia * n_in_features + ix;
+            long long const incr = data_t::convert(data[ix] * edge_weight, data_t::frac + edge_weight_t::frac);
+            weighted_feature_mean[iax] = aggr_t::add(weighted_feature_mean[iax], aggr_t::frac, incr, data_t::frac);
+          }
+
+          arrays.set_weight(iv * n_aggregators + ia, edge_weights_table.table[iw]);
+        }
+      }
+
+      for (unsigned ia = 0; ia < n_aggregators; ++ia)
+        edge_weight_aggr_t::set(arrays_local.edge_weight_mean[ia], edge_weight_mean[ia]);
+      for (unsigned iax = 0; iax < n_aggregators * n_in_features; ++iax)
+        aggr_t::set(arrays_local.weighted_feature_mean[iax], weighted_feature_mean[iax]);
+
+      return true;
+    }
+#endif
+
+    // Edge weights and means of the 'n_vertices / reuse_factor' vertices starting at iv_begin
+    template<class CONFIG_T, class data_getter_T, class nvtx_T, class arrays_local_T, class arrays_T>
+    inline
+    void
+    compute_weights_aggregates_block(
+      data_getter_T const& data_getter,
+      unsigned iv_begin,
+      nvtx_T const nvtx,
+      arrays_local_T& arrays_local,
+      arrays_T& arrays,
+      EdgeWeightTable<typename CONFIG_T::base_t> const& edge_weights_table
+    )
+    {
+      #pragma HLS INLINE
+
+#ifndef __SYNTHESIS__
+      if (compute_weights_aggregates_fast<CONFIG_T>(data_getter, iv_begin, nvtx, arrays_local, arrays, edge_weights_table))
+        return;
+#endif
+
+      unsigned const unroll_factor = CONFIG_T::n_vertices >> CONFIG_T::log2_reuse_factor;
+
+     VerticesInner:
+      for (unsigned ir = 0; ir < unroll_factor; ++ir) {
+        unsigned iv = iv_begin + ir;
+
+        if (iv >= nvtx)
+          break;
+
+        compute_weights_aggregates<CONFIG_T>(data_getter, iv, arrays_local, arrays, edge_weights_table);
+      }
+    }
+
     template<class CONFIG_T, class arrays_T>
     inline
     typename CONFIG_T::aggr_t
@@ -479,6 +743,8 @@ namespace nnet {
       unsigned const unroll_factor = CONFIG_T::n_vertices >> CONFIG_T::log2_reuse_factor;
 
       Means<CONFIG_T, typename CONFIG_T::edge_weight_aggr_t> means_accum;
+
+      EdgeWeightTable<typename CONFIG_T::base_t> edge_weights_table;
       
      VerticesOuter:
       for (unsigned ivv = 0; ivv < CONFIG_T::reuse_factor; ++ivv) {
@@ -489,15 +755,7 @@ namespace nnet {
 
         Means<CONFIG_T, typename CONFIG_T::edge_weight_aggr_t> means_local;
 
-       VerticesInner:
-        for (unsigned ir = 0; ir < unroll_factor; ++ir) {
-          unsigned iv = ivv * unroll_factor + ir;
-
-          if (iv == nvtx)
-            break;
-    
-          compute_weights_aggregates<CONFIG_T>(data_getter, iv, means_local, arrays);
-        }
+        compute_weights_aggregates_block<CONFIG_T>(data_getter, ivv * unroll_factor, nvtx, means_local, arrays, edge_weights_table);
 
         means_accum.add_means_normalized(means_local);
       }
@@ -584,6 +842,8 @@ namespace nnet {
       unsigned const unroll_factor = current_layer_t::n_vertices >> current_layer_t::log2_reuse_factor;
 
       Means<current_layer_t, typename current_layer_t::edge_weight_aggr_t> means_accum;
+
+      EdgeWeightTable<typename current_layer_t::base_t> edge_weights_table;
       
      VerticesOuter:
       for (unsigned ivv = 0; ivv < current_layer_t::reuse_factor; ++ivv) {
@@ -610,7 +870,7 @@ namespace nnet {
 
           SingleVertexDataGetter<current_layer_t, data_T> data_getter(data);
           
-          compute_weights_aggregates<current_layer_t>(data_getter, iv, means_local, current_arrays);
+          compute_weights_aggregates<current_layer_t>(data_getter, iv, means_local, current_arrays, edge_weights_table);
         }
 
         means_accum.add_means_normalized(means_local);
@@ -770,7 +1030,7 @@ namespace nnet {
     typedef typename CONFIG_T::template sublayer_t<ilast> last_layer_t;
 
     garnet_utils::WeightsAndMeans<first_layer_t> arrays_first;
-    garnet_utils::Means<last_layer_t> arrays_last;
+    garnet_utils::WeightsAndMeans<last_layer_t> arrays_last;
 
     garnet_utils::aggregate<first_layer_t>(
       data,
@@ -0,0 +1,290 @@
+#ifndef NNET_GARNET_STREAM_H_
+#define NNET_GARNET_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_types.h"
+#include "nnet_garnet.h"
+#include "hls_stream.h"
+
+namespace nnet {
+  namespace garnet_utils {
+
+    // In io_stream, every element of the input and output streams holds 'n_vertices / reuse_factor' consecutive
+    // vertices, i.e. the reuse factor of the config is the number of stream elements per event.
+
+    template<class CONFIG_T, class data_T>
+    struct PackedVertexDataGetter {
+      typedef typename data_T::value_type data_t;
+
+      data_T const& dataref;
+
+      PackedVertexDataGetter(data_T const& d) : dataref{d} {
+        #pragma HLS INLINE
+      }
+      data_t const& get(unsigned iv, unsigned ix) const {
+        #pragma HLS INLINE
+        unsigned const unroll_factor = CONFIG_T::n_vertices >> CONFIG_T::log2_reuse_factor;
+        unsigned const irx = (iv % unroll_factor) * CONFIG_T::n_in_features + ix;
+        return dataref[irx];
+      }
+    };
+
+    template<class CONFIG_T, class res_T>
+    struct PackedVertexResSetter {
+      typedef typename res_T::value_type res_t;
+
+      res_T& resref;
+
+      PackedVertexResSetter(res_T& r) : resref{r} {
+        #pragma HLS INLINE
+      }
+      void set(unsigned iv, unsigned io, res_t const& acc) {
+        #pragma HLS INLINE
+        unsigned const unroll_factor = CONFIG_T::n_vertices >> CONFIG_T::log2_reuse_factor;
+        unsigned const iro = (iv % unroll_factor) * CONFIG_T::n_out_features + io;
+        resref[iro] = acc;
+      }
+    };
+
+    template<class CONFIG_T, class data_T, class nvtx_T, class arrays_T>
+    void
+    aggregate_stream(
+      hls::stream<data_T>& data,
+      nvtx_T const nvtx,
+      arrays_T& arrays
+    )
+    {
+      unsigned const unroll_factor = CONFIG_T::n_vertices >> CONFIG_T::log2_reuse_factor;
+      assert(data_T::size == unroll_factor * CONFIG_T::n_in_features);
+
+      Means<CONFIG_T, typename CONFIG_T::edge_weight_aggr_t> means_accum;
+
+      EdgeWeightTable<typename CONFIG_T::base_t> edge_weights_table;
+
+      // Edge weights and means are accumulated as the vertices arrive
+     VerticesOuter:
+      for (unsigned ivv = 0; ivv < CONFIG_T::reuse_factor; ++ivv) {
+        #pragma HLS PIPELINE
+
+        // The stream always carries n_vertices vertices, the ones beyond nvtx are read and dropped
+        data_T in_data = data.read();
+        PackedVertexDataGetter<CONFIG_T, data_T> data_getter(in_data);
+
+        Means<CONFIG_T, typename CONFIG_T::edge_weight_aggr_t> means_local;
+
+        compute_weights_aggregates_block<CONFIG_T>(data_getter, ivv * unroll_factor, nvtx, means_local, arrays, edge_weights_table);
+
+        means_accum.add_means_normalized(means_local);
+      }
+
+      arrays.set_means_normalized(nvtx, means_accum);
+    }
+
+    template<class CONFIG_T, class nvtx_T, class arrays_T, class res_T>
+    void
+    distribute_stream(
+      nvtx_T const nvtx,
+      arrays_T const& arrays,
+      hls::stream<res_T>& res
+    )
+    {
+      typename CONFIG_T::aggr_t output_base[CONFIG_T::n_out_features * CONFIG_T::n_aggregators];
+      #pragma HLS ARRAY_PARTITION variable=output_base complete
+
+      compute_output_base<CONFIG_T>(arrays, output_base);
+
+      unsigned const unroll_factor = CONFIG_T::n_vertices >> CONFIG_T::log2_reuse_factor;
+      assert(res_T::size == unroll_factor * CONFIG_T::n_out_features);
+
+     VerticesOuter:
+      for (unsigned ivv = 0; ivv < CONFIG_T::reuse_factor; ++ivv) {
+        #pragma HLS PIPELINE
+
+        res_T res_pack;
+        #pragma HLS DATA_PACK variable=res_pack
+
+        PackedVertexResSetter<CONFIG_T, res_T> res_setter(res_pack);
+
+       VerticesInner:
+        for (unsigned ir = 0; ir < unroll_factor; ++ir) {
+          unsigned iv = ivv * unroll_factor + ir;
+
+          if (iv < nvtx) {
+            compute_vertex_output<CONFIG_T>(arrays, iv, output_base, res_setter);
+          }
+          else {
+           OutFeatures:
+            for (unsigned io = 0; io < CONFIG_T::n_out_features; ++io)
+              res_setter.set(iv, io, 0);
+          }
+        }
+
+        res.write(res_pack);
+      }
+    }
+
+    template<class CONFIG_T, class nvtx_T, class arrays_T, class res_T>
+    void
+    set_output_stream(
+      nvtx_T const nvtx,
+      arrays_T const& arrays,
+      hls::stream<res_T>& res
+    )
+    {
+      OutputBiasNormalizer<CONFIG_T, nvtx_T> normalize_bias(nvtx);
+
+      typename res_T::value_type out_data[CONFIG_T::n_out_features];
+      #pragma HLS ARRAY_PARTITION variable=out_data complete
+
+      set_output<CONFIG_T>(normalize_bias, arrays, out_data);
+
+      res_T res_pack;
+      #pragma HLS DATA_PACK variable=res_pack
+
+     OutFeatures:
+      for (unsigned io = 0; io < CONFIG_T::n_out_features; ++io) {
+        #pragma HLS UNROLL
+        res_pack[io] = out_data[io];
+      }
+
+      res.write(res_pack);
+    }
+  }
+
+  // vertices -> vertices
+  template<class data_T, class nvtx_T, class res_T, typename CONFIG_T>
+  typename std::enable_if<CONFIG_T::output_collapse == CONFIG_T::no_collapse>::type
+  garnet(
+    hls::stream<data_T>& data,
+    hls::stream<nvtx_T>& nvtx,
+    hls::stream<res_T>& res
+  )
+  {
+    #pragma HLS DATAFLOW
+
+    typename nvtx_T::value_type const nvtx_in = nvtx.read()[0];
+
+    garnet_utils::WeightsAndMeans<CONFIG_T> arrays;
+
+    garnet_utils::aggregate_stream<CONFIG_T>(
+      data,
+      nvtx_in,
+      arrays
+    );
+
+    garnet_utils::distribute_stream<CONFIG_T>(
+      nvtx_in,
+      arrays,
+      res
+    );
+  }
+
+  // vertices -> out features
+  template<class data_T, class nvtx_T, class res_T, typename CONFIG_T>
+  typename std::enable_if<CONFIG_T::output_collapse == CONFIG_T::collapse_mean>::type
+  garnet(
+    hls::stream<data_T>& data,
+    hls::stream<nvtx_T>& nvtx,
+    hls::stream<res_T>& res
+  )
+  {
+    #pragma HLS DATAFLOW
+
+    typename nvtx_T::value_type const nvtx_in = nvtx.read()[0];
+
+    garnet_utils::Means<CONFIG_T> arrays;
+
+    garnet_utils::aggregate_stream<CONFIG_T>(
+      data,
+      nvtx_in,
+      arrays
+    );
+
+    garnet_utils::set_output_stream<CONFIG_T>(
+      nvtx_in,
+      arrays,
+      res
+    );
+  }
+
+  // vertices -> vertices
+  template<class data_T, class nvtx_T, class res_T, typename CONFIG_T>
+  typename std::enable_if<CONFIG_T::output_collapse == CONFIG_T::no_collapse>::type
+  garnet_stack(
+    hls::stream<data_T>& data,
+    hls::stream<nvtx_T>& nvtx,
+    hls::stream<res_T>& res
+  )
+  {
+    #pragma HLS DATAFLOW
+
+    typedef typename CONFIG_T::template sublayer_t<0> first_layer_t;
+    unsigned const ilast = CONFIG_T::n_sublayers - 1;
+    typedef typename CONFIG_T::template sublayer_t<ilast> last_layer_t;
+
+    typename nvtx_T::value_type const nvtx_in = nvtx.read()[0];
+
+    garnet_utils::WeightsAndMeans<first_layer_t> arrays_first;
+    garnet_utils::WeightsAndMeans<last_layer_t> arrays_last;
+
+    garnet_utils::aggregate_stream<first_layer_t>(
+      data,
+      nvtx_in,
+      arrays_first
+    );
+
+    garnet_utils::sublayer<first_layer_t, typename first_layer_t::next_layer_t, last_layer_t>(
+      nvtx_in,
+      arrays_first,
+      arrays_last
+    );
+
+    garnet_utils::distribute_stream<last_layer_t>(
+      nvtx_in,
+      arrays_last,
+      res
+    );
+  }
+
+  // vertices -> out features
+  template<class data_T, class nvtx_T, class res_T, typename CONFIG_T>
+  typename std::enable_if<CONFIG_T::output_collapse == CONFIG_T::collapse_mean>::type
+  garnet_stack(
+    hls::stream<data_T>& data,
+    hls::stream<nvtx_T>& nvtx,
+    hls::stream<res_T>& res
+  )
+  {
+    #pragma HLS DATAFLOW
+
+    typedef typename CONFIG_T::template sublayer_t<0> first_layer_t;
+    unsigned const ilast = CONFIG_T::n_sublayers - 1;
+    typedef typename CONFIG_T::template sublayer_t<ilast> last_layer_t;
+
+    typename nvtx_T::value_type const nvtx_in = nvtx.read()[0];
+
+    garnet_utils::WeightsAndMeans<first_layer_t> arrays_first;
+    garnet_utils::Means<last_layer_t> arrays_last;
+
+    garnet_utils::aggregate_stream<first_layer_t>(
+      data,
+      nvtx_in,
+      arrays_first
+    );
+
+    garnet_utils::sublayer<first_layer_t, typename first_layer_t::next_layer_t, last_layer_t>(
+      nvtx_in,
+      arrays_first,
+      arrays_last
+    );
+
+    garnet_utils::set_output_stream<last_layer_t>(
+      nvtx_in,
+      arrays_last,
+      res
+    );
+  }
+
+}
+
+#endif
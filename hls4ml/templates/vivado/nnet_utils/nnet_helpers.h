@@ -30,6 +30,12 @@
 #include <iostream>
 #include "hls_stream.h"
 
+#ifdef HLS_STREAM_THREAD_SAFE
+#include <atomic>
+#include <mutex>
+#include <thread>
+#endif
+
 namespace nnet {
 
 #ifndef __SYNTHESIS__
@@ -274,6 +280,26 @@ void save_layer_output(hls::stream<data_T> &data, const char *layer_name, size_t
     }
 }
 
+#ifdef HLS_STREAM_THREAD_SAFE
+inline std::mutex &csim_print_mutex() {
+    static std::mutex print_mutex;
+    return print_mutex;
+}
+
+// Runs one layer of the threaded C simulation, a deadlock is reported and counted instead of ending the program
+template<class F>
+std::thread csim_thread(const char *layer_name, std::atomic<int> &n_deadlocked, F layer) {
+    return std::thread([=, &n_deadlocked]() {
+        try {
+            layer();
+        } catch (const hls::stream_deadlock &e) {
+            std::lock_guard<std::mutex> lock(csim_print_mutex());
+            std::cout << "ERROR: Layer " << layer_name << " deadlocked: " << e.what() << std::endl;
+            n_deadlocked++;
+        }
+    });
+}
+#endif
 
 #endif
 
@@ -13,28 +13,75 @@ struct resize_config {
     static const unsigned n_chan = 10;
     static const unsigned new_height = 10;
     static const unsigned new_width = 10;
+
+    // Source coordinates of every output row and column, computed at compile time. Output row i interpolates
+    // input rows y_lower[i] and y_upper[i] with weight y_lerp[i] / 2^interp_bits on y_upper[i] (same for columns).
+    // Nearest neighbour only uses y_lower/x_lower.
+    static const unsigned interp_bits = 10;
+    // static const unsigned y_lower[new_height], y_upper[new_height], y_lerp[new_height];
+    // static const unsigned x_lower[new_width], x_upper[new_width], x_lerp[new_width];
+
+    typedef ap_fixed<16,6> interp_t; // Precision of the interpolation between two pixels
 };
 
+template<typename CONFIG_T>
+ap_ufixed<CONFIG_T::interp_bits, 0> resize_weight(unsigned lerp) {
+    #pragma HLS INLINE
+    ap_ufixed<CONFIG_T::interp_bits, 0> weight;
+    weight.range(CONFIG_T::interp_bits - 1, 0) = lerp;
+    return weight;
+}
+
+// Linear interpolation a + (b - a) * weight
+template<typename CONFIG_T, class data_T>
+typename CONFIG_T::interp_t resize_lerp(data_T a, data_T b, ap_ufixed<CONFIG_T::interp_bits, 0> weight) {
+    #pragma HLS INLINE
+    typename CONFIG_T::interp_t diff = typename CONFIG_T::interp_t(b) - typename CONFIG_T::interp_t(a);
+    return typename CONFIG_T::interp_t(a) + typename CONFIG_T::interp_t(diff * weight);
+}
+
 template<class data_T, typename CONFIG_T>
 void resize_nearest(
     data_T image[CONFIG_T::height * CONFIG_T::width * CONFIG_T::n_chan],
     data_T resized[CONFIG_T::new_height * CONFIG_T::new_width * CONFIG_T::n_chan]
 ) {
-    int y_ratio = (int)((CONFIG_T::height << 16) / CONFIG_T::new_height) + 1;
-    int x_ratio = (int)((CONFIG_T::width << 16) / CONFIG_T::new_width) + 1;
-    int x2, y2;
+    #pragma HLS PIPELINE
+
+    for (int i = 0; i < CONFIG_T::new_height; i++) {
+        unsigned y = CONFIG_T::y_lower[i];
+        for (int j = 0; j < CONFIG_T::new_width; j++) {
+            unsigned x = CONFIG_T::x_lower[j];
+            for (int k = 0; k < CONFIG_T::n_chan; k++) {
+                resized[(i * CONFIG_T::new_width + j) * CONFIG_T::n_chan + k] = image[(y * CONFIG_T::width + x) * CONFIG_T::n_chan + k];
+            }
+        }
+    }
+}
 
+template<class data_T, typename CONFIG_T>
+void resize_bilinear(
+    data_T image[CONFIG_T::height * CONFIG_T::width * CONFIG_T::n_chan],
+    data_T resized[CONFIG_T::new_height * CONFIG_T::new_width * CONFIG_T::n_chan]
+) {
     #pragma HLS PIPELINE
 
     for (int i = 0; i < CONFIG_T::new_height; i++) {
+        unsigned y0 = CONFIG_T::y_lower[i];
+        unsigned y1 = CONFIG_T::y_upper[i];
+        ap_ufixed<CONFIG_T::interp_bits, 0> wy = resize_weight<CONFIG_T>(CONFIG_T::y_lerp[i]);
         for (int j = 0; j < CONFIG_T::new_width; j++) {
-            x2 = ((j * x_ratio) >> 16);
-            y2 = ((i * y_ratio) >> 16);
+            unsigned x0 = CONFIG_T::x_lower[j];
+            unsigned x1 = CONFIG_T::x_upper[j];
+            ap_ufixed<CONFIG_T::interp_bits, 0> wx = resize_weight<CONFIG_T>(CONFIG_T::x_lerp[j]);
             for (int k = 0; k < CONFIG_T::n_chan; k++) {
-                resized[(i * CONFIG_T::new_width * CONFIG_T::n_chan) + j * CONFIG_T::n_chan + k] = image[(y2 * CONFIG_T::width * CONFIG_T::n_chan) + x2 * CONFIG_T::n_chan + k];
+                typename CONFIG_T::interp_t top = resize_lerp<CONFIG_T>(
+                    image[(y0 * CONFIG_T::width + x0) * CONFIG_T::n_chan + k], image[(y0 * CONFIG_T::width + x1) * CONFIG_T::n_chan + k], wx);
+                typename CONFIG_T::interp_t bottom = resize_lerp<CONFIG_T>(
+                    image[(y1 * CONFIG_T::width + x0) * CONFIG_T::n_chan + k], image[(y1 * CONFIG_T::width + x1) * CONFIG_T::n_chan + k], wx);
+                resized[(i * CONFIG_T::new_width + j) * CONFIG_T::n_chan + k] = resize_lerp<CONFIG_T>(top, bottom, wy);
             }
         }
-    }  
+    }
 }
 
 }
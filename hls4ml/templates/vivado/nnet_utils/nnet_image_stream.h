@@ -1,64 +1,116 @@
-#ifndef NNET_IMAGE_STREAM_H_
-#define NNET_IMAGE_STREAM_H_
-
-#include "nnet_common.h"
-#include "hls_stream.h"
-
-namespace nnet {
-
-template<class data_T, typename CONFIG_T>
-void resize_nearest(
-    hls::stream<data_T> &image,
-    hls::stream<data_T> &resized
-) {
-	assert(CONFIG_T::new_height % CONFIG_T::height == 0);
-	assert(CONFIG_T::new_width % CONFIG_T::width == 0);
-	constexpr unsigned ratio_height = CONFIG_T::new_height / CONFIG_T::height;
-	constexpr unsigned ratio_width = CONFIG_T::new_width / CONFIG_T::width;
-	
-	
-	ImageHeight: for (unsigned h = 0; h < CONFIG_T::height; h++) {
-		#pragma HLS PIPELINE
-	
-		data_T data_in_row[CONFIG_T::width];
-		
-		ImageWidth: for (unsigned i = 0; i < CONFIG_T::width; i++) {
-			#pragma HLS UNROLL
-			
-			data_T  in_data = image.read();
-			
-			ImageChan: for (unsigned j = 0; j < CONFIG_T::n_chan; j++) {
-				#pragma HLS UNROLL
-				
-				data_in_row[i][j] = in_data[j];
-			}
-		}
-		
-		ResizeHeight: for (unsigned i = 0; i <ratio_height; i++) {
-			#pragma HLS UNROLL
-			
-			ImageWidth2: for (unsigned l = 0; l < CONFIG_T::width; l++) {
-				#pragma HLS UNROLL
-				
-				ResizeWidth: for (unsigned j = 0; j < ratio_width; j++) {
-					#pragma HLS UNROLL
-				
-					data_T out_data;
-					#pragma HLS DATA_PACK variable=out_data
-				
-					ResizeChan: for (unsigned k = 0; k < CONFIG_T::n_chan; k++) {
-						#pragma HLS UNROLL
-					
-						out_data[k] = data_in_row[l][k];
-					}
-					
-					resized.write(out_data);   
-				}
-			}
-		}
-	}
-}
-
-}
-
-#endif
+#ifndef NNET_IMAGE_STREAM_H_
+#define NNET_IMAGE_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_image.h"
+#include "hls_stream.h"
+
+namespace nnet {
+
+// The output is produced row by row. Before computing an output row, the input rows are read up to the last row
+// it needs, rows that no output needs (downscaling) are read and dropped. The remaining input rows are drained
+// at the end so the whole image is always consumed.
+
+template<class data_T, typename CONFIG_T>
+void read_image_row(
+    hls::stream<data_T> &image,
+    typename data_T::value_type row[CONFIG_T::width * CONFIG_T::n_chan]
+) {
+    ReadRow: for (unsigned x = 0; x < CONFIG_T::width; x++) {
+        #pragma HLS PIPELINE
+        data_T in_data = image.read();
+        ReadChan: for (unsigned k = 0; k < CONFIG_T::n_chan; k++) {
+            #pragma HLS UNROLL
+            row[x * CONFIG_T::n_chan + k] = in_data[k];
+        }
+    }
+}
+
+template<class data_T, typename CONFIG_T>
+void resize_nearest(
+    hls::stream<data_T> &image,
+    hls::stream<data_T> &resized
+) {
+    assert(data_T::size == CONFIG_T::n_chan);
+
+    typename data_T::value_type row[CONFIG_T::width * CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=row cyclic factor=CONFIG_T::n_chan
+
+    unsigned rows_read = 0;
+
+    ResizeHeight: for (unsigned i = 0; i < CONFIG_T::new_height; i++) {
+        ReadRows: for (; rows_read <= CONFIG_T::y_lower[i]; rows_read++) {
+            #pragma HLS LOOP_TRIPCOUNT min=0 max=CONFIG_T::height
+            read_image_row<data_T, CONFIG_T>(image, row);
+        }
+
+        ResizeWidth: for (unsigned j = 0; j < CONFIG_T::new_width; j++) {
+            #pragma HLS PIPELINE
+            unsigned x = CONFIG_T::x_lower[j];
+            data_T out_data;
+            #pragma HLS DATA_PACK variable=out_data
+            ResizeChan: for (unsigned k = 0; k < CONFIG_T::n_chan; k++) {
+                #pragma HLS UNROLL
+                out_data[k] = row[x * CONFIG_T::n_chan + k];
+            }
+            resized.write(out_data);
+        }
+    }
+
+    DrainRows: for (; rows_read < CONFIG_T::height; rows_read++) {
+        #pragma HLS LOOP_TRIPCOUNT min=0 max=CONFIG_T::height
+        read_image_row<data_T, CONFIG_T>(image, row);
+    }
+}
+
+// Bilinear interpolation only needs the two most recent input rows, input row r is kept in slot r % 2
+template<class data_T, typename CONFIG_T>
+void resize_bilinear(
+    hls::stream<data_T> &image,
+    hls::stream<data_T> &resized
+) {
+    assert(data_T::size == CONFIG_T::n_chan);
+
+    typename data_T::value_type rows[2][CONFIG_T::width * CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=rows complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=rows cyclic factor=CONFIG_T::n_chan dim=2
+
+    unsigned rows_read = 0;
+
+    ResizeHeight: for (unsigned i = 0; i < CONFIG_T::new_height; i++) {
+        ReadRows: for (; rows_read <= CONFIG_T::y_upper[i]; rows_read++) {
+            #pragma HLS LOOP_TRIPCOUNT min=0 max=CONFIG_T::height
+            read_image_row<data_T, CONFIG_T>(image, rows[rows_read % 2]);
+        }
+
+        unsigned slot0 = CONFIG_T::y_lower[i] % 2;
+        unsigned slot1 = CONFIG_T::y_upper[i] % 2;
+        ap_ufixed<CONFIG_T::interp_bits, 0> wy = resize_weight<CONFIG_T>(CONFIG_T::y_lerp[i]);
+
+        ResizeWidth: for (unsigned j = 0; j < CONFIG_T::new_width; j++) {
+            #pragma HLS PIPELINE
+            unsigned x0 = CONFIG_T::x_lower[j];
+            unsigned x1 = CONFIG_T::x_upper[j];
+            ap_ufixed<CONFIG_T::interp_bits, 0> wx = resize_weight<CONFIG_T>(CONFIG_T::x_lerp[j]);
+
+            data_T out_data;
+            #pragma HLS DATA_PACK variable=out_data
+            ResizeChan: for (unsigned k = 0; k < CONFIG_T::n_chan; k++) {
+                #pragma HLS UNROLL
+                typename CONFIG_T::interp_t top = resize_lerp<CONFIG_T>(rows[slot0][x0 * CONFIG_T::n_chan + k], rows[slot0][x1 * CONFIG_T::n_chan + k], wx);
+                typename CONFIG_T::interp_t bottom = resize_lerp<CONFIG_T>(rows[slot1][x0 * CONFIG_T::n_chan + k], rows[slot1][x1 * CONFIG_T::n_chan + k], wx);
+                out_data[k] = resize_lerp<CONFIG_T>(top, bottom, wy);
+            }
+            resized.write(out_data);
+        }
+    }
+
+    DrainRows: for (; rows_read < CONFIG_T::height; rows_read++) {
+        #pragma HLS LOOP_TRIPCOUNT min=0 max=CONFIG_T::height
+        read_image_row<data_T, CONFIG_T>(image, rows[rows_read % 2]);
+    }
+}
+
+}
+
+#endif
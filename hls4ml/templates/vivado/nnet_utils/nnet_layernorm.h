@@ -0,0 +1,158 @@
+#ifndef NNET_LAYERNORM_H_
+#define NNET_LAYERNORM_H_
+
+#include "nnet_common.h"
+#include "nnet_mult.h"
+#include "hls_stream.h"
+#include <math.h>
+
+namespace nnet {
+
+struct layernorm_config
+{
+    // Internal data type definitions
+    typedef float bias_t;
+    typedef float scale_t;
+    typedef float mean_t;
+    typedef float variance_t;
+    typedef float table_t;
+
+    // Layer Sizes
+    static const unsigned n_in = 20;   // Size of the normalized (last) axis
+    static const unsigned seq_len = 4; // Number of vectors normalized independently
+
+    // Inverse square root table
+    static const unsigned table_size = 1024;
+    static constexpr float table_range = 1.0;
+    static const unsigned table_shifts = 0; // Divisions by 4 of the variances past table_range
+    static constexpr float epsilon = 0.001;
+
+    // Resource reuse info
+    static const unsigned io_type = io_parallel;
+    static const unsigned reuse_factor = 1;
+    static const bool store_weights_in_bram = false;
+    static const unsigned n_zeros = 0;
+    template<class x_T, class y_T>
+    using product = nnet::product::mult<x_T, y_T>;
+};
+
+template<typename CONFIG_T, int N_TABLE>
+void init_invert_sqr_table(typename CONFIG_T::table_t table_out[N_TABLE])
+{
+    // Inversion function:
+    //   result = 1/sqrt(x + epsilon), x being the center of the bin covered by the entry
+    float step = CONFIG_T::table_range / float(N_TABLE);
+    for (int ii = 0; ii < N_TABLE; ii++) {
+        float in_val = step * (ii + 0.5) + CONFIG_T::epsilon;
+        table_out[ii] = 1.0 / sqrt(in_val);
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void layernorm_1d(
+    data_T    data[CONFIG_T::n_in],
+    res_T     res[CONFIG_T::n_in],
+    typename CONFIG_T::scale_t  scale[CONFIG_T::n_in],
+    typename CONFIG_T::bias_t   bias[CONFIG_T::n_in]
+)
+{
+    #pragma HLS INLINE
+    #pragma HLS ARRAY_PARTITION variable=data complete
+    #pragma HLS ARRAY_PARTITION variable=res complete
+
+#ifdef __HLS_SYN__
+    bool initialized = false;
+    typename CONFIG_T::table_t invert_sqr_table[CONFIG_T::table_size];
+#else
+    static bool initialized = false;
+    static typename CONFIG_T::table_t invert_sqr_table[CONFIG_T::table_size];
+#endif
+    if (!initialized) {
+        init_invert_sqr_table<CONFIG_T, CONFIG_T::table_size>(invert_sqr_table);
+        initialized = true;
+    }
+
+    // 1/n_in with the (finer) resolution of the variance
+    typename CONFIG_T::variance_t const n_inv = 1. / CONFIG_T::n_in;
+    // Entries of the table per unit of variance
+    ap_ufixed<24, 16> const index_scale = CONFIG_T::table_size / CONFIG_T::table_range;
+
+    typename CONFIG_T::mean_t sum = 0;
+    Mean: for (int i = 0; i < CONFIG_T::n_in; i++) {
+        #pragma HLS UNROLL
+        sum += data[i];
+    }
+    typename CONFIG_T::mean_t mean = sum * n_inv;
+
+    typename CONFIG_T::mean_t diff[CONFIG_T::n_in];
+    #pragma HLS ARRAY_PARTITION variable=diff complete
+    typename CONFIG_T::variance_t sum_sq = 0;
+    Variance: for (int i = 0; i < CONFIG_T::n_in; i++) {
+        #pragma HLS UNROLL
+        diff[i] = data[i] - mean;
+        sum_sq += diff[i] * diff[i];
+    }
+    typename CONFIG_T::variance_t variance = sum_sq * n_inv;
+
+    // Variances past the range of the table are divided by 4 until they fit, each division halves the result
+    typename CONFIG_T::variance_t const range = CONFIG_T::table_range;
+    unsigned shift = 0;
+    RangeReduce: for (unsigned k = 0; k < CONFIG_T::table_shifts; k++) {
+        #pragma HLS UNROLL
+        if (variance >= range) {
+            variance = variance >> 2;
+            shift++;
+        }
+    }
+
+    int index = variance * index_scale;
+    if (index < 0) index = 0;
+    if (index > CONFIG_T::table_size - 1) index = CONFIG_T::table_size - 1;
+    typename CONFIG_T::table_t inv_std = invert_sqr_table[index];
+
+    Result: for (int i = 0; i < CONFIG_T::n_in; i++) {
+        #pragma HLS UNROLL
+        typename CONFIG_T::mean_t norm = (diff[i] * inv_std) >> shift;
+        res[i] = CONFIG_T::template product<typename CONFIG_T::mean_t, typename CONFIG_T::scale_t>::product(norm, scale[i]) + bias[i];
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void layernormalize(
+    data_T    data[CONFIG_T::seq_len * CONFIG_T::n_in],
+    res_T     res[CONFIG_T::seq_len * CONFIG_T::n_in],
+    typename CONFIG_T::scale_t  scale[CONFIG_T::n_in],
+    typename CONFIG_T::bias_t   bias[CONFIG_T::n_in]
+)
+{
+    #pragma HLS ARRAY_PARTITION variable=scale complete
+    #pragma HLS ARRAY_PARTITION variable=bias complete
+
+    constexpr unsigned multiplier_limit = DIV_ROUNDUP(CONFIG_T::n_in, CONFIG_T::reuse_factor);
+    CONFIG_T::template product<typename CONFIG_T::mean_t, typename CONFIG_T::scale_t>::limit(multiplier_limit);
+
+    data_T in_val[CONFIG_T::n_in];
+    #pragma HLS ARRAY_PARTITION variable=in_val complete
+    res_T out_val[CONFIG_T::n_in];
+    #pragma HLS ARRAY_PARTITION variable=out_val complete
+
+    LayerNormLoop: for (int j = 0; j < CONFIG_T::seq_len; j++) {
+        #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+
+        for (int i = 0; i < CONFIG_T::n_in; i++) {
+            #pragma HLS UNROLL
+            in_val[i] = data[j * CONFIG_T::n_in + i];
+        }
+
+        layernorm_1d<data_T, res_T, CONFIG_T>(in_val, out_val, scale, bias);
+
+        for (int i = 0; i < CONFIG_T::n_in; i++) {
+            #pragma HLS UNROLL
+            res[j * CONFIG_T::n_in + i] = out_val[i];
+        }
+    }
+}
+
+}
+
+#endif
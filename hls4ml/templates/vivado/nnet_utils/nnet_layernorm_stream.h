@@ -0,0 +1,61 @@
+#ifndef NNET_LAYERNORM_STREAM_H_
+#define NNET_LAYERNORM_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_mult.h"
+#include "nnet_types.h"
+#include "nnet_layernorm.h"
+#include "hls_stream.h"
+
+namespace nnet {
+
+// ****************************************************
+//       Streaming Layer Normalization
+// ****************************************************
+
+// Every element of the stream holds one vector of the normalized axis
+template<class data_T, class res_T, typename CONFIG_T>
+void layernormalize(
+    hls::stream<data_T> &data,
+    hls::stream<res_T>  &res,
+    typename CONFIG_T::scale_t scale[CONFIG_T::n_in],
+    typename CONFIG_T::bias_t  bias[CONFIG_T::n_in]
+) {
+    #pragma HLS ARRAY_PARTITION variable=scale complete
+    #pragma HLS ARRAY_PARTITION variable=bias complete
+
+    assert(data_T::size == CONFIG_T::n_in && res_T::size == CONFIG_T::n_in);
+
+    constexpr unsigned multiplier_limit = DIV_ROUNDUP(CONFIG_T::n_in, CONFIG_T::reuse_factor);
+    CONFIG_T::template product<typename CONFIG_T::mean_t, typename CONFIG_T::scale_t>::limit(multiplier_limit);
+
+    typename data_T::value_type in_val[CONFIG_T::n_in];
+    #pragma HLS ARRAY_PARTITION variable=in_val complete
+    typename res_T::value_type out_val[CONFIG_T::n_in];
+    #pragma HLS ARRAY_PARTITION variable=out_val complete
+
+    LayerNormLoop: for (int j = 0; j < CONFIG_T::seq_len; j++) {
+        #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+
+        data_T in_data = data.read();
+        LayerNormUnpack: for (int i = 0; i < CONFIG_T::n_in; i++) {
+            #pragma HLS UNROLL
+            in_val[i] = in_data[i];
+        }
+
+        layernorm_1d<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(in_val, out_val, scale, bias);
+
+        res_T out_data;
+        #pragma HLS DATA_PACK variable=out_data
+        LayerNormPack: for (int i = 0; i < CONFIG_T::n_in; i++) {
+            #pragma HLS UNROLL
+            out_data[i] = out_val[i];
+        }
+
+        res.write(out_data);
+    }
+}
+
+}
+
+#endif
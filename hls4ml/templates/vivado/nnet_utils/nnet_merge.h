@@ -30,6 +30,8 @@ namespace nnet {
 struct merge_config
 {
     static const unsigned n_elem = 10;
+    static const unsigned n_inputs = 2;
+    typedef float accum_t; // Used by the N-input merges
 };
 
 struct dot_config {
@@ -53,6 +55,15 @@ struct concat_config {
     static const unsigned axis = -1;
 };
 
+struct concat_n_config {
+    static const unsigned n_inputs = 3;
+    static const unsigned n_outer = 1;     // Product of the dimensions before the concatenation axis
+    static const unsigned n_inner = 1;     // Product of the dimensions after the concatenation axis
+    static const unsigned n_axis_out = 30; // Size of the output along the concatenation axis
+    // Size of every input along the concatenation axis and its offset in the output
+    // static constexpr unsigned n_axis[n_inputs], axis_offset[n_inputs];
+};
+
 template<class input1_T, class input2_T, class res_T, typename CONFIG_T>
 void add(
     input1_T data1[CONFIG_T::n_elem],
@@ -120,6 +131,108 @@ void minimum(
     }
 }
 
+// N-input merges fold the inputs one by one into an accumulator of type CONFIG_T::accum_t, so a merge of any
+// number of inputs is a single layer instead of a chain of two-input merges
+namespace merge_op {
+
+struct add {
+    template<class acc_T, class x_T>
+    static acc_T apply(acc_T acc, x_T x) { return acc + x; }
+    template<class CONFIG_T, class acc_T>
+    static acc_T finish(acc_T acc) { return acc; }
+};
+
+struct multiply {
+    template<class acc_T, class x_T>
+    static acc_T apply(acc_T acc, x_T x) { return acc * x; }
+    template<class CONFIG_T, class acc_T>
+    static acc_T finish(acc_T acc) { return acc; }
+};
+
+struct average {
+    template<class acc_T, class x_T>
+    static acc_T apply(acc_T acc, x_T x) { return acc + x; }
+    template<class CONFIG_T, class acc_T>
+    static acc_T finish(acc_T acc) { return acc / (acc_T) CONFIG_T::n_inputs; }
+};
+
+struct maximum {
+    template<class acc_T, class x_T>
+    static acc_T apply(acc_T acc, x_T x) { return (x > acc) ? (acc_T) x : acc; }
+    template<class CONFIG_T, class acc_T>
+    static acc_T finish(acc_T acc) { return acc; }
+};
+
+struct minimum {
+    template<class acc_T, class x_T>
+    static acc_T apply(acc_T acc, x_T x) { return (x < acc) ? (acc_T) x : acc; }
+    template<class CONFIG_T, class acc_T>
+    static acc_T finish(acc_T acc) { return acc; }
+};
+
+}
+
+template<class OP, typename CONFIG_T>
+void merge_n_fold(typename CONFIG_T::accum_t acc[]) {}
+
+template<class OP, typename CONFIG_T, class input_T, class... rest_T>
+void merge_n_fold(
+    typename CONFIG_T::accum_t acc[CONFIG_T::n_elem],
+    input_T data[CONFIG_T::n_elem],
+    rest_T... rest)
+{
+    #pragma HLS INLINE
+    for (int ii = 0; ii < CONFIG_T::n_elem; ii++) {
+        acc[ii] = OP::apply(acc[ii], data[ii]);
+    }
+    merge_n_fold<OP, CONFIG_T>(acc, rest...);
+}
+
+template<class OP, class res_T, typename CONFIG_T, class input_T, class... rest_T>
+void merge_n(
+    res_T res[CONFIG_T::n_elem],
+    input_T data[CONFIG_T::n_elem],
+    rest_T... rest)
+{
+    #pragma HLS PIPELINE
+
+    typename CONFIG_T::accum_t acc[CONFIG_T::n_elem];
+    #pragma HLS ARRAY_PARTITION variable=acc complete
+
+    for (int ii = 0; ii < CONFIG_T::n_elem; ii++) {
+        acc[ii] = data[ii];
+    }
+    merge_n_fold<OP, CONFIG_T>(acc, rest...);
+    for (int ii = 0; ii < CONFIG_T::n_elem; ii++) {
+        res[ii] = OP::template finish<CONFIG_T>(acc[ii]);
+    }
+}
+
+template<class res_T, typename CONFIG_T, class... input_T>
+void add_n(res_T res[CONFIG_T::n_elem], input_T... data) {
+    merge_n<merge_op::add, res_T, CONFIG_T>(res, data...);
+}
+
+template<class res_T, typename CONFIG_T, class... input_T>
+void multiply_n(res_T res[CONFIG_T::n_elem], input_T... data) {
+    merge_n<merge_op::multiply, res_T, CONFIG_T>(res, data...);
+}
+
+template<class res_T, typename CONFIG_T, class... input_T>
+void average_n(res_T res[CONFIG_T::n_elem], input_T... data) {
+    merge_n<merge_op::average, res_T, CONFIG_T>(res, data...);
+}
+
+template<class res_T, typename CONFIG_T, class... input_T>
+void maximum_n(res_T res[CONFIG_T::n_elem], input_T... data) {
+    merge_n<merge_op::maximum, res_T, CONFIG_T>(res, data...);
+}
+
+template<class res_T, typename CONFIG_T, class... input_T>
+void minimum_n(res_T res[CONFIG_T::n_elem], input_T... data) {
+    merge_n<merge_op::minimum, res_T, CONFIG_T>(res, data...);
+}
+
 template<class input1_T, class input2_T, class res_T, typename CONFIG_T>
 void dot1d(
     input1_T data1[CONFIG_T::n_in],
@@ -269,7 +382,7 @@ void concatenate3d_2(
                              + kk;
                 res[res_idx] = data1[data_idx];
             }
-            for (int kk=0; kk<CONFIG_T::n_elem1_2; kk++) {
+            for (int kk=0; kk<CONFIG_T::n_elem2_2; kk++) {
                 int res_idx = ii * CONFIG_T::n_elem1_1 * (CONFIG_T::n_elem1_2 + CONFIG_T::n_elem2_2)
                             + jj * (CONFIG_T::n_elem1_2 + CONFIG_T::n_elem2_2)
                             + kk + CONFIG_T::n_elem1_2;
@@ -297,6 +410,32 @@ void concatenate3d(
     }
 }
 
+// Concatenation of any number of inputs along any axis, input I fills the slice
+// [axis_offset[I], axis_offset[I] + n_axis[I]) of the concatenation axis
+template<typename CONFIG_T, unsigned I, class res_T>
+void concatenate_n_copy(res_T *res) {}
+
+template<typename CONFIG_T, unsigned I, class res_T, class input_T, class... rest_T>
+void concatenate_n_copy(res_T *res, input_T *data, rest_T... rest) {
+    #pragma HLS INLINE
+    const unsigned n_copy = CONFIG_T::n_axis[I] * CONFIG_T::n_inner;
+    for (int i = 0; i < CONFIG_T::n_outer; i++) {
+        for (int j = 0; j < n_copy; j++) {
+            res[(i * CONFIG_T::n_axis_out + CONFIG_T::axis_offset[I]) * CONFIG_T::n_inner + j] = data[i * n_copy + j];
+        }
+    }
+    concatenate_n_copy<CONFIG_T, I + 1>(res, rest...);
+}
+
+template<class res_T, typename CONFIG_T, class... input_T>
+void concatenate_n(
+    res_T res[CONFIG_T::n_outer * CONFIG_T::n_axis_out * CONFIG_T::n_inner],
+    input_T... data)
+{
+    #pragma HLS PIPELINE
+    concatenate_n_copy<CONFIG_T, 0>(res, data...);
+}
+
 }
 
 #endif
@@ -21,6 +21,7 @@
 #define NNET_MERGE_STREAM_H_
 
 #include "nnet_common.h"
+#include "nnet_merge.h"
 #include "hls_stream.h"
 #include <math.h>
 
@@ -176,6 +177,81 @@ void minimum(
     }
 }
 
+// N-input merges read one packet of every input per iteration and fold them into the accumulator in order
+template<class OP, typename CONFIG_T, class input_T, class... rest_T>
+void merge_n_fold(
+    typename CONFIG_T::accum_t acc[],
+    hls::stream<input_T> &data,
+    hls::stream<rest_T> &... rest)
+{
+    #pragma HLS INLINE
+    input_T in_data = data.read();
+    MergeFoldPack: for (int j = 0; j < input_T::size; j++) {
+        #pragma HLS UNROLL
+        acc[j] = OP::apply(acc[j], in_data[j]);
+    }
+    merge_n_fold<OP, CONFIG_T>(acc, rest...);
+}
+
+template<class OP, class res_T, typename CONFIG_T, class input_T, class... rest_T>
+void merge_n(
+    hls::stream<res_T> &res,
+    hls::stream<input_T> &data,
+    hls::stream<rest_T> &... rest)
+{
+    assert(input_T::size == res_T::size);
+
+    MergeLoop: for (int i = 0; i < CONFIG_T::n_elem / res_T::size; i++) {
+        #pragma HLS PIPELINE
+
+        typename CONFIG_T::accum_t acc[res_T::size];
+        #pragma HLS ARRAY_PARTITION variable=acc complete
+
+        input_T in_data = data.read();
+        MergeInitPack: for (int j = 0; j < res_T::size; j++) {
+            #pragma HLS UNROLL
+            acc[j] = in_data[j];
+        }
+
+        merge_n_fold<OP, CONFIG_T>(acc, rest...);
+
+        res_T out_data;
+        #pragma HLS DATA_PACK variable=out_data
+
+        MergePack: for (int j = 0; j < res_T::size; j++) {
+            #pragma HLS UNROLL
+            out_data[j] = OP::template finish<CONFIG_T>(acc[j]);
+        }
+
+        res.write(out_data);
+    }
+}
+
+template<class res_T, typename CONFIG_T, class... input_T>
+void add_n(hls::stream<res_T> &res, hls::stream<input_T> &... data) {
+    merge_n<merge_op::add, res_T, CONFIG_T>(res, data...);
+}
+
+template<class res_T, typename CONFIG_T, class... input_T>
+void multiply_n(hls::stream<res_T> &res, hls::stream<input_T> &... data) {
+    merge_n<merge_op::multiply, res_T, CONFIG_T>(res, data...);
+}
+
+template<class res_T, typename CONFIG_T, class... input_T>
+void average_n(hls::stream<res_T> &res, hls::stream<input_T> &... data) {
+    merge_n<merge_op::average, res_T, CONFIG_T>(res, data...);
+}
+
+template<class res_T, typename CONFIG_T, class... input_T>
+void maximum_n(hls::stream<res_T> &res, hls::stream<input_T> &... data) {
+    merge_n<merge_op::maximum, res_T, CONFIG_T>(res, data...);
+}
+
+template<class res_T, typename CONFIG_T, class... input_T>
+void minimum_n(hls::stream<res_T> &res, hls::stream<input_T> &... data) {
+    merge_n<merge_op::minimum, res_T, CONFIG_T>(res, data...);
+}
+
 template<class input1_T, class input2_T, class res_T, typename CONFIG_T>
 void concatenate3d_0(
     hls::stream<input1_T> &data1,
@@ -403,6 +479,60 @@ void concatenate1d(
         res.write(out_data);
     }
 }
+// Concatenation along the last axis packs one packet of every input into each output packet, the offset of
+// every input in the output packet is accumulated at compile time
+template<unsigned offset, class res_T>
+void concatenate_n_pack(res_T &out_data) {}
+
+template<unsigned offset, class res_T, class input_T, class... rest_T>
+void concatenate_n_pack(res_T &out_data, hls::stream<input_T> &data, hls::stream<rest_T> &... rest) {
+    #pragma HLS INLINE
+    input_T in_data = data.read();
+    ConcatPackInput: for (int k = 0; k < input_T::size; k++) {
+        #pragma HLS UNROLL
+        out_data[offset + k] = in_data[k];
+    }
+    concatenate_n_pack<offset + input_T::size>(out_data, rest...);
+}
+
+// Along any other axis the packets are forwarded unchanged, the inputs take turns for every outer index
+template<typename CONFIG_T, unsigned I, class res_T>
+void concatenate_n_forward(hls::stream<res_T> &res) {}
+
+template<typename CONFIG_T, unsigned I, class res_T, class input_T, class... rest_T>
+void concatenate_n_forward(hls::stream<res_T> &res, hls::stream<input_T> &data, hls::stream<rest_T> &... rest) {
+    #pragma HLS INLINE
+    ConcatForward: for (int j = 0; j < CONFIG_T::n_axis[I] * CONFIG_T::n_inner / input_T::size; j++) {
+        #pragma HLS PIPELINE II=1
+        input_T in_data = data.read();
+        res_T out_data;
+        #pragma HLS DATA_PACK variable=out_data
+        ConcatForwardPack: for (int k = 0; k < input_T::size; k++) {
+            #pragma HLS UNROLL
+            out_data[k] = in_data[k];
+        }
+        res.write(out_data);
+    }
+    concatenate_n_forward<CONFIG_T, I + 1>(res, rest...);
+}
+
+template<class res_T, typename CONFIG_T, class... input_T>
+void concatenate_n(hls::stream<res_T> &res, hls::stream<input_T> &... data) {
+    if (CONFIG_T::n_inner == 1 && CONFIG_T::n_axis_out == res_T::size) {
+        ConcatPackLoop: for (int i = 0; i < CONFIG_T::n_outer; i++) {
+            #pragma HLS PIPELINE
+            res_T out_data;
+            #pragma HLS DATA_PACK variable=out_data
+            concatenate_n_pack<0>(out_data, data...);
+            res.write(out_data);
+        }
+    } else {
+        ConcatOuterLoop: for (int i = 0; i < CONFIG_T::n_outer; i++) {
+            concatenate_n_forward<CONFIG_T, 0>(res, data...);
+        }
+    }
+}
+
 }
 
 #endif
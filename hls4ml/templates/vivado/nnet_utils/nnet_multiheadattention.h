@@ -0,0 +1,190 @@
+#ifndef NNET_MHT_H_
+#define NNET_MHT_H_
+
+#include "nnet_common.h"
+#include "nnet_mult.h"
+#include "nnet_dense.h"
+#include "nnet_activation.h"
+#include "hls_stream.h"
+#include <math.h>
+
+namespace nnet {
+
+struct multiheadattention_config
+{
+    // Internal data type definitions
+    typedef float accum_t;
+    typedef float qkv_t;       // Projected queries, keys and values
+    typedef float score_t;     // Dot products of the queries and the keys
+    typedef float attention_t; // Softmax of the scores
+    typedef float context_t;   // Attention-weighted values, input of the output projection
+
+    // Layer Sizes
+    static const unsigned num_heads = 2;
+    static const unsigned head_dim_key = 4;
+    static const unsigned head_dim_value = 4;
+    static const unsigned feature_dim = 8;    // Size of the query vectors
+    static const unsigned feature_dim_kv = 8; // Size of the key/value vectors
+    static const unsigned seq_len = 4;        // Length of the query sequence
+    static const unsigned seq_len_kv = 4;     // Length of the key/value sequence
+    static const unsigned out_dim = 8;
+
+    // Resource reuse info
+    static const unsigned io_type = io_parallel;
+    static const unsigned reuse_factor = 1;
+    static const bool store_weights_in_bram = false;
+
+    // Dense configurations of the per-head projections and of the output projection, and softmax configuration
+    typedef dense_config config_query;
+    typedef dense_config config_key;
+    typedef dense_config config_value;
+    typedef dense_config config_output;
+    typedef activ_config config_softmax;
+
+    template<class x_T, class y_T>
+    using product = nnet::product::mult<x_T, y_T>;
+};
+
+// Applies the same dense layer to every vector of a sequence
+template<class data_T, class res_T, typename CONFIG_T, unsigned SEQ_LEN>
+void dense_sequence(
+    data_T    data[SEQ_LEN * CONFIG_T::n_in],
+    res_T     res[SEQ_LEN * CONFIG_T::n_out],
+    typename CONFIG_T::weight_t  weights[CONFIG_T::n_in * CONFIG_T::n_out],
+    typename CONFIG_T::bias_t    biases[CONFIG_T::n_out]
+)
+{
+    data_T in_val[CONFIG_T::n_in];
+    #pragma HLS ARRAY_PARTITION variable=in_val complete
+    res_T out_val[CONFIG_T::n_out];
+    #pragma HLS ARRAY_PARTITION variable=out_val complete
+
+    SequenceLoop: for (unsigned j = 0; j < SEQ_LEN; j++) {
+        for (unsigned i = 0; i < CONFIG_T::n_in; i++) {
+            #pragma HLS UNROLL
+            in_val[i] = data[j * CONFIG_T::n_in + i];
+        }
+
+        dense<data_T, res_T, CONFIG_T>(in_val, out_val, weights, biases);
+
+        for (unsigned i = 0; i < CONFIG_T::n_out; i++) {
+            #pragma HLS UNROLL
+            res[j * CONFIG_T::n_out + i] = out_val[i];
+        }
+    }
+}
+
+// Scaled dot-product attention of one head. The 1/sqrt(head_dim_key) scaling is folded into the query projection.
+// The result is written to the slice of the context (seq_len x num_heads x head_dim_value) belonging to the head.
+template<typename CONFIG_T>
+void attention_head(
+    typename CONFIG_T::qkv_t query[CONFIG_T::seq_len * CONFIG_T::head_dim_key],
+    typename CONFIG_T::qkv_t key[CONFIG_T::seq_len_kv * CONFIG_T::head_dim_key],
+    typename CONFIG_T::qkv_t value[CONFIG_T::seq_len_kv * CONFIG_T::head_dim_value],
+    typename CONFIG_T::context_t context[CONFIG_T::seq_len * CONFIG_T::num_heads * CONFIG_T::head_dim_value],
+    unsigned head
+)
+{
+    constexpr unsigned multiplier_limit = DIV_ROUNDUP(CONFIG_T::seq_len_kv * (CONFIG_T::head_dim_key + CONFIG_T::head_dim_value), CONFIG_T::reuse_factor);
+    CONFIG_T::template product<typename CONFIG_T::qkv_t, typename CONFIG_T::qkv_t>::limit(multiplier_limit);
+
+    typename CONFIG_T::score_t score[CONFIG_T::seq_len_kv];
+    #pragma HLS ARRAY_PARTITION variable=score complete
+    typename CONFIG_T::attention_t attention[CONFIG_T::seq_len_kv];
+    #pragma HLS ARRAY_PARTITION variable=attention complete
+
+    QueryLoop: for (unsigned i = 0; i < CONFIG_T::seq_len; i++) {
+        #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+
+        Score: for (unsigned j = 0; j < CONFIG_T::seq_len_kv; j++) {
+            typename CONFIG_T::accum_t acc = 0;
+            for (unsigned d = 0; d < CONFIG_T::head_dim_key; d++) {
+                acc += CONFIG_T::template product<typename CONFIG_T::qkv_t, typename CONFIG_T::qkv_t>::product(
+                    query[i * CONFIG_T::head_dim_key + d], key[j * CONFIG_T::head_dim_key + d]);
+            }
+            score[j] = acc;
+        }
+
+        softmax<typename CONFIG_T::score_t, typename CONFIG_T::attention_t, typename CONFIG_T::config_softmax>(score, attention);
+
+        Context: for (unsigned d = 0; d < CONFIG_T::head_dim_value; d++) {
+            typename CONFIG_T::accum_t acc = 0;
+            for (unsigned j = 0; j < CONFIG_T::seq_len_kv; j++) {
+                acc += CONFIG_T::template product<typename CONFIG_T::attention_t, typename CONFIG_T::qkv_t>::product(
+                    attention[j], value[j * CONFIG_T::head_dim_value + d]);
+            }
+            context[(i * CONFIG_T::num_heads + head) * CONFIG_T::head_dim_value + d] = acc;
+        }
+    }
+}
+
+template<class data_T, class data_kv_T, class res_T, typename CONFIG_T>
+void multiheadattention(
+    data_T    query[CONFIG_T::seq_len * CONFIG_T::feature_dim],
+    data_kv_T value[CONFIG_T::seq_len_kv * CONFIG_T::feature_dim_kv],
+    res_T     res[CONFIG_T::seq_len * CONFIG_T::out_dim],
+    typename CONFIG_T::config_query::weight_t  query_weight[CONFIG_T::num_heads * CONFIG_T::feature_dim * CONFIG_T::head_dim_key],
+    typename CONFIG_T::config_query::bias_t    query_bias[CONFIG_T::num_heads * CONFIG_T::head_dim_key],
+    typename CONFIG_T::config_key::weight_t    key_weight[CONFIG_T::num_heads * CONFIG_T::feature_dim_kv * CONFIG_T::head_dim_key],
+    typename CONFIG_T::config_key::bias_t      key_bias[CONFIG_T::num_heads * CONFIG_T::head_dim_key],
+    typename CONFIG_T::config_value::weight_t  value_weight[CONFIG_T::num_heads * CONFIG_T::feature_dim_kv * CONFIG_T::head_dim_value],
+    typename CONFIG_T::config_value::bias_t    value_bias[CONFIG_T::num_heads * CONFIG_T::head_dim_value],
+    typename CONFIG_T::config_output::weight_t output_weight[CONFIG_T::num_heads * CONFIG_T::head_dim_value * CONFIG_T::out_dim],
+    typename CONFIG_T::config_output::bias_t   output_bias[CONFIG_T::out_dim]
+)
+{
+    typename CONFIG_T::qkv_t q_proj[CONFIG_T::num_heads][CONFIG_T::seq_len * CONFIG_T::head_dim_key];
+    typename CONFIG_T::qkv_t k_proj[CONFIG_T::num_heads][CONFIG_T::seq_len_kv * CONFIG_T::head_dim_key];
+    typename CONFIG_T::qkv_t v_proj[CONFIG_T::num_heads][CONFIG_T::seq_len_kv * CONFIG_T::head_dim_value];
+    #pragma HLS ARRAY_PARTITION variable=q_proj complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=k_proj complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=v_proj complete dim=1
+
+    typename CONFIG_T::context_t context[CONFIG_T::seq_len * CONFIG_T::num_heads * CONFIG_T::head_dim_value];
+    #pragma HLS ARRAY_PARTITION variable=context cyclic factor=CONFIG_T::num_heads*CONFIG_T::head_dim_value
+
+    // Each head has its own projection and attention units, the reuse factor applies per head
+    HeadLoop: for (unsigned h = 0; h < CONFIG_T::num_heads; h++) {
+        #pragma HLS UNROLL
+
+        dense_sequence<data_T, typename CONFIG_T::qkv_t, typename CONFIG_T::config_query, CONFIG_T::seq_len>(
+            query, q_proj[h],
+            query_weight + h * CONFIG_T::feature_dim * CONFIG_T::head_dim_key, query_bias + h * CONFIG_T::head_dim_key);
+        dense_sequence<data_kv_T, typename CONFIG_T::qkv_t, typename CONFIG_T::config_key, CONFIG_T::seq_len_kv>(
+            value, k_proj[h],
+            key_weight + h * CONFIG_T::feature_dim_kv * CONFIG_T::head_dim_key, key_bias + h * CONFIG_T::head_dim_key);
+        dense_sequence<data_kv_T, typename CONFIG_T::qkv_t, typename CONFIG_T::config_value, CONFIG_T::seq_len_kv>(
+            value, v_proj[h],
+            value_weight + h * CONFIG_T::feature_dim_kv * CONFIG_T::head_dim_value, value_bias + h * CONFIG_T::head_dim_value);
+
+        attention_head<CONFIG_T>(q_proj[h], k_proj[h], v_proj[h], context, h);
+    }
+
+    dense_sequence<typename CONFIG_T::context_t, res_T, typename CONFIG_T::config_output, CONFIG_T::seq_len>(
+        context, res, output_weight, output_bias);
+}
+
+// Self-attention, the query is also used as key and value
+template<class data_T, class res_T, typename CONFIG_T>
+void multiheadattention(
+    data_T    data[CONFIG_T::seq_len * CONFIG_T::feature_dim],
+    res_T     res[CONFIG_T::seq_len * CONFIG_T::out_dim],
+    typename CONFIG_T::config_query::weight_t  query_weight[CONFIG_T::num_heads * CONFIG_T::feature_dim * CONFIG_T::head_dim_key],
+    typename CONFIG_T::config_query::bias_t    query_bias[CONFIG_T::num_heads * CONFIG_T::head_dim_key],
+    typename CONFIG_T::config_key::weight_t    key_weight[CONFIG_T::num_heads * CONFIG_T::feature_dim_kv * CONFIG_T::head_dim_key],
+    typename CONFIG_T::config_key::bias_t      key_bias[CONFIG_T::num_heads * CONFIG_T::head_dim_key],
+    typename CONFIG_T::config_value::weight_t  value_weight[CONFIG_T::num_heads * CONFIG_T::feature_dim_kv * CONFIG_T::head_dim_value],
+    typename CONFIG_T::config_value::bias_t    value_bias[CONFIG_T::num_heads * CONFIG_T::head_dim_value],
+    typename CONFIG_T::config_output::weight_t output_weight[CONFIG_T::num_heads * CONFIG_T::head_dim_value * CONFIG_T::out_dim],
+    typename CONFIG_T::config_output::bias_t   output_bias[CONFIG_T::out_dim]
+)
+{
+    #pragma HLS INLINE
+    multiheadattention<data_T, data_T, res_T, CONFIG_T>(
+        data, data, res,
+        query_weight, query_bias, key_weight, key_bias, value_weight, value_bias, output_weight, output_bias);
+}
+
+}
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef NNET_MHT_STREAM_H_
+#define NNET_MHT_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_types.h"
+#include "nnet_multiheadattention.h"
+#include "hls_stream.h"
+
+namespace nnet {
+
+// ****************************************************
+//       Streaming Multi-Head Attention
+// ****************************************************
+
+// Every element of the streams holds one vector of the sequence. Attention needs the whole key/value sequence
+// before the first output can be computed, so the sequences are buffered and processed as arrays.
+
+template<class data_T, unsigned SEQ_LEN, unsigned N_IN>
+void read_sequence(
+    hls::stream<data_T> &data,
+    typename data_T::value_type buffer[SEQ_LEN * N_IN]
+) {
+    assert(data_T::size == N_IN);
+
+    ReadSequence: for (unsigned j = 0; j < SEQ_LEN; j++) {
+        #pragma HLS PIPELINE
+        data_T in_data = data.read();
+        ReadPack: for (unsigned i = 0; i < N_IN; i++) {
+            #pragma HLS UNROLL
+            buffer[j * N_IN + i] = in_data[i];
+        }
+    }
+}
+
+template<class res_T, unsigned SEQ_LEN, unsigned N_OUT>
+void write_sequence(
+    typename res_T::value_type buffer[SEQ_LEN * N_OUT],
+    hls::stream<res_T> &res
+) {
+    assert(res_T::size == N_OUT);
+
+    WriteSequence: for (unsigned j = 0; j < SEQ_LEN; j++) {
+        #pragma HLS PIPELINE
+        res_T out_data;
+        #pragma HLS DATA_PACK variable=out_data
+        WritePack: for (unsigned i = 0; i < N_OUT; i++) {
+            #pragma HLS UNROLL
+            out_data[i] = buffer[j * N_OUT + i];
+        }
+        res.write(out_data);
+    }
+}
+
+template<class data_T, class data_kv_T, class res_T, typename CONFIG_T>
+void multiheadattention(
+    hls::stream<data_T>    &query,
+    hls::stream<data_kv_T> &value,
+    hls::stream<res_T>     &res,
+    typename CONFIG_T::config_query::weight_t  query_weight[CONFIG_T::num_heads * CONFIG_T::feature_dim * CONFIG_T::head_dim_key],
+    typename CONFIG_T::config_query::bias_t    query_bias[CONFIG_T::num_heads * CONFIG_T::head_dim_key],
+    typename CONFIG_T::config_key::weight_t    key_weight[CONFIG_T::num_heads * CONFIG_T::feature_dim_kv * CONFIG_T::head_dim_key],
+    typename CONFIG_T::config_key::bias_t      key_bias[CONFIG_T::num_heads * CONFIG_T::head_dim_key],
+    typename CONFIG_T::config_value::weight_t  value_weight[CONFIG_T::num_heads * CONFIG_T::feature_dim_kv * CONFIG_T::head_dim_value],
+    typename CONFIG_T::config_value::bias_t    value_bias[CONFIG_T::num_heads * CONFIG_T::head_dim_value],
+    typename CONFIG_T::config_output::weight_t output_weight[CONFIG_T::num_heads * CONFIG_T::head_dim_value * CONFIG_T::out_dim],
+    typename CONFIG_T::config_output::bias_t   output_bias[CONFIG_T::out_dim]
+) {
+    typename data_T::value_type query_buf[CONFIG_T::seq_len * CONFIG_T::feature_dim];
+    typename data_kv_T::value_type value_buf[CONFIG_T::seq_len_kv * CONFIG_T::feature_dim_kv];
+    typename res_T::value_type res_buf[CONFIG_T::seq_len * CONFIG_T::out_dim];
+    #pragma HLS ARRAY_PARTITION variable=query_buf cyclic factor=CONFIG_T::feature_dim
+    #pragma HLS ARRAY_PARTITION variable=value_buf cyclic factor=CONFIG_T::feature_dim_kv
+    #pragma HLS ARRAY_PARTITION variable=res_buf cyclic factor=CONFIG_T::out_dim
+
+    read_sequence<data_T, CONFIG_T::seq_len, CONFIG_T::feature_dim>(query, query_buf);
+    read_sequence<data_kv_T, CONFIG_T::seq_len_kv, CONFIG_T::feature_dim_kv>(value, value_buf);
+
+    multiheadattention<typename data_T::value_type, typename data_kv_T::value_type, typename res_T::value_type, CONFIG_T>(
+        query_buf, value_buf, res_buf,
+        query_weight, query_bias, key_weight, key_bias, value_weight, value_bias, output_weight, output_bias);
+
+    write_sequence<res_T, CONFIG_T::seq_len, CONFIG_T::out_dim>(res_buf, res);
+}
+
+// Self-attention, the query is also used as key and value
+template<class data_T, class res_T, typename CONFIG_T>
+void multiheadattention(
+    hls::stream<data_T> &data,
+    hls::stream<res_T>  &res,
+    typename CONFIG_T::config_query::weight_t  query_weight[CONFIG_T::num_heads * CONFIG_T::feature_dim * CONFIG_T::head_dim_key],
+    typename CONFIG_T::config_query::bias_t    query_bias[CONFIG_T::num_heads * CONFIG_T::head_dim_key],
+    typename CONFIG_T::config_key::weight_t    key_weight[CONFIG_T::num_heads * CONFIG_T::feature_dim_kv * CONFIG_T::head_dim_key],
+    typename CONFIG_T::config_key::bias_t      key_bias[CONFIG_T::num_heads * CONFIG_T::head_dim_key],
+    typename CONFIG_T::config_value::weight_t  value_weight[CONFIG_T::num_heads * CONFIG_T::feature_dim_kv * CONFIG_T::head_dim_value],
+    typename CONFIG_T::config_value::bias_t    value_bias[CONFIG_T::num_heads * CONFIG_T::head_dim_value],
+    typename CONFIG_T::config_output::weight_t output_weight[CONFIG_T::num_heads * CONFIG_T::head_dim_value * CONFIG_T::out_dim],
+    typename CONFIG_T::config_output::bias_t   output_bias[CONFIG_T::out_dim]
+) {
+    typename data_T::value_type data_buf[CONFIG_T::seq_len * CONFIG_T::feature_dim];
+    typename res_T::value_type res_buf[CONFIG_T::seq_len * CONFIG_T::out_dim];
+    #pragma HLS ARRAY_PARTITION variable=data_buf cyclic factor=CONFIG_T::feature_dim
+    #pragma HLS ARRAY_PARTITION variable=res_buf cyclic factor=CONFIG_T::out_dim
+
+    read_sequence<data_T, CONFIG_T::seq_len, CONFIG_T::feature_dim>(data, data_buf);
+
+    multiheadattention<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(
+        data_buf, res_buf,
+        query_weight, query_bias, key_weight, key_bias, value_weight, value_bias, output_weight, output_bias);
+
+    write_sequence<res_T, CONFIG_T::seq_len, CONFIG_T::out_dim>(res_buf, res);
+}
+
+}
+
+#endif
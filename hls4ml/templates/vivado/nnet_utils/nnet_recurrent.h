@@ -26,10 +26,16 @@
 #include "nnet_recr_activations.h"
 #include "nnet_dense.h"
 #include "hls_stream.h"
+#ifndef __SYNTHESIS__
+#include <algorithm>
+#include <vector>
+#endif
 
 
 namespace nnet {
 
+enum class recurrent_implementation { sequential=0, pipelined=1 };
+
 struct lstm_config
 {
     // Internal data type definitions
@@ -50,6 +56,7 @@ struct lstm_config
     static const unsigned n_zeros = 0;
     static const bool store_weights_in_bram = false;
     static const bool use_static = true;
+    static const recurrent_implementation implementation = recurrent_implementation::sequential;
 
     template<class x_T, class y_T, class config_T>
     using activation_recr = nnet::activation::relu<x_T, y_T, config_T>;
@@ -208,6 +215,240 @@ template<class data_T, class res_T, typename CONFIG_T>
   }
 }
 
+// Pipelined recurrent engine
+// The projection of the inputs onto the gates (W*x + b) does not depend on the state, so it is computed for all the
+// time steps by a separate stage, with a new time step every 'reuse_factor' cycles. The recurrent stage only computes
+// U*h (with 'recurrent_reuse_factor') and the cell update. The two stages form a dataflow region, so the projection
+// of the next sequence overlaps with the recurrent updates of the current one.
+
+template<class data_T, typename CONFIG_T, unsigned n_gates>
+  void recurrent_input_projection(
+      data_T    data[CONFIG_T::n_sequence*CONFIG_T::n_in],
+      typename CONFIG_T::accum_t proj[CONFIG_T::n_sequence][n_gates*CONFIG_T::n_state],
+      typename CONFIG_T::weight_t     param  [CONFIG_T::n_state*n_gates*CONFIG_T::n_in],
+      typename CONFIG_T::bias_t     param_b[CONFIG_T::n_state*n_gates]
+      ) {
+
+    data_T data_in[CONFIG_T::n_in];
+    typename CONFIG_T::accum_t proj_step[n_gates*CONFIG_T::n_state];
+    #pragma HLS ARRAY_PARTITION variable=data_in complete
+    #pragma HLS ARRAY_PARTITION variable=proj_step complete
+
+    InputProjection: for(unsigned i_seq = 0; i_seq < CONFIG_T::n_sequence; i_seq++) {
+      if (CONFIG_T::mult_config1::strategy == nnet::latency) {
+        #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+      }
+      for(unsigned j = 0; j < CONFIG_T::n_in; j++) {
+        #pragma HLS UNROLL
+        data_in[j] = data[j + i_seq*CONFIG_T::n_in];
+      }
+      nnet::dense<data_T, typename CONFIG_T::accum_t, typename CONFIG_T::mult_config1>(data_in, proj_step, param, param_b);
+      for(unsigned j = 0; j < n_gates*CONFIG_T::n_state; j++) {
+        #pragma HLS UNROLL
+        proj[i_seq][j] = proj_step[j];
+      }
+    }
+}
+
+template<class data_T, typename CONFIG_T, unsigned n_gates>
+  void recurrent_input_projection(
+      hls::stream<data_T> &data_stream,
+      typename CONFIG_T::accum_t proj[CONFIG_T::n_sequence][n_gates*CONFIG_T::n_state],
+      typename CONFIG_T::weight_t     param  [CONFIG_T::n_state*n_gates*CONFIG_T::n_in],
+      typename CONFIG_T::bias_t     param_b[CONFIG_T::n_state*n_gates]
+      ) {
+
+    typename data_T::value_type data_in[CONFIG_T::n_in];
+    typename CONFIG_T::accum_t proj_step[n_gates*CONFIG_T::n_state];
+    #pragma HLS ARRAY_PARTITION variable=data_in complete
+    #pragma HLS ARRAY_PARTITION variable=proj_step complete
+
+    InputProjection: for(unsigned i_seq = 0; i_seq < CONFIG_T::n_sequence; i_seq++) {
+      if (CONFIG_T::mult_config1::strategy == nnet::latency) {
+        #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+      }
+      data_T data_pack = data_stream.read();
+      DataPack: for(unsigned i_pack = 0; i_pack < data_T::size; i_pack++) {
+        #pragma HLS UNROLL
+        data_in[i_pack] = data_pack[i_pack];
+      }
+      nnet::dense<typename data_T::value_type, typename CONFIG_T::accum_t, typename CONFIG_T::mult_config1>(data_in, proj_step, param, param_b);
+      for(unsigned j = 0; j < n_gates*CONFIG_T::n_state; j++) {
+        #pragma HLS UNROLL
+        proj[i_seq][j] = proj_step[j];
+      }
+    }
+}
+
+// Gate activations and state update of one LSTM step, from the input (W*x + b) and recurrent (U*h + br) products
+template<class res_T, typename CONFIG_T>
+  void lstm_cell_update(
+      typename CONFIG_T::accum_t tmpres      [CONFIG_T::n_state*4],
+      typename CONFIG_T::accum_t tmpres_state[CONFIG_T::n_state*4],
+      res_T     h_state[CONFIG_T::n_state],
+      res_T     s_state[CONFIG_T::n_state]
+      ) {
+
+  typename CONFIG_T::accum_t tmpres_ifo  [CONFIG_T::n_state*3]; //activated i,f,o matrices (keras notation)
+  typename CONFIG_T::accum_t tmpres_c    [CONFIG_T::n_state];   //activated c-matrix (keras notation)
+  typename CONFIG_T::accum_t inputacc_ifo[CONFIG_T::n_state*3]; //i,f,o matrices (keras notation)
+  typename CONFIG_T::accum_t inputacc_c  [CONFIG_T::n_state]; //c-matrix (keras notation)
+  typename CONFIG_T::accum_t s_actstate[CONFIG_T::n_state];
+
+  #pragma HLS ARRAY_PARTITION variable=tmpres_ifo   complete
+  #pragma HLS ARRAY_PARTITION variable=tmpres_c     complete
+  #pragma HLS ARRAY_PARTITION variable=inputacc_ifo complete
+  #pragma HLS ARRAY_PARTITION variable=inputacc_c   complete
+  #pragma HLS ARRAY_PARTITION variable=s_actstate   complete
+
+  for(int iacc = 0; iacc < (3*CONFIG_T::n_state); iacc++) {
+    #pragma HLS UNROLL
+    int index = iacc;
+    if(iacc > 2*CONFIG_T::n_state-1) index = iacc + CONFIG_T::n_state;
+    inputacc_ifo[iacc] = tmpres[index] + tmpres_state[index];
+  }
+  for(int iacc = 0; iacc < (CONFIG_T::n_state); iacc++) {
+    #pragma HLS UNROLL
+    int index = iacc + CONFIG_T::n_state*2;
+    inputacc_c[iacc] = tmpres[index] + tmpres_state[index];
+  }
+
+  CONFIG_T::template activation_recr<typename CONFIG_T::accum_t, typename CONFIG_T::accum_t, typename CONFIG_T::ACT_CONFIG_LSTM>::activation(inputacc_ifo, tmpres_ifo);
+
+  //Now for the confusion matrix
+  CONFIG_T::template activation<typename CONFIG_T::accum_t, typename CONFIG_T::accum_t, typename CONFIG_T::ACT_CONFIG_T>::activation(inputacc_c, tmpres_c);
+
+  // Operation: s=g*i+sold*f (update state with buffer to avoid timing issues)
+  for(int iacc = 0; iacc < (CONFIG_T::n_state); iacc++) {
+    #pragma HLS UNROLL
+    s_state[iacc] = tmpres_c[iacc]*tmpres_ifo[iacc] + s_state[iacc]*tmpres_ifo[iacc+(CONFIG_T::n_state)];
+  }
+  // Operation: h=act(s)*o
+  CONFIG_T::template activation<res_T, typename CONFIG_T::accum_t, typename CONFIG_T::ACT_CONFIG_T>::activation(s_state, s_actstate);
+
+  for(int iacc = 0; iacc < CONFIG_T::n_state; iacc++) {
+    #pragma HLS UNROLL
+    h_state[iacc] = tmpres_ifo[iacc+2*(CONFIG_T::n_state)]*s_actstate[iacc];
+  }
+}
+
+template<class res_T, typename CONFIG_T>
+  void lstm_recurrent_step(
+      typename CONFIG_T::accum_t proj[CONFIG_T::n_state*4],
+      res_T     h_state[CONFIG_T::n_state],
+      res_T     s_state[CONFIG_T::n_state],
+      typename CONFIG_T::weight_t     param_r[CONFIG_T::n_state*4*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t     param_br[CONFIG_T::n_state*4]
+      ) {
+
+  typename CONFIG_T::accum_t tmpres_state[CONFIG_T::n_state*4];
+  #pragma HLS ARRAY_PARTITION variable=tmpres_state complete
+
+  nnet::dense<res_T, typename CONFIG_T::accum_t, typename CONFIG_T::mult_config2>(h_state, tmpres_state, param_r, param_br);
+  nnet::lstm_cell_update<res_T, CONFIG_T>(proj, tmpres_state, h_state, s_state);
+}
+
+template<class res_T, typename CONFIG_T>
+  void lstm_recurrent_update(
+      typename CONFIG_T::accum_t proj[CONFIG_T::n_sequence][CONFIG_T::n_state*4],
+      res_T     res[CONFIG_T::n_sequence_out*CONFIG_T::n_state],
+      typename CONFIG_T::weight_t     param_r[CONFIG_T::n_state*4*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t     param_br[CONFIG_T::n_state*4]
+      ) {
+
+    res_T h_state[CONFIG_T::n_state];
+    res_T s_state[CONFIG_T::n_state];
+    #pragma HLS ARRAY_PARTITION variable=h_state complete
+    #pragma HLS ARRAY_PARTITION variable=s_state complete
+
+    for(int ii = 0; ii < CONFIG_T::n_state; ii++) {
+      #pragma HLS UNROLL
+      h_state[ii] = 0;
+      s_state[ii] = 0;
+    }
+    RecurrentUpdate: for(unsigned i_seq = 0; i_seq < CONFIG_T::n_sequence; i_seq++) {
+      nnet::lstm_recurrent_step<res_T, CONFIG_T>(proj[i_seq], h_state, s_state, param_r, param_br);
+      if (CONFIG_T::n_sequence_out > 1)
+        for(int i = CONFIG_T::n_state*i_seq, j = 0; i < (CONFIG_T::n_state*(i_seq+1)); i++, j++) {
+          #pragma HLS UNROLL
+          res[i] = h_state[j];
+        }
+    }
+    if (CONFIG_T::n_sequence_out == 1)
+      for(int i = 0; i < (CONFIG_T::n_state); i++) {
+        #pragma HLS UNROLL
+        res[i] = h_state[i];
+      }
+}
+
+template<class res_T, typename CONFIG_T>
+  void lstm_recurrent_update(
+      typename CONFIG_T::accum_t proj[CONFIG_T::n_sequence][CONFIG_T::n_state*4],
+      hls::stream<res_T> &res_stream,
+      typename CONFIG_T::weight_t     param_r[CONFIG_T::n_state*4*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t     param_br[CONFIG_T::n_state*4]
+      ) {
+
+    typename res_T::value_type h_state[CONFIG_T::n_state];
+    typename res_T::value_type s_state[CONFIG_T::n_state];
+    #pragma HLS ARRAY_PARTITION variable=h_state complete
+    #pragma HLS ARRAY_PARTITION variable=s_state complete
+
+    for(int ii = 0; ii < CONFIG_T::n_state; ii++) {
+      #pragma HLS UNROLL
+      h_state[ii] = 0;
+      s_state[ii] = 0;
+    }
+    RecurrentUpdate: for(unsigned i_seq = 0; i_seq < CONFIG_T::n_sequence; i_seq++) {
+      nnet::lstm_recurrent_step<typename res_T::value_type, CONFIG_T>(proj[i_seq], h_state, s_state, param_r, param_br);
+      if (CONFIG_T::n_sequence_out > 1 || i_seq == CONFIG_T::n_sequence - 1) {
+        res_T res_pack;
+        #pragma HLS DATA_PACK variable=res_pack
+        ResPack: for (int i_pack = 0; i_pack < res_T::size; i_pack++) {
+          #pragma HLS UNROLL
+          res_pack[i_pack] = h_state[i_pack];
+        }
+        res_stream.write(res_pack);
+      }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void lstm_stack_pipelined(
+      data_T    data      [CONFIG_T::n_sequence*CONFIG_T::n_in],
+      res_T     res [CONFIG_T::n_sequence_out*CONFIG_T::n_state],
+      typename CONFIG_T::weight_t     param  [CONFIG_T::n_state*4*CONFIG_T::n_in],
+      typename CONFIG_T::weight_t     param_r[CONFIG_T::n_state*4*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t     param_b[CONFIG_T::n_state*4],
+      typename CONFIG_T::bias_t     param_br[CONFIG_T::n_state*4]
+      ) {
+    #pragma HLS DATAFLOW
+
+    typename CONFIG_T::accum_t proj[CONFIG_T::n_sequence][CONFIG_T::n_state*4];
+    #pragma HLS ARRAY_PARTITION variable=proj complete dim=2
+
+    nnet::recurrent_input_projection<data_T, CONFIG_T, 4>(data, proj, param, param_b);
+    nnet::lstm_recurrent_update<res_T, CONFIG_T>(proj, res, param_r, param_br);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void lstm_stack_pipelined(
+      hls::stream<data_T> &data_stream,
+      hls::stream<res_T>  &res_stream,
+      typename CONFIG_T::weight_t     param  [CONFIG_T::n_state*4*CONFIG_T::n_in],
+      typename CONFIG_T::weight_t     param_r[CONFIG_T::n_state*4*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t     param_b[CONFIG_T::n_state*4],
+      typename CONFIG_T::bias_t     param_br[CONFIG_T::n_state*4]
+      ) {
+    #pragma HLS DATAFLOW
+
+    typename CONFIG_T::accum_t proj[CONFIG_T::n_sequence][CONFIG_T::n_state*4];
+    #pragma HLS ARRAY_PARTITION variable=proj complete dim=2
+
+    nnet::recurrent_input_projection<data_T, CONFIG_T, 4>(data_stream, proj, param, param_b);
+    nnet::lstm_recurrent_update<res_T, CONFIG_T>(proj, res_stream, param_r, param_br);
+}
+
 template<class data_T, class res_T, typename CONFIG_T>
   void lstm_stack(
       data_T    data      [CONFIG_T::n_sequence*CONFIG_T::n_in],
@@ -218,6 +459,11 @@ template<class data_T, class res_T, typename CONFIG_T>
       typename CONFIG_T::bias_t     param_br[CONFIG_T::n_state*4]
       ) {
 
+    if (CONFIG_T::implementation == recurrent_implementation::pipelined) {
+      nnet::lstm_stack_pipelined<data_T, res_T, CONFIG_T>(data, res, param, param_r, param_b, param_br);
+      return;
+    }
+
     res_T     h_newstate[CONFIG_T::n_state];
     res_T     s_newstate[CONFIG_T::n_state];
     data_T    data_in[CONFIG_T::n_in];
@@ -264,6 +510,11 @@ template<class data_T, class res_T, typename CONFIG_T>
       typename CONFIG_T::bias_t     param_br[CONFIG_T::n_state*4]
       ) {
 
+    if (CONFIG_T::implementation == recurrent_implementation::pipelined) {
+      nnet::lstm_stack_pipelined<data_T, res_T, CONFIG_T>(data_stream, res_stream, param, param_r, param_b, param_br);
+      return;
+    }
+
     typename res_T::value_type  h_newstate[CONFIG_T::n_state];
     typename res_T::value_type  s_newstate[CONFIG_T::n_state];
     #pragma HLS ARRAY_PARTITION variable=h_newstate complete
@@ -288,7 +539,7 @@ template<class data_T, class res_T, typename CONFIG_T>
           data_in[i_pack] = data_pack[i_pack];
       }
       if (CONFIG_T::use_static)
-        nnet::lstm_static<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(reset_state,data_in,h_newstate, param,param_r,param_b, param_br);
+        nnet::lstm_static<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(reset_state,data_in,h_newstate, s_newstate, param,param_r,param_b, param_br);
       else
         nnet::lstm<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(reset_state,data_in,h_newstate, s_newstate, param,param_r,param_b, param_br);
       if (CONFIG_T::n_sequence_out > 1){
@@ -338,6 +589,7 @@ struct gru_config
     static const bool store_weights_in_bram = false;
     static const bool use_static = true;
     static const unsigned n_zeros = 0;
+    static const recurrent_implementation implementation = recurrent_implementation::sequential;
 
     template<class x_T, class y_T, class config_T>
     using activation_recr = nnet::activation::relu<x_T, y_T, config_T>;
@@ -486,6 +738,164 @@ template<class data_T, class res_T, typename CONFIG_T>
     }
 }
 
+// Gate activations and state update of one GRU step, from the input (W*x + b) and recurrent (U*h + br) products
+template<class res_T, typename CONFIG_T>
+  void gru_cell_update(
+      typename CONFIG_T::accum_t tmpres         [CONFIG_T::n_state*3],
+      typename CONFIG_T::accum_t tmpres_state_zr[CONFIG_T::n_state*3],
+      res_T     h_state[CONFIG_T::n_state]
+      ) {
+
+    typename CONFIG_T::accum_t tmpres_state_h [CONFIG_T::n_state];
+    typename CONFIG_T::accum_t tmpres_zr   [CONFIG_T::n_state*2]; //activated i,f,o matrices (keras notation)
+    typename CONFIG_T::accum_t tmpres_h    [CONFIG_T::n_state];   //activated c-matrix (keras notation)
+    typename CONFIG_T::accum_t inputacc_zr [CONFIG_T::n_state*2]; //i,f,o matrices (keras notation)
+    typename CONFIG_T::accum_t inputacc_h  [CONFIG_T::n_state]; //c-matrix (keras notation)
+
+    #pragma HLS ARRAY_PARTITION variable=tmpres_state_h  complete
+    #pragma HLS ARRAY_PARTITION variable=tmpres_zr       complete
+    #pragma HLS ARRAY_PARTITION variable=tmpres_h        complete
+    #pragma HLS ARRAY_PARTITION variable=inputacc_zr     complete
+    #pragma HLS ARRAY_PARTITION variable=inputacc_h      complete
+
+    for(int iacc = 0; iacc < (2*CONFIG_T::n_state); iacc++) {
+      #pragma HLS UNROLL
+      inputacc_zr[iacc] = tmpres[iacc] + tmpres_state_zr[iacc];
+    }
+
+    CONFIG_T::template activation_recr<typename CONFIG_T::accum_t, typename CONFIG_T::accum_t, typename CONFIG_T::ACT_CONFIG_GRU>::activation(inputacc_zr, tmpres_zr);
+
+    // Hadamard product of r(t) and U_h*h(t-1)
+    for(int iacc = 0; iacc < (CONFIG_T::n_state); iacc++) {
+      #pragma HLS UNROLL
+      tmpres_state_h[iacc] = tmpres_zr[iacc+(CONFIG_T::n_state)]*tmpres_state_zr[iacc + (2*CONFIG_T::n_state)];
+    }
+
+    for(int iacc = 0; iacc < (CONFIG_T::n_state); iacc++) {
+      #pragma HLS UNROLL
+      int index = iacc + CONFIG_T::n_state*2;
+      inputacc_h[iacc] = tmpres[index] + tmpres_state_h[iacc];
+    }
+
+    CONFIG_T::template activation<typename CONFIG_T::accum_t, typename CONFIG_T::accum_t, typename CONFIG_T::ACT_CONFIG_T>::activation(inputacc_h, tmpres_h);
+
+    //Mix the state with the previous state
+    for(int iacc = 0; iacc < (CONFIG_T::n_state); iacc++) {
+      #pragma HLS UNROLL
+      h_state[iacc] = (res_T)(tmpres_h[iacc]*(1-tmpres_zr[iacc]) + h_state[iacc]*tmpres_zr[iacc]);
+    }
+}
+
+template<class res_T, typename CONFIG_T>
+  void gru_recurrent_step(
+      typename CONFIG_T::accum_t proj[CONFIG_T::n_state*3],
+      res_T     h_state[CONFIG_T::n_state],
+      typename CONFIG_T::weight_t     param_zr[CONFIG_T::n_state*3*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_br [CONFIG_T::n_state*3]
+      ) {
+
+    typename CONFIG_T::accum_t tmpres_state_zr[CONFIG_T::n_state*3];
+    #pragma HLS ARRAY_PARTITION variable=tmpres_state_zr complete
+
+    nnet::dense<res_T, typename CONFIG_T::accum_t, typename CONFIG_T::mult_config2>(h_state, tmpres_state_zr, param_zr, param_br);
+    nnet::gru_cell_update<res_T, CONFIG_T>(proj, tmpres_state_zr, h_state);
+}
+
+template<class res_T, typename CONFIG_T>
+  void gru_recurrent_update(
+      typename CONFIG_T::accum_t proj[CONFIG_T::n_sequence][CONFIG_T::n_state*3],
+      res_T     res[CONFIG_T::n_sequence_out*CONFIG_T::n_state],
+      typename CONFIG_T::weight_t     param_zr[CONFIG_T::n_state*3*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_br [CONFIG_T::n_state*3]
+      ) {
+
+    res_T h_state[CONFIG_T::n_state];
+    #pragma HLS ARRAY_PARTITION variable=h_state complete
+
+    for(int ii = 0; ii < CONFIG_T::n_state; ii++) {
+      #pragma HLS UNROLL
+      h_state[ii] = 0;
+    }
+    RecurrentUpdate: for(unsigned i_seq = 0; i_seq < CONFIG_T::n_sequence; i_seq++) {
+      nnet::gru_recurrent_step<res_T, CONFIG_T>(proj[i_seq], h_state, param_zr, param_br);
+      if (CONFIG_T::n_sequence_out > 1)
+        for(int i = CONFIG_T::n_state*i_seq, j = 0; i < (CONFIG_T::n_state*(i_seq+1)); i++, j++) {
+          #pragma HLS UNROLL
+          res[i] = h_state[j];
+        }
+    }
+    if (CONFIG_T::n_sequence_out == 1)
+      for(int i = 0; i < (CONFIG_T::n_state); i++) {
+        #pragma HLS UNROLL
+        res[i] = h_state[i];
+      }
+}
+
+template<class res_T, typename CONFIG_T>
+  void gru_recurrent_update(
+      typename CONFIG_T::accum_t proj[CONFIG_T::n_sequence][CONFIG_T::n_state*3],
+      hls::stream<res_T> &res_stream,
+      typename CONFIG_T::weight_t     param_zr[CONFIG_T::n_state*3*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_br [CONFIG_T::n_state*3]
+      ) {
+
+    typename res_T::value_type h_state[CONFIG_T::n_state];
+    #pragma HLS ARRAY_PARTITION variable=h_state complete
+
+    for(int ii = 0; ii < CONFIG_T::n_state; ii++) {
+      #pragma HLS UNROLL
+      h_state[ii] = 0;
+    }
+    RecurrentUpdate: for(unsigned i_seq = 0; i_seq < CONFIG_T::n_sequence; i_seq++) {
+      nnet::gru_recurrent_step<typename res_T::value_type, CONFIG_T>(proj[i_seq], h_state, param_zr, param_br);
+      if (CONFIG_T::n_sequence_out > 1 || i_seq == CONFIG_T::n_sequence - 1) {
+        res_T res_pack;
+        #pragma HLS DATA_PACK variable=res_pack
+        ResPack: for (int i_pack = 0; i_pack < res_T::size; i_pack++) {
+          #pragma HLS UNROLL
+          res_pack[i_pack] = h_state[i_pack];
+        }
+        res_stream.write(res_pack);
+      }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void gru_stack_pipelined(
+      data_T    data      [CONFIG_T::n_sequence*CONFIG_T::n_in],
+      res_T     res[CONFIG_T::n_sequence_out*CONFIG_T::n_state],
+      typename CONFIG_T::weight_t     param   [CONFIG_T::n_state*3*CONFIG_T::n_in],
+      typename CONFIG_T::weight_t     param_zr[CONFIG_T::n_state*3*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_b [CONFIG_T::n_state*3],
+      typename CONFIG_T::bias_t       param_br [CONFIG_T::n_state*3]
+      ) {
+    #pragma HLS DATAFLOW
+
+    typename CONFIG_T::accum_t proj[CONFIG_T::n_sequence][CONFIG_T::n_state*3];
+    #pragma HLS ARRAY_PARTITION variable=proj complete dim=2
+
+    nnet::recurrent_input_projection<data_T, CONFIG_T, 3>(data, proj, param, param_b);
+    nnet::gru_recurrent_update<res_T, CONFIG_T>(proj, res, param_zr, param_br);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void gru_stack_pipelined(
+      hls::stream<data_T> &data_stream,
+      hls::stream<res_T>  &res_stream,
+      typename CONFIG_T::weight_t     param   [CONFIG_T::n_state*3*CONFIG_T::n_in],
+      typename CONFIG_T::weight_t     param_zr[CONFIG_T::n_state*3*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_b [CONFIG_T::n_state*3],
+      typename CONFIG_T::bias_t       param_br [CONFIG_T::n_state*3]
+      ) {
+    #pragma HLS DATAFLOW
+
+    typename CONFIG_T::accum_t proj[CONFIG_T::n_sequence][CONFIG_T::n_state*3];
+    #pragma HLS ARRAY_PARTITION variable=proj complete dim=2
+
+    nnet::recurrent_input_projection<data_T, CONFIG_T, 3>(data_stream, proj, param, param_b);
+    nnet::gru_recurrent_update<res_T, CONFIG_T>(proj, res_stream, param_zr, param_br);
+}
+
 template<class data_T, class res_T, typename CONFIG_T>
   void gru_stack(
         data_T    data      [CONFIG_T::n_sequence*CONFIG_T::n_in],
@@ -496,6 +906,11 @@ template<class data_T, class res_T, typename CONFIG_T>
         typename CONFIG_T::bias_t       param_br [CONFIG_T::n_state*3]
         ) {
 
+      if (CONFIG_T::implementation == recurrent_implementation::pipelined) {
+        nnet::gru_stack_pipelined<data_T, res_T, CONFIG_T>(data, res, param, param_zr, param_b, param_br);
+        return;
+      }
+
       res_T   h_state[CONFIG_T::n_state];
       data_T  data_in[CONFIG_T::n_in];
       bool    reset_state = true;
@@ -540,6 +955,11 @@ template<class data_T, class res_T, typename CONFIG_T>
       typename CONFIG_T::bias_t       param_br [CONFIG_T::n_state*3]
       ) {
 
+    if (CONFIG_T::implementation == recurrent_implementation::pipelined) {
+      nnet::gru_stack_pipelined<data_T, res_T, CONFIG_T>(data_stream, res_stream, param, param_zr, param_b, param_br);
+      return;
+    }
+
     typename res_T::value_type  h_newstate[CONFIG_T::n_state];
     #pragma HLS ARRAY_PARTITION variable=h_newstate complete
     for(int ii = 0; ii < CONFIG_T::n_state; ii++) {
@@ -588,6 +1008,555 @@ template<class data_T, class res_T, typename CONFIG_T>
 }
 
 
+// Struct for the SimpleRNN template
+
+struct simple_rnn_config
+{
+    // Internal data type definitions
+    typedef float weight_t;
+    typedef float bias_t;
+    typedef float accum_t;
+
+    // Layer Sizes
+    static const unsigned n_in =  2;
+    static const unsigned n_out = 2;
+    static const unsigned n_state = 2;
+    static const unsigned n_sequence = 2;
+    static const unsigned n_sequence_out = 1;
+    static const unsigned table_size = 1024;
+
+    // Resource reuse info
+    static const unsigned io_type = io_parallel;
+    static const unsigned reuse_factor = 1;
+    static const bool store_weights_in_bram = false;
+    static const bool use_static = true;
+    static const unsigned n_zeros = 0;
+
+    template<class x_T, class y_T, class config_T>
+    using activation = nnet::activation::relu<x_T, y_T, config_T>;
+};
+
+// Fully-connected recurrent layer: h(t) = activation(W*x(t) + b + U*h(t-1) + br)
+template<class res_T, typename CONFIG_T>
+  void simple_rnn_cell_update(
+      typename CONFIG_T::accum_t tmpres      [CONFIG_T::n_state],
+      typename CONFIG_T::accum_t tmpres_state[CONFIG_T::n_state],
+      res_T     h_state[CONFIG_T::n_state]
+      ) {
+
+    typename CONFIG_T::accum_t inputacc[CONFIG_T::n_state];
+    #pragma HLS ARRAY_PARTITION variable=inputacc complete
+
+    for(int iacc = 0; iacc < (CONFIG_T::n_state); iacc++) {
+      #pragma HLS UNROLL
+      inputacc[iacc] = tmpres[iacc] + tmpres_state[iacc];
+    }
+
+    CONFIG_T::template activation<typename CONFIG_T::accum_t, res_T, typename CONFIG_T::ACT_CONFIG_T>::activation(inputacc, h_state);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void simple_rnn(bool reset_state,
+            data_T    data      [CONFIG_T::n_in],
+            res_T     h_newstate[CONFIG_T::n_state],
+            typename CONFIG_T::weight_t     param  [CONFIG_T::n_state*CONFIG_T::n_in],
+            typename CONFIG_T::weight_t     param_r[CONFIG_T::n_state*CONFIG_T::n_state],
+            typename CONFIG_T::bias_t       param_b [CONFIG_T::n_state],
+            typename CONFIG_T::bias_t       param_br[CONFIG_T::n_state]
+            ) {
+
+    typename CONFIG_T::accum_t tmpres      [CONFIG_T::n_state];
+    typename CONFIG_T::accum_t tmpres_state[CONFIG_T::n_state];
+
+    #pragma HLS ARRAY_PARTITION variable=h_newstate   complete
+    #pragma HLS ARRAY_PARTITION variable=tmpres       complete
+    #pragma HLS ARRAY_PARTITION variable=tmpres_state complete
+
+    nnet::dense<data_T, typename CONFIG_T::accum_t, typename CONFIG_T::mult_config1>(data, tmpres, param, param_b);
+    nnet::dense<res_T, typename CONFIG_T::accum_t, typename CONFIG_T::mult_config2>(h_newstate, tmpres_state, param_r, param_br);
+
+    nnet::simple_rnn_cell_update<res_T, CONFIG_T>(tmpres, tmpres_state, h_newstate);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void simple_rnn_static(bool reset_state,
+            data_T    data      [CONFIG_T::n_in],
+            res_T     h_newstate[CONFIG_T::n_state],
+            typename CONFIG_T::weight_t     param  [CONFIG_T::n_state*CONFIG_T::n_in],
+            typename CONFIG_T::weight_t     param_r[CONFIG_T::n_state*CONFIG_T::n_state],
+            typename CONFIG_T::bias_t       param_b [CONFIG_T::n_state],
+            typename CONFIG_T::bias_t       param_br[CONFIG_T::n_state]
+            ) {
+    // Initialize the state variable -- will maintain state between function calls
+
+    static res_T h_state[CONFIG_T::n_state];
+    typename CONFIG_T::accum_t tmpres      [CONFIG_T::n_state];
+    typename CONFIG_T::accum_t tmpres_state[CONFIG_T::n_state];
+
+    #pragma HLS ARRAY_PARTITION variable=h_state      complete
+    #pragma HLS ARRAY_PARTITION variable=h_newstate   complete
+    #pragma HLS ARRAY_PARTITION variable=tmpres       complete
+    #pragma HLS ARRAY_PARTITION variable=tmpres_state complete
+
+    if(reset_state){
+      for(int i_h_state = 0; i_h_state < (CONFIG_T::n_state); i_h_state++) {
+        #pragma HLS UNROLL
+        h_state[i_h_state] = 0;
+      }
+    }
+
+    nnet::dense<data_T, typename CONFIG_T::accum_t, typename CONFIG_T::mult_config1>(data, tmpres, param, param_b);
+    nnet::dense<res_T, typename CONFIG_T::accum_t, typename CONFIG_T::mult_config2>(h_state, tmpres_state, param_r, param_br);
+
+    nnet::simple_rnn_cell_update<res_T, CONFIG_T>(tmpres, tmpres_state, h_state);
+
+    for(int iacc = 0; iacc < (CONFIG_T::n_state); iacc++) {
+      #pragma HLS UNROLL
+      h_newstate[iacc] = h_state[iacc];
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void simple_rnn_stack(
+        data_T    data      [CONFIG_T::n_sequence*CONFIG_T::n_in],
+        res_T     res[CONFIG_T::n_sequence_out*CONFIG_T::n_state],
+        typename CONFIG_T::weight_t     param  [CONFIG_T::n_state*CONFIG_T::n_in],
+        typename CONFIG_T::weight_t     param_r[CONFIG_T::n_state*CONFIG_T::n_state],
+        typename CONFIG_T::bias_t       param_b [CONFIG_T::n_state],
+        typename CONFIG_T::bias_t       param_br[CONFIG_T::n_state]
+        ) {
+
+      res_T   h_state[CONFIG_T::n_state];
+      data_T  data_in[CONFIG_T::n_in];
+      bool    reset_state = true;
+
+      #pragma HLS ARRAY_PARTITION variable=h_state complete
+      #pragma HLS ARRAY_PARTITION variable=data_in complete
+
+      for(int ii = 0; ii < CONFIG_T::n_state; ii++) {
+        #pragma HLS UNROLL
+        h_state[ii] = 0;
+      }
+      for(int iloop = 0; iloop < CONFIG_T::n_sequence; iloop++) {
+        for(int j = 0; j < CONFIG_T::n_in; j++) {
+        #pragma HLS UNROLL
+          data_in[j] = data[j + iloop*CONFIG_T::n_in];
+        }
+        if (CONFIG_T::use_static)
+          nnet::simple_rnn_static<data_T, res_T, CONFIG_T>(reset_state, data_in, h_state, param, param_r, param_b, param_br);
+        else
+          nnet::simple_rnn<data_T, res_T, CONFIG_T>(reset_state, data_in, h_state, param, param_r, param_b, param_br);
+        if (CONFIG_T::n_sequence_out > 1)
+          for(int i=CONFIG_T::n_state*iloop, j=0; i<(CONFIG_T::n_state*(iloop+1)); i++,j++){
+            #pragma HLS UNROLL
+            res[i] = h_state[j];
+          }
+        reset_state = false;
+      }
+      if (CONFIG_T::n_sequence_out == 1)
+        for(int i=0; i<(CONFIG_T::n_state); i++){
+          #pragma HLS UNROLL
+          res[i] = h_state[i];
+        }
+    }
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void simple_rnn_stack(
+      hls::stream<data_T> &data_stream,
+      hls::stream<res_T>  &res_stream,
+      typename CONFIG_T::weight_t     param  [CONFIG_T::n_state*CONFIG_T::n_in],
+      typename CONFIG_T::weight_t     param_r[CONFIG_T::n_state*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_b [CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_br[CONFIG_T::n_state]
+      ) {
+
+    typename res_T::value_type  h_newstate[CONFIG_T::n_state];
+    #pragma HLS ARRAY_PARTITION variable=h_newstate complete
+    for(int ii = 0; ii < CONFIG_T::n_state; ii++) {
+      #pragma HLS UNROLL
+      h_newstate[ii] = 0;
+    }
+
+    typename data_T::value_type data_in[CONFIG_T::n_in];
+    bool reset_state = true;
+
+    DataPropagation: for(int i_in = 0; i_in < CONFIG_T::n_sequence*CONFIG_T::n_in / data_T::size; i_in++) {
+      data_T data_pack = data_stream.read();
+      DataPack: for (int i_pack = 0; i_pack < data_T::size; i_pack++) {
+          #pragma HLS UNROLL
+          data_in[i_pack] = data_pack[i_pack];
+      }
+      if (CONFIG_T::use_static)
+        nnet::simple_rnn_static<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(reset_state, data_in, h_newstate, param, param_r, param_b, param_br);
+      else
+        nnet::simple_rnn<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(reset_state, data_in, h_newstate, param, param_r, param_b, param_br);
+      if (CONFIG_T::n_sequence_out > 1){
+        res_T res_pack;
+        #pragma HLS DATA_PACK variable=res_pack
+        ResPack_sequences: for (int i_pack = 0; i_pack < res_T::size; i_pack++) {
+            #pragma HLS UNROLL
+            res_pack[i_pack] = h_newstate[i_pack];
+        }
+        res_stream.write(res_pack);
+      }
+      reset_state = false;
+    }
+
+    if (CONFIG_T::n_sequence_out == 1){
+      res_T res_pack;
+      #pragma HLS DATA_PACK variable=res_pack
+      ResPack: for (int i_pack = 0; i_pack < res_T::size; i_pack++) {
+          #pragma HLS UNROLL
+          res_pack[i_pack] = h_newstate[i_pack];
+      }
+      res_stream.write(res_pack);
+    }
+}
+
+#ifndef __SYNTHESIS__
+
+// Batched C simulation
+// The '_stack_batch' functions advance 'n_batch' independent sequences together, one time step at a time. At every
+// step the kernels are applied to all the sequences with one blocked matrix product, reading each weight once per
+// block instead of once per sequence. The results are identical to calling the '_stack' functions on each sequence.
+// Only used by the batched prediction of the compiled model, not for synthesis.
+
+static const unsigned recurrent_batch_block = 64;
+
+template<class data_T, typename CONFIG_T>
+  void recurrent_dense_batch(
+      unsigned n_batch,
+      const data_T *data,
+      unsigned data_stride,
+      typename CONFIG_T::accum_t *res,
+      typename CONFIG_T::weight_t weights[CONFIG_T::n_in*CONFIG_T::n_out],
+      typename CONFIG_T::bias_t   biases[CONFIG_T::n_out]
+      ) {
+
+    for(unsigned i_batch = 0; i_batch < n_batch; i_batch++) {
+      for(unsigned jj = 0; jj < CONFIG_T::n_out; jj++) {
+        res[i_batch*CONFIG_T::n_out + jj] = (typename CONFIG_T::accum_t) biases[jj];
+      }
+    }
+
+    for(unsigned i_block = 0; i_block < n_batch; i_block += recurrent_batch_block) {
+      unsigned block_end = std::min(n_batch, i_block + recurrent_batch_block);
+      for(unsigned ii = 0; ii < CONFIG_T::n_in; ii++) {
+        for(unsigned jj = 0; jj < CONFIG_T::n_out; jj++) {
+          // The "resource" strategy stores the kernel transposed
+          typename CONFIG_T::weight_t weight = (CONFIG_T::strategy == nnet::latency) ?
+            weights[ii*CONFIG_T::n_out + jj] : weights[jj*CONFIG_T::n_in + ii];
+          for(unsigned i_batch = i_block; i_batch < block_end; i_batch++) {
+            res[i_batch*CONFIG_T::n_out + jj] += static_cast<typename CONFIG_T::accum_t>(
+              CONFIG_T::template product<data_T, typename CONFIG_T::weight_t>::product(data[i_batch*data_stride + ii], weight));
+          }
+        }
+      }
+    }
+}
+
+template<class res_T, typename CONFIG_T>
+  void recurrent_write_batch(
+      unsigned n_batch,
+      unsigned i_seq,
+      const res_T *h_state,
+      res_T *res
+      ) {
+
+    if (CONFIG_T::n_sequence_out == 1 && i_seq != CONFIG_T::n_sequence - 1) return;
+    unsigned offset = (CONFIG_T::n_sequence_out == 1) ? 0 : i_seq*CONFIG_T::n_state;
+    for(unsigned i_batch = 0; i_batch < n_batch; i_batch++) {
+      for(unsigned i = 0; i < CONFIG_T::n_state; i++) {
+        res[i_batch*CONFIG_T::n_sequence_out*CONFIG_T::n_state + offset + i] = h_state[i_batch*CONFIG_T::n_state + i];
+      }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void simple_rnn_stack_batch(
+      unsigned n_batch,
+      data_T    *data,
+      res_T     *res,
+      typename CONFIG_T::weight_t     param  [CONFIG_T::n_state*CONFIG_T::n_in],
+      typename CONFIG_T::weight_t     param_r[CONFIG_T::n_state*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_b [CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_br[CONFIG_T::n_state]
+      ) {
+
+    std::vector<res_T> h_state(n_batch*CONFIG_T::n_state, res_T(0));
+    std::vector<typename CONFIG_T::accum_t> tmpres(n_batch*CONFIG_T::n_state);
+    std::vector<typename CONFIG_T::accum_t> tmpres_state(n_batch*CONFIG_T::n_state);
+
+    for(unsigned i_seq = 0; i_seq < CONFIG_T::n_sequence; i_seq++) {
+      nnet::recurrent_dense_batch<data_T, typename CONFIG_T::mult_config1>(n_batch, data + i_seq*CONFIG_T::n_in, CONFIG_T::n_sequence*CONFIG_T::n_in, tmpres.data(), param, param_b);
+      nnet::recurrent_dense_batch<res_T, typename CONFIG_T::mult_config2>(n_batch, h_state.data(), CONFIG_T::n_state, tmpres_state.data(), param_r, param_br);
+      for(unsigned i_batch = 0; i_batch < n_batch; i_batch++) {
+        unsigned offset = i_batch*CONFIG_T::n_state;
+        nnet::simple_rnn_cell_update<res_T, CONFIG_T>(&tmpres[offset], &tmpres_state[offset], &h_state[offset]);
+      }
+      nnet::recurrent_write_batch<res_T, CONFIG_T>(n_batch, i_seq, h_state.data(), res);
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void lstm_stack_batch(
+      unsigned n_batch,
+      data_T    *data,
+      res_T     *res,
+      typename CONFIG_T::weight_t     param  [CONFIG_T::n_state*4*CONFIG_T::n_in],
+      typename CONFIG_T::weight_t     param_r[CONFIG_T::n_state*4*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_b [CONFIG_T::n_state*4],
+      typename CONFIG_T::bias_t       param_br[CONFIG_T::n_state*4]
+      ) {
+
+    std::vector<res_T> h_state(n_batch*CONFIG_T::n_state, res_T(0));
+    std::vector<res_T> s_state(n_batch*CONFIG_T::n_state, res_T(0));
+    std::vector<typename CONFIG_T::accum_t> tmpres(n_batch*CONFIG_T::n_state*4);
+    std::vector<typename CONFIG_T::accum_t> tmpres_state(n_batch*CONFIG_T::n_state*4);
+
+    for(unsigned i_seq = 0; i_seq < CONFIG_T::n_sequence; i_seq++) {
+      nnet::recurrent_dense_batch<data_T, typename CONFIG_T::mult_config1>(n_batch, data + i_seq*CONFIG_T::n_in, CONFIG_T::n_sequence*CONFIG_T::n_in, tmpres.data(), param, param_b);
+      nnet::recurrent_dense_batch<res_T, typename CONFIG_T::mult_config2>(n_batch, h_state.data(), CONFIG_T::n_state, tmpres_state.data(), param_r, param_br);
+      for(unsigned i_batch = 0; i_batch < n_batch; i_batch++) {
+        unsigned offset = i_batch*CONFIG_T::n_state;
+        nnet::lstm_cell_update<res_T, CONFIG_T>(&tmpres[4*offset], &tmpres_state[4*offset], &h_state[offset], &s_state[offset]);
+      }
+      nnet::recurrent_write_batch<res_T, CONFIG_T>(n_batch, i_seq, h_state.data(), res);
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void gru_stack_batch(
+      unsigned n_batch,
+      data_T    *data,
+      res_T     *res,
+      typename CONFIG_T::weight_t     param   [CONFIG_T::n_state*3*CONFIG_T::n_in],
+      typename CONFIG_T::weight_t     param_zr[CONFIG_T::n_state*3*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_b [CONFIG_T::n_state*3],
+      typename CONFIG_T::bias_t       param_br[CONFIG_T::n_state*3]
+      ) {
+
+    std::vector<res_T> h_state(n_batch*CONFIG_T::n_state, res_T(0));
+    std::vector<typename CONFIG_T::accum_t> tmpres(n_batch*CONFIG_T::n_state*3);
+    std::vector<typename CONFIG_T::accum_t> tmpres_state_zr(n_batch*CONFIG_T::n_state*3);
+
+    for(unsigned i_seq = 0; i_seq < CONFIG_T::n_sequence; i_seq++) {
+      nnet::recurrent_dense_batch<data_T, typename CONFIG_T::mult_config1>(n_batch, data + i_seq*CONFIG_T::n_in, CONFIG_T::n_sequence*CONFIG_T::n_in, tmpres.data(), param, param_b);
+      nnet::recurrent_dense_batch<res_T, typename CONFIG_T::mult_config2>(n_batch, h_state.data(), CONFIG_T::n_state, tmpres_state_zr.data(), param_zr, param_br);
+      for(unsigned i_batch = 0; i_batch < n_batch; i_batch++) {
+        unsigned offset = i_batch*CONFIG_T::n_state;
+        nnet::gru_cell_update<res_T, CONFIG_T>(&tmpres[3*offset], &tmpres_state_zr[3*offset], &h_state[offset]);
+      }
+      nnet::recurrent_write_batch<res_T, CONFIG_T>(n_batch, i_seq, h_state.data(), res);
+    }
+}
+
+#endif
+
+#ifndef __SYNTHESIS__
+
+// Explicit state of the recurrent layers
+// The '_stack' functions start every sequence from a zero state, kept in 'static' arrays. The '_stack_state' functions
+// instead start from the given state object and leave the final state in it, so the next call continues the sequence.
+// Each independent stream of sequences holds its own state objects, which allows interleaving several streams and
+// calling the emulation from several threads. Only used by the stateful C simulation of the compiled model.
+
+template<class res_T, typename CONFIG_T>
+struct simple_rnn_state {
+    res_T h[CONFIG_T::n_state];
+
+    void reset() {
+        for(unsigned i = 0; i < CONFIG_T::n_state; i++) h[i] = 0;
+    }
+};
+
+template<class res_T, typename CONFIG_T>
+struct lstm_state {
+    res_T h[CONFIG_T::n_state];
+    res_T s[CONFIG_T::n_state];
+
+    void reset() {
+        for(unsigned i = 0; i < CONFIG_T::n_state; i++) {
+            h[i] = 0;
+            s[i] = 0;
+        }
+    }
+};
+
+template<class res_T, typename CONFIG_T>
+struct gru_state {
+    res_T h[CONFIG_T::n_state];
+
+    void reset() {
+        for(unsigned i = 0; i < CONFIG_T::n_state; i++) h[i] = 0;
+    }
+};
+
+template<class data_T, typename CONFIG_T>
+  void recurrent_read_stream(
+      hls::stream<data_T> &data_stream,
+      typename data_T::value_type data[CONFIG_T::n_sequence*CONFIG_T::n_in]
+      ) {
+    for(unsigned i_in = 0; i_in < CONFIG_T::n_sequence*CONFIG_T::n_in / data_T::size; i_in++) {
+      data_T data_pack = data_stream.read();
+      for(unsigned i_pack = 0; i_pack < data_T::size; i_pack++) {
+        data[i_in*data_T::size + i_pack] = data_pack[i_pack];
+      }
+    }
+}
+
+template<class res_T, typename CONFIG_T>
+  void recurrent_write_stream(
+      typename res_T::value_type res[CONFIG_T::n_sequence_out*CONFIG_T::n_state],
+      hls::stream<res_T> &res_stream
+      ) {
+    for(unsigned i_out = 0; i_out < CONFIG_T::n_sequence_out*CONFIG_T::n_state / res_T::size; i_out++) {
+      res_T res_pack;
+      for(unsigned i_pack = 0; i_pack < res_T::size; i_pack++) {
+        res_pack[i_pack] = res[i_out*res_T::size + i_pack];
+      }
+      res_stream.write(res_pack);
+    }
+}
+
+template<class res_T, typename CONFIG_T>
+  void recurrent_write_state(
+      unsigned i_seq,
+      res_T h_state[CONFIG_T::n_state],
+      res_T res[CONFIG_T::n_sequence_out*CONFIG_T::n_state]
+      ) {
+    if (CONFIG_T::n_sequence_out == 1 && i_seq != CONFIG_T::n_sequence - 1) return;
+    unsigned offset = (CONFIG_T::n_sequence_out == 1) ? 0 : i_seq*CONFIG_T::n_state;
+    for(unsigned i = 0; i < CONFIG_T::n_state; i++) {
+      res[offset + i] = h_state[i];
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void simple_rnn_stack_state(
+      data_T    data[CONFIG_T::n_sequence*CONFIG_T::n_in],
+      res_T     res[CONFIG_T::n_sequence_out*CONFIG_T::n_state],
+      simple_rnn_state<res_T, CONFIG_T> &state,
+      typename CONFIG_T::weight_t     param  [CONFIG_T::n_state*CONFIG_T::n_in],
+      typename CONFIG_T::weight_t     param_r[CONFIG_T::n_state*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_b [CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_br[CONFIG_T::n_state]
+      ) {
+
+    typename CONFIG_T::accum_t tmpres      [CONFIG_T::n_state];
+    typename CONFIG_T::accum_t tmpres_state[CONFIG_T::n_state];
+
+    for(unsigned i_seq = 0; i_seq < CONFIG_T::n_sequence; i_seq++) {
+      nnet::dense<data_T, typename CONFIG_T::accum_t, typename CONFIG_T::mult_config1>(data + i_seq*CONFIG_T::n_in, tmpres, param, param_b);
+      nnet::dense<res_T, typename CONFIG_T::accum_t, typename CONFIG_T::mult_config2>(state.h, tmpres_state, param_r, param_br);
+      nnet::simple_rnn_cell_update<res_T, CONFIG_T>(tmpres, tmpres_state, state.h);
+      nnet::recurrent_write_state<res_T, CONFIG_T>(i_seq, state.h, res);
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void simple_rnn_stack_state(
+      hls::stream<data_T> &data_stream,
+      hls::stream<res_T>  &res_stream,
+      simple_rnn_state<typename res_T::value_type, CONFIG_T> &state,
+      typename CONFIG_T::weight_t     param  [CONFIG_T::n_state*CONFIG_T::n_in],
+      typename CONFIG_T::weight_t     param_r[CONFIG_T::n_state*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_b [CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_br[CONFIG_T::n_state]
+      ) {
+
+    typename data_T::value_type data[CONFIG_T::n_sequence*CONFIG_T::n_in];
+    typename res_T::value_type res[CONFIG_T::n_sequence_out*CONFIG_T::n_state];
+
+    nnet::recurrent_read_stream<data_T, CONFIG_T>(data_stream, data);
+    nnet::simple_rnn_stack_state<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(data, res, state, param, param_r, param_b, param_br);
+    nnet::recurrent_write_stream<res_T, CONFIG_T>(res, res_stream);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void lstm_stack_state(
+      data_T    data[CONFIG_T::n_sequence*CONFIG_T::n_in],
+      res_T     res[CONFIG_T::n_sequence_out*CONFIG_T::n_state],
+      lstm_state<res_T, CONFIG_T> &state,
+      typename CONFIG_T::weight_t     param  [CONFIG_T::n_state*4*CONFIG_T::n_in],
+      typename CONFIG_T::weight_t     param_r[CONFIG_T::n_state*4*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_b [CONFIG_T::n_state*4],
+      typename CONFIG_T::bias_t       param_br[CONFIG_T::n_state*4]
+      ) {
+
+    typename CONFIG_T::accum_t tmpres      [CONFIG_T::n_state*4];
+    typename CONFIG_T::accum_t tmpres_state[CONFIG_T::n_state*4];
+
+    for(unsigned i_seq = 0; i_seq < CONFIG_T::n_sequence; i_seq++) {
+      nnet::dense<data_T, typename CONFIG_T::accum_t, typename CONFIG_T::mult_config1>(data + i_seq*CONFIG_T::n_in, tmpres, param, param_b);
+      nnet::dense<res_T, typename CONFIG_T::accum_t, typename CONFIG_T::mult_config2>(state.h, tmpres_state, param_r, param_br);
+      nnet::lstm_cell_update<res_T, CONFIG_T>(tmpres, tmpres_state, state.h, state.s);
+      nnet::recurrent_write_state<res_T, CONFIG_T>(i_seq, state.h, res);
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void lstm_stack_state(
+      hls::stream<data_T> &data_stream,
+      hls::stream<res_T>  &res_stream,
+      lstm_state<typename res_T::value_type, CONFIG_T> &state,
+      typename CONFIG_T::weight_t     param  [CONFIG_T::n_state*4*CONFIG_T::n_in],
+      typename CONFIG_T::weight_t     param_r[CONFIG_T::n_state*4*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_b [CONFIG_T::n_state*4],
+      typename CONFIG_T::bias_t       param_br[CONFIG_T::n_state*4]
+      ) {
+
+    typename data_T::value_type data[CONFIG_T::n_sequence*CONFIG_T::n_in];
+    typename res_T::value_type res[CONFIG_T::n_sequence_out*CONFIG_T::n_state];
+
+    nnet::recurrent_read_stream<data_T, CONFIG_T>(data_stream, data);
+    nnet::lstm_stack_state<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(data, res, state, param, param_r, param_b, param_br);
+    nnet::recurrent_write_stream<res_T, CONFIG_T>(res, res_stream);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void gru_stack_state(
+      data_T    data[CONFIG_T::n_sequence*CONFIG_T::n_in],
+      res_T     res[CONFIG_T::n_sequence_out*CONFIG_T::n_state],
+      gru_state<res_T, CONFIG_T> &state,
+      typename CONFIG_T::weight_t     param   [CONFIG_T::n_state*3*CONFIG_T::n_in],
+      typename CONFIG_T::weight_t     param_zr[CONFIG_T::n_state*3*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_b [CONFIG_T::n_state*3],
+      typename CONFIG_T::bias_t       param_br[CONFIG_T::n_state*3]
+      ) {
+
+    typename CONFIG_T::accum_t tmpres         [CONFIG_T::n_state*3];
+    typename CONFIG_T::accum_t tmpres_state_zr[CONFIG_T::n_state*3];
+
+    for(unsigned i_seq = 0; i_seq < CONFIG_T::n_sequence; i_seq++) {
+      nnet::dense<data_T, typename CONFIG_T::accum_t, typename CONFIG_T::mult_config1>(data + i_seq*CONFIG_T::n_in, tmpres, param, param_b);
+      nnet::dense<res_T, typename CONFIG_T::accum_t, typename CONFIG_T::mult_config2>(state.h, tmpres_state_zr, param_zr, param_br);
+      nnet::gru_cell_update<res_T, CONFIG_T>(tmpres, tmpres_state_zr, state.h);
+      nnet::recurrent_write_state<res_T, CONFIG_T>(i_seq, state.h, res);
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void gru_stack_state(
+      hls::stream<data_T> &data_stream,
+      hls::stream<res_T>  &res_stream,
+      gru_state<typename res_T::value_type, CONFIG_T> &state,
+      typename CONFIG_T::weight_t     param   [CONFIG_T::n_state*3*CONFIG_T::n_in],
+      typename CONFIG_T::weight_t     param_zr[CONFIG_T::n_state*3*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_b [CONFIG_T::n_state*3],
+      typename CONFIG_T::bias_t       param_br[CONFIG_T::n_state*3]
+      ) {
+
+    typename data_T::value_type data[CONFIG_T::n_sequence*CONFIG_T::n_in];
+    typename res_T::value_type res[CONFIG_T::n_sequence_out*CONFIG_T::n_state];
+
+    nnet::recurrent_read_stream<data_T, CONFIG_T>(data_stream, data);
+    nnet::gru_stack_state<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(data, res, state, param, param_zr, param_b, param_br);
+    nnet::recurrent_write_stream<res_T, CONFIG_T>(res, res_stream);
+}
+
+#endif
+
 }//end namespace
 
 #endif
@@ -16,51 +16,32 @@ struct broadcast_config
   static const unsigned out_chan = 3;
 };
 
-template<class data_T, class res_T, int N>
-void clone_stream(hls::stream<data_T> &data, hls::stream<res_T> &res1, hls::stream<res_T> &res2) {
-    CloneLoop: for (int i = 0; i < N / data_T::size; i++) {
-        #pragma HLS PIPELINE
-
-        data_T in_data = data.read();
-        res_T out_data1;
-        res_T out_data2;
-        #pragma HLS DATA_PACK variable=out_data1
-        #pragma HLS DATA_PACK variable=out_data2
-
-        ClonePack: for (int j = 0; j < data_T::size; j++) {
-            #pragma HLS UNROLL
-            out_data1[j] = in_data[j];
-            out_data2[j] = in_data[j];
-        }
-
-        res1.write(out_data1);
-        res2.write(out_data2);
-    }
+// Writes the same packet to every output stream, the recursion is unrolled at compile time for any number of outputs
+template<class res_T>
+void clone_write(const res_T &out_data) {}
+
+template<class res_T, class... rest_T>
+void clone_write(const res_T &out_data, hls::stream<res_T> &res, rest_T &... rest) {
+    #pragma HLS INLINE
+    res.write(out_data);
+    clone_write<res_T>(out_data, rest...);
 }
 
-template<class data_T, class res_T, int N>
-void clone_stream(hls::stream<data_T> &data, hls::stream<res_T> &res1, hls::stream<res_T> &res2, hls::stream<res_T> &res3) {
+template<class data_T, class res_T, int N, class... rest_T>
+void clone_stream(hls::stream<data_T> &data, hls::stream<res_T> &res1, rest_T &... rest) {
     CloneLoop: for (int i = 0; i < N / data_T::size; i++) {
         #pragma HLS PIPELINE
 
         data_T in_data = data.read();
-        res_T out_data1;
-        res_T out_data2;
-        res_T out_data3;
-        #pragma HLS DATA_PACK variable=out_data1
-        #pragma HLS DATA_PACK variable=out_data2
-        #pragma HLS DATA_PACK variable=out_data3
+        res_T out_data;
+        #pragma HLS DATA_PACK variable=out_data
 
         ClonePack: for (int j = 0; j < data_T::size; j++) {
             #pragma HLS UNROLL
-            out_data1[j] = in_data[j];
-            out_data2[j] = in_data[j];
-            out_data3[j] = in_data[j];
+            out_data[j] = in_data[j];
         }
 
-        res1.write(out_data1);
-        res2.write(out_data2);
-        res3.write(out_data3);
+        clone_write<res_T>(out_data, res1, rest...);
     }
 }
 
@@ -172,29 +153,6 @@ void broadcast_stream(hls::stream<data_T> &data, hls::stream<res_T> &res) {
     }
 }
 
-template<class data_T, class res_T, typename CONFIG_T>
-void transpose_2d(hls::stream<data_T> &data, hls::stream<res_T> &res) {
-    typename data_T::value_type data_array[CONFIG_T::height * CONFIG_T::width];   
-    #pragma HLS ARRAY_PARTITION variable=data_array complete
-
-    for (int i = 0; i < CONFIG_T::height * CONFIG_T::width / data_T::size; i++) {
-        #pragma HLS PIPELINE
-        data_T in_data = data.read();
-	for (int j = 0; j < data_T::size; j++) {
-	    data_array[i * data_T::size + j] = typename data_T::value_type(in_data[j]);
-        }
-    }
-  
-    for (int i = 0; i < CONFIG_T::height * CONFIG_T::width / res_T::size; i++) {
-        #pragma HLS PIPELINE
-        res_T out_data;
-        #pragma HLS DATA_PACK variable=out_data
-        for (int j = 0; j < res_T::size; j++) {
-	    out_data[j] = typename res_T::value_type(data_array[j * data_T::size + i]);
-        }
-	res.write(out_data);
-    }
-} 
 }
 
 #endif
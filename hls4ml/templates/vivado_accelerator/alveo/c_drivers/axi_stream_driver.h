@@ -0,0 +1,69 @@
+#ifndef AXI_STREAM_DRIVER_H_
+#define AXI_STREAM_DRIVER_H_
+
+/*
+* Transport for the Alveo cards, through the XRT native API. Built with -DHLS4ML_XRT, see build_host.sh.
+* Each slot is a pair of device buffers and a run of the kernel: the input of batch k + 1 is synced to the card
+* while the kernel works on batch k.
+*/
+
+#include "host_runtime.h"
+
+#include <xrt/xrt_bo.h>
+#include <xrt/xrt_device.h>
+#include <xrt/xrt_kernel.h>
+
+namespace nnet {
+
+template<class in_T, class out_T>
+class accelerator_transport : public axi_transport<in_T, out_T> {
+  public:
+    // n_in and n_out are the words per event, in_pack and out_pack the words per beat of the streams of the kernel
+    accelerator_transport(const std::string &xclbin, unsigned n_in, unsigned n_out, unsigned n_slots,
+                          unsigned batch_size, unsigned in_pack = 1, unsigned out_pack = 1, unsigned device_index = 0)
+        : _n_in(n_in), _n_out(n_out), _n_slots(n_slots), _batch_size(batch_size), _in_pack(in_pack),
+          _out_pack(out_pack), _device(device_index), _events(n_slots, 0)
+    {
+        xrt::uuid uuid = _device.load_xclbin(xclbin);
+        _kernel = xrt::kernel(_device, uuid, "krnl_rtl");
+        for (unsigned s = 0; s < n_slots; s++) {
+            _in_bo.push_back(xrt::bo(_device, (size_t) batch_size * n_in * sizeof(in_T), _kernel.group_id(0)));
+            _out_bo.push_back(xrt::bo(_device, (size_t) batch_size * n_out * sizeof(out_T), _kernel.group_id(1)));
+            _runs.push_back(xrt::run(_kernel));
+        }
+    }
+
+    unsigned n_slots() const { return _n_slots; }
+    unsigned batch_size() const { return _batch_size; }
+
+    in_T *input_buffer(unsigned slot) { return _in_bo[slot].template map<in_T *>(); }
+    out_T *output_buffer(unsigned slot) { return _out_bo[slot].template map<out_T *>(); }
+
+    void start(unsigned slot, unsigned n_events) {
+        _in_bo[slot].sync(XCL_BO_SYNC_BO_TO_DEVICE, (size_t) n_events * _n_in * sizeof(in_T), 0);
+        _runs[slot].set_arg(0, _in_bo[slot]);
+        _runs[slot].set_arg(1, _out_bo[slot]);
+        // The lengths are in beats
+        _runs[slot].set_arg(2, n_events * _n_in / _in_pack);
+        _runs[slot].set_arg(3, n_events * _n_out / _out_pack);
+        _runs[slot].start();
+        _events[slot] = n_events;
+    }
+
+    void wait(unsigned slot) {
+        _runs[slot].wait();
+        _out_bo[slot].sync(XCL_BO_SYNC_BO_FROM_DEVICE, (size_t) _events[slot] * _n_out * sizeof(out_T), 0);
+    }
+
+  private:
+    const unsigned _n_in, _n_out, _n_slots, _batch_size, _in_pack, _out_pack;
+    xrt::device _device;
+    xrt::kernel _kernel;
+    std::vector<xrt::bo> _in_bo, _out_bo;
+    std::vector<xrt::run> _runs;
+    std::vector<unsigned> _events;
+};
+
+}
+
+#endif
@@ -4,6 +4,8 @@ import numpy as np
 from pynq import Overlay
 from pynq import allocate
 
+#hls-fpga-machine-learning insert definitions
+
 
 class NeuralNetworkOverlay(Overlay):
     def __init__(self, xclbin_name, dtbo=None, download=True, ignore_version=False, device=None):
@@ -12,7 +14,7 @@ class NeuralNetworkOverlay(Overlay):
         self.input_buffer=None
         self.output_buffer=None
 
-    def allocate_mem(self, X_shape, y_shape, dtype=np.float32, trg_in=None, trg_out=None):
+    def allocate_mem(self, X_shape, y_shape, dtype=np.float32, trg_in=None, trg_out=None, out_dtype=None):
         """
         Buffer allocation in the card memory
         Parameters
@@ -40,6 +42,7 @@ class NeuralNetworkOverlay(Overlay):
                   set it to HBM[0] for alveo-u50. 
         trg_out : output buffer target memory.By default the v++ command
                   set it to HBM[0] for alveo-u50.
+        out_dtype : the data type of the elements of the output vector, if different from `dtype`.
 
         Assigns
         -------
@@ -49,9 +52,9 @@ class NeuralNetworkOverlay(Overlay):
 
         """
         self.input_buffer  = allocate(shape=X_shape, dtype=dtype, target=trg_in )
-        self.output_buffer = allocate(shape=y_shape, dtype=dtype, target=trg_out)
+        self.output_buffer = allocate(shape=y_shape, dtype=dtype if out_dtype is None else out_dtype, target=trg_out)
 
-    def predict(self, X, y_shape, dtype=np.float32, debug=None, profile=False, encode=None,
+    def predict(self, X, y_shape, dtype=None, debug=None, profile=False, encode=None,
                 decode=None):
         """
         Obtain the predictions of the NN implemented in the FPGA.
@@ -59,21 +62,31 @@ class NeuralNetworkOverlay(Overlay):
         - X : the input vector. Should be numpy ndarray.
         - y_shape : the shape of the output vector. Needed to the accelerator to set the TLAST bit properly and
                     for sizing the output vector shape.
-        - dtype   : the data type of the elements of the input/output vectors.
+        - dtype   : the data type of the elements of the input/output vectors. By default the one of the
+                    interface, the values are then encoded and decoded by encode_events()/decode_events(), which
+                    also pack several values per beat of the stream.
         - debug : boolean, if set the function will print information about the data transfers status.
         - profile : boolean. Set it to `True` to print the performance of the algorithm in term of `inference/s`.
         - encode/decode: function pointers. See `dtype` section for more information.
         - return: an output array based on `np.ndarray` with a shape equal to `y_shape` and a `dtype` equal to
                   the namesake parameter.
         """
-        self.allocate_mem(X_shape=X.shape, y_shape=y_shape, dtype=dtype)
         if profile:
             timea = datetime.now()
         if encode is not None:
-            X = encode(X)
-        in_size  = np.prod(X.shape)
-        out_size = np.prod(y_shape)
-        self.input_buffer[:] = X
+            words = encode_events(encode(X), N_IN, PACK_IN, None)
+        else:
+            words = encode_events(X, N_IN, PACK_IN, FIXED_IN)
+        # The buffers hold the words of the streams, the events are padded to whole beats
+        n_events = words.shape[0]
+        in_dtype = dtype if dtype is not None else (np.float32 if FIXED_IN is None else FIXED_IN[0])
+        out_dtype = dtype if dtype is not None else (np.float32 if FIXED_OUT is None else FIXED_OUT[0])
+        self.allocate_mem(X_shape=words.shape, y_shape=(n_events, -(-N_OUT // PACK_OUT) * PACK_OUT), dtype=in_dtype,
+                          out_dtype=out_dtype)
+        # The lengths are in beats
+        in_size  = self.input_buffer.size // PACK_IN
+        out_size = self.output_buffer.size // PACK_OUT
+        self.input_buffer[:] = words
         self.input_buffer.sync_to_device()
         if debug:
             print("Send OK")
@@ -83,7 +96,11 @@ class NeuralNetworkOverlay(Overlay):
         self.output_buffer.sync_from_device()
         if debug:
             print("Recieve OK")
-        result = self.output_buffer.copy()
+        if decode is not None:
+            result = decode(decode_events(self.output_buffer, N_OUT, None))
+        else:
+            result = decode_events(self.output_buffer, N_OUT, FIXED_OUT)
+        result = np.array(result).reshape(y_shape)
         if profile:
             timeb = datetime.now()
             dts, rate = self._print_dt(timea, timeb, len(X))
@@ -0,0 +1,17 @@
+#!/bin/bash
+
+# Host program of the accelerator:
+#   ./build_host.sh       myproject_host_csim, on the C simulation library (run compile() or build_lib.sh first)
+#   ./build_host.sh hw    myproject_host for the Alveo cards, with XRT from ${XILINX_XRT}
+# On the Zynq boards the host program is bare-metal: add myproject_host.cpp and the headers to a Vitis
+# application on the standalone BSP of the exported hardware instead.
+
+CXX=${CXX:-g++}
+CFLAGS="-O3 -std=c++11"
+PROJECT=myproject
+
+if [[ "$1" == "hw" ]]; then
+    ${CXX} ${CFLAGS} -DHLS4ML_XRT -I${XILINX_XRT}/include ${PROJECT}_host.cpp -L${XILINX_XRT}/lib -lxrt_coreutil -pthread -o ${PROJECT}_host
+else
+    ${CXX} ${CFLAGS} -DHLS4ML_CSIM ${PROJECT}_host.cpp -pthread -ldl -o ${PROJECT}_host_csim
+fi
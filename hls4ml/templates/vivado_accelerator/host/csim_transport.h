@@ -0,0 +1,139 @@
+#ifndef CSIM_TRANSPORT_H_
+#define CSIM_TRANSPORT_H_
+
+#include "host_runtime.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <dlfcn.h>
+#include <unistd.h>
+
+namespace nnet {
+
+/*
+* Local stand-in for the accelerator, backed by the C simulation library of the project (built by compile()).
+* The batches are processed one after the other by a worker thread, so the host fills the next slot while the
+* current one is "on the device", as with the hardware transports. In batch mode, the library runs all the events of
+* a batch through the wrapper in one transfer.
+*/
+template<class in_codec, class out_codec>
+class csim_transport : public axi_transport<typename in_codec::word_t, typename out_codec::word_t> {
+  public:
+    typedef typename in_codec::word_t in_T;
+    typedef typename out_codec::word_t out_T;
+    typedef void (*top_function_t)(double *, double *);
+    typedef void (*batch_function_t)(double *, double *, unsigned);
+
+    csim_transport(const std::string &library, const std::string &top, unsigned n_in, unsigned n_out,
+                   unsigned n_in_words, unsigned n_out_words, unsigned n_slots, unsigned batch_size)
+        : _n_in(n_in), _n_out(n_out), _n_in_words(n_in_words), _n_out_words(n_out_words), _n_slots(n_slots),
+          _batch_size(batch_size),
+          _inputs(n_slots), _outputs(n_slots), _pending(n_slots, false), _stop(false)
+    {
+        _library = dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (_library == NULL) {
+            throw std::runtime_error(std::string("Cannot load the C simulation library: ") + dlerror());
+        }
+        _top = (top_function_t) dlsym(_library, (top + "_double").c_str());
+        if (_top == NULL) {
+            dlclose(_library);
+            throw std::runtime_error("The C simulation library has no function " + top + "_double");
+        }
+        _batch = (batch_function_t) dlsym(_library, (top + "_batch_double").c_str());
+        // The library reads the weights from the directory "weights" on its first call, next to it in the project
+        char cwd[4096];
+        std::string::size_type sep = library.rfind('/');
+        if (getcwd(cwd, sizeof(cwd)) != NULL && (sep == std::string::npos || chdir(library.substr(0, sep).c_str()) == 0)) {
+            std::vector<double> in(n_in, 0.), out(n_out);
+            _top(in.data(), out.data());
+            if (chdir(cwd) != 0) throw std::runtime_error("Cannot return to the working directory");
+        }
+        for (unsigned s = 0; s < n_slots; s++) {
+            _inputs[s].resize((size_t) batch_size * n_in_words);
+            _outputs[s].resize((size_t) batch_size * n_out_words);
+        }
+        _worker = std::thread(&csim_transport::run, this);
+    }
+
+    ~csim_transport() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _cond.notify_all();
+        _worker.join();
+        dlclose(_library);
+    }
+
+    unsigned n_slots() const { return _n_slots; }
+    unsigned batch_size() const { return _batch_size; }
+
+    in_T *input_buffer(unsigned slot) { return _inputs[slot].data(); }
+    out_T *output_buffer(unsigned slot) { return _outputs[slot].data(); }
+
+    void start(unsigned slot, unsigned n_events) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _pending[slot] = true;
+            _queue.push_back(std::make_pair(slot, n_events));
+        }
+        _cond.notify_all();
+    }
+
+    void wait(unsigned slot) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cond.wait(lock, [this, slot] { return !_pending[slot]; });
+    }
+
+  private:
+    void run() {
+        std::vector<double> in((size_t) _batch_size * _n_in), out((size_t) _batch_size * _n_out);
+        while (true) {
+            std::pair<unsigned, unsigned> job;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _cond.wait(lock, [this] { return _stop || !_queue.empty(); });
+                if (_queue.empty()) return;
+                job = _queue.front();
+                _queue.pop_front();
+            }
+            const unsigned slot = job.first, n_events = job.second;
+            decode_events<in_codec>(_inputs[slot].data(), in.data(), n_events, _n_in, _n_in_words);
+            if (_batch != NULL) {
+                _batch(in.data(), out.data(), n_events);
+            } else {
+                for (unsigned e = 0; e < n_events; e++) {
+                    _top(in.data() + (size_t) e * _n_in, out.data() + (size_t) e * _n_out);
+                }
+            }
+            encode_events<out_codec>(out.data(), _outputs[slot].data(), n_events, _n_out, _n_out_words);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _pending[slot] = false;
+            }
+            _cond.notify_all();
+        }
+    }
+
+    const unsigned _n_in, _n_out, _n_in_words, _n_out_words, _n_slots, _batch_size;
+    void *_library;
+    top_function_t _top;
+    batch_function_t _batch;
+    std::vector<std::vector<in_T>> _inputs;
+    std::vector<std::vector<out_T>> _outputs;
+    std::vector<bool> _pending;
+    std::deque<std::pair<unsigned, unsigned>> _queue;
+    bool _stop;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    std::thread _worker;
+};
+
+}
+
+#endif
@@ -0,0 +1,217 @@
+#ifndef HOST_RUNTIME_H_
+#define HOST_RUNTIME_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace nnet {
+
+/*
+* Conversion between the floating point values of the host and the words of the AXI stream, one value per word.
+* The loops run over the whole batch without branches so that the compiler vectorizes them.
+*/
+template<class word_T>
+struct float_codec {
+    typedef word_T word_t;
+
+    template<class T>
+    static void encode(const T *x, word_T *words, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            words[i] = (word_T) x[i];
+        }
+    }
+
+    template<class T>
+    static void decode(const word_T *words, T *y, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            y[i] = (T) words[i];
+        }
+    }
+};
+
+// Words holding the raw two's complement value of an ap_fixed with F fractional bits, converted as the ap_fixed
+// would: truncation (AP_TRN) or rounding (AP_RND) and wrap around (AP_WRAP) or saturation (AP_SAT)
+template<class word_T, int F, bool Round = false, bool Saturate = false>
+struct fixed_codec {
+    typedef word_T word_t;
+
+    template<class T>
+    static void encode(const T *x, word_T *words, size_t n) {
+        const double scale = std::ldexp(1.0, F);
+        const long long min = (long long) std::numeric_limits<word_T>::min();
+        const long long max = (long long) std::numeric_limits<word_T>::max();
+        for (size_t i = 0; i < n; i++) {
+            double v = (double) x[i] * scale + (Round ? 0.5 : 0.0);
+            long long raw = (long long) v;
+            raw -= (v < (double) raw); // floor
+            if (Saturate) raw = std::min(std::max(raw, min), max);
+            words[i] = (word_T) raw;
+        }
+    }
+
+    template<class T>
+    static void decode(const word_T *words, T *y, size_t n) {
+        const double scale = std::ldexp(1.0, -F);
+        for (size_t i = 0; i < n; i++) {
+            y[i] = (T) ((double) words[i] * scale);
+        }
+    }
+};
+
+/*
+* Conversion of whole events. When several values are packed in a beat, an event of n values takes a whole number of
+* beats, the stride, and the unused values of its last beat are zero.
+*/
+template<class codec, class T>
+void encode_events(const T *x, typename codec::word_t *words, size_t n_events, unsigned n, unsigned stride) {
+    if (n == stride) {
+        codec::encode(x, words, n_events * n);
+        return;
+    }
+    for (size_t e = 0; e < n_events; e++) {
+        codec::encode(x + e * n, words + e * stride, n);
+        std::fill(words + e * stride + n, words + (e + 1) * stride, typename codec::word_t(0));
+    }
+}
+
+template<class codec, class T>
+void decode_events(const typename codec::word_t *words, T *y, size_t n_events, unsigned n, unsigned stride) {
+    if (n == stride) {
+        codec::decode(words, y, n_events * n);
+        return;
+    }
+    for (size_t e = 0; e < n_events; e++) {
+        codec::decode(words + e * stride, y + e * n, n);
+    }
+}
+
+/*
+* Moves batches of events between the host and the accelerator. A transport owns n_slots pairs of input and output
+* buffers holding up to batch_size events each, and keeps any number of them in flight: start() returns as soon as
+* the transfer is queued, wait() blocks until the results of the slot are in its output buffer.
+*/
+template<class in_T, class out_T>
+class axi_transport {
+  public:
+    virtual ~axi_transport() {}
+
+    virtual unsigned n_slots() const = 0;
+    virtual unsigned batch_size() const = 0;
+
+    virtual in_T *input_buffer(unsigned slot) = 0;
+    virtual out_T *output_buffer(unsigned slot) = 0;
+
+    virtual void start(unsigned slot, unsigned n_events) = 0;
+    virtual void wait(unsigned slot) = 0;
+};
+
+struct axi_benchmark_result {
+    size_t n_events;
+    double seconds;
+    double events_per_second;
+    // Time from the start of the transfer of a batch to its results, in microseconds
+    double latency_mean;
+    double latency_p50;
+    double latency_p99;
+    double latency_max;
+};
+
+/*
+* Runs the events through a transport batch by batch, with all the slots of the transport in flight: while the
+* accelerator works on batch k, the results of batch k - n_slots are decoded and batch k + 1 is encoded and queued.
+* Two slots give double buffering, three triple buffering.
+*/
+template<class in_codec, class out_codec>
+class axi_runtime {
+  public:
+    typedef typename in_codec::word_t in_T;
+    typedef typename out_codec::word_t out_T;
+    typedef std::chrono::steady_clock clock;
+
+    // n_in_words and n_out_words are the words per event in the buffers of the transport, see encode_events()
+    axi_runtime(axi_transport<in_T, out_T> &transport, unsigned n_in, unsigned n_out, unsigned n_in_words,
+                unsigned n_out_words)
+        : _transport(transport), _n_in(n_in), _n_out(n_out), _n_in_words(n_in_words), _n_out_words(n_out_words),
+          _first(transport.n_slots()), _count(transport.n_slots()), _start(transport.n_slots()) {}
+
+    template<class T>
+    void predict(const T *x, T *y, size_t n_events) {
+        const unsigned n_slots = _transport.n_slots();
+        const unsigned batch_size = _transport.batch_size();
+        const size_t n_batches = (n_events + batch_size - 1) / batch_size;
+
+        for (size_t b = 0; b < n_batches; b++) {
+            const unsigned slot = b % n_slots;
+            if (b >= n_slots) finish(slot, y);
+            _first[slot] = b * batch_size;
+            _count[slot] = (unsigned) std::min<size_t>(batch_size, n_events - _first[slot]);
+            encode_events<in_codec>(x + _first[slot] * _n_in, _transport.input_buffer(slot), _count[slot], _n_in,
+                                    _n_in_words);
+            _start[slot] = clock::now();
+            _transport.start(slot, _count[slot]);
+        }
+        for (size_t b = n_batches > n_slots ? n_batches - n_slots : 0; b < n_batches; b++) {
+            finish(b % n_slots, y);
+        }
+    }
+
+    // Latencies of the batches processed since the last call
+    std::vector<double> take_latencies() {
+        std::vector<double> latencies;
+        latencies.swap(_latencies);
+        return latencies;
+    }
+
+    // Throughput and latency over n_events random inputs in [-1, 1)
+    axi_benchmark_result benchmark(size_t n_events, unsigned seed = 0) {
+        std::vector<float> x(n_events * _n_in), y(n_events * _n_out);
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> dist(-1.f, 1.f);
+        for (size_t i = 0; i < x.size(); i++) x[i] = dist(gen);
+
+        take_latencies();
+        clock::time_point begin = clock::now();
+        predict(x.data(), y.data(), n_events);
+        clock::time_point end = clock::now();
+
+        std::vector<double> latencies = take_latencies();
+        std::sort(latencies.begin(), latencies.end());
+        axi_benchmark_result result;
+        result.n_events = n_events;
+        result.seconds = std::chrono::duration<double>(end - begin).count();
+        result.events_per_second = n_events / result.seconds;
+        result.latency_mean = 0;
+        for (size_t i = 0; i < latencies.size(); i++) result.latency_mean += latencies[i] / latencies.size();
+        result.latency_p50 = latencies.empty() ? 0 : latencies[latencies.size() / 2];
+        result.latency_p99 = latencies.empty() ? 0 : latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+        result.latency_max = latencies.empty() ? 0 : latencies.back();
+        return result;
+    }
+
+  private:
+    template<class T>
+    void finish(unsigned slot, T *y) {
+        _transport.wait(slot);
+        _latencies.push_back(std::chrono::duration<double, std::micro>(clock::now() - _start[slot]).count());
+        decode_events<out_codec>(_transport.output_buffer(slot), y + _first[slot] * _n_out, _count[slot], _n_out,
+                                 _n_out_words);
+    }
+
+    axi_transport<in_T, out_T> &_transport;
+    const unsigned _n_in, _n_out, _n_in_words, _n_out_words;
+    std::vector<size_t> _first;
+    std::vector<unsigned> _count;
+    std::vector<clock::time_point> _start;
+    std::vector<double> _latencies;
+};
+
+}
+
+#endif
@@ -0,0 +1,135 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "host_runtime.h"
+#ifdef HLS4ML_CSIM
+#include "csim_transport.h"
+#else
+#include "axi_stream_driver.h"
+#endif
+
+//hls-fpga-machine-learning insert definitions
+
+/*
+* Host program of the accelerator. Runs the events of the input file and writes the results, or with --benchmark
+* measures the throughput and the latency of the batches on random inputs. Built against the C simulation library
+* (-DHLS4ML_CSIM) it runs without the board, with the same buffering as on the hardware.
+*/
+
+static void usage(const char *name) {
+    std::cout << "Usage: " << name << " [options]\n"
+              << "  --input FILE      events to process, one per line (default tb_data/tb_input_features.dat)\n"
+              << "  --output FILE     results, one event per line (default tb_data/host_results.log)\n"
+              << "  --benchmark N     process N random events and report the throughput and the latency\n"
+              << "  --batch B         events per transfer (default 64)\n"
+              << "  --slots K         buffers in flight, 2 for double buffering, 3 for triple (default 2)\n"
+#ifdef HLS4ML_CSIM
+              << "  --library FILE    C simulation library (default DEFAULT_LIBRARY)\n"
+#elif defined(HLS4ML_XRT)
+              << "  --xclbin FILE     FPGA binary (default DEFAULT_XCLBIN)\n"
+#endif
+              ;
+}
+
+static bool read_events(const std::string &path, std::vector<float> &data, unsigned size, size_t &n_events) {
+    std::ifstream fin(path);
+    if (!fin.is_open()) return false;
+    std::string line;
+    n_events = 0;
+    while (std::getline(fin, line)) {
+        std::istringstream values(line);
+        float value;
+        unsigned n = 0;
+        while (values >> value) {
+            data.push_back(value);
+            n++;
+        }
+        if (n == 0) continue;
+        if (n != size) {
+            std::cerr << "Event " << n_events << " of " << path << " has " << n << " values instead of " << size << std::endl;
+            return false;
+        }
+        n_events++;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    std::string input = "tb_data/tb_input_features.dat";
+    std::string output = "tb_data/host_results.log";
+    std::string library = "DEFAULT_LIBRARY";
+    std::string xclbin = "DEFAULT_XCLBIN";
+    size_t benchmark = 0;
+    unsigned batch = 64, slots = 2;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h" || i + 1 >= argc) {
+            usage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "--input") input = value;
+        else if (arg == "--output") output = value;
+        else if (arg == "--benchmark") benchmark = std::strtoul(value.c_str(), NULL, 10);
+        else if (arg == "--batch") batch = std::strtoul(value.c_str(), NULL, 10);
+        else if (arg == "--slots") slots = std::strtoul(value.c_str(), NULL, 10);
+        else if (arg == "--library") library = value;
+        else if (arg == "--xclbin") xclbin = value;
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (batch == 0 || slots == 0) {
+        std::cerr << "The batch size and the number of slots must be positive" << std::endl;
+        return 1;
+    }
+
+#ifdef HLS4ML_CSIM
+    nnet::csim_transport<in_codec_t, out_codec_t> transport(library, "myproject", N_IN, N_OUT, N_IN_WORDS, N_OUT_WORDS,
+                                                            slots, batch);
+#elif defined(HLS4ML_XRT)
+    nnet::accelerator_transport<in_word_t, out_word_t> transport(xclbin, N_IN_WORDS, N_OUT_WORDS, slots, batch,
+                                                                 PACK_IN, PACK_OUT);
+#else
+    nnet::accelerator_transport<in_word_t, out_word_t> transport(N_IN_WORDS, N_OUT_WORDS, slots, batch);
+#endif
+    nnet::axi_runtime<in_codec_t, out_codec_t> runtime(transport, N_IN, N_OUT, N_IN_WORDS, N_OUT_WORDS);
+
+    if (benchmark > 0) {
+        nnet::axi_benchmark_result result = runtime.benchmark(benchmark);
+        std::cout << "Processed " << result.n_events << " events in " << result.seconds << " s ("
+                  << result.events_per_second << " events/s), batch " << batch << ", " << slots << " slots" << std::endl;
+        std::cout << "Batch latency (us): mean " << result.latency_mean << ", p50 " << result.latency_p50
+                  << ", p99 " << result.latency_p99 << ", max " << result.latency_max << std::endl;
+        return 0;
+    }
+
+    std::vector<float> x;
+    size_t n_events = 0;
+    if (!read_events(input, x, N_IN, n_events)) {
+        std::cerr << "Cannot read the events from " << input << std::endl;
+        return 1;
+    }
+    std::vector<float> y(n_events * N_OUT);
+    runtime.predict(x.data(), y.data(), n_events);
+
+    std::ofstream fout(output);
+    fout.precision(std::numeric_limits<float>::max_digits10);
+    for (size_t e = 0; e < n_events; e++) {
+        for (unsigned i = 0; i < N_OUT; i++) {
+            fout << y[e * N_OUT + i] << " ";
+        }
+        fout << std::endl;
+    }
+    std::cout << "Processed " << n_events << " events, results in " << output << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+//hls-fpga-machine-learning insert include
+
+// Unpacks the beats of the input stream into events, until the beat with TLAST. The event is shifted in PACK_IN values
+// at a time so that every beat goes to the same registers, one beat per clock cycle across the events of the batch.
+static void read_events(
+    hls::stream<input_axi_t> &in,
+    hls::stream<input_event_t> &in_events,
+    hls::stream<bool> &in_last
+) {
+    input_event_t event;
+    #pragma HLS DATA_PACK variable=event
+    unsigned beat = 0;
+    bool last = false;
+
+    ReadBeats: do {
+        #pragma HLS PIPELINE
+        input_axi_t word = in.read();
+        last = word.last;
+        ShiftIn: for (unsigned i = 0; i < N_IN_BEATS * PACK_IN - PACK_IN; i++) {
+            #pragma HLS UNROLL
+            event[i] = event[i + PACK_IN];
+        }
+        Unpack: for (unsigned j = 0; j < PACK_IN; j++) {
+            #pragma HLS UNROLL
+            event[N_IN_BEATS * PACK_IN - PACK_IN + j] = unpack_input(word, j);
+        }
+        if (++beat == N_IN_BEATS || last) {
+            in_events.write(event);
+            in_last.write(last);
+            beat = 0;
+        }
+    } while (!last);
+}
+
+// Runs the events through the network. With io_parallel the loop is pipelined, a new event enters the network at its
+// initiation interval. With io_stream the network is a dataflow region of its own, called once per event
+static void run_events(
+    hls::stream<input_event_t> &in_events,
+    hls::stream<bool> &in_last,
+    hls::stream<output_event_t> &out_events,
+    hls::stream<bool> &out_last
+) {
+    bool last = false;
+
+    RunEvents: do {
+        //hls-fpga-machine-learning insert pipeline
+        input_event_t in_event = in_events.read();
+        last = in_last.read();
+        output_event_t out_event;
+        #pragma HLS DATA_PACK variable=out_event
+
+        //hls-fpga-machine-learning insert local vars
+
+        //hls-fpga-machine-learning insert enqueue
+
+        //hls-fpga-machine-learning insert call
+
+        //hls-fpga-machine-learning insert dequeue
+
+        out_events.write(out_event);
+        out_last.write(last);
+    } while (!last);
+}
+
+// Packs the results into the beats of the output stream, with TLAST on the last beat of the last event of the batch
+static void write_events(
+    hls::stream<output_event_t> &out_events,
+    hls::stream<bool> &out_last,
+    hls::stream<output_axi_t> &out
+) {
+    output_event_t event;
+    #pragma HLS DATA_PACK variable=event
+    unsigned beat = 0;
+    bool last = false;
+
+    WriteBeats: do {
+        #pragma HLS PIPELINE
+        if (beat == 0) {
+            event = out_events.read();
+            last = out_last.read();
+        }
+        output_axi_t word;
+        Pack: for (unsigned j = 0; j < PACK_OUT; j++) {
+            #pragma HLS UNROLL
+            pack_output(word, j, event[j]);
+        }
+        ShiftOut: for (unsigned i = 0; i < N_OUT_BEATS * PACK_OUT - PACK_OUT; i++) {
+            #pragma HLS UNROLL
+            event[i] = event[i + PACK_OUT];
+        }
+        word.last = last && beat == N_OUT_BEATS - 1;
+        out.write(word);
+        if (++beat == N_OUT_BEATS) beat = 0;
+    } while (!last || beat != 0);
+}
+
+void myproject_axi(
+    hls::stream<input_axi_t> &in,
+    hls::stream<output_axi_t> &out
+) {
+
+    //hls-fpga-machine-learning insert interface
+
+    hls::stream<input_event_t> in_events("in_events");
+    hls::stream<bool> in_last("in_last");
+    hls::stream<output_event_t> out_events("out_events");
+    hls::stream<bool> out_last("out_last");
+
+    read_events(in, in_events, in_last);
+    run_events(in_events, in_last, out_events, out_last);
+    write_events(out_events, out_last, out);
+}
@@ -0,0 +1,49 @@
+#ifndef MYPROJECT_AXI_H_
+#define MYPROJECT_AXI_H_
+
+#include <iostream>
+//hls-fpga-machine-learning insert include
+
+//hls-fpga-machine-learning insert definitions
+
+// Events of the batch as they are passed between the processes of the wrapper, padded to a whole number of beats
+typedef nnet::array<T_in, N_IN_BEATS * PACK_IN> input_event_t;
+typedef nnet::array<T_out, N_OUT_BEATS * PACK_OUT> output_event_t;
+
+void myproject_axi(
+    hls::stream<input_axi_t> &in,
+    hls::stream<output_axi_t> &out
+        );
+
+// Runs n_events events through the accelerator in one transfer, with TLAST on the last beat as the DMA sends it
+template<class data_T, class res_T>
+void myproject_axi_events(const data_T *x, res_T *y, unsigned n_events) {
+    hls::stream<input_axi_t> in("in");
+    hls::stream<output_axi_t> out("out");
+
+    for (unsigned e = 0; e < n_events; e++) {
+        for (unsigned b = 0; b < N_IN_BEATS; b++) {
+            input_axi_t beat;
+            for (unsigned j = 0; j < PACK_IN; j++) {
+                unsigned i = b * PACK_IN + j;
+                pack_input(beat, j, i < N_IN ? T_in(x[e * N_IN + i]) : T_in(0));
+            }
+            beat.last = (e == n_events - 1 && b == N_IN_BEATS - 1);
+            in.write(beat);
+        }
+    }
+
+    myproject_axi(in, out);
+
+    for (unsigned e = 0; e < n_events; e++) {
+        for (unsigned b = 0; b < N_OUT_BEATS; b++) {
+            output_axi_t beat = out.read();
+            for (unsigned j = 0; j < PACK_OUT; j++) {
+                unsigned i = b * PACK_OUT + j;
+                if (i < N_OUT) y[e * N_OUT + i] = res_T(unpack_output(beat, j));
+            }
+        }
+    }
+}
+
+#endif
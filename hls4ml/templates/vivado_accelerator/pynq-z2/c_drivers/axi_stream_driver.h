@@ -0,0 +1,93 @@
+#ifndef AXI_STREAM_DRIVER_H_
+#define AXI_STREAM_DRIVER_H_
+
+/*
+* Transport for the AXI DMA of the Zynq designs (design.tcl), for bare-metal applications built with the standalone
+* BSP in Vitis. The DMA runs in simple mode, one transfer per direction at a time: the slots are queued and the next
+* one starts as soon as the DMA is done with the current one, while the host encodes and decodes the others.
+*/
+
+#include "host_runtime.h"
+
+#include <deque>
+
+#include "xaxidma.h"
+#include "xil_cache.h"
+#include "xparameters.h"
+
+namespace nnet {
+
+template<class in_T, class out_T>
+class accelerator_transport : public axi_transport<in_T, out_T> {
+  public:
+    accelerator_transport(unsigned n_in, unsigned n_out, unsigned n_slots, unsigned batch_size,
+                          unsigned device_id = XPAR_AXIDMA_0_DEVICE_ID)
+        : _n_in(n_in), _n_out(n_out), _n_slots(n_slots), _batch_size(batch_size),
+          _inputs(n_slots), _outputs(n_slots), _events(n_slots, 0), _active(-1)
+    {
+        XAxiDma_Config *config = XAxiDma_LookupConfig(device_id);
+        if (config == NULL || XAxiDma_CfgInitialize(&_dma, config) != XST_SUCCESS) {
+            throw std::runtime_error("Cannot initialize the AXI DMA");
+        }
+        XAxiDma_IntrDisable(&_dma, XAXIDMA_IRQ_ALL_MASK, XAXIDMA_DEVICE_TO_DMA);
+        XAxiDma_IntrDisable(&_dma, XAXIDMA_IRQ_ALL_MASK, XAXIDMA_DMA_TO_DEVICE);
+        for (unsigned s = 0; s < n_slots; s++) {
+            _inputs[s].resize((size_t) batch_size * n_in);
+            _outputs[s].resize((size_t) batch_size * n_out);
+        }
+    }
+
+    unsigned n_slots() const { return _n_slots; }
+    unsigned batch_size() const { return _batch_size; }
+
+    in_T *input_buffer(unsigned slot) { return _inputs[slot].data(); }
+    out_T *output_buffer(unsigned slot) { return _outputs[slot].data(); }
+
+    void start(unsigned slot, unsigned n_events) {
+        _events[slot] = n_events;
+        _queue.push_back(slot);
+        poll();
+    }
+
+    void wait(unsigned slot) {
+        while (_active == (int) slot || std::find(_queue.begin(), _queue.end(), slot) != _queue.end()) {
+            poll();
+        }
+    }
+
+  private:
+    void poll() {
+        if (_active >= 0) {
+            if (XAxiDma_Busy(&_dma, XAXIDMA_DMA_TO_DEVICE) || XAxiDma_Busy(&_dma, XAXIDMA_DEVICE_TO_DMA)) return;
+            Xil_DCacheInvalidateRange((UINTPTR) _outputs[_active].data(), out_bytes(_active));
+            _active = -1;
+        }
+        if (_queue.empty()) return;
+
+        const unsigned slot = _queue.front();
+        _queue.pop_front();
+        Xil_DCacheFlushRange((UINTPTR) _inputs[slot].data(), in_bytes(slot));
+        Xil_DCacheInvalidateRange((UINTPTR) _outputs[slot].data(), out_bytes(slot));
+        // The receive channel is armed first so that the stream of results never stalls the core
+        if (XAxiDma_SimpleTransfer(&_dma, (UINTPTR) _outputs[slot].data(), out_bytes(slot), XAXIDMA_DEVICE_TO_DMA) != XST_SUCCESS ||
+            XAxiDma_SimpleTransfer(&_dma, (UINTPTR) _inputs[slot].data(), in_bytes(slot), XAXIDMA_DMA_TO_DEVICE) != XST_SUCCESS) {
+            throw std::runtime_error("Cannot start the AXI DMA transfer");
+        }
+        _active = slot;
+    }
+
+    u32 in_bytes(unsigned slot) const { return _events[slot] * _n_in * sizeof(in_T); }
+    u32 out_bytes(unsigned slot) const { return _events[slot] * _n_out * sizeof(out_T); }
+
+    const unsigned _n_in, _n_out, _n_slots, _batch_size;
+    XAxiDma _dma;
+    std::vector<std::vector<in_T>> _inputs;
+    std::vector<std::vector<out_T>> _outputs;
+    std::vector<unsigned> _events;
+    std::deque<unsigned> _queue;
+    int _active;
+};
+
+}
+
+#endif
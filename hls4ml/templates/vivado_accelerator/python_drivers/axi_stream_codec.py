@@ -0,0 +1,36 @@
+# Conversion of the events to and from the words of the AXI streams, shared by the Python drivers of all boards.
+# The writer inserts it in the driver after the definitions of the streams.
+
+import numpy as np
+
+
+def encode_events(X, n_values, pack, fixed):
+    """
+    Convert the events to the words of the input stream, as the accelerator expects them in memory.
+    Parameters:
+    - X : the events, n_values values each.
+    - n_values, pack : the values per event and per beat of the stream. Each event takes a whole number of beats,
+                       the words of its last beat past its values are zero.
+    - fixed : None for a floating point interface, or the (dtype, fractional bits, rounding, saturation) of the
+              ap_fixed words, which hold the raw two's complement value.
+    """
+    X = np.asarray(X).reshape(-1, n_values)
+    if fixed is not None:
+        dtype, fractional, rounding, saturation = fixed
+        raw = np.floor(X * 2.0 ** fractional + (0.5 if rounding else 0.0))
+        if saturation:
+            raw = np.clip(raw, np.iinfo(dtype).min, np.iinfo(dtype).max)
+        X = raw.astype(np.int64).astype(dtype)  # wraps around as AP_WRAP
+    words = np.zeros((X.shape[0], -(-n_values // pack) * pack), dtype=X.dtype)
+    words[:, :n_values] = X
+    return words
+
+
+def decode_events(words, n_values, fixed):
+    """
+    Convert the words of the output stream, see encode_events(), to the values of the events.
+    """
+    y = words[:, :n_values]
+    if fixed is not None:
+        y = y * 2.0 ** -fixed[1]
+    return y
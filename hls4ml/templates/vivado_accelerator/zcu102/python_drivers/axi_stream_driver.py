@@ -4,15 +4,22 @@ from datetime import datetime
 import pynq.lib.dma
 import numpy as np
 
+#hls-fpga-machine-learning insert definitions
+
 
 class NeuralNetworkOverlay(Overlay):
-    def __init__(self, bitfile_name, x_shape, y_shape, dtype=np.float32, dtbo=None, download=True, ignore_version=False,
+    def __init__(self, bitfile_name, x_shape, y_shape, dtype=None, dtbo=None, download=True, ignore_version=False,
                  device=None):
         super().__init__(bitfile_name, dtbo=None, download=True, ignore_version=False, device=None)
         self.sendchannel = self.hier_0.axi_dma_0.sendchannel
         self.recvchannel = self.hier_0.axi_dma_0.recvchannel
-        self.input_buffer = allocate(shape=x_shape, dtype=dtype)
-        self.output_buffer = allocate(shape=y_shape, dtype=dtype)
+        # The buffers hold the words of the streams, the events are padded to whole beats
+        n_events = int(np.prod(x_shape)) // N_IN
+        in_dtype = dtype if dtype is not None else (np.float32 if FIXED_IN is None else FIXED_IN[0])
+        out_dtype = dtype if dtype is not None else (np.float32 if FIXED_OUT is None else FIXED_OUT[0])
+        self.input_buffer = allocate(shape=(n_events, -(-N_IN // PACK_IN) * PACK_IN), dtype=in_dtype)
+        self.output_buffer = allocate(shape=(n_events, -(-N_OUT // PACK_OUT) * PACK_OUT), dtype=out_dtype)
+        self.y_shape = y_shape
 
     def _print_dt(self, timea, timeb, N):
         dt = (timeb - timea)
@@ -43,6 +50,8 @@ class NeuralNetworkOverlay(Overlay):
                     encode_v = np.vectorize(encode) # to apply them element-wise
                     decode_v = np.vectorize(decode)
                   ```
+                  By default the dtype is the one of the interface, and the values are encoded and decoded by
+                  encode_events()/decode_events(), which also pack several values per beat of the stream.
         - profile : boolean. Set it to `True` to print the performance of the algorithm in term of `inference/s`.
         - encode/decode: function pointers. See `dtype` section for more information.
         - return: an output array based on `np.ndarray` with a shape equal to `y_shape` and a `dtype` equal to
@@ -51,8 +60,9 @@ class NeuralNetworkOverlay(Overlay):
         if profile:
             timea = datetime.now()
         if encode is not None:
-            X = encode(X)
-        self.input_buffer[:] = X
+            self.input_buffer[:] = encode_events(encode(X), N_IN, PACK_IN, None)
+        else:
+            self.input_buffer[:] = encode_events(X, N_IN, PACK_IN, FIXED_IN)
         self.sendchannel.transfer(self.input_buffer)
         self.recvchannel.transfer(self.output_buffer)
         if debug:
@@ -63,13 +73,15 @@ class NeuralNetworkOverlay(Overlay):
         self.recvchannel.wait()
         if debug:
             print("Receive OK")
-        # result = self.output_buffer.copy()
         if decode is not None:
-            self.output_buffer = decode(self.output_buffer)
+            result = decode(decode_events(self.output_buffer, N_OUT, None))
+        else:
+            result = decode_events(self.output_buffer, N_OUT, FIXED_OUT)
+        result = np.array(result).reshape(self.y_shape)
 
         if profile:
             timeb = datetime.now()
             dts, rate = self._print_dt(timea, timeb, len(X))
-            return self.output_buffer, dts, rate
+            return result, dts, rate
         else:
-            return self.output_buffer
\ No newline at end of file
+            return result
@@ -3,3 +3,4 @@ from __future__ import absolute_import
 from hls4ml.utils.config import config_from_keras_model, config_from_pytorch_model, config_from_onnx_model
 from hls4ml.utils.plot import plot_model
 from hls4ml.utils.example_models import fetch_example_model, fetch_example_list
+from hls4ml.utils.precision_tuner import tune_precision
@@ -102,20 +102,21 @@ def config_from_keras_model(model, granularity='model', default_precision='ap_fi
     #Define supported layers
     core_layers = ['InputLayer', 'Dropout', 'Flatten', 'Reshape', 'Permute', 'Embedding']
     dense_layers = ['Dense', 'BinaryDense', 'TernaryDense']
-    conv_layers = ['Conv1D', 'Conv2D', 'BinaryConv2D', 'SeparableConv2D']
+    conv_layers = ['Conv1D', 'Conv2D', 'BinaryConv2D', 'SeparableConv2D', 'Conv1DTranspose', 'Conv2DTranspose']
     pooling_layers = ['MaxPooling1D', 'MaxPooling2D', 'GlobalMaxPooling1D', 'GlobalMaxPooling2D', 'AveragePooling1D', 'AveragePooling2D', 'GlobalAveragePooling1D', 'GlobalAveragePooling2D']
-    norm_layers = ['BatchNormalization']
+    norm_layers = ['BatchNormalization', 'LayerNormalization']
     activation_layers = ['Activation', 'LeakyReLU', 'ThresholdedReLU', 'ELU', 'PReLU', 'Softmax', 'ReLU']
     merge_layers = ['Add', 'Subtract', 'Multiply', 'Average', 'Maximum', 'Minimum', 'Concatenate', 'Dot']
     qkeras_layers = ['QDense', 'QActivation', 'QConv1D', 'QConv2D', 'QBatchNormalization', 'QConv2DBatchnorm']
-    upsampling_layers = ['UpSampling1D', 'UpSampling2D']
+    upsampling_layers = ['UpSampling1D', 'UpSampling2D', 'Resizing']
     reshaping_layers = ['ZeroPadding1D', 'ZeroPadding2D']
     graph_layers = ['GarNet', 'GarNetStack']
     rnn_layers = ['SimpleRNN', 'LSTM', 'GRU']
+    attention_layers = ['MultiHeadAttention']
     #Define layers to skip because they're not configurable or not converted to HLS
     skip_layers = ['Dropout', 'Flatten', 'Reshape', 'Permute']
     #All supported layers
-    supported_layers = core_layers + dense_layers + conv_layers + pooling_layers + norm_layers + activation_layers + merge_layers + qkeras_layers + upsampling_layers + reshaping_layers + graph_layers + rnn_layers + skip_layers
+    supported_layers = core_layers + dense_layers + conv_layers + pooling_layers + norm_layers + activation_layers + merge_layers + qkeras_layers + upsampling_layers + reshaping_layers + graph_layers + rnn_layers + attention_layers + skip_layers
 
     keras_layer_config = None
     if model_arch['class_name'] == 'Sequential':
@@ -223,6 +224,12 @@ def config_from_keras_model(model, granularity='model', default_precision='ap_fi
             layer_config['Precision']['bias'] = default_precision
             layer_config['ReuseFactor'] = default_reuse_factor
         
+        elif layer['class_name'] in attention_layers:
+            layer_config['Precision'] = {}
+            layer_config['Precision']['result'] = default_precision
+            layer_config['ReuseFactor'] = default_reuse_factor
+            layer_config['table_size'] = 1024
+
         elif layer['class_name'] in qkeras_layers:
             if 'precision' in layer:
                 layer_config['Precision'] = {}
@@ -0,0 +1,192 @@
+from __future__ import print_function
+import copy
+import math
+import numpy as np
+
+# Precision used while tracing the ranges of the layer outputs, wide enough to not saturate
+_trace_precision = 'ap_fixed<64,32>'
+
+def _integer_bits(values):
+    values = np.asarray(values)
+    if values.size == 0:
+        return 1, True
+    signed = bool(np.min(values) < 0)
+    max_abs = float(np.max(np.abs(values)))
+    if max_abs == 0:
+        return 1, signed
+    integer = int(math.floor(math.log2(max_abs))) + 1 + int(signed)
+    return max(integer, 1), signed
+
+def _precision_string(integer, fractional, signed):
+    width = max(integer + fractional, 1)
+    return 'ap_{}fixed<{},{}>'.format('' if signed else 'u', width, integer)
+
+def _mult_count(layer):
+    weight = layer.weights.get('weight')
+    if weight is None:
+        return 0
+    return int(weight.data.size)
+
+def tune_precision(hls_model, X, y, metric, min_score, max_fractional_bits=16, max_evaluations=50, output_dir=None):
+    """Tunes the fixed-point precision of the inputs, weights, accumulators and outputs of every layer.
+
+    The integer bits of each variable are derived from its range: the weights are taken from the model, the layer
+    outputs are traced with a wide precision on the data `X`. All variables start with `max_fractional_bits`
+    fractional bits, which are first narrowed uniformly and then for each variable separately, starting from the
+    ones that contribute the most to the size of the multipliers. Each candidate configuration is compiled and
+    evaluated with the bit-accurate `predict()` on `X`, and it is accepted if `metric(y, y_pred)` is at least
+    `min_score`.
+
+    Args:
+        hls_model (ModelGraph): The model to tune, converted from a Keras, PyTorch or ONNX model.
+        X (ndarray): Data used to trace the ranges of the outputs and to evaluate the metric.
+        y (ndarray): Reference output (e.g. the true labels or the output of the floating point model), passed to
+            `metric`.
+        metric (callable): Function `metric(y, y_pred)` returning a score, higher is better.
+        min_score (float): Minimum score a configuration has to achieve.
+        max_fractional_bits (int, optional): Number of fractional bits to start from. Defaults to 16.
+        max_evaluations (int, optional): Maximum number of configurations to compile and evaluate. Defaults to 50.
+        output_dir (str, optional): Directory in which the candidate configurations are compiled. Defaults to the
+            output directory of `hls_model` with the '_precision_tuning' suffix.
+
+    Returns:
+        dict: A copy of the 'HLSConfig' of the model with the tuned 'Precision' of each layer under 'LayerName'.
+    """
+    from hls4ml.converters import convert_from_config
+
+    if output_dir is None:
+        output_dir = hls_model.config.get_output_dir() + '_precision_tuning'
+    if isinstance(X, list):
+        X = [np.ascontiguousarray(x) for x in X]
+        input_data = X
+    else:
+        X = np.ascontiguousarray(X)
+        input_data = [X]
+
+    def convert(hls_config):
+        new_config = hls_model.config.config.copy()
+        new_config['HLSConfig'] = hls_config
+        new_config['OutputDir'] = output_dir
+        return convert_from_config(new_config)
+
+    # Trace the outputs of all layers without the precision of the current configuration
+    trace_config = copy.deepcopy(hls_model.config.config['HLSConfig'])
+    trace_config.setdefault('Model', {})['Precision'] = _trace_precision
+    for layer_cfg in trace_config.get('LayerType', {}).values():
+        layer_cfg.pop('Precision', None)
+    for layer_cfg in trace_config.setdefault('LayerName', {}).values():
+        layer_cfg.pop('Precision', None)
+    for layer in hls_model.get_layers():
+        trace_config['LayerName'].setdefault(layer.name, {})['Trace'] = True
+    trace_model = convert(trace_config)
+    _, trace_output = trace_model.trace(X)
+
+    # Variables to tune, as (layer name, variable) -> (integer bits, signed)
+    variables = {}
+    sensitivity = {}
+    layers = list(trace_model.get_layers())
+    for layer in layers:
+        if layer.name in trace_model.inputs:
+            ranges = input_data[trace_model.inputs.index(layer.name)]
+        elif layer.name in trace_output:
+            ranges = trace_output[layer.name]
+        else:
+            continue
+        variables[(layer.name, 'result')] = _integer_bits(ranges)
+        if 'weight' in layer.weights:
+            integer, signed = _integer_bits(ranges)
+            # Partial sums may exceed the range of the final sum
+            variables[(layer.name, 'accum')] = (integer + 1, True)
+        for w_name, weight in layer.weights.items():
+            variables[(layer.name, w_name)] = _integer_bits(weight.data)
+
+    # Prefer narrowing the variables that are inputs to large multiplier arrays
+    for layer in layers:
+        if (layer.name, 'result') not in variables:
+            continue
+        consumers = [node for node in layers if layer.outputs[0] in node.inputs]
+        mults = sum(_mult_count(node) for node in consumers)
+        sensitivity[(layer.name, 'result')] = mults if mults > 0 else int(np.prod(layer.get_output_variable().shape))
+        if (layer.name, 'accum') in variables:
+            sensitivity[(layer.name, 'accum')] = int(np.prod(layer.get_output_variable().shape))
+        for w_name, weight in layer.weights.items():
+            sensitivity[(layer.name, w_name)] = _mult_count(layer) if w_name == 'weight' else int(weight.data.size)
+
+    def width(layer_name, var, fractional):
+        integer, _ = variables[(layer_name, var)]
+        return max(integer + fractional[(layer_name, var)], 1)
+
+    # Estimate of the LUT and DSP cost of the multipliers
+    def multiplier_bits(fractional):
+        total = 0
+        for layer in layers:
+            if (layer.name, 'weight') not in variables:
+                continue
+            input_node = layer.get_input_node()
+            if input_node is None or (input_node.name, 'result') not in variables:
+                continue
+            total += _mult_count(layer) * width(layer.name, 'weight', fractional) * width(input_node.name, 'result', fractional)
+        return total
+
+    def make_config(fractional):
+        hls_config = copy.deepcopy(hls_model.config.config['HLSConfig'])
+        layer_name_cfg = hls_config.setdefault('LayerName', {})
+        for (layer_name, var), (integer, signed) in variables.items():
+            layer_cfg = layer_name_cfg.setdefault(layer_name, {})
+            precision_cfg = layer_cfg.get('Precision')
+            if not isinstance(precision_cfg, dict):
+                layer_cfg['Precision'] = {} if precision_cfg is None else {'default': precision_cfg}
+            layer_cfg['Precision'][var] = _precision_string(integer, fractional[(layer_name, var)], signed)
+        return hls_config
+
+    scores = {}
+    def evaluate(fractional):
+        key = tuple(sorted(fractional.items()))
+        if key not in scores:
+            if len(scores) >= max_evaluations:
+                return None
+            model = convert(make_config(fractional))
+            model.compile()
+            y_pred = model.predict(X)
+            if isinstance(y, np.ndarray) and isinstance(y_pred, np.ndarray) and y_pred.size == y.size:
+                y_pred = y_pred.reshape(y.shape)
+            scores[key] = metric(y, y_pred)
+            print('Precision tuning: evaluation {}, score {:.6g}'.format(len(scores), scores[key]))
+        return scores[key]
+
+    def passes(fractional):
+        score = evaluate(fractional)
+        return score is not None and score >= min_score
+
+    fractional = {var: max_fractional_bits for var in variables.keys()}
+    if not passes(fractional):
+        print('WARNING: The score with {} fractional bits is below {}, not narrowing the precision.'.format(max_fractional_bits, min_score))
+        return make_config(fractional)
+
+    # Find the smallest uniform number of fractional bits first, then narrow each variable with the others fixed
+    def narrow(apply, high):
+        low = 0
+        while low < high:
+            mid = (low + high) // 2
+            if passes(apply(mid)):
+                high = mid
+            else:
+                low = mid + 1
+        return high
+
+    uniform = narrow(lambda bits: {var: min(f, bits) for var, f in fractional.items()}, max_fractional_bits)
+    fractional = {var: min(f, uniform) for var, f in fractional.items()}
+
+    for var in sorted(variables.keys(), key=lambda v: sensitivity.get(v, 0), reverse=True):
+        if len(scores) >= max_evaluations:
+            break
+        def apply(bits, var=var):
+            candidate = dict(fractional)
+            candidate[var] = bits
+            return candidate
+        fractional[var] = narrow(apply, fractional[var])
+
+    print('Precision tuning: {} evaluations, multiplier size reduced from {} to {} bit products'.format(
+        len(scores), multiplier_bits({var: max_fractional_bits for var in variables.keys()}), multiplier_bits(fractional)))
+
+    return make_config(fractional)
@@ -28,6 +28,25 @@ class QuartusWriter(Writer):
                 max_rf = rf
         return max_rf
 
+    def get_cpragmas(self, model):
+        cpragmas = 'hls_max_concurrency(0)\n'
+        if model.config.get_config_value('IOType') != 'io_stream':
+            # In io_stream the reuse factor sets the interval of the loops of the tasks, not of the component
+            cpragmas += 'hls_component_ii({})\n'.format(self.get_max_reuse_factor(model))
+        clock_mhz = 1000 / (model.config.get_config_value('ClockPeriod'))
+        cpragmas += 'hls_scheduler_target_fmax_mhz({})\n'.format(int(np.ceil(clock_mhz)))
+        return cpragmas
+
+    def get_top_level_signature(self, model):
+        indent = '    '
+        if model.config.get_config_value('IOType') == 'io_stream':
+            # Streams can't be copied, the inputs and the outputs are passed by reference
+            ports = ['nnet::stream_in<{}> &{}_port'.format(inp.type.name, inp.name) for inp in model.get_input_variables()]
+            ports += ['nnet::stream_out<{}> &{}_port'.format(out.type.name, out.name) for out in model.get_output_variables()]
+            return 'void {}(\n{}\n)'.format(model.config.get_project_name(), ',\n'.join([indent + port for port in ports]))
+        else:
+            return 'output_data {}(\n{}input_data inputs\n)'.format(model.config.get_project_name(), indent)
+
     def print_array_to_cpp(self, var, layer, odir):
         #######################################
         ## Print weight array to C++
@@ -47,11 +66,21 @@ class QuartusWriter(Writer):
 
         rf = int(layer.get_attr('reuse_factor'))
         weight_header = '#ifdef __INTELFPGA_COMPILER__\n'
-        if (rf == 1 or var.name[0] == 'b' or layer.get_attr('n_in') * layer.get_attr('n_out') <= 2048
+        if layer.get_attr('table_impl') is not None:
+            # Embedding tables, every copy of the table is a dual-port memory
+            if layer.get_attr('table_impl') == 'mem_auto' and var.data_length <= 2048:
+                weight_header += 'hls_init_on_powerup\n'
+            else:
+                replicates = int(np.ceil(layer.get_attr('read_ports') / 2))
+                if layer.get_attr('table_impl') != 'mem_auto':
+                    weight_header += 'hls_memory_impl("{}")\n'.format('MLAB' if layer.get_attr('table_impl') == 'mem_lutram' else 'BLOCK_RAM')
+                weight_header += 'hls_max_replicates({})\n'.format(replicates)
+        elif (rf == 1 or var.name[0] == 'b' or var.data_length <= 2048 or layer.get_attr('strategy') == 'latency'
                 or (var.name[0] == 'w' and var.type.precision.width < 3)):
             weight_header += 'hls_init_on_powerup\n'
         else:
-            block_factor = (layer.get_attr('n_in') * layer.get_attr('n_out')) / rf
+            n_in, n_out = get_backend('Quartus').get_layer_mult_size(layer)
+            block_factor = (n_in * n_out) / rf
             nbanks = int(2 ** np.ceil(np.log2(block_factor)) / 2)
             var_width = int(np.ceil(var.type.precision.width / 8))
             bwidth = self.next_pow2(var_width)
@@ -86,6 +115,7 @@ class QuartusWriter(Writer):
 
         model_inputs = model.get_input_variables()
         model_outputs = model.get_output_variables()
+        io_type = model.config.get_config_value('IOType')
 
         indent = '    '
 
@@ -95,12 +125,8 @@ class QuartusWriter(Writer):
                 newline = line.replace('myproject', model.config.get_project_name())
 
             elif '//hls-fpga-machine-learning insert cpragmas' in line:
-
                 newline = line
-                newline += 'hls_max_concurrency(0)\n'
-                newline += 'hls_component_ii({})\n'.format(self.get_max_reuse_factor(model))
-                clock_mhz = 1000 / (model.config.get_config_value('ClockPeriod'))
-                newline += 'hls_scheduler_target_fmax_mhz({})\n'.format(np.ceil(clock_mhz).astype(np.int))
+                newline += self.get_cpragmas(model)
 
             elif '//hls-fpga-machine-learning insert weights' in line:
                 newline = line
@@ -114,21 +140,79 @@ class QuartusWriter(Writer):
                     for w in layer.get_weights():
                         newline += '#include "weights/{}_test.h"\n'.format(w.name)
 
-            elif '//hls-fpga-machine-learning insert layers' in line:
-                newline = line + '\n'
-                for layer in model.get_layers():
-                    vars = layer.get_variables()
-                    for var in vars:
-                        if var not in model_inputs and var not in model_outputs:
+            elif '//hls-fpga-machine-learning insert tasks' in line:
+                newline = ''
+                if io_type == 'io_stream':
+                    # The streams between the layers are global, each layer runs in its own task
+                    newline = line
+                    for layer in model.get_layers():
+                        for var in layer.get_variables():
                             def_cpp = var.definition_cpp()
                             if def_cpp is not None:
-                                newline += '    ' + def_cpp + ';\n'
-                    if layer.get_attr('activation') == 'tanh':  # TODO move this to an optimizer
-                        layer.set_attr('activation') == 'dense_tanh'
-                    func = layer.get_attr('function_cpp', None)
-                    if func:
-                        newline += '    ' + func + '\n'
-                        newline += '\n'
+                                newline += def_cpp + ';\n'
+                    newline += '\n'
+                    for layer in model.get_layers():
+                        func = layer.get_attr('function_cpp', None)
+                        if func:
+                            newline += 'void {}_task() {{\n'.format(layer.name)
+                            newline += indent + func + '\n'
+                            newline += '}\n\n'
+
+            elif '//hls-fpga-machine-learning insert top-level' in line:
+                newline = self.get_top_level_signature(model) + ' {\n'
+
+            elif '//hls-fpga-machine-learning insert component' in line:
+                newline = 'component ' + self.get_top_level_signature(model) + ' {\n'
+
+            elif '//hls-fpga-machine-learning insert outputs' in line:
+                newline = ''
+                if io_type != 'io_stream':
+                    newline += indent + 'hls_register output_data outputs;\n'
+
+            elif '//hls-fpga-machine-learning insert layers' in line:
+                newline = line + '\n'
+                if io_type == 'io_stream':
+                    tasks = [layer.name + '_task' for layer in model.get_layers() if layer.get_attr('function_cpp', None)]
+                    copy_in = ''
+                    for inp in model_inputs:
+                        copy_in += indent + 'nnet::copy_stream<{}, {}>({}_port, {});\n'.format(inp.type.name, inp.size_cpp(), inp.name, inp.name)
+                    copy_out = ''
+                    for out in model_outputs:
+                        copy_out += indent + 'nnet::copy_stream<{}, {}>({}, {}_port);\n'.format(out.type.name, out.size_cpp(), out.name, out.name)
+
+                    # C simulation runs the layers one after the other, in hardware the tasks run concurrently
+                    newline += '#ifndef __INTELFPGA_COMPILER__\n'
+                    newline += copy_in
+                    for task in tasks:
+                        newline += indent + task + '();\n'
+                    newline += copy_out
+                    newline += '#else\n'
+                    for task in tasks:
+                        newline += indent + 'ihc::launch<{}>();\n'.format(task)
+                    newline += copy_in
+                    newline += copy_out
+                    for task in tasks:
+                        newline += indent + 'ihc::collect<{}>();\n'.format(task)
+                    newline += '#endif\n'
+                else:
+                    for layer in model.get_layers():
+                        vars = layer.get_variables()
+                        for var in vars:
+                            if var not in model_inputs and var not in model_outputs:
+                                def_cpp = var.definition_cpp()
+                                if def_cpp is not None:
+                                    newline += '    ' + def_cpp + ';\n'
+                        if layer.get_attr('activation') == 'tanh':  # TODO move this to an optimizer
+                            layer.set_attr('activation') == 'dense_tanh'
+                        func = layer.get_attr('function_cpp', None)
+                        if func:
+                            newline += '    ' + func + '\n'
+                            newline += '\n'
+
+            elif '//hls-fpga-machine-learning insert return' in line:
+                newline = ''
+                if io_type != 'io_stream':
+                    newline += indent + 'return outputs;\n'
 
             # Just copy line
             else:
@@ -161,20 +245,22 @@ class QuartusWriter(Writer):
                 newline = line.replace('myproject', model.config.get_project_name())
             elif '//hls-fpga-machine-learning insert cpragmas' in line:
                 newline = line
-                newline += 'hls_max_concurrency(0)\n'
-                newline += 'hls_component_ii({})\n'.format(self.get_max_reuse_factor(model))
-                clock_mhz = 1000 / (model.config.get_config_value('ClockPeriod'))
-                newline += 'hls_scheduler_target_fmax_mhz({})\n'.format(np.ceil(clock_mhz).astype(np.int))
-            elif 'component output_data myproject(' in line:
-                newline = 'component output_data {}(\n'.format(model.config.get_project_name())
-            elif '//hls-fpga-machine-learning insert inputs' in line:
-                for inp in model_inputs:
-                    newline = ''
-                    newline += indent + inp.definition_cpp() + ';\n'
-            elif '//hls-fpga-machine-learning insert outputs' in line:
-                for out in model_outputs:
-                    newline = ''
-                    newline += indent + out.definition_cpp() + ';\n'
+                newline += self.get_cpragmas(model)
+            elif '//hls-fpga-machine-learning insert data structs' in line:
+                newline = ''
+                if model.config.get_config_value('IOType') != 'io_stream':
+                    newline += 'struct input_data {\n'
+                    for inp in model_inputs:
+                        newline += indent + inp.definition_cpp() + ';\n'
+                    newline += '};\n\n'
+                    newline += 'struct output_data {\n'
+                    for out in model_outputs:
+                        newline += indent + out.definition_cpp() + ';\n'
+                    newline += '};\n'
+            elif '//hls-fpga-machine-learning insert top-level' in line:
+                newline = self.get_top_level_signature(model) + ';\n'
+            elif '//hls-fpga-machine-learning insert component' in line:
+                newline = 'component ' + self.get_top_level_signature(model) + ';\n'
             else:
                 newline = line
             fout.write(newline)
@@ -200,7 +286,11 @@ class QuartusWriter(Writer):
                 all_precision = OrderedDict()
                 for layer in model.get_layers():
                     layer_precision = layer.get_layer_precision()
-                    all_precision.update(layer_precision)
+                    for type_name, type_var in layer_precision.items():
+                        # Ensure that layer's types doesn't override existing types
+                        # This can happen in case of InplaceVariable types
+                        if type_name not in all_precision:
+                            all_precision[type_name] = type_var
                 for used_type in all_precision.values():
                     newline += used_type.definition_cpp()
             else:
@@ -218,8 +308,11 @@ class QuartusWriter(Writer):
 
             if '//hls-fpga-machine-learning insert includes' in line:
                 newline = line
-                for include in sorted(
-                        set(sum((layer.get_attr('include_header', []) for layer in model.get_layers()), []))):
+                includes = set(sum((layer.get_attr('include_header', []) for layer in model.get_layers()), []))
+                if model.config.get_config_value('IOType') == 'io_stream':
+                    # The top-level function copies the data between its ports and the streams of the layers
+                    includes.add('nnet_utils/nnet_stream.h')
+                for include in sorted(includes):
                     newline += '#include "%s"\n' % include
 
             elif "//hls-fpga-machine-learning insert layer-config" in line:
@@ -276,12 +369,31 @@ class QuartusWriter(Writer):
         f = open(os.path.join(filedir, '../templates/quartus/myproject_test.cpp'), 'r')
         fout = open('{}/{}_test.cpp'.format(model.config.get_output_dir(), model.config.get_project_name()), 'w')
 
+        io_stream = model.config.get_config_value('IOType') == 'io_stream'
+        # In io_stream the outputs are read from the streams into vectors once the component has finished
+        output_ref = 'outputs[j]' if io_stream else 'outputs[j].{}'.format(outvar.member_name)
+
         for line in f.readlines():
             indent = ' ' * (len(line) - len(line.lstrip(' ')))
 
             # Insert numbers
             if 'myproject' in line:
                 newline = line.replace('myproject', model.config.get_project_name())
+            elif '//hls-fpga-machine-learning insert inputs/outputs' in line:
+                newline = ''
+                if io_stream:
+                    for inp in model.get_input_variables():
+                        newline += indent + 'nnet::stream_in<{}> {};\n'.format(inp.type.name, inp.name)
+                    newline += indent + 'nnet::stream_out<{}> {};\n'.format(outvar.type.name, outvar.name)
+                else:
+                    newline += indent + 'std::vector<input_data> inputs;\n'
+                    newline += indent + 'std::vector<output_data> outputs;\n'
+            elif '//hls-fpga-machine-learning insert data' in line and io_stream:
+                newline = line
+                newline += '      float *in_ptr = in.data();\n'
+                for inp in model.get_input_variables():
+                    newline += f'      nnet::convert_data<float, {inp.type.name}, {inp.size_cpp()}>(in_ptr, {inp.name});\n'
+                    newline += f'      in_ptr += {inp.size_cpp()};\n'
             elif '//hls-fpga-machine-learning insert data' in line:
                 newline = line
                 # TODO this is not correct for more than one input
@@ -293,6 +405,14 @@ class QuartusWriter(Writer):
                     newline += f'      std::copy(in_begin, in_end, inputs.back().{inp.member_name});\n'
                     newline += '      in_begin = in_end;\n'
                 newline += '      outputs.emplace_back();\n'
+            elif '//hls-fpga-machine-learning insert zero' in line and io_stream:
+                newline = line
+                for inp in model.get_input_variables():
+                    newline += indent + f'std::vector<float> {inp.name}_zeros({inp.size_cpp()}, 0.0);\n'
+                newline += indent + 'for(int i = 0; i < num_iterations; i++) {\n'
+                for inp in model.get_input_variables():
+                    newline += indent + f'  nnet::convert_data<float, {inp.type.name}, {inp.size_cpp()}>({inp.name}_zeros.data(), {inp.name});\n'
+                newline += indent + '}\n'
             elif '//hls-fpga-machine-learning insert zero' in line:
                 newline = line
                 newline += indent + 'for(int i = 0; i < num_iterations; i++) {\n'
@@ -306,11 +426,20 @@ class QuartusWriter(Writer):
                 newline = line
 
                 newline += indent + 'for(int i = 0; i < num_iterations; i++) {\n'
-                newline += indent + f'  ihc_hls_enqueue(&outputs[i], {model.config.get_project_name()}, inputs[i]);\n'
+                if io_stream:
+                    ports = ', '.join([inp.name for inp in model.get_input_variables()] + [outvar.name])
+                    newline += indent + f'  ihc_hls_enqueue_noret(&{model.config.get_project_name()}, {ports});\n'
+                else:
+                    newline += indent + f'  ihc_hls_enqueue(&outputs[i], {model.config.get_project_name()}, inputs[i]);\n'
                 newline += indent + '}\n'
             elif 'hls-fpga-machine-learning insert run' in line:
                 newline = line
                 newline += '    ' + 'ihc_hls_component_run_all({});\n'.format(model.config.get_project_name())
+                if io_stream:
+                    newline += '    ' + f'std::vector<std::vector<float> > outputs(num_iterations, std::vector<float>({outvar.size_cpp()}));\n'
+                    newline += '    ' + 'for(int j = 0; j < num_iterations; j++) {\n'
+                    newline += '    ' + f'  nnet::convert_data_back<{outvar.type.name}, float, {outvar.size_cpp()}>({outvar.name}, outputs[j].data());\n'
+                    newline += '    ' + '}\n'
             elif '//hls-fpga-machine-learning insert predictions' in line:
                 newline = line
                 newline += indent + 'for(int i = 0; i < {}; i++) {{\n'.format(outvar.size_cpp())
@@ -320,13 +449,13 @@ class QuartusWriter(Writer):
             elif '//hls-fpga-machine-learning insert tb-output' in line:
                 newline = line
                 newline += indent + 'for(int i = 0; i < {}; i++) {{\n'.format(outvar.size_cpp())
-                newline += indent + '  fout << outputs[j].{}[i] << " ";\n'.format(outvar.member_name)
+                newline += indent + '  fout << {}[i] << " ";\n'.format(output_ref)
                 newline += indent + '}\n'
                 newline += indent + 'fout << std::endl;\n'
             elif '//hls-fpga-machine-learning insert output' in line or '//hls-fpga-machine-learning insert quantized' in line:
                 newline = line
                 newline += indent + 'for(int i = 0; i < {}; i++) {{\n'.format(outvar.size_cpp())
-                newline += indent + '  std::cout << outputs[j].{}[i] << " ";\n'.format(outvar.member_name)
+                newline += indent + '  std::cout << {}[i] << " ";\n'.format(output_ref)
                 newline += indent + '}\n'
                 newline += indent + 'std::cout << std::endl;\n'
             else:
@@ -374,6 +503,26 @@ class QuartusWriter(Writer):
                 newline += indent + insize_str + ',\n'
                 newline += indent + outsize_str + '\n'
 
+            elif '//hls-fpga-machine-learning insert wrapper' in line and model.config.get_config_value('IOType') == 'io_stream':
+                dtype = line.split('#', 1)[1].strip()
+                newline = ''
+                for i in model_inputs:
+                    newline += indent + 'nnet::stream_in<{}> {}_ap;\n'.format(i.type.name, i.cppname)
+                    newline += indent + 'nnet::convert_data<{}, {}, {}>({}, {}_ap);\n'.format(dtype, i.type.name, i.size_cpp(), i.cppname, i.cppname)
+                newline += '\n'
+
+                for o in model_outputs:
+                    newline += indent + 'nnet::stream_out<{}> {}_ap;\n'.format(o.type.name, o.cppname)
+
+                input_vars = ','.join([i.cppname + '_ap' for i in model_inputs])
+                output_vars = ','.join([o.cppname + '_ap' for o in model_outputs])
+                top_level = indent + '{}({},{});\n'.format(model.config.get_project_name(), input_vars, output_vars)
+                newline += top_level
+                newline += '\n'
+
+                for o in model_outputs:
+                    newline += indent + 'nnet::convert_data_back<{}, {}, {}>({}_ap, {});\n'.format(o.type.name, dtype, o.size_cpp(), o.cppname, o.cppname)
+
             elif '//hls-fpga-machine-learning insert wrapper' in line:
                 dtype = line.split('#', 1)[1].strip()
                 newline = ''
@@ -14,6 +14,10 @@ class VivadoAcceleratorWriter(VivadoWriter):
             Args:
                 model : The ModelGraph to write the wrapper for
         '''
+        if self.vivado_accelerator_config.get_batch():
+            self.write_axi_batch_wrapper(model)
+            return
+
         inp_axi_t, out_axi_t, inp, out = self.vivado_accelerator_config.get_corrected_types()
         indent = '    '
 
@@ -184,6 +188,161 @@ class VivadoAcceleratorWriter(VivadoWriter):
         f.close()
         fout.close()
 
+    def _make_beat_definition(self, direction, struct_name, value_t, pack, bitwidth):
+        ''' Return the struct of the beats of an AXI stream of the batch mode wrapper and the functions to access
+            the values packed in them
+            Args:
+                direction : 'input' or 'output', used in the names of the struct and the functions
+                struct_name : name of the struct, 'in_struct' or 'out_struct'
+                value_t : C++ type of the values, 'T_in' or 'T_out'
+                pack : number of values per beat
+                bitwidth : width of the values
+        '''
+        indent = '    '
+        data_t = value_t if pack == 1 else 'ap_uint<{}>'.format(pack * bitwidth)
+        newline = 'typedef struct {} {{\n'.format(struct_name)
+        newline += indent + '{} data;\n'.format(data_t)
+        newline += indent + 'ap_uint<1> last;\n'
+        newline += indent + '{}(){{this->data = 0; this->last = 0;}};\n'.format(struct_name)
+        newline += '}} {}_axi_t;\n'.format(direction)
+
+        unpack_header = 'inline {value_t} unpack_{dir}(const {dir}_axi_t &beat, unsigned j)'
+        pack_header = 'inline void pack_{dir}({dir}_axi_t &beat, unsigned j, const {value_t} &value)'
+        if pack == 1:
+            newline += (unpack_header + ' {{ return beat.data; }}\n').format(dir=direction, value_t=value_t)
+            newline += (pack_header + ' {{ beat.data = value; }}\n').format(dir=direction, value_t=value_t)
+        else:
+            lane = 'beat.data.range({w} * j + {w} - 1, {w} * j)'.format(w=bitwidth)
+            newline += (unpack_header + ' {{\n').format(dir=direction, value_t=value_t)
+            newline += indent + '{} value;\n'.format(value_t)
+            newline += indent + 'value.range({}, 0) = ap_uint<{}>({});\n'.format(bitwidth - 1, bitwidth, lane)
+            newline += indent + 'return value;\n'
+            newline += '}\n'
+            newline += (pack_header + ' {{\n').format(dir=direction, value_t=value_t)
+            newline += indent + '{} = ap_uint<{}>(value.range({}, 0));\n'.format(lane, bitwidth, bitwidth - 1)
+            newline += '}\n'
+
+        return newline
+
+    def write_axi_batch_wrapper(self, model):
+        ''' Write the top level HLS C++ file of the batch mode, which runs all the events of a transfer, up to the
+            beat with TLAST, through the network in one call
+            Args:
+                model : The ModelGraph to write the wrapper for
+        '''
+        inp_axi_t, out_axi_t, inp, out = self.vivado_accelerator_config.get_corrected_types()
+        in_pack, out_pack = self.vivado_accelerator_config.get_packing()
+        in_bit, out_bit = self.vivado_accelerator_config.get_value_bitwidth()
+        io_type = model.config.get_config_value("IOType")
+        project_name = model.config.get_project_name()
+        indent = '    '
+
+        #######################
+        ## myproject_axi.h
+        #######################
+
+        filedir = os.path.dirname(os.path.abspath(__file__))
+        f = open(os.path.join(filedir, '../templates/vivado_accelerator/myproject_axi_batch.h'), 'r')
+        fout = open('{}/firmware/{}_axi.h'.format(model.config.get_output_dir(), project_name), 'w')
+
+        for line in f.readlines():
+            if '//hls-fpga-machine-learning insert include' in line:
+                newline = '#include "{}.h"\n'.format(project_name)
+            elif '//hls-fpga-machine-learning insert definitions' in line:
+                newline = ''
+                newline += 'static const unsigned N_IN = {};\n'.format(inp.size())
+                newline += 'static const unsigned N_OUT = {};\n'.format(out.size())
+                newline += 'static const unsigned PACK_IN = {};\n'.format(in_pack)
+                newline += 'static const unsigned PACK_OUT = {};\n'.format(out_pack)
+                newline += 'static const unsigned N_IN_BEATS = (N_IN + PACK_IN - 1) / PACK_IN;\n'
+                newline += 'static const unsigned N_OUT_BEATS = (N_OUT + PACK_OUT - 1) / PACK_OUT;\n'
+                newline += 'typedef {} T_in;\n'.format(inp_axi_t)
+                newline += 'typedef {} T_out;\n'.format(out_axi_t)
+                newline += self._make_beat_definition('input', 'in_struct', 'T_in', in_pack, in_bit)
+                newline += self._make_beat_definition('output', 'out_struct', 'T_out', out_pack, out_bit)
+            else:
+                newline = line.replace('MYPROJECT', project_name.upper()).replace('myproject', project_name)
+            fout.write(newline)
+        f.close()
+        fout.close()
+
+        #######################
+        ## myproject_axi.cpp
+        #######################
+
+        f = open(os.path.join(filedir, '../templates/vivado_accelerator/myproject_axi_batch.cpp'), 'r')
+        fout = open('{}/firmware/{}_axi.cpp'.format(model.config.get_output_dir(), project_name), 'w')
+
+        body_indent = indent * 2
+        for line in f.readlines():
+            if '//hls-fpga-machine-learning insert include' in line:
+                newline = '#include "{}_axi.h"\n'.format(project_name)
+            elif '//hls-fpga-machine-learning insert interface' in line:
+                newline = ''
+                newline += indent + '#pragma HLS INTERFACE axis port=in\n'
+                newline += indent + '#pragma HLS INTERFACE axis port=out\n'
+                newline += indent + '#pragma HLS INTERFACE ap_ctrl_none port=return\n'
+                newline += indent + '#pragma HLS DATAFLOW\n'
+            elif '//hls-fpga-machine-learning insert pipeline' in line:
+                # The io_stream network is a dataflow region of its own, its layers overlap the events instead
+                newline = body_indent + '#pragma HLS PIPELINE\n' if io_type == 'io_parallel' else ''
+            elif '//hls-fpga-machine-learning insert local vars' in line:
+                newline = ''
+                if io_type == 'io_parallel':
+                    newline += body_indent + inp.type.name + ' in_local[N_IN];\n'
+                    newline += body_indent + out.type.name + ' out_local[N_OUT];\n'
+                elif io_type == 'io_stream':
+                    newline += body_indent + 'hls::stream<' + inp.type.name + '> in_local("input_1");\n'
+                    newline += body_indent + 'hls::stream<' + out.type.name + '> out_local("output_1");\n'
+                    newline += body_indent + '#pragma HLS STREAM variable=in_local depth=N_IN\n'
+                    newline += body_indent + '#pragma HLS STREAM variable=out_local depth=N_OUT\n'
+            elif '//hls-fpga-machine-learning insert enqueue' in line:
+                newline = ''
+                if io_type == 'io_parallel':
+                    newline += body_indent + 'for (unsigned i = 0; i < N_IN; i++) {\n'
+                    newline += body_indent + indent + '#pragma HLS UNROLL\n'
+                    newline += body_indent + indent + 'in_local[i] = in_event[i]; // Read input with cast\n'
+                    newline += body_indent + '}\n'
+                elif io_type == 'io_stream':
+                    newline += body_indent + 'for (unsigned i = 0; i < N_IN / {input_t}::size; i++) {{\n'
+                    newline += body_indent + indent + '{input_t} ctype;\n'
+                    newline += body_indent + indent + '#pragma HLS DATA_PACK variable=ctype\n'
+                    newline += body_indent + indent + 'for (unsigned j = 0; j < {input_t}::size; j++) {{\n'
+                    newline += body_indent + indent * 2 + '#pragma HLS UNROLL\n'
+                    newline += body_indent + indent * 2 + 'ctype[j] = typename {input_t}::value_type(in_event[i * {input_t}::size + j]);\n'
+                    newline += body_indent + indent + '}}\n'
+                    newline += body_indent + indent + 'in_local.write(ctype);\n'
+                    newline += body_indent + '}}\n'
+                    newline = newline.format(input_t=inp.type.name)
+            elif '//hls-fpga-machine-learning insert call' in line:
+                newline = body_indent + '{}(in_local, out_local);\n'.format(project_name)
+            elif '//hls-fpga-machine-learning insert dequeue' in line:
+                newline = ''
+                if io_type == 'io_parallel':
+                    newline += body_indent + 'for (unsigned i = 0; i < N_OUT; i++) {\n'
+                    newline += body_indent + indent + '#pragma HLS UNROLL\n'
+                    newline += body_indent + indent + 'out_event[i] = T_out(out_local[i]); // Write output with cast\n'
+                    newline += body_indent + '}\n'
+                elif io_type == 'io_stream':
+                    newline += body_indent + 'for (unsigned i = 0; i < N_OUT / {result_t}::size; i++) {{\n'
+                    newline += body_indent + indent + '{result_t} ctype = out_local.read();\n'
+                    newline += body_indent + indent + 'for (unsigned j = 0; j < {result_t}::size; j++) {{\n'
+                    newline += body_indent + indent * 2 + '#pragma HLS UNROLL\n'
+                    newline += body_indent + indent * 2 + 'out_event[i * {result_t}::size + j] = T_out(ctype[j]);\n'
+                    newline += body_indent + indent + '}}\n'
+                    newline += body_indent + '}}\n'
+                    newline = newline.format(result_t=out.type.name)
+                # Padding of the last beat
+                newline += body_indent + 'for (unsigned i = N_OUT; i < N_OUT_BEATS * PACK_OUT; i++) {\n'
+                newline += body_indent + indent + '#pragma HLS UNROLL\n'
+                newline += body_indent + indent + 'out_event[i] = 0;\n'
+                newline += body_indent + '}\n'
+            else:
+                newline = line.replace('myproject', project_name)
+            fout.write(newline)
+        f.close()
+        fout.close()
+
     def modify_build_script(self, model):
         '''
         Modify the build_prj.tcl and build_lib.sh scripts to add the extra wrapper files and set the top function
@@ -238,28 +397,34 @@ class VivadoAcceleratorWriter(VivadoWriter):
         inp = model.get_input_variables()[0]
         out = model.get_output_variables()[0]
 
+        # In batch mode the test bench and the bridge hold the values, myproject_axi_events() packs them into beats
+        batch = self.vivado_accelerator_config.get_batch()
+        input_axi_t, output_axi_t = ('T_in', 'T_out') if batch else ('input_axi_t', 'output_axi_t')
+        axi_call = '{}_axi_events({{}}, {{}}, 1)' if batch else '{}_axi({{}},{{}})'
+        axi_call = axi_call.format(model.config.get_project_name())
+
         for line in f.readlines():
             if '{}.h'.format(model.config.get_project_name()) in line:
                 newline = line.replace('{}.h'.format(model.config.get_project_name()),
                                        '{}_axi.h'.format(model.config.get_project_name()))
             elif inp.definition_cpp() in line:
-                newline = line.replace(inp.definition_cpp(), 'input_axi_t inputs[N_IN]') #TODO instead of replacing strings, how about we use proper variables and their definition?
+                newline = line.replace(inp.definition_cpp(), input_axi_t + ' inputs[N_IN]') #TODO instead of replacing strings, how about we use proper variables and their definition?
             elif out.definition_cpp() in line:
-                newline = line.replace(out.definition_cpp(), 'output_axi_t outputs[N_OUT]')
+                newline = line.replace(out.definition_cpp(), output_axi_t + ' outputs[N_OUT]')
             elif 'unsigned short' in line:
                 newline = ''
             elif '{}('.format(model.config.get_project_name()) in line:
                 indent_amount = line.split(model.config.get_project_name())[0]
-                newline = indent_amount + '{}_axi(inputs,outputs);\n'.format(model.config.get_project_name())
+                newline = indent_amount + axi_call.format('inputs', 'outputs') + ';\n'
             elif inp.size_cpp() in line or inp.cppname in line or inp.type.name in line:
                 newline = line.replace(inp.size_cpp(), 'N_IN').replace(inp.cppname, 'inputs').replace(inp.type.name,
-                                                                                                      'input_axi_t')
+                                                                                                      input_axi_t)
             elif out.size_cpp() in line or out.cppname in line or out.type.name in line:
                 newline = line.replace(out.size_cpp(), 'N_OUT').replace(out.cppname, 'outputs').replace(out.type.name,
-                                                                                                        'output_axi_t')
+                                                                                                        output_axi_t)
             else:
                 newline = line
-            if self.vivado_accelerator_config.get_interface() == 'axi_stream':
+            if self.vivado_accelerator_config.get_interface() == 'axi_stream' and not batch:
                 if 'nnet::fill_zero' in line:
                     indent = line.split('n')[0]
                     newline = indent + 'inputs[N_IN-1].last = 1;\n'
@@ -289,18 +454,29 @@ class VivadoAcceleratorWriter(VivadoWriter):
                                        '{}_axi.h'.format(model.config.get_project_name()))
             elif inp.definition_cpp(name_suffix='_ap') in line:
                 newline = line.replace(inp.definition_cpp(name_suffix='_ap'),
-                                       'input_axi_t {}_ap[N_IN]'.format(inp.cppname))
+                                       '{} {}_ap[N_IN]'.format(input_axi_t, inp.cppname))
             elif out.definition_cpp(name_suffix='_ap') in line:
                 newline = line.replace(out.definition_cpp(name_suffix='_ap'),
-                                       'output_axi_t {}_ap[N_OUT]'.format(out.cppname))
+                                       '{} {}_ap[N_OUT]'.format(output_axi_t, out.cppname))
             elif '{}('.format(model.config.get_project_name()) in line:
                 indent_amount = line.split(model.config.get_project_name())[0]
-                newline = indent_amount + '{}_axi({}_ap,{}_ap);\n'.format(model.config.get_project_name(), inp.cppname,
-                                                                          out.cppname)
+                newline = indent_amount + axi_call.format(inp.cppname + '_ap', out.cppname + '_ap') + ';\n'
             elif inp.size_cpp() in line or inp.cppname in line or inp.type.name in line:
-                newline = line.replace(inp.size_cpp(), 'N_IN').replace(inp.type.name, 'input_axi_t')
+                newline = line.replace(inp.size_cpp(), 'N_IN').replace(inp.type.name, input_axi_t)
             elif out.size_cpp() in line or out.cppname in line or out.type.name in line:
-                newline = line.replace(out.size_cpp(), 'N_OUT').replace(out.type.name, 'output_axi_t')
+                newline = line.replace(out.size_cpp(), 'N_OUT').replace(out.type.name, output_axi_t)
+            elif '// Wrapper of the batched C simulation' in line and batch and not self._has_batch_function(model):
+                # All the events of a predict() call in one transfer, as the drivers send them
+                newline = line
+                for dtype in ['float', 'double']:
+                    newline += 'void {}_batch_{}(\n'.format(model.config.get_project_name(), dtype)
+                    newline += '    {} {}[],\n'.format(dtype, inp.cppname)
+                    newline += '    {} {}[],\n'.format(dtype, out.cppname)
+                    newline += '    unsigned n_samples\n'
+                    newline += ') {\n'
+                    newline += '    {}_axi_events({}, {}, n_samples);\n'.format(model.config.get_project_name(),
+                                                                               inp.cppname, out.cppname)
+                    newline += '}\n\n'
             else:
                 newline = line
             fout.write(newline)
@@ -321,6 +497,14 @@ class VivadoAcceleratorWriter(VivadoWriter):
             src_dir=os.path.join(filedir, self.vivado_accelerator_config.get_krnl_rtl_src_dir())
             dst_dir= os.path.abspath(model.config.get_output_dir())+'/src'
             copy_tree(src_dir,dst_dir)
+            # The kernel reads and writes the beats of the streams through one memory port
+            in_bit, out_bit = self.vivado_accelerator_config.get_io_bitwidth()
+            if in_bit != 32:
+                for src in ['krnl_rtl_int.sv', 'myproject_kernel.v']:
+                    with open(os.path.join(dst_dir, src), 'r') as f:
+                        rtl = f.read()
+                    with open(os.path.join(dst_dir, src), 'w') as f:
+                        f.write(rtl.replace('C_M_AXI_GMEM_DATA_WIDTH = 32', 'C_M_AXI_GMEM_DATA_WIDTH = {}'.format(in_bit)))
         f = open('{}/project.tcl'.format(model.config.get_output_dir()), 'w')
         f.write('variable myproject\n')
         f.write('set myproject "{}"\n'.format(model.config.get_project_name()))
@@ -329,15 +513,96 @@ class VivadoAcceleratorWriter(VivadoWriter):
              f.write('set part "{}"\n'.format(self.vivado_accelerator_config.get_part()))
         if self.vivado_accelerator_config.get_interface() == 'axi_stream':
             in_bit, out_bit = self.vivado_accelerator_config.get_io_bitwidth()
-            f.write('set bit_width_hls_output {}\n'.format(in_bit))
-            f.write('set bit_width_hls_input {}\n'.format(out_bit))
+            f.write('set bit_width_hls_output {}\n'.format(out_bit))
+            f.write('set bit_width_hls_input {}\n'.format(in_bit))
         f.close()
 
     def write_driver(self, model):
         filedir = os.path.dirname(os.path.abspath(__file__))
-        copyfile(os.path.join(filedir, self.vivado_accelerator_config.get_driver_path()),
-                 ('{}/' + self.vivado_accelerator_config.get_driver_file()).format(model.config.get_output_dir()))
-        
+        driver_path = os.path.join(filedir, self.vivado_accelerator_config.get_driver_path())
+        driver_out = ('{}/' + self.vivado_accelerator_config.get_driver_file()).format(model.config.get_output_dir())
+        if self.vivado_accelerator_config.get_driver() == 'c':
+            copyfile(driver_path, driver_out)
+            if self.vivado_accelerator_config.has_native_words():
+                self.write_host(model)
+            else:
+                print('WARNING: The host program is not written, it only supports AXI words of 8, 16, 32 or 64 bits.')
+            return
+
+        inp, out = model.get_input_variables()[0], model.get_output_variables()[0]
+        in_pack, out_pack = self.vivado_accelerator_config.get_packing()
+        fixed_in, fixed_out = self.vivado_accelerator_config.get_driver_types()
+
+        # The conversion of the events to the words of the streams is the same for all boards
+        with open(os.path.join(filedir, '../templates/vivado_accelerator/python_drivers/axi_stream_codec.py'), 'r') as f:
+            codec = f.read()
+        codec = codec[codec.index('def '):]
+
+        f = open(driver_path, 'r')
+        fout = open(driver_out, 'w')
+        for line in f.readlines():
+            if '#hls-fpga-machine-learning insert definitions' in line:
+                # Values per event and per beat of the streams, and the format of their words
+                newline = 'N_IN, N_OUT = {}, {}\n'.format(inp.size(), out.size())
+                newline += 'PACK_IN, PACK_OUT = {}, {}\n'.format(in_pack, out_pack)
+                newline += 'FIXED_IN = {}\n'.format(fixed_in)
+                newline += 'FIXED_OUT = {}\n'.format(fixed_out)
+                newline += '\n\n' + codec
+            else:
+                newline = line
+            fout.write(newline)
+        f.close()
+        fout.close()
+
+    def write_host(self, model):
+        '''
+        Write the C++ host program of the accelerator, with the runtime and the C simulation transport
+        '''
+        filedir = os.path.dirname(os.path.abspath(__file__))
+        host_dir = os.path.join(filedir, self.vivado_accelerator_config.get_host_dir())
+        output_dir = model.config.get_output_dir()
+        project_name = model.config.get_project_name()
+        inp, out = model.get_input_variables()[0], model.get_output_variables()[0]
+        in_word_t, in_codec_t, out_word_t, out_codec_t = self.vivado_accelerator_config.get_host_types()
+        in_pack, out_pack = self.vivado_accelerator_config.get_packing()
+
+        for header in ['host_runtime.h', 'csim_transport.h']:
+            copyfile(os.path.join(host_dir, header), '{}/{}'.format(output_dir, header))
+
+        f = open(os.path.join(host_dir, 'myproject_host.cpp'), 'r')
+        fout = open('{}/{}_host.cpp'.format(output_dir, project_name), 'w')
+
+        for line in f.readlines():
+            if '//hls-fpga-machine-learning insert definitions' in line:
+                newline = ''
+                newline += 'static const unsigned N_IN = {};\n'.format(inp.size())
+                newline += 'static const unsigned N_OUT = {};\n'.format(out.size())
+                # Words per beat, and per event with the padding of its last beat
+                newline += 'static const unsigned PACK_IN = {};\n'.format(in_pack)
+                newline += 'static const unsigned PACK_OUT = {};\n'.format(out_pack)
+                newline += 'static const unsigned N_IN_WORDS = (N_IN + PACK_IN - 1) / PACK_IN * PACK_IN;\n'
+                newline += 'static const unsigned N_OUT_WORDS = (N_OUT + PACK_OUT - 1) / PACK_OUT * PACK_OUT;\n'
+                newline += 'typedef {} in_word_t;\n'.format(in_word_t)
+                newline += 'typedef {} out_word_t;\n'.format(out_word_t)
+                newline += 'typedef {} in_codec_t;\n'.format(in_codec_t)
+                newline += 'typedef {} out_codec_t;\n'.format(out_codec_t)
+            else:
+                newline = line.replace('myproject', project_name)
+                newline = newline.replace('DEFAULT_LIBRARY', 'firmware/{}-{}.so'.format(
+                    project_name, model.config.get_config_value('Stamp')))
+                newline = newline.replace('DEFAULT_XCLBIN', 'xclbin_files/{}_kernel.xclbin'.format(project_name))
+            fout.write(newline)
+        f.close()
+        fout.close()
+
+        f = open(os.path.join(host_dir, 'build_host.sh'), 'r')
+        fout = open('{}/build_host.sh'.format(output_dir), 'w')
+        for line in f.readlines():
+            fout.write(line.replace('myproject', project_name))
+        f.close()
+        fout.close()
+
+
     def write_new_tar(self, model):
         os.remove(model.config.get_output_dir() + '.tar.gz')
         super(VivadoAcceleratorWriter, self).write_tar(model)
@@ -95,6 +95,235 @@ class VivadoWriter(Writer):
         elif mode == 'stream':
             return '#pragma HLS STREAM variable={name} depth={depth}'.format(name=variable.name, depth=depth)
 
+    @staticmethod
+    def _make_load_weights(model, indent):
+        newline = ''
+        for layer in model.get_layers():
+            for w in layer.get_weights():
+                if w.weight_class == 'CompressedWeightVariable':
+                    newline += indent + 'nnet::load_compressed_weights_from_txt<{}, {}>({}, "{}.txt");\n'.format(w.type.name, w.nonzeros, w.name, w.name)
+                elif w.weight_class == 'ExponentWeightVariable':
+                    newline += indent + 'nnet::load_exponent_weights_from_txt<{}, {}>({}, "{}.txt");\n'.format(w.type.name, w.data_length, w.name, w.name)
+                else:
+                    newline += indent + 'nnet::load_weights_from_txt<{}, {}>({}, "{}.txt");\n'.format(w.type.name, w.data_length, w.name, w.name)
+        return newline
+
+    @staticmethod
+    def _has_batch_function(model):
+        """
+        The batched C simulation (`myproject_batch`) is only generated for io_parallel models with recurrent layers,
+        where advancing all the sequences together is much faster than simulating them one by one.
+        """
+        if model.config.get_config_value('IOType') != 'io_parallel':
+            return False
+        if any(var.storage.lower() in ['bram', 'offchip'] for var in model.get_weight_variables()):
+            return False
+        return any(layer.get_attr('function_cpp_batch', None) for layer in model.get_layers())
+
+    @staticmethod
+    def _make_batch_header(model):
+        inputs_str = ', '.join(['{} *{}'.format(i.type.name, i.cppname) for i in model.get_input_variables()])
+        outputs_str = ', '.join(['{} *{}'.format(o.type.name, o.cppname) for o in model.get_output_variables()])
+        return 'void {}_batch(unsigned n_samples, {}, {})'.format(model.config.get_project_name(), inputs_str, outputs_str)
+
+    def _make_batch_function(self, model):
+        if not self._has_batch_function(model):
+            return ''
+
+        indent = '    '
+        model_inputs = model.get_input_variables()
+        model_outputs = model.get_output_variables()
+
+        # Sizes of the per-sample buffers, the batched buffers hold 'n_samples' of them back to back
+        sizes = OrderedDict()
+        for var in model_inputs + model_outputs:
+            sizes[var.name] = var.size_cpp()
+
+        newline = '#ifndef __SYNTHESIS__\n'
+        newline += '// Layer-by-layer C simulation of a batch of samples, see the "_stack_batch" functions of the recurrent layers\n'
+        newline += self._make_batch_header(model) + ' {\n'
+        newline += indent + 'static bool loaded_weights = false;\n'
+        newline += indent + 'if (!loaded_weights) {\n'
+        newline += self._make_load_weights(model, indent + '    ')
+        newline += indent + '    loaded_weights = true;\n'
+        newline += indent + '}\n\n'
+
+        for layer in model.get_layers():
+            for var in layer.get_variables():
+                if var.name in sizes or var.definition_cpp() is None:
+                    continue
+                sizes[var.name] = var.size_cpp()
+                newline += indent + 'std::vector<{type}> {name}_batch(n_samples * {size});\n'.format(type=var.type.name, name=var.name, size=var.size_cpp())
+                newline += indent + '{type} *{name} = {name}_batch.data();\n'.format(type=var.type.name, name=var.name)
+
+            func_batch = layer.get_attr('function_cpp_batch', None)
+            func = layer.get_attr('function_cpp', None)
+            if func_batch:
+                newline += indent + func_batch + ' // ' + layer.name + '\n'
+            elif func:
+                # Call the layer on each sample, with the arguments pointing into the batched buffers
+                for name, size in sizes.items():
+                    func = re.sub(r'\b{}\b'.format(re.escape(name)), '&{}[i_sample * ({})]'.format(name, size), func)
+                newline += indent + 'for (unsigned i_sample = 0; i_sample < n_samples; i_sample++) {\n'
+                newline += indent + '    ' + func + ' // ' + layer.name + '\n'
+                newline += indent + '}\n'
+
+        newline += '}\n'
+        newline += '#endif\n'
+
+        return newline
+
+    def _make_layers(self, model, stateful=False):
+        model_inputs = model.get_input_variables()
+        model_outputs = model.get_output_variables()
+
+        newline = ''
+        for layer in model.get_layers():
+            vars = layer.get_variables()
+            for var in vars:
+                if var not in model_inputs and var not in model_outputs:
+                    def_cpp = var.definition_cpp()
+                    if def_cpp is not None:
+                        newline += '    ' + def_cpp + ';\n'
+                        if var.pragma:
+                            newline += '    ' + self._make_array_pragma(var) + '\n'
+            func = layer.get_attr('function_cpp', None)
+            if stateful:
+                func = layer.get_attr('function_cpp_state', None) or func
+            if func:
+                func = [func]
+                if len(func) == 1:
+                    newline += '    ' + func[0] + ' // ' + layer.name + '\n'
+                else:
+                    newline += '// ' + layer.name + '\n'
+                    for line in func:
+                        newline += '    ' + line + '\n'
+                if model.config.trace_output and layer.get_attr('Trace', False) and not stateful:
+                    newline += '#ifndef __SYNTHESIS__\n'
+                    for var in vars:
+                        newline += '    nnet::save_layer_output<{}>({}, "{}", {});\n'.format(var.type.name, var.name, layer.name, var.size_cpp())
+                    newline += '#endif\n'
+                newline += '\n'
+
+        return newline
+
+    @staticmethod
+    def _has_stateful_function(model):
+        """
+        The stateful C simulation (`myproject_stateful`) is generated for models with recurrent layers. Instead of
+        starting every sequence from a zero state, the recurrent layers continue from the state object passed in.
+        """
+        if any(var.storage.lower() in ['bram', 'offchip'] for var in model.get_weight_variables()):
+            return False
+        return any(layer.get_attr('state_cpp', None) for layer in model.get_layers())
+
+    @staticmethod
+    def _make_stateful_header(model):
+        inputs_str = ', '.join([i.definition_cpp(as_reference=True) for i in model.get_input_variables()])
+        outputs_str = ', '.join([o.definition_cpp(as_reference=True) for o in model.get_output_variables()])
+        return 'void {prj}_stateful({prj}_state *state, {inputs}, {outputs})'.format(prj=model.config.get_project_name(), inputs=inputs_str, outputs=outputs_str)
+
+    def _make_stateful_function(self, model):
+        if not self._has_stateful_function(model):
+            return ''
+
+        prj = model.config.get_project_name()
+        indent = '    '
+        state_layers = [layer for layer in model.get_layers() if layer.get_attr('state_cpp', None)]
+
+        newline = '#ifndef __SYNTHESIS__\n'
+        newline += '// State of the recurrent layers for one stream of sequences\n'
+        newline += 'struct {}_state {{\n'.format(prj)
+        for layer in state_layers:
+            newline += indent + '{} layer{}_state;\n'.format(layer.get_attr('state_cpp'), layer.index)
+        newline += '};\n\n'
+
+        newline += '{prj}_state *{prj}_state_create() {{\n'.format(prj=prj)
+        newline += indent + '{prj}_state *state = new {prj}_state;\n'.format(prj=prj)
+        newline += indent + '{}_state_reset(state);\n'.format(prj)
+        newline += indent + 'return state;\n'
+        newline += '}\n\n'
+
+        newline += 'void {prj}_state_free({prj}_state *state) {{\n'.format(prj=prj)
+        newline += indent + 'delete state;\n'
+        newline += '}\n\n'
+
+        newline += 'void {prj}_state_reset({prj}_state *state) {{\n'.format(prj=prj)
+        for layer in state_layers:
+            newline += indent + 'state->layer{}_state.reset();\n'.format(layer.index)
+        newline += '}\n\n'
+
+        newline += self._make_stateful_header(model) + ' {\n'
+        newline += indent + 'static bool loaded_weights = false;\n'
+        newline += indent + 'if (!loaded_weights) {\n'
+        newline += self._make_load_weights(model, indent + '    ')
+        newline += indent + '    loaded_weights = true;\n'
+        newline += indent + '}\n\n'
+        newline += self._make_layers(model, stateful=True)
+        newline += '}\n'
+        newline += '#endif\n'
+
+        return newline
+
+    @staticmethod
+    def _has_threaded_function(model):
+        """
+        The threaded C simulation (`myproject_threaded`) is generated for io_stream models. It is only compiled with
+        HLS_STREAM_THREAD_SAFE, in which case the streams block once they hold as many elements as their depth.
+        """
+        if model.config.get_config_value('IOType') != 'io_stream':
+            return False
+        return not any(var.storage.lower() in ['bram', 'offchip'] for var in model.get_weight_variables())
+
+    @staticmethod
+    def _make_threaded_header(model):
+        inputs_str = ', '.join([i.definition_cpp(as_reference=True) for i in model.get_input_variables()])
+        outputs_str = ', '.join([o.definition_cpp(as_reference=True) for o in model.get_output_variables()])
+        return 'int {}_threaded({}, {})'.format(model.config.get_project_name(), inputs_str, outputs_str)
+
+    def _make_threaded_function(self, model):
+        if not self._has_threaded_function(model):
+            return ''
+
+        indent = '    '
+        model_inputs = model.get_input_variables()
+        model_outputs = model.get_output_variables()
+
+        newline = '#if !defined(__SYNTHESIS__) && defined(HLS_STREAM_THREAD_SAFE)\n'
+        newline += '// Every layer runs in its own thread, like the processes of the dataflow region. Returns the number of\n'
+        newline += '// layers that deadlocked on a stream\n'
+        newline += self._make_threaded_header(model) + ' {\n'
+        newline += indent + 'static bool loaded_weights = false;\n'
+        newline += indent + 'if (!loaded_weights) {\n'
+        newline += self._make_load_weights(model, indent + '    ')
+        newline += indent + '    loaded_weights = true;\n'
+        newline += indent + '}\n\n'
+        newline += indent + 'std::atomic<int> n_deadlocked(0);\n'
+        newline += indent + 'std::vector<std::thread> threads;\n\n'
+
+        for layer in model.get_layers():
+            for var in layer.get_variables():
+                if var in model_inputs or var in model_outputs:
+                    continue
+                def_cpp = var.definition_cpp()
+                if def_cpp is not None:
+                    newline += indent + def_cpp + ';\n'
+                    if var.pragma:
+                        newline += indent + '{}.set_depth({});\n'.format(var.name, var.pragma[1])
+            func = layer.get_attr('function_cpp', None)
+            if func:
+                newline += indent + 'threads.push_back(nnet::csim_thread("{}", n_deadlocked, [&]() {{ {} }}));\n'.format(layer.name, func)
+
+        newline += '\n'
+        newline += indent + 'for (unsigned i = 0; i < threads.size(); i++) {\n'
+        newline += indent + '    threads[i].join();\n'
+        newline += indent + '}\n'
+        newline += indent + 'return n_deadlocked;\n'
+        newline += '}\n'
+        newline += '#endif\n'
+
+        return newline
+
     def write_project_cpp(self, model):
         ###################
         ## myproject.cpp
@@ -106,7 +335,7 @@ class VivadoWriter(Writer):
 
         model_inputs = model.get_input_variables()
         model_outputs = model.get_output_variables()
-        model_brams = [var for var in model.get_weight_variables() if var.storage.lower() == 'bram']
+        model_brams = [var for var in model.get_weight_variables() if var.storage.lower() in ['bram', 'offchip']]
 
         indent = '    '
 
@@ -127,31 +356,28 @@ class VivadoWriter(Writer):
                 newline += '\n'
 
             elif '//hls-fpga-machine-learning insert load weights' in line:
-                newline = line
-                for layer in model.get_layers():
-                    for w in layer.get_weights():
-                        if w.weight_class == 'CompressedWeightVariable':
-                            newline += indent + '    nnet::load_compressed_weights_from_txt<{}, {}>({}, "{}.txt");\n'.format(w.type.name, w.nonzeros, w.name, w.name)
-                        elif w.weight_class == 'ExponentWeightVariable':
-                            newline += indent + '    nnet::load_exponent_weights_from_txt<{}, {}>({}, "{}.txt");\n'.format(w.type.name, w.data_length, w.name, w.name)
-                        else:
-                            newline += indent + '    nnet::load_weights_from_txt<{}, {}>({}, "{}.txt");\n'.format(w.type.name, w.data_length, w.name, w.name)
+                newline = line + self._make_load_weights(model, indent + '    ')
 
             #Add input/output type
             elif '//hls-fpga-machine-learning insert IO' in line:
                 newline = line
                 all_inputs = [i.cppname for i in model_inputs]
                 all_outputs = [o.cppname for o in model_outputs]
-                all_brams = [b.cppname for b in model_brams]
+                all_brams = [b.cppname for b in model_brams if b.storage.lower() == 'bram']
+                model_offchip = [b for b in model_brams if b.storage.lower() == 'offchip']
                 io_type = model.config.get_config_value("IOType")
 
+                # The off-chip weights share one memory port
+                for w in model_offchip:
+                    newline += indent + '#pragma HLS INTERFACE m_axi port={} offset=slave bundle=weights depth={} max_read_burst_length=256\n'.format(w.cppname, w.data_length)
+
                 if io_type == 'io_parallel':
                     for i in model_inputs: newline += indent + self._make_array_pragma(i) + '\n'
                     for o in model_outputs: newline += indent + self._make_array_pragma(o) + '\n'
                     # TODO discussed adding a handle for setting the interface mode for individual input and output arrays (16.03.2020)
                     # Probably the handle doesn't need to be exposed to the user but should be just set in hls_model.py
                     newline += indent + '#pragma HLS INTERFACE ap_vld port={},{} \n'.format(','.join(all_inputs), ','.join(all_outputs))
-                    if model.config.model_strategy.lower() == 'resource':
+                    if model.config.model_strategy.lower() == 'resource' or model_offchip:
                         newline += indent + '#pragma HLS DATAFLOW \n'
                     else:
                         newline += indent + '#pragma HLS PIPELINE \n'
@@ -161,32 +387,17 @@ class VivadoWriter(Writer):
                         newline += indent + '#pragma HLS INTERFACE bram port={} \n'.format(','.join(all_brams))
                     newline += indent + '#pragma HLS DATAFLOW \n'
 
+            elif '//hls-fpga-machine-learning insert batch' in line:
+                newline = self._make_batch_function(model)
+
             elif '//hls-fpga-machine-learning insert layers' in line:
-                newline = line + '\n'
-                for layer in model.get_layers():
-                    vars = layer.get_variables()
-                    for var in vars:
-                        if var not in model_inputs and var not in model_outputs:
-                            def_cpp = var.definition_cpp()
-                            if def_cpp is not None:
-                                newline += '    ' + def_cpp + ';\n'
-                                if var.pragma:
-                                    newline += '    ' + self._make_array_pragma(var) + '\n'
-                    func = layer.get_attr('function_cpp', None)
-                    if func:
-                        func = [func]
-                        if len(func) == 1:
-                            newline += '    ' + func[0] + ' // ' + layer.name + '\n'
-                        else:
-                            newline += '// ' + layer.name + '\n'
-                            for line in func:
-                                newline += '    ' + line + '\n'
-                        if model.config.trace_output and layer.get_attr('Trace', False):
-                            newline += '#ifndef __SYNTHESIS__\n'
-                            for var in vars:
-                                newline += '    nnet::save_layer_output<{}>({}, "{}", {});\n'.format(var.type.name, var.name, layer.name, var.size_cpp())
-                            newline += '#endif\n'
-                        newline += '\n'
+                newline = line + '\n' + self._make_layers(model)
+
+            elif '//hls-fpga-machine-learning insert stateful' in line:
+                newline = self._make_stateful_function(model)
+
+            elif '//hls-fpga-machine-learning insert threaded' in line:
+                newline = self._make_threaded_function(model)
 
             #Just copy line
             else:
@@ -208,7 +419,7 @@ class VivadoWriter(Writer):
 
         model_inputs = model.get_input_variables()
         model_outputs = model.get_output_variables()
-        model_brams = [var for var in model.get_weight_variables() if var.storage.lower() == 'bram']
+        model_brams = [var for var in model.get_weight_variables() if var.storage.lower() in ['bram', 'offchip']]
 
         indent = '    '
 
@@ -229,6 +440,33 @@ class VivadoWriter(Writer):
                 if len(model_brams) > 0:
                     newline += ',\n' + brams_str
                 newline += '\n'
+            elif '//hls-fpga-machine-learning insert stateful' in line:
+                newline = ''
+                if self._has_stateful_function(model):
+                    prj = model.config.get_project_name()
+                    newline += '#ifndef __SYNTHESIS__\n'
+                    newline += '// Stateful C simulation, the recurrent layers continue from the state of the previous call\n'
+                    newline += 'struct {}_state;\n'.format(prj)
+                    newline += '{prj}_state *{prj}_state_create();\n'.format(prj=prj)
+                    newline += 'void {prj}_state_free({prj}_state *state);\n'.format(prj=prj)
+                    newline += 'void {prj}_state_reset({prj}_state *state);\n'.format(prj=prj)
+                    newline += self._make_stateful_header(model) + ';\n'
+                    newline += '#endif\n'
+            elif '//hls-fpga-machine-learning insert threaded' in line:
+                newline = ''
+                if self._has_threaded_function(model):
+                    newline += '#if !defined(__SYNTHESIS__) && defined(HLS_STREAM_THREAD_SAFE)\n'
+                    newline += '// Threaded C simulation\n'
+                    newline += self._make_threaded_header(model) + ';\n'
+                    newline += '#endif\n'
+            elif '//hls-fpga-machine-learning insert batch' in line:
+                newline = ''
+                if self._has_batch_function(model):
+                    newline += '#ifndef __SYNTHESIS__\n'
+                    newline += '#include <vector>\n\n'
+                    newline += '// Batched C simulation\n'
+                    newline += self._make_batch_header(model) + ';\n'
+                    newline += '#endif\n'
             else:
                 newline = line
             fout.write(newline)
@@ -284,7 +522,7 @@ class VivadoWriter(Writer):
                 newline = line
                 for layer in model.get_layers():
                     for w in layer.get_weights():
-                        if w.storage.lower() != 'bram':
+                        if w.storage.lower() not in ['bram', 'offchip']:
                             newline += '#include "weights/{}.h"\n'.format(w.name)
 
             elif "//hls-fpga-machine-learning insert layer-config" in line:
@@ -361,7 +599,7 @@ class VivadoWriter(Writer):
 
         model_inputs = model.get_input_variables()
         model_outputs = model.get_output_variables()
-        model_brams = [var for var in model.get_weight_variables() if var.storage.lower() == 'bram']
+        model_brams = [var for var in model.get_weight_variables() if var.storage.lower() in ['bram', 'offchip']]
 
         for line in f.readlines():
             indent = ' ' * (len(line) - len(line.lstrip(' ')))
@@ -373,6 +611,8 @@ class VivadoWriter(Writer):
                 newline = line
                 for bram in model_brams:
                     newline += '#include \"firmware/weights/{}.h\"\n'.format(bram.cppname)
+                if any(b.storage.lower() == 'offchip' for b in model_brams):
+                    newline += '#include \"firmware/nnet_utils/nnet_dense_offchip.h\"\n'
             elif '//hls-fpga-machine-learning insert data' in line:
                 newline = line
                 offset = 0
@@ -413,6 +653,13 @@ class VivadoWriter(Writer):
                 newline = line
                 for out in model_outputs:
                     newline += indent + 'nnet::print_result<{}, {}>({}, fout);\n'.format(out.type.name, out.size_cpp(), out.cppname) #TODO enable this
+            elif '//hls-fpga-machine-learning insert offchip' in line:
+                newline = ''
+                if any(b.storage.lower() == 'offchip' for b in model_brams):
+                    # Weight reads of the memory model, see nnet_dense_offchip.h
+                    newline += indent + 'nnet::offchip_memory_model &memory = nnet::offchip_memory();\n'
+                    newline += indent + 'std::cout << "INFO: Off-chip weights: " << memory.n_bytes << " bytes in " << memory.n_bursts << " bursts, "\n'
+                    newline += indent + '          << memory.n_beats << " beats, about " << memory.cycles() << " cycles of the memory port" << std::endl;\n'
             elif '//hls-fpga-machine-learning insert output' in line or '//hls-fpga-machine-learning insert quantized' in line:
                 newline = line
                 for out in model_outputs:
@@ -423,6 +670,51 @@ class VivadoWriter(Writer):
         f.close()
         fout.close()
 
+    @staticmethod
+    def _make_bridge_wrapper(model, dtype, function, include_brams=False, state_arg=None, result=None):
+        model_inputs = model.get_input_variables()
+        model_outputs = model.get_output_variables()
+        model_brams = [var for var in model.get_weight_variables() if var.storage.lower() in ['bram', 'offchip']]
+
+        indent = '    '
+
+        newline = ''
+        for i in model_inputs:
+            newline += indent + '{var};\n'.format(var=i.definition_cpp(name_suffix='_ap'))
+            newline += indent + 'nnet::convert_data<{}, {}, {}>({}, {}_ap);\n'.format(dtype, i.type.name, i.size_cpp(), i.cppname, i.cppname)
+        newline += '\n'
+
+        for o in model_outputs:
+            newline += indent + '{var};\n'.format(var=o.definition_cpp(name_suffix='_ap'))
+
+        newline += '\n'
+
+        input_vars = ','.join([i.cppname + '_ap' for i in model_inputs])
+        bram_vars   =','.join([b.cppname for b in model_brams]) if include_brams else ''
+        output_vars = ','.join([o.cppname + '_ap' for o in model_outputs])
+
+        # Concatenate the input, output, and bram variables. Filter out empty/null values
+        all_vars = ','.join(filter(None, [state_arg, input_vars, output_vars, bram_vars]))
+
+        top_level = indent + '{}({});\n'.format(function, all_vars)
+        if result is not None:
+            top_level = indent + '{} = {}({});\n'.format(result, function, all_vars)
+        newline += top_level
+
+        newline += '\n'
+
+        # With a result, the outputs are only converted if the function returned zero (success)
+        out_indent = indent
+        if result is not None:
+            newline += indent + 'if ({} == 0) {{\n'.format(result)
+            out_indent = indent * 2
+        for o in model_outputs:
+            newline += out_indent + 'nnet::convert_data<{}, {}, {}>({}_ap, {});\n'.format(o.type.name, dtype, o.size_cpp(), o.cppname, o.cppname)
+        if result is not None:
+            newline += indent + '}\n'
+
+        return newline
+
     def write_bridge(self, model):
         ###################
         # c++-python bridge
@@ -434,7 +726,7 @@ class VivadoWriter(Writer):
 
         model_inputs = model.get_input_variables()
         model_outputs = model.get_output_variables()
-        model_brams = [var for var in model.get_weight_variables() if var.storage.lower() == 'bram']
+        model_brams = [var for var in model.get_weight_variables() if var.storage.lower() in ['bram', 'offchip']]
 
         indent = '    '
 
@@ -457,32 +749,87 @@ class VivadoWriter(Writer):
                 newline += indent + inputs_str + ',\n'
                 newline += indent + outputs_str + '\n'
             elif '//hls-fpga-machine-learning insert wrapper' in line:
+                dtype = line.split('#', 1)[1].strip()
+                newline = self._make_bridge_wrapper(model, dtype, model.config.get_project_name(), include_brams=True)
+            elif '//hls-fpga-machine-learning insert stateful' in line:
                 dtype = line.split('#', 1)[1].strip()
                 newline = ''
-                for i in model_inputs:
-                    newline += indent + '{var};\n'.format(var=i.definition_cpp(name_suffix='_ap'))
-                    newline += indent + 'nnet::convert_data<{}, {}, {}>({}, {}_ap);\n'.format(dtype, i.type.name, i.size_cpp(), i.cppname, i.cppname)
-                newline += '\n'
-
-                for o in model_outputs:
-                    newline += indent + '{var};\n'.format(var=o.definition_cpp(name_suffix='_ap'))
-
-                newline += '\n'
-
-                input_vars = ','.join([i.cppname + '_ap' for i in model_inputs])
-                bram_vars   =','.join([b.cppname for b in model_brams])
-                output_vars = ','.join([o.cppname + '_ap' for o in model_outputs])
-
-                # Concatenate the input, output, and bram variables. Filter out empty/null values
-                all_vars = ','.join(filter(None, [input_vars, output_vars, bram_vars]))
-
-                top_level = indent + '{}({});\n'.format(model.config.get_project_name(), all_vars)
-                newline += top_level
-
-                newline += '\n'
-
-                for o in model_outputs:
-                    newline += indent + 'nnet::convert_data<{}, {}, {}>({}_ap, {});\n'.format(o.type.name, dtype, o.size_cpp(), o.cppname, o.cppname)
+                if self._has_stateful_function(model):
+                    prj = model.config.get_project_name()
+                    inputs_str = ', '.join(['{type} {name}[{shape}]'.format(type=dtype, name=i.cppname, shape=i.size_cpp()) for i in model_inputs])
+                    outputs_str = ', '.join(['{type} {name}[{shape}]'.format(type=dtype, name=o.cppname, shape=o.size_cpp()) for o in model_outputs])
+                    newline += 'void {}_step_{}(\n'.format(prj, dtype)
+                    newline += indent + 'void *state,\n'
+                    newline += indent + inputs_str + ',\n'
+                    newline += indent + outputs_str + '\n'
+                    newline += ') {\n'
+                    newline += self._make_bridge_wrapper(model, dtype, prj + '_stateful', state_arg='({}_state *) state'.format(prj))
+                    newline += '}\n\n'
+            elif '//hls-fpga-machine-learning insert threaded' in line:
+                dtype = line.split('#', 1)[1].strip()
+                newline = ''
+                if self._has_threaded_function(model):
+                    prj = model.config.get_project_name()
+                    inputs_str = ', '.join(['{type} {name}[{shape}]'.format(type=dtype, name=i.cppname, shape=i.size_cpp()) for i in model_inputs])
+                    outputs_str = ', '.join(['{type} {name}[{shape}]'.format(type=dtype, name=o.cppname, shape=o.size_cpp()) for o in model_outputs])
+                    newline += '#ifdef HLS_STREAM_THREAD_SAFE\n'
+                    newline += 'int {}_threaded_{}(\n'.format(prj, dtype)
+                    newline += indent + inputs_str + ',\n'
+                    newline += indent + outputs_str + '\n'
+                    newline += ') {\n'
+                    newline += indent + 'int n_deadlocked;\n'
+                    newline += self._make_bridge_wrapper(model, dtype, prj + '_threaded', result='n_deadlocked')
+                    newline += indent + 'return n_deadlocked;\n'
+                    newline += '}\n'
+                    newline += '#endif\n'
+            elif '//hls-fpga-machine-learning insert state handles' in line:
+                newline = ''
+                if self._has_stateful_function(model):
+                    prj = model.config.get_project_name()
+                    newline += 'void *{}_create_state() {{\n'.format(prj)
+                    newline += indent + '{prj}_state *state = {prj}_state_create();\n'.format(prj=prj)
+                    # Load the weights and fill the lookup tables of the activations before the state is used from several threads
+                    for i in model_inputs:
+                        newline += indent + 'double {}[{}] = {{0}};\n'.format(i.cppname, i.size_cpp())
+                    for o in model_outputs:
+                        newline += indent + 'double {}[{}];\n'.format(o.cppname, o.size_cpp())
+                    all_vars = ', '.join([var.cppname for var in model_inputs + model_outputs])
+                    newline += indent + '{}_step_double(state, {});\n'.format(prj, all_vars)
+                    newline += indent + '{}_state_reset(state);\n'.format(prj)
+                    newline += indent + 'return state;\n'
+                    newline += '}\n\n'
+                    newline += 'void {}_free_state(void *state) {{\n'.format(prj)
+                    newline += indent + '{prj}_state_free(({prj}_state *) state);\n'.format(prj=prj)
+                    newline += '}\n\n'
+                    newline += 'void {}_reset_state(void *state) {{\n'.format(prj)
+                    newline += indent + '{prj}_state_reset(({prj}_state *) state);\n'.format(prj=prj)
+                    newline += '}\n'
+            elif '//hls-fpga-machine-learning insert batch' in line:
+                dtype = line.split('#', 1)[1].strip()
+                newline = ''
+                if self._has_batch_function(model):
+                    inputs_str = ', '.join(['{} {}[]'.format(dtype, i.cppname) for i in model_inputs])
+                    outputs_str = ', '.join(['{} {}[]'.format(dtype, o.cppname) for o in model_outputs])
+                    newline += 'void {}_batch_{}(\n'.format(model.config.get_project_name(), dtype)
+                    newline += indent + inputs_str + ',\n'
+                    newline += indent + outputs_str + ',\n'
+                    newline += indent + 'unsigned n_samples\n'
+                    newline += ') {\n'
+                    for var in model_inputs + model_outputs:
+                        newline += indent + 'std::vector<{}> {}_ap(n_samples * {});\n'.format(var.type.name, var.cppname, var.size_cpp())
+                    newline += indent + 'for (unsigned i_sample = 0; i_sample < n_samples; i_sample++) {\n'
+                    for i in model_inputs:
+                        newline += indent + '    nnet::convert_data<{dtype}, {type}, {size}>(&{name}[i_sample * ({size})], &{name}_ap[i_sample * ({size})]);\n'.format(dtype=dtype, type=i.type.name, size=i.size_cpp(), name=i.cppname)
+                    newline += indent + '}\n\n'
+
+                    all_vars = ', '.join(['{}_ap.data()'.format(var.cppname) for var in model_inputs + model_outputs])
+                    newline += indent + '{}_batch(n_samples, {});\n\n'.format(model.config.get_project_name(), all_vars)
+
+                    newline += indent + 'for (unsigned i_sample = 0; i_sample < n_samples; i_sample++) {\n'
+                    for o in model_outputs:
+                        newline += indent + '    nnet::convert_data<{type}, {dtype}, {size}>(&{name}_ap[i_sample * ({size})], &{name}[i_sample * ({size})]);\n'.format(dtype=dtype, type=o.type.name, size=o.size_cpp(), name=o.cppname)
+                    newline += indent + '}\n'
+                    newline += '}\n'
             elif '//hls-fpga-machine-learning insert trace_outputs' in line:
                 newline = ''
                 for layer in model.get_layers():
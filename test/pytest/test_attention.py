@@ -0,0 +1,126 @@
+import pytest
+from tensorflow.keras.models import Model, Sequential
+from tensorflow.keras.layers import Input, LayerNormalization, MultiHeadAttention
+import numpy as np
+import hls4ml
+
+
+seq_len = 8
+feature_dim = 16
+seq_len_kv = 6
+feature_dim_kv = 12
+
+
+@pytest.fixture(scope='module')
+def data():
+    np.random.seed(0)
+    X = np.random.rand(100, seq_len, feature_dim) * 4 - 2
+    X_kv = np.random.rand(100, seq_len_kv, feature_dim_kv) * 2 - 1
+    return X, X_kv
+
+
+@pytest.fixture(scope='module')
+def layernorm_model():
+    model = Sequential()
+    model.add(LayerNormalization(input_shape=(seq_len, feature_dim), epsilon=1e-3))
+    model.compile()
+    # Non-trivial scale and offset
+    gamma, beta = model.layers[0].get_weights()
+    model.layers[0].set_weights([np.random.uniform(0.5, 1.5, size=gamma.shape), np.random.uniform(-0.5, 0.5, size=beta.shape)])
+    return model
+
+
+@pytest.fixture(scope='module')
+def self_attention_model():
+    x = Input(shape=(seq_len, feature_dim))
+    y = LayerNormalization()(x)
+    y = MultiHeadAttention(num_heads=2, key_dim=4, value_dim=6)(y, y)
+    model = Model(inputs=x, outputs=y)
+    model.compile()
+    return model
+
+
+@pytest.fixture(scope='module')
+def cross_attention_model():
+    x = Input(shape=(seq_len, feature_dim))
+    x_kv = Input(shape=(seq_len_kv, feature_dim_kv))
+    y = MultiHeadAttention(num_heads=2, key_dim=4, output_shape=10)(x, x_kv)
+    model = Model(inputs=[x, x_kv], outputs=y)
+    model.compile()
+    return model
+
+
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+def test_layernorm(layernorm_model, data, io_type):
+    model = layernorm_model
+    X, _ = data
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<32,10>', granularity='name')
+    hls_model = hls4ml.converters.convert_from_keras_model(model,
+                                                           hls_config=config,
+                                                           io_type=io_type,
+                                                           output_dir=f'hls4mlprj_layernorm_{io_type}',
+                                                           part='xcvu9p-flgb2104-2-i')
+    hls_model.compile()
+
+    y_keras = model.predict(X)
+    y_hls = hls_model.predict(X).reshape(y_keras.shape)
+    np.testing.assert_allclose(y_keras, y_hls, rtol=0, atol=1e-2, verbose=True)
+
+
+# Variances far past the range of the inverse square root table
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+def test_layernorm_large_variance(layernorm_model, data, io_type):
+    model = layernorm_model
+    X = data[0] * 10
+    assert np.all(X.var(axis=-1) > 4)
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<32,10>', granularity='name')
+    hls_model = hls4ml.converters.convert_from_keras_model(model,
+                                                           hls_config=config,
+                                                           io_type=io_type,
+                                                           output_dir=f'hls4mlprj_layernorm_large_variance_{io_type}',
+                                                           part='xcvu9p-flgb2104-2-i')
+    hls_model.compile()
+
+    y_keras = model.predict(X)
+    y_hls = hls_model.predict(X).reshape(y_keras.shape)
+    np.testing.assert_allclose(y_keras, y_hls, rtol=0, atol=1e-2, verbose=True)
+
+
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+@pytest.mark.parametrize('reuse_factor', [1, 4])
+def test_self_attention(self_attention_model, data, io_type, reuse_factor):
+    model = self_attention_model
+    X, _ = data
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<16,6>', default_reuse_factor=reuse_factor, granularity='name')
+    hls_model = hls4ml.converters.convert_from_keras_model(model,
+                                                           hls_config=config,
+                                                           io_type=io_type,
+                                                           output_dir=f'hls4mlprj_self_attention_{io_type}_rf{reuse_factor}',
+                                                           part='xcvu9p-flgb2104-2-i')
+    hls_model.compile()
+
+    y_keras = model.predict(X)
+    y_hls = hls_model.predict(X).reshape(y_keras.shape)
+    # The softmax is computed with lookup tables, compare relative to the range of the output
+    np.testing.assert_allclose(y_keras, y_hls, rtol=0, atol=0.05 * np.max(np.abs(y_keras)), verbose=True)
+
+
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+def test_cross_attention(cross_attention_model, data, io_type):
+    model = cross_attention_model
+    X, X_kv = data
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<16,6>', granularity='name')
+    hls_model = hls4ml.converters.convert_from_keras_model(model,
+                                                           hls_config=config,
+                                                           io_type=io_type,
+                                                           output_dir=f'hls4mlprj_cross_attention_{io_type}',
+                                                           part='xcvu9p-flgb2104-2-i')
+    hls_model.compile()
+
+    y_keras = model.predict([X, X_kv])
+    y_hls = hls_model.predict([np.ascontiguousarray(X), np.ascontiguousarray(X_kv)]).reshape(y_keras.shape)
+    np.testing.assert_allclose(y_keras, y_hls, rtol=0, atol=0.05 * np.max(np.abs(y_keras)), verbose=True)
@@ -0,0 +1,67 @@
+import pytest
+import hls4ml
+import tensorflow as tf
+import numpy as np
+from pathlib import Path
+from tensorflow.keras.layers import Conv1D, Conv2D
+
+test_root_path = Path(__file__).parent
+
+strategy_options = ['Latency', 'Resource']
+
+@pytest.mark.parametrize("padds", ['valid', 'same'])
+@pytest.mark.parametrize("pf", [2, 4])
+@pytest.mark.parametrize("strategy", strategy_options)
+def test_parallelconv1d(padds, pf, strategy):
+    model = tf.keras.models.Sequential()
+    input_shape = (32, 3)
+    model.add(Conv1D(filters=4,
+                     kernel_size=(5,),
+                     padding=padds,
+                     input_shape=input_shape,
+                     kernel_initializer='normal',
+                     bias_initializer='normal'
+                     ))
+
+    model.compile(optimizer='adam', loss='mse')
+    X_input = np.random.rand(100, *input_shape)
+    keras_prediction = model.predict(X_input)
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<32,16>', granularity='name')
+    config['Model']['Strategy'] = strategy
+    config['LayerName'][model.layers[0].name]['ParallelizationFactor'] = pf
+    output_dir = str(test_root_path / 'hls4mlprj_parallelconv1d_{}_pf_{}_{}'.format(padds, pf, strategy))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=output_dir, io_type='io_stream')
+    hls_model.compile()
+    hls_prediction = hls_model.predict(X_input).reshape(keras_prediction.shape)
+
+    assert 'Repack' in [layer.class_name for layer in hls_model.get_layers()]
+    np.testing.assert_allclose(hls_prediction, keras_prediction, rtol=0, atol=0.001)
+
+@pytest.mark.parametrize("padds", ['valid', 'same'])
+@pytest.mark.parametrize("pf", [2, 4])
+@pytest.mark.parametrize("strategy", strategy_options)
+def test_parallelconv2d(padds, pf, strategy):
+    model = tf.keras.models.Sequential()
+    # Padded input width and number of output pixels must be divisible by the parallelization factor
+    input_shape = (16, 16, 3) if padds == 'valid' else (14, 14, 3)
+    model.add(Conv2D(filters=4,
+                     kernel_size=(3, 3),
+                     padding=padds,
+                     input_shape=input_shape,
+                     kernel_initializer='normal',
+                     bias_initializer='normal'
+                     ))
+
+    model.compile(optimizer='adam', loss='mse')
+    X_input = np.random.rand(100, *input_shape)
+    keras_prediction = model.predict(X_input)
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<32,16>', granularity='name')
+    config['Model']['Strategy'] = strategy
+    config['LayerName'][model.layers[0].name]['ParallelizationFactor'] = pf
+    output_dir = str(test_root_path / 'hls4mlprj_parallelconv2d_{}_pf_{}_{}'.format(padds, pf, strategy))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=output_dir, io_type='io_stream')
+    hls_model.compile()
+    hls_prediction = hls_model.predict(X_input).reshape(keras_prediction.shape)
+
+    assert 'Repack' in [layer.class_name for layer in hls_model.get_layers()]
+    np.testing.assert_allclose(hls_prediction, keras_prediction, rtol=0, atol=0.001)
@@ -0,0 +1,77 @@
+import pytest
+from tensorflow.keras.models import Sequential
+from tensorflow.keras.layers import Conv1DTranspose, Conv2DTranspose
+import numpy as np
+import hls4ml
+from pathlib import Path
+
+test_root_path = Path(__file__).parent
+
+in_height = 5
+in_width = 6
+in_feat = 3
+n_filt = 4
+
+atol = 5e-3
+
+@pytest.fixture(scope='module')
+def data_1d():
+    X = np.random.rand(100, in_width, in_feat)
+    return X
+
+@pytest.fixture(scope='module')
+def data_2d():
+    X = np.random.rand(100, in_height, in_width, in_feat)
+    return X
+
+
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+@pytest.mark.parametrize('strategy', ['Latency', 'Resource'])
+@pytest.mark.parametrize('padding', ['valid', 'same'])
+@pytest.mark.parametrize('kernel_size,strides', [(3, 2), (4, 2), (2, 3)])
+def test_conv1d_transpose(data_1d, kernel_size, strides, padding, strategy, io_type):
+    model = Sequential()
+    model.add(Conv1DTranspose(n_filt, kernel_size=kernel_size, strides=strides, padding=padding, input_shape=(in_width, in_feat),
+                              kernel_initializer='normal', bias_initializer='normal'))
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<24,10>', granularity='name')
+    config['Model']['Strategy'] = strategy
+    odir = str(test_root_path / f'hls4mlprj_conv1d_transpose_{kernel_size}_{strides}_{padding}_{strategy}_{io_type}')
+    hls_model = hls4ml.converters.convert_from_keras_model(model,
+                                                           hls_config=config,
+                                                           io_type=io_type,
+                                                           output_dir=odir,
+                                                           part='xcvu9p-flgb2104-2-i')
+    hls_model.compile()
+
+    y_keras = model.predict(data_1d).flatten()
+    y_hls = hls_model.predict(data_1d).flatten()
+    np.testing.assert_allclose(y_keras, y_hls, rtol=0, atol=atol, verbose=True)
+
+
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+@pytest.mark.parametrize('strategy', ['Latency', 'Resource'])
+@pytest.mark.parametrize('padding', ['valid', 'same'])
+@pytest.mark.parametrize('kernel_size,strides', [((3, 3), (2, 2)), ((4, 3), (2, 3)), ((1, 2), (2, 2))])
+def test_conv2d_transpose(data_2d, kernel_size, strides, padding, strategy, io_type):
+    model = Sequential()
+    model.add(Conv2DTranspose(n_filt, kernel_size=kernel_size, strides=strides, padding=padding, input_shape=(in_height, in_width, in_feat),
+                              kernel_initializer='normal', bias_initializer='normal'))
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<24,10>', granularity='name')
+    config['Model']['Strategy'] = strategy
+    kernel_str = '{}x{}'.format(*kernel_size)
+    stride_str = '{}x{}'.format(*strides)
+    odir = str(test_root_path / f'hls4mlprj_conv2d_transpose_{kernel_str}_{stride_str}_{padding}_{strategy}_{io_type}')
+    hls_model = hls4ml.converters.convert_from_keras_model(model,
+                                                           hls_config=config,
+                                                           io_type=io_type,
+                                                           output_dir=odir,
+                                                           part='xcvu9p-flgb2104-2-i')
+    hls_model.compile()
+
+    y_keras = model.predict(data_2d).flatten()
+    y_hls = hls_model.predict(data_2d).flatten()
+    np.testing.assert_allclose(y_keras, y_hls, rtol=0, atol=atol, verbose=True)
@@ -0,0 +1,68 @@
+import pytest
+import hls4ml
+import tensorflow as tf
+import numpy as np
+from pathlib import Path
+from tensorflow.keras.layers import Conv1D, Conv2D
+
+test_root_path = Path(__file__).parent
+
+io_type_options = ['io_parallel', 'io_stream']
+strategy_options = ['Latency', 'Resource']
+
+@pytest.mark.parametrize("padds", ['valid', 'same', 'causal'])
+@pytest.mark.parametrize("dilation", [(2,), (4,)])
+@pytest.mark.parametrize("io_type", io_type_options)
+@pytest.mark.parametrize("strategy", strategy_options)
+def test_dilatedconv1d(padds, dilation, io_type, strategy):
+    model = tf.keras.models.Sequential()
+    input_shape = (32, 3)
+    model.add(Conv1D(filters=4,
+                     kernel_size=(3,),
+                     dilation_rate=dilation,
+                     padding=padds,
+                     input_shape=input_shape,
+                     kernel_initializer='normal',
+                     bias_initializer='normal'
+                     ))
+
+    model.compile(optimizer='adam', loss='mse')
+    X_input = np.random.rand(100, *input_shape)
+    keras_prediction = model.predict(X_input)
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<32,16>')
+    config['Model']['Strategy'] = strategy
+    output_dir = str(test_root_path / 'hls4mlprj_dilatedconv1d_{}_dilation_{}_{}_{}'.format(padds, dilation[0], io_type, strategy))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=output_dir, io_type=io_type)
+    hls_model.compile()
+    hls_prediction = hls_model.predict(X_input).reshape(keras_prediction.shape)
+
+    np.testing.assert_allclose(hls_prediction, keras_prediction, rtol=0, atol=0.001)
+
+@pytest.mark.parametrize("padds", ['valid', 'same'])
+@pytest.mark.parametrize("dilation", [(2, 2), (1, 3)])
+@pytest.mark.parametrize("io_type", io_type_options)
+@pytest.mark.parametrize("strategy", strategy_options)
+def test_dilatedconv2d(padds, dilation, io_type, strategy):
+    model = tf.keras.models.Sequential()
+    input_shape = (16, 16, 3)
+    model.add(Conv2D(filters=4,
+                     kernel_size=(3, 3),
+                     dilation_rate=dilation,
+                     padding=padds,
+                     input_shape=input_shape,
+                     kernel_initializer='normal',
+                     bias_initializer='normal'
+                     ))
+
+    model.compile(optimizer='adam', loss='mse')
+    X_input = np.random.rand(100, *input_shape)
+    keras_prediction = model.predict(X_input)
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<32,16>')
+    config['Model']['Strategy'] = strategy
+    dilation_cfg = str(dilation).replace(', ', '_').replace('(', '').replace(')', '')
+    output_dir = str(test_root_path / 'hls4mlprj_dilatedconv2d_{}_dilation_{}_{}_{}'.format(padds, dilation_cfg, io_type, strategy))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=output_dir, io_type=io_type)
+    hls_model.compile()
+    hls_prediction = hls_model.predict(X_input).reshape(keras_prediction.shape)
+
+    np.testing.assert_allclose(hls_prediction, keras_prediction, rtol=0, atol=0.001)
@@ -53,3 +53,30 @@ def test_embedding_accuracy(data, keras_model, hls_model):
     y_hls4ml   = hls_model.predict(X.astype(np.float)).reshape(y_keras.shape)
     # "accuracy" of hls4ml predictions vs keras
     np.testing.assert_allclose(y_keras, y_hls4ml, rtol=0, atol=1e-03, verbose=True)
+
+
+@pytest.mark.parametrize('backend, io_type', [
+                            ('Vivado', 'io_parallel'),
+                            ('Vivado', 'io_stream'),
+                            ('Quartus', 'io_parallel')
+                        ])
+@pytest.mark.parametrize('reuse_factor, read_ports', [(1, None), (4, 6), (10, None)])
+def test_embedding_banked(data, keras_model, backend, io_type, reuse_factor, read_ports):
+    hls_config = hls4ml.utils.config_from_keras_model(keras_model,
+                                                      default_precision='ap_fixed<16,6>',
+                                                      granularity='name')
+    hls_config['LayerName']['embedding_input']['Precision']['result'] = 'ap_uint<4>'
+    hls_config['LayerName']['embedding']['ReuseFactor'] = reuse_factor
+    if read_ports is not None:
+        hls_config['LayerName']['embedding']['ReadPorts'] = read_ports
+    out_dir = str(test_root_path / 'hls4mlprj_embed_banked_{}_{}_{}_{}').format(backend, io_type, reuse_factor, read_ports)
+    hls_model = hls4ml.converters.convert_from_keras_model(keras_model,
+                                                           backend=backend,
+                                                           hls_config=hls_config,
+                                                           io_type=io_type,
+                                                           output_dir=out_dir)
+    hls_model.compile()
+
+    y_keras = keras_model.predict(data)
+    y_hls4ml = hls_model.predict(data.astype(np.float)).reshape(y_keras.shape)
+    np.testing.assert_allclose(y_keras, y_hls4ml, rtol=0, atol=1e-03, verbose=True)
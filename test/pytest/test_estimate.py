@@ -0,0 +1,118 @@
+import pytest
+import hls4ml
+import tensorflow as tf
+import numpy as np
+from pathlib import Path
+from tensorflow.keras.layers import Dense, Conv2D
+
+test_root_path = Path(__file__).parent
+
+@pytest.mark.parametrize("strategy", ['Latency', 'Resource'])
+def test_estimate_dense(strategy):
+    model = tf.keras.models.Sequential()
+    model.add(Dense(16, input_shape=(32,), activation='relu'))
+    model.add(Dense(8))
+    model.compile(optimizer='adam', loss='mse')
+
+    estimates = []
+    for rf in [1, 4, 16]:
+        config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<16,6>')
+        config['Model']['Strategy'] = strategy
+        config['Model']['ReuseFactor'] = rf
+        output_dir = str(test_root_path / 'hls4mlprj_estimate_dense_{}_rf{}'.format(strategy, rf))
+        hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=output_dir)
+        estimate = hls_model.estimate()
+
+        assert set(estimate['Layers'].keys()) == set(layer.name for layer in hls_model.get_layers())
+        assert estimate['CriticalPath'][-1] == list(hls_model.get_layers())[-1].name
+        assert estimate['Interval'] == rf
+        estimates.append(estimate)
+
+    # Fewer multipliers and longer latency with increasing reuse factor
+    assert estimates[0]['DSP'] > estimates[1]['DSP'] > estimates[2]['DSP']
+    assert estimates[0]['Latency'] < estimates[1]['Latency'] < estimates[2]['Latency']
+
+def test_estimate_conv_stream():
+    model = tf.keras.models.Sequential()
+    model.add(Conv2D(4, kernel_size=(3, 3), input_shape=(16, 16, 3)))
+    model.compile(optimizer='adam', loss='mse')
+
+    estimates = []
+    for pf in [1, 2]:
+        config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<16,6>', granularity='name')
+        config['LayerName'][model.layers[0].name]['ParallelizationFactor'] = pf
+        output_dir = str(test_root_path / 'hls4mlprj_estimate_conv_stream_pf{}'.format(pf))
+        hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=output_dir, io_type='io_stream')
+        estimates.append(hls_model.estimate())
+
+    conv_name = model.layers[0].name
+    # One input pixel per cycle with a single multiplier array
+    assert estimates[0]['Layers'][conv_name]['Interval'] == 16 * 16
+    assert estimates[1]['Layers'][conv_name]['Interval'] == 16 * 16 // 2
+    assert estimates[1]['Layers'][conv_name]['DSP'] == 2 * estimates[0]['Layers'][conv_name]['DSP']
+
+@pytest.mark.parametrize("io_type", ['io_parallel', 'io_stream'])
+def test_optimize_config(io_type):
+    model = tf.keras.models.Sequential()
+    model.add(Dense(32, input_shape=(64,), activation='relu'))
+    model.add(Dense(16, activation='relu'))
+    model.add(Dense(4))
+    model.compile(optimizer='adam', loss='mse')
+    X_input = np.random.rand(100, 64)
+    keras_prediction = model.predict(X_input)
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<16,6>')
+    output_dir = str(test_root_path / 'hls4mlprj_optimize_config_{}'.format(io_type))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=output_dir, io_type=io_type)
+    assert hls_model.estimate()['DSP'] > 200
+
+    # Fit into the DSP budget
+    optimized_config = hls_model.optimize_config(dsp_budget=200)
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=optimized_config, output_dir=output_dir, io_type=io_type)
+    estimate = hls_model.estimate()
+    assert estimate['DSP'] <= 200
+    for layer in model.layers:
+        assert 'ReuseFactor' in optimized_config['LayerName'][layer.name]
+
+    hls_model.compile()
+    hls_prediction = hls_model.predict(X_input).reshape(keras_prediction.shape)
+    np.testing.assert_allclose(hls_prediction, keras_prediction, rtol=0, atol=0.05)
+
+    # Spend as few resources as possible within the latency budget
+    optimized_config = hls_model.optimize_config(latency_budget=2 * estimate['Latency'])
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=optimized_config, output_dir=output_dir, io_type=io_type)
+    relaxed_estimate = hls_model.estimate()
+    assert relaxed_estimate['Latency'] <= 2 * estimate['Latency']
+    assert relaxed_estimate['DSP'] <= estimate['DSP']
+
+@pytest.mark.parametrize("rf, part, storage, impl", [
+    (1, 'xcku115-flvb2104-2-i', 'auto', 'register'),
+    (16, 'xcku115-flvb2104-2-i', 'auto', 'lutram'),
+    (4096, 'xcku115-flvb2104-2-i', 'auto', 'bram'),
+    (4096, 'xcvu9p-flga2104-2L-e', 'auto', 'uram'),
+    (16, 'xcku115-flvb2104-2-i', 'bram', 'bram'),
+])
+def test_weight_memory(rf, part, storage, impl):
+    model = tf.keras.models.Sequential()
+    model.add(Dense(64, input_shape=(256,), name='dense'))
+    model.compile(optimizer='adam', loss='mse')
+    X_input = np.random.rand(10, 256)
+    keras_prediction = model.predict(X_input)
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<16,6>', granularity='name')
+    config['LayerName']['dense']['Strategy'] = 'Resource'
+    config['LayerName']['dense']['ReuseFactor'] = rf
+    config['LayerName']['dense']['WeightStorage'] = storage
+    output_dir = str(test_root_path / 'hls4mlprj_weight_memory_rf{}_{}_{}'.format(rf, part.split('-')[0], storage))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=output_dir, part=part)
+    hls_model.compile()
+
+    memory = hls_model.estimate()['Layers']['dense']['WeightMemory']
+    assert memory['Impl'] == impl
+    assert memory['Depth'] == rf
+    assert hls_model.graph['dense'].get_attr('weight_impl') == 'mem_' + impl
+    with open(output_dir + '/firmware/parameters.h') as f:
+        assert 'weight_impl = nnet::mem_{};'.format(impl) in f.read()
+
+    hls_prediction = hls_model.predict(X_input).reshape(keras_prediction.shape)
+    np.testing.assert_allclose(hls_prediction, keras_prediction, rtol=0, atol=0.05)
@@ -7,8 +7,14 @@ import pytest
 
 vmax = 16
 feat = 3
-@pytest.fixture(scope='module')
-def garnet_models():
+
+# With 16-bit types the C simulation of the aggregation emulates the fixed-point arithmetic with 64-bit integers,
+# 32-bit types are too wide for it and use the ap_fixed code
+precisions = [(32, 6), (16, 6)]
+
+@pytest.fixture(scope='module', params=precisions)
+def garnet_models(request):
+    width, integer = request.param
     x = Input(shape=(vmax, feat))
     n = Input(shape=(1,), dtype='uint16')
     inputs = [x, n]
@@ -21,10 +27,10 @@ def garnet_models():
     config['Model'] = {}
     config['Model']['ReuseFactor'] = 1
     config['Model']['Strategy'] = 'Latency'
-    config['Model']['Precision'] = 'ap_fixed<32,6>'
-    config['LayerName']['gar_1']['Precision'] = {'default': 'ap_fixed<32, 6, AP_RND, AP_SAT>', 'result': 'ap_fixed<32, 6>'}
+    config['Model']['Precision'] = 'ap_fixed<{},{}>'.format(width, integer)
+    config['LayerName']['gar_1']['Precision'] = {'default': 'ap_fixed<{}, {}, AP_RND, AP_SAT>'.format(width, integer), 'result': 'ap_fixed<{}, {}>'.format(width, integer)}
 
-    cfg = hls4ml.converters.create_config(output_dir='hls4mlprj_garnet', part='xc7z020clg400-1')
+    cfg = hls4ml.converters.create_config(output_dir='hls4mlprj_garnet_{}'.format(width), part='xc7z020clg400-1')
     cfg['HLSConfig'] = config
     cfg['KerasModel'] = model
     
@@ -42,3 +48,36 @@ def test_accuracy(garnet_models, batch):
     y_hls = hls_model.predict(x_hls).reshape(y.shape)
                                                                 
     np.testing.assert_allclose(y_hls, y, rtol=0, atol=0.1)
+
+@pytest.mark.parametrize('width,integer', precisions)
+@pytest.mark.parametrize('vertex_parallelism', [1, 4])
+def test_accuracy_stream(vertex_parallelism, width, integer):
+    x = Input(shape=(vmax, feat))
+    n = Input(shape=(1,), dtype='uint16')
+    inputs = [x, n]
+    outputs = GarNet(8, 8, 16, simplified=True, collapse='mean', input_format='xn',
+                     output_activation=None, name='gar_1', quantize_transforms=False)(inputs)
+    model = Model(inputs=inputs, outputs=outputs)
+
+    config = hls4ml.utils.config_from_keras_model(model, granularity='name')
+    config['Model'] = {}
+    config['Model']['ReuseFactor'] = 1
+    config['Model']['Strategy'] = 'Latency'
+    config['Model']['Precision'] = 'ap_fixed<{},{}>'.format(width, integer)
+    config['LayerName']['gar_1']['Precision'] = {'default': 'ap_fixed<{}, {}, AP_RND, AP_SAT>'.format(width, integer), 'result': 'ap_fixed<{}, {}>'.format(width, integer)}
+    config['LayerName']['gar_1']['VertexParallelism'] = vertex_parallelism
+
+    cfg = hls4ml.converters.create_config(output_dir='hls4mlprj_garnet_stream_vp{}_{}'.format(vertex_parallelism, width), part='xc7z020clg400-1', io_type='io_stream')
+    cfg['HLSConfig'] = config
+    cfg['KerasModel'] = model
+
+    hls_model = hls4ml.converters.keras_to_hls(cfg)
+    hls_model.compile()
+
+    batch = 3
+    x = [np.random.rand(batch, vmax, feat), np.random.randint(0, vmax, size=(batch, 1))]
+    y = model.predict(x)
+    x_hls = [x[0], x[1].astype(np.float64)]
+    y_hls = hls_model.predict(x_hls).reshape(y.shape)
+
+    np.testing.assert_allclose(y_hls, y, rtol=0, atol=0.1)
@@ -0,0 +1,83 @@
+import pytest
+import hls4ml
+import numpy as np
+from tensorflow.keras.models import Model
+from tensorflow.keras.layers import Input, Dense, Add, Multiply, Average, Maximum, Minimum, Concatenate
+from pathlib import Path
+
+test_root_path = Path(__file__).parent
+
+n_in = 8
+n_branches = 4
+
+atol = 5e-3
+
+@pytest.fixture(scope='module')
+def data():
+    X = np.random.rand(100, n_in)
+    return X
+
+def make_branches(inp, n_out, n):
+    # The input feeds all branches, so io_stream clones it into n streams in a single stage
+    return [Dense(n_out[i] if isinstance(n_out, list) else n_out, name='dense_{}'.format(i))(inp) for i in range(n)]
+
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+@pytest.mark.parametrize('merge_layer', [Add, Multiply, Average, Maximum, Minimum])
+def test_merge_n(data, merge_layer, io_type):
+    inp = Input(shape=(n_in,), name='input_1')
+    out = merge_layer(name='merge')(make_branches(inp, 6, n_branches))
+    model = Model(inputs=inp, outputs=out)
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<32,12>')
+    odir = str(test_root_path / 'hls4mlprj_merge_n_{}_{}'.format(merge_layer.__name__.lower(), io_type))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type=io_type, output_dir=odir)
+    hls_model.compile()
+
+    y_keras = model.predict(data)
+    y_hls = hls_model.predict(data).reshape(y_keras.shape)
+    np.testing.assert_allclose(y_keras, y_hls, rtol=0, atol=atol, verbose=True)
+
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+@pytest.mark.parametrize('axis', [1, 2, 3])
+def test_concatenate_n(axis, io_type):
+    inp = Input(shape=(3, 4, n_in), name='input_1')
+    n_out = [2, 3, 4] if axis == 3 else 5
+    out = Concatenate(axis=axis, name='concatenate')(make_branches(inp, n_out, 3))
+    model = Model(inputs=inp, outputs=out)
+    model.compile()
+
+    X = np.random.rand(100, 3, 4, n_in)
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<32,12>')
+    odir = str(test_root_path / 'hls4mlprj_concatenate_n_{}_{}'.format(axis, io_type))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type=io_type, output_dir=odir)
+    hls_model.compile()
+
+    y_keras = model.predict(X)
+    y_hls = hls_model.predict(X).reshape(y_keras.shape)
+    np.testing.assert_allclose(y_keras, y_hls, rtol=0, atol=atol, verbose=True)
+
+# At the default precision the sum of the inputs, or their product, leaves the range of the output before the
+# average (or the last input) brings it back
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+@pytest.mark.parametrize('merge_layer', [Add, Multiply, Average])
+def test_merge_n_accum(merge_layer, io_type):
+    inputs = [Input(shape=(n_in,), name='input_{}'.format(i + 1)) for i in range(3)]
+    out = merge_layer(name='merge')(inputs)
+    model = Model(inputs=inputs, outputs=out)
+    model.compile()
+
+    if merge_layer is Multiply:
+        X = [np.random.uniform(5, 6, (100, n_in)), np.random.uniform(6, 7, (100, n_in)), np.random.uniform(0.3, 0.5, (100, n_in))]
+    else:
+        X = [np.random.uniform(15, 20, (100, n_in)), np.random.uniform(15, 20, (100, n_in)), np.random.uniform(-20, -15, (100, n_in))]
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<16,6>')
+    odir = str(test_root_path / 'hls4mlprj_merge_n_accum_{}_{}'.format(merge_layer.__name__.lower(), io_type))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type=io_type, output_dir=odir)
+    hls_model.compile()
+
+    y_keras = model.predict(X)
+    y_hls = hls_model.predict([np.ascontiguousarray(x) for x in X]).reshape(y_keras.shape)
+    # The inputs are rounded to 10 fractional bits, and the product scales their error by up to 42
+    np.testing.assert_allclose(y_keras, y_hls, rtol=0, atol=0.05, verbose=True)
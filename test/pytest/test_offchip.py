@@ -0,0 +1,62 @@
+import pytest
+import hls4ml
+import numpy as np
+from tensorflow.keras.models import Sequential
+from tensorflow.keras.layers import Dense, Activation
+from pathlib import Path
+
+test_root_path = Path(__file__).parent
+
+@pytest.fixture(scope='module')
+def model():
+    model = Sequential()
+    model.add(Dense(50, input_shape=(40,), name='dense1'))
+    model.add(Activation('relu', name='relu1'))
+    model.add(Dense(10, name='dense2'))
+    model.compile()
+    return model
+
+@pytest.fixture(scope='module')
+def data():
+    return np.random.uniform(-2, 2, size=(100, 40))
+
+def convert(model, name, io_type, strategy, model_config={}, layer_config={}):
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<16,6>', granularity='name')
+    config['Model']['Strategy'] = strategy
+    config['Model']['ReuseFactor'] = 10 if strategy == 'Resource' else 1
+    config['Model'].update(model_config)
+    for layer, layer_conf in layer_config.items():
+        config['LayerName'][layer].update(layer_conf)
+    odir = str(test_root_path / 'hls4mlprj_offchip_{}_{}_{}'.format(name, io_type, strategy.lower()))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type=io_type, output_dir=odir)
+    hls_model.compile()
+    return hls_model
+
+# Tiles of 7 of the 50 neurons of dense1 leave a last tile of 1 neuron
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+@pytest.mark.parametrize('strategy', ['Latency', 'Resource'])
+@pytest.mark.parametrize('offchip', ['layer', 'factor'])
+def test_offchip_dense(model, data, io_type, strategy, offchip):
+    ref_model = convert(model, 'ref', io_type, strategy)
+    if offchip == 'layer':
+        hls_model = convert(model, offchip, io_type, strategy, layer_config={'dense1': {'WeightStorage': 'offchip', 'OffchipTile': 7}})
+        offchip_layers = ['dense1']
+    else:
+        hls_model = convert(model, offchip, io_type, strategy, model_config={'OffchipFactor': 100}, layer_config={'dense1': {'OffchipTile': 7}})
+        offchip_layers = ['dense1', 'dense2']
+
+    for name in ['dense1', 'dense2']:
+        assert (hls_model.graph[name].get_weights('weight').storage == 'offchip') == (name in offchip_layers)
+    assert hls_model.graph['dense1'].get_attr('offchip_tile') == 7
+
+    np.testing.assert_array_equal(hls_model.predict(data), ref_model.predict(data))
+
+# The board designs do not connect the m_axi port of the weights
+def test_offchip_accelerator(model):
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<16,6>', granularity='name')
+    config['LayerName']['dense1']['WeightStorage'] = 'offchip'
+    odir = str(test_root_path / 'hls4mlprj_offchip_accelerator')
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=odir,
+                                                           backend='VivadoAccelerator', board='alveo-u50')
+    with pytest.raises(Exception, match='off-chip'):
+        hls_model.write()
@@ -0,0 +1,36 @@
+import pytest
+import hls4ml
+import tensorflow as tf
+import numpy as np
+from pathlib import Path
+from tensorflow.keras.layers import Dense, Activation
+
+test_root_path = Path(__file__).parent
+
+def test_tune_precision():
+    model = tf.keras.models.Sequential()
+    model.add(Dense(16, input_shape=(8,), kernel_initializer='normal', bias_initializer='normal'))
+    model.add(Activation('relu'))
+    model.add(Dense(4, kernel_initializer='normal', bias_initializer='normal'))
+    model.compile(optimizer='adam', loss='mse')
+    X_input = np.random.rand(100, 8) * 4 - 2
+    keras_prediction = model.predict(X_input)
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<32,16>', granularity='name')
+    output_dir = str(test_root_path / 'hls4mlprj_tune_precision')
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=output_dir)
+
+    metric = lambda y, y_hls: -np.max(np.abs(y - y_hls))
+    tuned_config = hls4ml.utils.tune_precision(hls_model, X_input, keras_prediction, metric, min_score=-0.05, max_evaluations=12)
+
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=tuned_config, output_dir=output_dir)
+    hls_model.compile()
+    hls_prediction = hls_model.predict(X_input).reshape(keras_prediction.shape)
+    np.testing.assert_allclose(hls_prediction, keras_prediction, rtol=0, atol=0.05)
+
+    # Narrower than the starting precision everywhere
+    for layer in model.layers:
+        for var, precision in tuned_config['LayerName'][layer.name]['Precision'].items():
+            if var == 'default':
+                continue
+            assert hls4ml.backends.get_backend('Vivado').convert_precision_string(precision).width < 32
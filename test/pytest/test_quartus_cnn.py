@@ -0,0 +1,135 @@
+import pytest
+import hls4ml
+import numpy as np
+from tensorflow.keras.models import Model, Sequential
+from tensorflow.keras.layers import Input, Dense, Conv1D, Conv2D, MaxPooling1D, MaxPooling2D, AveragePooling1D, \
+                                    AveragePooling2D, GlobalMaxPooling1D, GlobalAveragePooling1D, ZeroPadding1D, \
+                                    ZeroPadding2D, Flatten, Add, Subtract, Multiply, Average, Maximum, Minimum, \
+                                    Concatenate
+from pathlib import Path
+
+test_root_path = Path(__file__).parent
+
+# The Quartus kernels are checked bit for bit against the Vivado kernels, both backends use the same precision
+
+def convert_both(model, name, strategy='Latency', reuse_factor=1, precision='ap_fixed<16,6>'):
+    hls_models = {}
+    for backend in ['Vivado', 'Quartus']:
+        config = hls4ml.utils.config_from_keras_model(model, default_precision=precision)
+        config['Model']['Strategy'] = strategy
+        config['Model']['ReuseFactor'] = reuse_factor
+        odir = str(test_root_path / 'hls4mlprj_quartus_cnn_{}_{}'.format(name, backend))
+        hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=odir, backend=backend)
+        hls_model.compile()
+        hls_models[backend] = hls_model
+    return hls_models['Vivado'], hls_models['Quartus']
+
+def check(model, X, name, **kwargs):
+    vivado_model, quartus_model = convert_both(model, name, **kwargs)
+    y_vivado = vivado_model.predict(X)
+    y_quartus = quartus_model.predict(X)
+    np.testing.assert_array_equal(y_quartus, y_vivado)
+
+@pytest.mark.parametrize('strategy,reuse_factor', [('Latency', 1), ('Resource', 1), ('Resource', 3)])
+@pytest.mark.parametrize('padding,strides', [('valid', 1), ('same', 1), ('same', 2)])
+def test_conv1d(strategy, reuse_factor, padding, strides):
+    model = Sequential()
+    model.add(Conv1D(4, 3, strides=strides, padding=padding, input_shape=(16, 3), name='conv1d'))
+    model.compile()
+
+    X = np.random.rand(50, 16, 3)
+    name = 'conv1d_{}{}_{}_{}'.format(strategy.lower(), reuse_factor, padding, strides)
+    check(model, X, name, strategy=strategy, reuse_factor=reuse_factor)
+
+@pytest.mark.parametrize('strategy,reuse_factor', [('Latency', 1), ('Resource', 1), ('Resource', 3)])
+@pytest.mark.parametrize('padding,strides', [('valid', 1), ('same', 1), ('same', 2)])
+def test_conv2d(strategy, reuse_factor, padding, strides):
+    model = Sequential()
+    model.add(Conv2D(4, (3, 3), strides=strides, padding=padding, input_shape=(8, 8, 3), name='conv2d'))
+    model.compile()
+
+    X = np.random.rand(50, 8, 8, 3)
+    name = 'conv2d_{}{}_{}_{}'.format(strategy.lower(), reuse_factor, padding, strides)
+    check(model, X, name, strategy=strategy, reuse_factor=reuse_factor)
+
+@pytest.mark.parametrize('pooling', [MaxPooling1D, AveragePooling1D, GlobalMaxPooling1D, GlobalAveragePooling1D])
+def test_pooling1d(pooling):
+    model = Sequential()
+    model.add(Conv1D(4, 3, input_shape=(18, 2), name='conv1d'))
+    model.add(pooling(name='pooling'))
+    model.compile()
+
+    X = np.random.rand(50, 18, 2)
+    check(model, X, 'pooling1d_{}'.format(pooling.__name__.lower()))
+
+@pytest.mark.parametrize('pooling', [MaxPooling2D, AveragePooling2D])
+def test_pooling2d(pooling):
+    model = Sequential()
+    model.add(Conv2D(4, (3, 3), input_shape=(10, 10, 2), name='conv2d'))
+    model.add(pooling(pool_size=(2, 2), name='pooling'))
+    model.add(Flatten(name='flatten'))
+    model.add(Dense(5, name='dense'))
+    model.compile()
+
+    X = np.random.rand(50, 10, 10, 2)
+    check(model, X, 'pooling2d_{}'.format(pooling.__name__.lower()))
+
+def test_zeropadding():
+    inp = Input(shape=(6, 6, 2), name='input_1')
+    x = ZeroPadding2D(padding=((1, 2), (2, 1)), name='zeropad2d')(inp)
+    x = Conv2D(3, (3, 3), name='conv2d')(x)
+    model = Model(inputs=inp, outputs=x)
+    model.compile()
+
+    X = np.random.rand(50, 6, 6, 2)
+    check(model, X, 'zeropadding2d')
+
+    model = Sequential()
+    model.add(ZeroPadding1D(padding=(2, 1), input_shape=(10, 2), name='zeropad1d'))
+    model.add(Conv1D(3, 3, name='conv1d'))
+    model.compile()
+
+    X = np.random.rand(50, 10, 2)
+    check(model, X, 'zeropadding1d')
+
+@pytest.mark.parametrize('merge_layer', [Add, Subtract, Multiply, Average, Maximum, Minimum, Concatenate])
+@pytest.mark.parametrize('n_inputs', [2, 3])
+def test_merge(merge_layer, n_inputs):
+    if merge_layer is Subtract and n_inputs > 2:
+        pytest.skip('Subtract only takes two inputs')
+    inp = Input(shape=(6, 6, 2), name='input_1')
+    branches = [Conv2D(3, (3, 3), name='conv2d_{}'.format(i))(inp) for i in range(n_inputs)]
+    out = merge_layer(name='merge')(branches)
+    model = Model(inputs=inp, outputs=out)
+    model.compile()
+
+    X = np.random.rand(50, 6, 6, 2)
+    check(model, X, 'merge_{}_{}'.format(merge_layer.__name__.lower(), n_inputs))
+
+# The Resource strategy runs on native integers in the C simulation, the rounding and saturation must not change.
+# The products of 40-bit values do not fit the native integers and run through the ac_fixed kernels
+@pytest.mark.parametrize('precision', ['ap_fixed<16,6>', 'ap_fixed<12,4,AP_RND_CONV,AP_SAT>',
+                                       'ap_fixed<10,3,AP_RND_ZERO,AP_SAT_SYM>', 'ap_ufixed<10,3,AP_RND_INF,AP_SAT>',
+                                       'ap_fixed<40,12>'])
+@pytest.mark.parametrize('reuse_factor', [1, 2, 16, 64])
+def test_dense_precision(precision, reuse_factor):
+    model = Sequential()
+    model.add(Dense(16, input_shape=(4,), name='dense'))
+    model.compile()
+    model.set_weights([w * 8 for w in model.get_weights()])
+
+    X = np.random.uniform(-4, 4, size=(100, 4))
+    name = 'dense_{}_{}'.format(''.join(c if c.isalnum() else '_' for c in precision), reuse_factor)
+    check(model, X, name, strategy='Resource', reuse_factor=reuse_factor, precision=precision)
+
+# Exponential weights have no native integer model, the Resource strategy must fall back to the ac_types kernels
+@pytest.mark.parametrize('strategy,reuse_factor', [('Latency', 1), ('Resource', 1), ('Resource', 4), ('Resource', 32)])
+def test_dense_po2(strategy, reuse_factor):
+    from qkeras.qlayers import QDense
+    from qkeras.quantizers import quantized_po2
+    model = Sequential()
+    model.add(QDense(8, input_shape=(16,), name='dense', kernel_quantizer=quantized_po2(4, 1)))
+    model.compile()
+
+    X = np.random.uniform(-2, 2, size=(100, 16))
+    check(model, X, 'dense_po2_{}{}'.format(strategy.lower(), reuse_factor), strategy=strategy, reuse_factor=reuse_factor)
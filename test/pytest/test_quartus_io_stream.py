@@ -0,0 +1,83 @@
+import pytest
+import hls4ml
+import numpy as np
+from tensorflow.keras.models import Model, Sequential
+from tensorflow.keras.layers import Input, Dense, Activation, BatchNormalization, Conv1D, Conv2D, MaxPooling1D, \
+                                    AveragePooling2D, GlobalAveragePooling1D, GlobalMaxPooling2D, ZeroPadding2D, \
+                                    Flatten, Reshape, Add, Concatenate
+from pathlib import Path
+
+test_root_path = Path(__file__).parent
+
+# The streaming kernels compute the same values as the io_parallel ones, only the interface differs
+
+def convert_both(model, name, strategy='Latency', reuse_factor=1):
+    hls_models = {}
+    for io_type in ['io_parallel', 'io_stream']:
+        config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<16,6>')
+        config['Model']['Strategy'] = strategy
+        config['Model']['ReuseFactor'] = reuse_factor
+        odir = str(test_root_path / 'hls4mlprj_quartus_io_stream_{}_{}'.format(name, io_type))
+        hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=odir, io_type=io_type, backend='Quartus')
+        hls_model.compile()
+        hls_models[io_type] = hls_model
+    return hls_models['io_parallel'], hls_models['io_stream']
+
+def check(model, X, name, **kwargs):
+    parallel_model, stream_model = convert_both(model, name, **kwargs)
+    y_parallel = parallel_model.predict(X)
+    y_stream = stream_model.predict(X)
+    np.testing.assert_array_equal(y_stream, y_parallel)
+
+@pytest.mark.parametrize('strategy,reuse_factor', [('Latency', 1), ('Resource', 3)])
+def test_conv2d(strategy, reuse_factor):
+    model = Sequential()
+    model.add(ZeroPadding2D(padding=((1, 0), (0, 1)), input_shape=(8, 8, 3), name='zeropad2d'))
+    model.add(Conv2D(4, (3, 3), padding='same', name='conv2d_1'))
+    model.add(BatchNormalization(name='bn'))
+    model.add(Activation('relu', name='relu'))
+    model.add(Conv2D(4, (3, 3), strides=2, name='conv2d_2'))
+    model.add(AveragePooling2D(pool_size=(2, 2), name='pooling'))
+    model.add(Flatten(name='flatten'))
+    model.add(Dense(5, name='dense'))
+    model.add(Activation('sigmoid', name='sigmoid'))
+    model.compile()
+
+    X = np.random.rand(20, 8, 8, 3)
+    check(model, X, 'conv2d_{}{}'.format(strategy.lower(), reuse_factor), strategy=strategy, reuse_factor=reuse_factor)
+
+def test_conv1d():
+    model = Sequential()
+    model.add(Conv1D(4, 3, padding='same', input_shape=(16, 3), name='conv1d_1'))
+    model.add(MaxPooling1D(pool_size=2, name='pooling'))
+    model.add(Conv1D(5, 2, name='conv1d_2'))
+    model.add(GlobalAveragePooling1D(name='global_pooling'))
+    model.compile()
+
+    X = np.random.rand(20, 16, 3)
+    check(model, X, 'conv1d')
+
+def test_branches():
+    inp = Input(shape=(6, 6, 2), name='input_1')
+    x = Conv2D(4, (3, 3), padding='same', name='conv2d_1')(inp)
+    y = Conv2D(4, (3, 3), padding='same', name='conv2d_2')(x)
+    x = Add(name='add')([x, y])
+    x = Concatenate(name='concatenate')([x, y])
+    x = GlobalMaxPooling2D(name='global_pooling')(x)
+    model = Model(inputs=inp, outputs=x)
+    model.compile()
+
+    X = np.random.rand(20, 6, 6, 2)
+    check(model, X, 'branches')
+
+def test_reshape():
+    model = Sequential()
+    model.add(Dense(12, input_shape=(8,), name='dense_1'))
+    model.add(Reshape((3, 4), name='reshape'))
+    model.add(Conv1D(3, 2, name='conv1d'))
+    model.add(Flatten(name='flatten'))
+    model.add(Dense(4, name='dense_2'))
+    model.compile()
+
+    X = np.random.rand(20, 8)
+    check(model, X, 'reshape')
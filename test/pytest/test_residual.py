@@ -0,0 +1,99 @@
+import pytest
+import hls4ml
+import numpy as np
+from tensorflow.keras.models import Model
+from tensorflow.keras.layers import Input, Conv2D, Conv2DTranspose, MaxPooling2D, Activation, Add, Concatenate
+from pathlib import Path
+
+test_root_path = Path(__file__).parent
+
+in_shape = (8, 8, 4)
+
+atol = 5e-3
+
+@pytest.fixture(scope='module')
+def data():
+    X = np.random.rand(10, *in_shape)
+    return X
+
+def residual_block(merge):
+    inp = Input(shape=in_shape, name='input_1')
+    x = Conv2D(in_shape[-1], (3, 3), padding='same', name='conv_1')(inp)
+    x = Activation('relu', name='relu_1')(x)
+    x = Conv2D(in_shape[-1], (3, 3), padding='same', name='conv_2')(x)
+    if merge == 'add':
+        out = Add(name='merge')([x, inp])
+    else:
+        out = Concatenate(axis=int(merge[-1]), name='merge')([x, inp])
+    return Model(inputs=inp, outputs=out)
+
+@pytest.mark.parametrize('merge', ['add', 'concatenate_1', 'concatenate_3'])
+def test_residual_bypass_depth(data, merge):
+    model = residual_block(merge)
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<32,16>')
+    odir = str(test_root_path / 'hls4mlprj_residual_{}'.format(merge))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type='io_stream', output_dir=odir)
+    hls_model.compile()
+
+    # The bypass only has to hold the words written while the convolutions fill their line buffers
+    clone = [layer for layer in hls_model.get_layers() if layer.class_name == 'Clone'][0]
+    bypass = clone.get_output_variable(clone.outputs[-1])
+    n_words = np.prod(in_shape[:-1])
+    if merge == 'concatenate_1':
+        assert bypass.pragma[1] == n_words
+    else:
+        assert bypass.pragma[1] < n_words
+
+    y_keras = model.predict(data)
+    y_hls = hls_model.predict(data).reshape(y_keras.shape)
+    y_threaded = hls_model.predict_threaded(data).reshape(y_keras.shape)
+    np.testing.assert_allclose(y_keras, y_hls, rtol=0, atol=atol, verbose=True)
+    np.testing.assert_array_equal(y_hls, y_threaded)
+
+def test_residual_deadlock(data):
+    model = residual_block('add')
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<32,16>')
+    odir = str(test_root_path / 'hls4mlprj_residual_deadlock')
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type='io_stream', output_dir=odir)
+    hls_model.compile()
+
+    clone = [layer for layer in hls_model.get_layers() if layer.class_name == 'Clone'][0]
+    for output in clone.outputs:
+        clone.get_output_variable(output).pragma = ('stream', 1)
+
+    with pytest.raises(Exception, match='deadlocked'):
+        hls_model.predict_threaded(data[:1])
+
+@pytest.mark.parametrize('kernel_size,strides,padding', [((2, 2), 2, 'valid'), ((3, 3), 1, 'same'), ((5, 5), 1, 'same')])
+def test_transpose_stream_fill(data, kernel_size, strides, padding):
+    inp = Input(shape=in_shape, name='input_1')
+    x = Conv2DTranspose(in_shape[-1], kernel_size, strides=strides, padding=padding, name='conv2d_transpose')(inp)
+    if strides > 1:
+        x = MaxPooling2D(strides, name='pool')(x)
+    out = Add(name='merge')([x, inp])
+    model = Model(inputs=inp, outputs=out)
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<32,16>')
+    odir = str(test_root_path / 'hls4mlprj_residual_transpose_{}_{}_{}'.format(kernel_size[0], strides, padding))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type='io_stream', output_dir=odir)
+    hls_model.compile()
+
+    # The transposed convolution writes its first output rows after reading the whole input row of their window
+    layer = hls_model.graph['conv2d_transpose']
+    fill = hls_model.config.backend.estimate_stream_fill(layer)
+    assert fill == (layer.get_attr('crop_top') // strides + 1) * in_shape[1]
+
+    # The bypass holds all but the last word read before then, which waits in the other output of the clone
+    clone = [layer for layer in hls_model.get_layers() if layer.class_name == 'Clone'][0]
+    bypass = clone.get_output_variable(clone.outputs[-1])
+    y_hls = hls_model.predict(data)
+    bypass.pragma = ('stream', fill - 1)
+    np.testing.assert_array_equal(y_hls, hls_model.predict_threaded(data))
+    bypass.pragma = ('stream', fill - 2)
+    with pytest.raises(Exception, match='deadlocked'):
+        hls_model.predict_threaded(data[:1])
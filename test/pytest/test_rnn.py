@@ -56,3 +56,114 @@ def test_rnn_parsing(rnn_layer, return_sequences):
     np.testing.assert_array_equal(hls_weights[0].data, rnn_weights[0])
     np.testing.assert_array_equal(hls_weights[2].data, rnn_weights[1])
     np.testing.assert_array_equal(hls_weights[1].data, rnn_weights[2])
+
+@pytest.mark.parametrize('rnn_layer', rnn_layers)
+@pytest.mark.parametrize('return_sequences', [True, False])
+@pytest.mark.parametrize('implementation', ['Sequential', 'Pipelined'])
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+def test_rnn_accuracy(rnn_layer, return_sequences, implementation, io_type):
+    if rnn_layer is SimpleRNN and implementation == 'Pipelined':
+        pytest.skip('SimpleRNN only has the sequential implementation')
+
+    time_steps = 5
+    input_size = 4
+    input_shape = (time_steps, input_size)
+
+    model_input = Input(shape=input_shape)
+    model_output = rnn_layer(8, return_sequences=return_sequences)(model_input)
+
+    model = Model(model_input, model_output)
+    model.compile(optimizer='adam', loss='mse')
+
+    X_input = np.random.rand(50, time_steps, input_size) * 2 - 1
+    keras_prediction = model.predict(X_input)
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<24,8>', granularity='name')
+    config['LayerName'][model.layers[1].name]['RecurrentReuseFactor'] = 2
+    config['LayerName'][model.layers[1].name]['RecurrentImplementation'] = implementation
+    prj_name = 'hls4mlprj_rnn_accuracy_{}_seq_{}_{}_{}'.format(
+        rnn_layer.__name__.lower(),
+        int(return_sequences),
+        implementation.lower(),
+        io_type
+    )
+    output_dir = str(test_root_path / prj_name)
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=output_dir, io_type=io_type)
+    hls_model.compile()
+
+    hls_prediction = hls_model.predict(X_input).reshape(keras_prediction.shape)
+    np.testing.assert_allclose(hls_prediction, keras_prediction, rtol=0, atol=5e-2)
+
+@pytest.mark.parametrize('rnn_layer', rnn_layers)
+@pytest.mark.parametrize('strategy', ['Latency', 'Resource'])
+def test_rnn_batch_predict(rnn_layer, strategy):
+    time_steps = 5
+    input_size = 4
+    input_shape = (time_steps, input_size)
+
+    model_input = Input(shape=input_shape)
+    model_output = rnn_layer(8, return_sequences=True)(model_input)
+
+    model = Model(model_input, model_output)
+    model.compile(optimizer='adam', loss='mse')
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<24,8>', granularity='name')
+    config['Model']['Strategy'] = strategy
+    config['Model']['ReuseFactor'] = 2
+    prj_name = 'hls4mlprj_rnn_batch_{}_{}'.format(rnn_layer.__name__.lower(), strategy.lower())
+    output_dir = str(test_root_path / prj_name)
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=output_dir, io_type='io_parallel')
+    hls_model.compile()
+
+    X_input = np.ascontiguousarray(np.random.rand(20, time_steps, input_size) * 2 - 1)
+    keras_prediction = model.predict(X_input)
+
+    # The batch is simulated in one call, each sample on its own goes through the top function
+    hls_prediction = hls_model.predict(X_input).reshape(keras_prediction.shape)
+    hls_prediction_single = np.array([hls_model.predict(np.ascontiguousarray(x)) for x in X_input]).reshape(keras_prediction.shape)
+
+    np.testing.assert_array_equal(hls_prediction, hls_prediction_single)
+    np.testing.assert_allclose(hls_prediction, keras_prediction, rtol=0, atol=5e-2)
+
+@pytest.mark.parametrize('rnn_layer', rnn_layers)
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+def test_rnn_stateful(rnn_layer, io_type):
+    chunk_steps = 3
+    n_chunks = 2
+    input_size = 4
+
+    # Same weights, one model for the whole sequence and one for a chunk of it
+    layer = rnn_layer(6, return_sequences=True)
+    full_input = Input(shape=(chunk_steps * n_chunks, input_size))
+    full_model = Model(full_input, layer(full_input))
+    chunk_input = Input(shape=(chunk_steps, input_size))
+    chunk_model = Model(chunk_input, layer(chunk_input))
+
+    def convert(model, name):
+        config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<24,8>', granularity='name')
+        output_dir = str(test_root_path / 'hls4mlprj_rnn_stateful_{}_{}_{}'.format(rnn_layer.__name__.lower(), io_type, name))
+        hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=output_dir, io_type=io_type)
+        hls_model.compile()
+        return hls_model
+
+    hls_full = convert(full_model, 'full')
+    hls_chunk = convert(chunk_model, 'chunk')
+
+    X_input = np.ascontiguousarray(np.random.rand(2, chunk_steps * n_chunks, input_size) * 2 - 1)
+    full_prediction = [hls_full.predict(np.ascontiguousarray(x)).reshape(-1) for x in X_input]
+
+    # Two streams stepped in turns, each continuing from its own state
+    states = [hls_chunk.create_state() for x in X_input]
+    chunk_prediction = [[], []]
+    for i_chunk in range(n_chunks):
+        for x, state, pred in zip(X_input, states, chunk_prediction):
+            chunk = np.ascontiguousarray(x[i_chunk * chunk_steps:(i_chunk + 1) * chunk_steps])
+            pred.append(state.step(chunk).reshape(-1))
+
+    for full, chunks in zip(full_prediction, chunk_prediction):
+        np.testing.assert_array_equal(np.concatenate(chunks), full)
+
+    # After a reset the state starts from zero again
+    states[0].reset()
+    first_chunk = np.ascontiguousarray(X_input[0, :chunk_steps])
+    np.testing.assert_array_equal(states[0].step(first_chunk), hls_chunk.predict(first_chunk))
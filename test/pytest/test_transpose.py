@@ -0,0 +1,57 @@
+import pytest
+import hls4ml
+import numpy as np
+from pathlib import Path
+from tensorflow.keras.models import Sequential
+from tensorflow.keras.layers import Permute, Flatten, Dense, Reshape
+
+test_root_path = Path(__file__).parent
+
+in_shape = (4, 3, 5)
+
+@pytest.fixture(scope='module')
+def data():
+    X = np.random.rand(100, *in_shape)
+    return X
+
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+@pytest.mark.parametrize('dims', [(1, 3, 2), (2, 1, 3), (2, 3, 1), (3, 1, 2), (3, 2, 1)])
+def test_permute(data, dims, io_type):
+    model = Sequential()
+    model.add(Permute(dims, input_shape=in_shape))
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<16,6>', granularity='name')
+    dims_str = ''.join(str(d) for d in dims)
+    odir = str(test_root_path / f'hls4mlprj_permute_{dims_str}_{io_type}')
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type=io_type, output_dir=odir)
+    hls_model.compile()
+
+    y_keras = model.predict(data).flatten()
+    y_hls = hls_model.predict(data).flatten()
+    np.testing.assert_allclose(y_keras, y_hls, rtol=0, atol=1e-3, verbose=True)
+
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+def test_permute_folded_into_dense(data, io_type):
+    n_in = int(np.prod(in_shape))
+    model = Sequential()
+    model.add(Permute((3, 1, 2), input_shape=in_shape))
+    model.add(Flatten())
+    model.add(Dense(n_in, name='dense1'))
+    model.add(Reshape(in_shape))
+    model.add(Permute((2, 3, 1)))
+    model.add(Flatten())
+    model.add(Dense(8, name='dense2'))
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<24,10>', granularity='name')
+    odir = str(test_root_path / f'hls4mlprj_permute_dense_{io_type}')
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type=io_type, output_dir=odir)
+    hls_model.compile()
+
+    # All transposes are absorbed in the order of the weights of the Dense layers
+    assert not any(layer.class_name == 'Transpose' for layer in hls_model.get_layers())
+
+    y_keras = model.predict(data).flatten()
+    y_hls = hls_model.predict(data).flatten()
+    np.testing.assert_allclose(y_keras, y_hls, rtol=0, atol=1e-2, verbose=True)
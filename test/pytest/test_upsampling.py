@@ -1,6 +1,6 @@
 import pytest
 from tensorflow.keras.models import Sequential
-from tensorflow.keras.layers import UpSampling1D, UpSampling2D
+from tensorflow.keras.layers import UpSampling1D, UpSampling2D, Resizing
 import numpy as np
 import hls4ml
 from pathlib import Path
@@ -65,3 +65,49 @@ def test_upsampling(keras_model_1d, keras_model_2d, data_1d, data_2d, model_type
     y_keras = model.predict(data).flatten()
     y_hls = hls_model.predict(data).flatten()
     np.testing.assert_allclose(y_keras, y_hls, rtol=0, atol=atol, verbose=True)
+
+
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+@pytest.mark.parametrize('interpolation', ['nearest', 'bilinear'])
+@pytest.mark.parametrize('new_height,new_width', [(12, 16), (9, 13), (4, 5)])
+def test_resizing(data_2d, new_height, new_width, interpolation, io_type):
+    model = Sequential()
+    model.add(Resizing(new_height, new_width, interpolation=interpolation, input_shape=(in_height, in_width, in_feat)))
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model,
+                                                  default_precision='ap_fixed<16,2>',
+                                                  granularity='name')
+    odir = str(test_root_path / f'hls4mlprj_resizing_{new_height}x{new_width}_{interpolation}_{io_type}')
+    hls_model = hls4ml.converters.convert_from_keras_model(model,
+                                                           hls_config=config,
+                                                           io_type=io_type,
+                                                           output_dir=odir,
+                                                           part='xcvu9p-flgb2104-2-i')
+    hls_model.compile()
+
+    y_keras = model.predict(data_2d).flatten()
+    y_hls = hls_model.predict(data_2d).flatten()
+    np.testing.assert_allclose(y_keras, y_hls, rtol=0, atol=atol, verbose=True)
+
+
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+def test_upsampling_bilinear(data_2d, io_type):
+    model = Sequential()
+    model.add(UpSampling2D(input_shape=(in_height, in_width, in_feat), size=(size, size), interpolation='bilinear'))
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model,
+                                                  default_precision='ap_fixed<16,2>',
+                                                  granularity='name')
+    odir = str(test_root_path / f'hls4mlprj_upsampling_bilinear_{io_type}')
+    hls_model = hls4ml.converters.convert_from_keras_model(model,
+                                                           hls_config=config,
+                                                           io_type=io_type,
+                                                           output_dir=odir,
+                                                           part='xcvu9p-flgb2104-2-i')
+    hls_model.compile()
+
+    y_keras = model.predict(data_2d).flatten()
+    y_hls = hls_model.predict(data_2d).flatten()
+    np.testing.assert_allclose(y_keras, y_hls, rtol=0, atol=atol, verbose=True)
@@ -0,0 +1,136 @@
+import pytest
+import hls4ml
+import numpy as np
+import subprocess
+import importlib.util
+from tensorflow.keras.models import Sequential
+from tensorflow.keras.layers import Dense, Activation
+from pathlib import Path
+from hls4ml.backends.vivado_accelerator.vivado_accelerator_config import VivadoAcceleratorConfig
+
+test_root_path = Path(__file__).parent
+
+@pytest.fixture(scope='module')
+def model():
+    model = Sequential()
+    model.add(Dense(8, input_shape=(16,), name='dense1'))
+    model.add(Activation('relu', name='relu1'))
+    model.add(Dense(4, name='dense2'))
+    model.compile()
+    return model
+
+@pytest.fixture(scope='module')
+def data():
+    return np.random.uniform(-2, 2, size=(200, 16)).astype(np.float32)
+
+def convert(model, name, io_type, **kwargs):
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<16,6>')
+    odir = str(test_root_path / 'hls4mlprj_accelerator_{}_{}'.format(name, io_type))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type=io_type, output_dir=odir,
+                                                           backend='VivadoAccelerator', **kwargs)
+    hls_model.compile()
+    return hls_model
+
+# The host program drives the C simulation library through the same runtime as the hardware
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+@pytest.mark.parametrize('batch', [False, True])
+def test_host_csim(model, data, io_type, batch):
+    hls_model = convert(model, 'host_batch' if batch else 'host', io_type, driver='c', batch=batch)
+    y = hls_model.predict(data)
+
+    odir = Path(hls_model.config.get_output_dir())
+    np.savetxt(odir / 'tb_data' / 'host_input.dat', data, fmt='%.9g')
+    subprocess.run(['bash', 'build_host.sh'], cwd=odir, check=True)
+
+    # Batches of 32 leave a partial last batch, with 1 slot each batch waits for the previous one
+    for slots in [1, 2, 3]:
+        output = 'tb_data/host_results_{}.log'.format(slots)
+        subprocess.run(['./myproject_host_csim', '--input', 'tb_data/host_input.dat', '--output', output,
+                        '--batch', '32', '--slots', str(slots)], cwd=odir, check=True)
+        y_host = np.loadtxt(odir / output)
+        np.testing.assert_array_equal(y_host.astype(np.float32), y.reshape(y_host.shape).astype(np.float32))
+
+    result = subprocess.run(['./myproject_host_csim', '--benchmark', '1000', '--batch', '64', '--slots', '2'], cwd=odir,
+                            check=True, capture_output=True, text=True)
+    assert 'Processed 1000 events' in result.stdout
+
+# The events of a transfer run through the TLAST batch wrapper, 3 values per beat pad the 16 inputs and the 4 outputs
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+@pytest.mark.parametrize('packing', [1, 3])
+def test_batch_wrapper(model, data, io_type, packing):
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<16,6>')
+    odir = str(test_root_path / 'hls4mlprj_accelerator_ref_{}'.format(io_type))
+    ref_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type=io_type, output_dir=odir)
+    ref_model.compile()
+
+    hls_model = convert(model, 'batch_pack{}'.format(packing), io_type, batch=True, packing=packing,
+                        input_type='ap_fixed<16,6>', output_type='ap_fixed<16,6>')
+    np.testing.assert_array_equal(hls_model.predict(data), ref_model.predict(data))
+    np.testing.assert_array_equal(hls_model.predict(data[:1]).reshape(1, -1), ref_model.predict(data[:1]).reshape(1, -1))
+
+codec_path = Path(hls4ml.__file__).parent / 'templates' / 'vivado_accelerator' / 'python_drivers' / 'axi_stream_codec.py'
+codec_spec = importlib.util.spec_from_file_location('axi_stream_codec', codec_path)
+codec = importlib.util.module_from_spec(codec_spec)
+codec_spec.loader.exec_module(codec)
+
+# 5 values per event in beats of 4 values leave 3 words of padding
+@pytest.mark.parametrize('dtype, fractional', [(np.int16, 10), (np.uint8, 4), (np.int32, 16), (np.uint16, 0)])
+def test_codec_round_trip(dtype, fractional):
+    raw = np.random.randint(np.iinfo(dtype).min, np.iinfo(dtype).max, size=(10, 5), dtype=dtype)
+    X = raw * 2.0 ** -fractional
+    words = codec.encode_events(X, 5, 4, (dtype, fractional, False, False))
+    assert words.dtype == dtype and words.shape == (10, 8)
+    np.testing.assert_array_equal(words[:, :5], raw)
+    np.testing.assert_array_equal(words[:, 5:], 0)
+    np.testing.assert_array_equal(codec.decode_events(words, 5, (dtype, fractional, False, False)), X)
+
+@pytest.mark.parametrize('dtype', [np.int8, np.uint8])
+@pytest.mark.parametrize('rounding', [False, True])
+@pytest.mark.parametrize('saturation', [False, True])
+def test_codec_quantization(dtype, rounding, saturation):
+    fixed = (dtype, 2, rounding, saturation)
+    info = np.iinfo(dtype)
+    # 0.2 and 0.8 of a step above a value of the grid, their opposites if signed, and 4 steps past both ends of the range
+    X = np.array([[1.25 + 0.2 / 4, 1.25 + 0.8 / 4, (info.max + 4) / 4, (info.min - 4) / 4]])
+    if info.min < 0:
+        X = np.concatenate([X, -X[:, :2]], axis=1)
+    y = codec.decode_events(codec.encode_events(X, X.shape[1], 1, fixed), X.shape[1], fixed)
+
+    raw = np.floor(X * 4 + (0.5 if rounding else 0.0))
+    if saturation:
+        raw = np.clip(raw, info.min, info.max)
+    else:
+        raw = (raw - info.min) % (info.max - info.min + 1) + info.min
+    np.testing.assert_array_equal(y, raw / 4)
+    assert y[0, 1] == (1.5 if rounding else 1.25)
+
+# Bus of 64, 128 and 512 bits for the pynq-z2, the zcu102 and the Alveo, 16 inputs and 4 outputs
+@pytest.mark.parametrize('board, precision, packing', [('pynq-z2', 'ap_fixed<16,6>', (4, 4)),
+                                                       ('pynq-z2', 'ap_fixed<8,3>', (8, 4)),
+                                                       ('zcu102', 'ap_fixed<16,6>', (8, 4)),
+                                                       ('zcu102', 'float', (1, 1)),
+                                                       ('alveo-u50', 'ap_fixed<16,6>', (16, 16)),
+                                                       ('alveo-u50', 'float', (1, 1))])
+def test_auto_pack(model, board, precision, packing):
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<16,6>')
+    odir = str(test_root_path / 'hls4mlprj_accelerator_auto_{}'.format(board))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=odir,
+                                                           backend='VivadoAccelerator', board=board, batch=True,
+                                                           packing='auto', input_type=precision, output_type=precision)
+    accel_config = VivadoAcceleratorConfig(hls_model.config, hls_model.get_input_variables(),
+                                           hls_model.get_output_variables())
+    assert accel_config.get_packing() == packing
+
+# The Alveo kernel moves the beats of both streams through one memory port
+@pytest.mark.parametrize('packing, output_type', [({'Input': 'auto', 'Output': 2}, 'ap_fixed<16,6>'),
+                                                  ('auto', 'float'),
+                                                  (1, 'float')])
+def test_alveo_beat_width(model, packing, output_type):
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<16,6>')
+    odir = str(test_root_path / 'hls4mlprj_accelerator_alveo_beat')
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=odir,
+                                                           backend='VivadoAccelerator', board='alveo-u50', batch=True,
+                                                           packing=packing, input_type='ap_fixed<16,6>',
+                                                           output_type=output_type)
+    with pytest.raises(Exception, match='same width'):
+        VivadoAcceleratorConfig(hls_model.config, hls_model.get_input_variables(), hls_model.get_output_variables())